@@ -2,6 +2,10 @@
 
 #include <cpuinfo.h>
 
+extern "C" {
+#include <linux/getcpu.h>
+}
+
 static void cpuinfo_get_current_processor(benchmark::State& state) {
 	cpuinfo_initialize();
 	while (state.KeepRunning()) {
@@ -38,4 +42,24 @@ static void cpuinfo_get_current_uarch_index_with_default(benchmark::State& state
 }
 BENCHMARK(cpuinfo_get_current_uarch_index_with_default)->Unit(benchmark::kNanosecond);
 
+static void linux_getcpu(benchmark::State& state, enum cpuinfo_linux_getcpu_method method) {
+	cpuinfo_initialize();
+	const cpuinfo_linux_getcpu_function getcpu = cpuinfo_linux_probe_getcpu_method(method);
+	if (getcpu == nullptr) {
+		state.SkipWithError("getcpu method is not supported");
+		return;
+	}
+	while (state.KeepRunning()) {
+		uint32_t cpu;
+		getcpu(&cpu);
+		benchmark::DoNotOptimize(cpu);
+	}
+}
+BENCHMARK_CAPTURE(linux_getcpu, rseq, cpuinfo_linux_getcpu_method_rseq)->Unit(benchmark::kNanosecond);
+BENCHMARK_CAPTURE(linux_getcpu, vdso, cpuinfo_linux_getcpu_method_vdso)->Unit(benchmark::kNanosecond);
+BENCHMARK_CAPTURE(linux_getcpu, rdpid, cpuinfo_linux_getcpu_method_rdpid)->Unit(benchmark::kNanosecond);
+BENCHMARK_CAPTURE(linux_getcpu, rdtscp, cpuinfo_linux_getcpu_method_rdtscp)->Unit(benchmark::kNanosecond);
+BENCHMARK_CAPTURE(linux_getcpu, syscall, cpuinfo_linux_getcpu_method_syscall)
+	->Unit(benchmark::kNanosecond);
+
 BENCHMARK_MAIN();
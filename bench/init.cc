@@ -1,12 +1,59 @@
 #include <benchmark/benchmark.h>
 
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
 #include <cpuinfo.h>
 
 static void cpuinfo_initialize(benchmark::State& state) {
 	while (state.KeepRunning()) {
 		cpuinfo_initialize();
+		cpuinfo_deinitialize();
+	}
+}
+BENCHMARK(cpuinfo_initialize)->Unit(benchmark::kMicrosecond);
+
+#if defined(__linux__)
+/* Per-processor detection runs on multiple threads only if the library is built with CPUINFO_PARALLEL_INIT */
+static void cpuinfo_initialize_parallel(benchmark::State& state) {
+	const std::string threads = std::to_string(state.range(0));
+	setenv("CPUINFO_PARALLEL_INIT", threads.c_str(), 1);
+	while (state.KeepRunning()) {
+		cpuinfo_initialize();
+		cpuinfo_deinitialize();
+	}
+	unsetenv("CPUINFO_PARALLEL_INIT");
+}
+BENCHMARK(cpuinfo_initialize_parallel)->Unit(benchmark::kMicrosecond)->Arg(1)->Arg(4)->Arg(16);
+
+static void cpuinfo_initialize_from_snapshot(benchmark::State& state) {
+	const char* temp_dir = getenv("TMPDIR");
+	const std::string path = std::string(temp_dir != nullptr ? temp_dir : "/tmp") + "/cpuinfo-init-bench-" +
+		std::to_string(getpid()) + ".snapshot";
+	if (!cpuinfo_initialize()) {
+		state.SkipWithError("failed to initialize cpuinfo");
+		return;
+	}
+	const bool saved = cpuinfo_save_snapshot(path.c_str());
+	cpuinfo_deinitialize();
+	if (!saved) {
+		std::remove(path.c_str());
+		state.SkipWithError("failed to save topology snapshot");
+		return;
+	}
+
+	while (state.KeepRunning()) {
+		cpuinfo_initialize_from_snapshot(path.c_str());
+		cpuinfo_deinitialize();
 	}
+	std::remove(path.c_str());
 }
-BENCHMARK(cpuinfo_initialize)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(cpuinfo_initialize_from_snapshot)->Unit(benchmark::kMicrosecond);
+#endif
 
 BENCHMARK_MAIN();
@@ -0,0 +1,31 @@
+#include <benchmark/benchmark.h>
+
+#include <cpuinfo.h>
+
+extern "C" {
+#include <cpuinfo/internal-api.h>
+}
+
+/* cpuinfo_initialize_isa detects the ISA only once, so measure the detection routine behind it */
+static void cpuinfo_initialize_isa(benchmark::State& state) {
+	while (state.KeepRunning()) {
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+		cpuinfo_x86_init_isa();
+#elif CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+		cpuinfo_arm_linux_init_isa();
+#elif CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+		cpuinfo_riscv_linux_init_isa();
+#endif
+	}
+}
+BENCHMARK(cpuinfo_initialize_isa)->Unit(benchmark::kMicrosecond);
+
+static void cpuinfo_initialize(benchmark::State& state) {
+	while (state.KeepRunning()) {
+		cpuinfo_initialize();
+		cpuinfo_deinitialize();
+	}
+}
+BENCHMARK(cpuinfo_initialize)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
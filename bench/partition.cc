@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+/*
+ * Synthetic 1+3+4 phone layout: one prime core, three performance cores, and
+ * four efficiency cores, with capacities mocked in sysfs and detected by
+ * cpuinfo. Slower cores are emulated by repeating the work of each item in
+ * proportion to the inverse of their detected capacity.
+ */
+static const uint32_t cores_count = 8;
+static const uint32_t capacities[cores_count] = {1024, 640, 640, 640, 256, 256, 256, 256};
+static const uint64_t range_size = 1 << 16;
+
+/* Processor with 8 cores without SMT, and x2APIC IDs equal to Linux processor numbers */
+static cpuinfo_mock_cpuid cpuid_dump[] = {
+	{0x00000000, 0, 0x0000000B, 0x756E6547, 0x6C65746E, 0x49656E69},
+	{0x00000001, 0, 0x000606A6, 0x00080800, 0x7FFEFBFF, 0xBFEBFBFF},
+	{0x00000004, 0, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x0000000B, 0, 0x00000000, 0x00000001, 0x00000100, 0x00000000},
+	{0x0000000B, 1, 0x00000003, 0x00000008, 0x00000201, 0x00000000},
+	{0x0000000B, 2, 0x00000000, 0x00000000, 0x00000002, 0x00000000},
+};
+
+static std::vector<std::string> paths, contents;
+static std::vector<cpuinfo_mock_file> filesystem;
+
+static void mock_phone_layout() {
+	const std::string cpulist = "0-" + std::to_string(cores_count - 1) + "\n";
+	paths.push_back("/sys/devices/system/cpu/kernel_max");
+	contents.push_back(std::to_string(cores_count - 1) + "\n");
+	for (const char* list : {"possible", "present", "online"}) {
+		paths.push_back(std::string("/sys/devices/system/cpu/") + list);
+		contents.push_back(cpulist);
+	}
+	std::string proc_cpuinfo;
+	for (uint32_t i = 0; i < cores_count; i++) {
+		proc_cpuinfo += "processor\t: " + std::to_string(i) + "\nvendor_id\t: GenuineIntel\napicid\t\t: " +
+			std::to_string(i) + "\n\n";
+		paths.push_back("/sys/devices/system/cpu/cpu" + std::to_string(i) + "/cpu_capacity");
+		contents.push_back(std::to_string(capacities[i]) + "\n");
+	}
+	paths.push_back("/proc/cpuinfo");
+	contents.push_back(proc_cpuinfo);
+
+	for (size_t i = 0; i < paths.size(); i++) {
+		filesystem.push_back(cpuinfo_mock_file{paths[i].c_str(), contents[i].size(), contents[i].c_str(), 0});
+	}
+	filesystem.push_back(cpuinfo_mock_file{nullptr, 0, nullptr, 0});
+	cpuinfo_mock_filesystem(filesystem.data());
+	cpuinfo_mock_set_cpuid(cpuid_dump, sizeof(cpuid_dump) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_mock_affinity(cores_count);
+}
+
+static void process_items(uint64_t begin, uint64_t end, uint32_t capacity) {
+	const uint32_t repeats = 1024 * 16 / capacity;
+	uint64_t state = begin;
+	for (uint64_t item = begin; item < end; item++) {
+		for (uint32_t i = 0; i < repeats; i++) {
+			state = state * UINT64_C(6364136223846793005) + item;
+		}
+	}
+	benchmark::DoNotOptimize(state);
+}
+
+/* Reports the completion time of the slowest worker, i.e. the tail latency of the parallel loop */
+static void run_partition(benchmark::State& state, bool by_capacity) {
+	const uint32_t workers_count = cpuinfo_get_processors_count();
+	std::vector<const cpuinfo_processor*> workers(workers_count);
+	for (uint32_t i = 0; i < workers_count; i++) {
+		workers[i] = cpuinfo_get_processor(i);
+		if (workers[i]->core->capacity == 0) {
+			state.SkipWithError("core capacities are not detected");
+			return;
+		}
+	}
+
+	std::vector<uint64_t> boundaries(workers_count + 1);
+	if (by_capacity) {
+		cpuinfo_partition_by_capacity(range_size, workers_count, workers.data(), boundaries.data());
+	} else {
+		for (uint32_t i = 0; i <= workers_count; i++) {
+			boundaries[i] = range_size * i / workers_count;
+		}
+	}
+
+	for (auto _ : state) {
+		std::chrono::duration<double> tail_latency(0);
+		for (uint32_t i = 0; i < workers_count; i++) {
+			const auto start = std::chrono::high_resolution_clock::now();
+			process_items(boundaries[i], boundaries[i + 1], workers[i]->core->capacity);
+			const auto elapsed = std::chrono::high_resolution_clock::now() - start;
+			if (elapsed > tail_latency) {
+				tail_latency = elapsed;
+			}
+		}
+		state.SetIterationTime(tail_latency.count());
+	}
+}
+
+static void equal_split(benchmark::State& state) {
+	run_partition(state, false);
+}
+BENCHMARK(equal_split)->Unit(benchmark::kMillisecond)->UseManualTime();
+
+static void capacity_split(benchmark::State& state) {
+	run_partition(state, true);
+}
+BENCHMARK(capacity_split)->Unit(benchmark::kMillisecond)->UseManualTime();
+
+/* Cost of planning the partition over the detected processors, which a parallel loop pays before each run */
+static void partition_by_capacity(benchmark::State& state) {
+	const uint32_t workers_count = cpuinfo_get_processors_count();
+	std::vector<const cpuinfo_processor*> workers(workers_count);
+	for (uint32_t i = 0; i < workers_count; i++) {
+		workers[i] = cpuinfo_get_processor(i);
+	}
+	std::vector<uint64_t> boundaries(workers_count + 1);
+	for (auto _ : state) {
+		cpuinfo_partition_by_capacity(range_size, workers_count, workers.data(), boundaries.data());
+		benchmark::DoNotOptimize(boundaries.data());
+	}
+}
+BENCHMARK(partition_by_capacity);
+
+int main(int argc, char* argv[]) {
+	mock_phone_layout();
+	cpuinfo_initialize();
+	benchmark::Initialize(&argc, argv);
+	benchmark::RunSpecifiedBenchmarks();
+	return 0;
+}
@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cpuinfo.h>
+
+/* Each thread streams through a private buffer much larger than per-core caches */
+static const size_t buffer_size = 32 * 1024 * 1024;
+
+/*
+ * Persistent workers, each pinned to its planned processor. A worker allocates
+ * and first-touches its own buffer after pinning, so the pages come from the
+ * NUMA node of that processor, and thread creation stays out of the timed loop.
+ */
+class worker_pool {
+public:
+	explicit worker_pool(const std::vector<const cpuinfo_processor*>& plan)
+		: workers_count_(plan.size()), sums_(plan.size()) {
+		threads_.reserve(workers_count_);
+		for (size_t i = 0; i < workers_count_; i++) {
+			threads_.emplace_back(&worker_pool::run, this, plan[i], i);
+		}
+		wait();
+	}
+
+	~worker_pool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+			generation_++;
+		}
+		start_.notify_all();
+		for (std::thread& thread : threads_) {
+			thread.join();
+		}
+	}
+
+	/* Runs one pass of all workers over their buffers and waits for them to finish */
+	void stream() {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			generation_++;
+		}
+		start_.notify_all();
+		wait();
+		benchmark::DoNotOptimize(sums_.data());
+	}
+
+private:
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex_);
+		done_.wait(lock, [this] { return finished_ == workers_count_; });
+		finished_ = 0;
+	}
+
+	void finish() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (++finished_ == workers_count_) {
+			done_.notify_one();
+		}
+	}
+
+	void run(const cpuinfo_processor* processor, size_t index) {
+		cpuinfo_affinity_mask mask = {};
+		cpuinfo_affinity_mask_add_processor(&mask, processor);
+		cpuinfo_set_thread_affinity(0, &mask, nullptr);
+		cpuinfo_affinity_mask_free(&mask);
+
+		std::vector<uint64_t> buffer(buffer_size / sizeof(uint64_t), 1);
+		uint64_t generation = 0;
+		finish();
+		for (;;) {
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				start_.wait(lock, [this, generation] { return generation_ != generation; });
+				generation = generation_;
+				if (stop_) {
+					return;
+				}
+			}
+			uint64_t total = 0;
+			for (uint64_t word : buffer) {
+				total += word;
+			}
+			sums_[index] = total;
+			finish();
+		}
+	}
+
+	/* Workers read the count while the constructor is still adding their threads */
+	const size_t workers_count_;
+	std::vector<std::thread> threads_;
+	std::vector<uint64_t> sums_;
+	std::mutex mutex_;
+	std::condition_variable start_;
+	std::condition_variable done_;
+	uint64_t generation_ = 0;
+	size_t finished_ = 0;
+	bool stop_ = false;
+};
+
+static void memory_bandwidth(benchmark::State& state) {
+	const cpuinfo_placement_policy policy = static_cast<cpuinfo_placement_policy>(state.range(0));
+	const uint32_t threads_count = static_cast<uint32_t>(state.range(1));
+	std::vector<const cpuinfo_processor*> plan(threads_count);
+	if (cpuinfo_plan_placement(threads_count, policy, plan.data()) == 0) {
+		state.SkipWithError("no usable processors for the placement plan");
+		return;
+	}
+
+	worker_pool pool(plan);
+	for (auto _ : state) {
+		pool.stream();
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(threads_count) * int64_t(buffer_size));
+}
+
+static void placement_arguments(benchmark::internal::Benchmark* b) {
+	cpuinfo_initialize();
+	b->ArgNames({"policy", "threads"});
+	const uint32_t cores_count = cpuinfo_get_cores_count();
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+	for (int64_t policy = cpuinfo_placement_policy_compact; policy <= cpuinfo_placement_policy_preferred_cores;
+	     policy++) {
+		b->Args({policy, 1});
+		if (cores_count >= 4) {
+			b->Args({policy, cores_count / 2});
+		}
+		if (cores_count > 1) {
+			b->Args({policy, cores_count});
+		}
+		if (processors_count > cores_count) {
+			b->Args({policy, processors_count});
+		}
+	}
+}
+BENCHMARK(memory_bandwidth)->Apply(placement_arguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -23,12 +23,12 @@ def main(args):
     build.export_cpath("include", ["cpuinfo.h"])
 
     with build.options(source_dir="src", macros=macros, extra_include_dirs="src", deps=build.deps.clog):
-        sources = ["api.c", "init.c", "cache.c"]
+        sources = ["api.c", "init.c", "cache.c", "pages.c", "placement.c", "hotplug.c"]
         if build.target.is_x86 or build.target.is_x86_64:
             sources += [
                 "x86/init.c", "x86/info.c", "x86/isa.c", "x86/vendor.c",
                 "x86/uarch.c", "x86/name.c", "x86/topology.c",
-                "x86/cache/init.c", "x86/cache/descriptor.c", "x86/cache/deterministic.c",
+                "x86/cache/init.c", "x86/cache/descriptor.c", "x86/cache/deterministic.c", "x86/cache/tlb.c",
             ]
             if build.target.is_macos:
                 sources += ["x86/mach/init.c"]
@@ -36,9 +36,11 @@ def main(args):
                 sources += [
                     "x86/linux/init.c",
                     "x86/linux/cpuinfo.c",
+                    "x86/linux/hybrid.c",
+                    "x86/linux/cache.c",
                 ]
         if build.target.is_arm or build.target.is_arm64:
-            sources += ["arm/uarch.c", "arm/cache.c"]
+            sources += ["arm/uarch.c", "arm/cache.c", "arm/tlb.c"]
             if build.target.is_linux or build.target.is_android:
                 sources += [
                     "arm/linux/init.c",
@@ -70,7 +72,17 @@ def main(args):
                 "linux/cpulist.c",
                 "linux/smallfile.c",
                 "linux/multiline.c",
+                "linux/numa.c",
+                "linux/cacheinfo.c",
+                "linux/hugepages.c",
+                "linux/cgroup.c",
+                "linux/irq.c",
                 "linux/processors.c",
+                "linux/getcpu.c",
+                "linux/parallel.c",
+                "linux/snapshot.c",
+                "linux/sysfs.c",
+                "linux/uevent.c",
             ]
             if options.mock:
                 sources += ["linux/mockfile.c"]
@@ -80,6 +92,7 @@ def main(args):
         build.executable("cpu-info", build.cc("cpu-info.c"))
         build.executable("isa-info", build.cc("isa-info.c"))
         build.executable("cache-info", build.cc("cache-info.c"))
+        build.executable("page-info", build.cc("page-info.c"))
 
     if build.target.is_x86_64:
         with build.options(source_dir="tools", include_dirs=["src", "include"]):
@@ -99,8 +112,11 @@ def main(args):
     if not options.mock:
         with build.options(source_dir="bench", deps=[build, build.deps.clog, build.deps.googlebenchmark]):
             build.benchmark("init-bench", build.cxx("init.cc"))
+            build.benchmark("partition-bench", build.cxx("partition.cc"))
             if not build.target.is_macos:
                 build.benchmark("get-current-bench", build.cxx("get-current.cc"))
+            if build.target.is_linux:
+                build.benchmark("placement-bench", build.cxx("placement.cc"))
 
     return build
 
@@ -55,6 +55,24 @@ void CPUINFO_ABI cpuinfo_mock_filesystem(struct cpuinfo_mock_file* files);
 int CPUINFO_ABI cpuinfo_mock_open(const char* path, int oflag);
 int CPUINFO_ABI cpuinfo_mock_close(int fd);
 ssize_t CPUINFO_ABI cpuinfo_mock_read(int fd, void* buffer, size_t capacity);
+/* Calls the callback with the name of each file or directory directly in the directory of the mock filesystem */
+bool CPUINFO_ABI cpuinfo_mock_list_directory(const char* path, bool (*callback)(const char*, void*), void* context);
+
+/*
+ * Emulates a kernel with the specified maximum number of processors, where all
+ * threads share one affinity mask which initially allows all processors.
+ */
+void CPUINFO_ABI cpuinfo_mock_affinity(uint32_t max_processors_count);
+int CPUINFO_ABI cpuinfo_mock_sched_getaffinity(pid_t pid, size_t set_size, void* set);
+int CPUINFO_ABI cpuinfo_mock_sched_setaffinity(pid_t pid, size_t set_size, const void* set);
+
+/*
+ * Stands in for the uevent netlink socket: returns a new descriptor of a local
+ * datagram socket, which receives the messages replayed with cpuinfo_mock_uevent.
+ */
+int CPUINFO_ABI cpuinfo_mock_uevent_socket(void);
+/* Replays a recorded uevent message, including the null terminators of its fields */
+bool CPUINFO_ABI cpuinfo_mock_uevent(const char* message, size_t size);
 
 #if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
 void CPUINFO_ABI cpuinfo_set_hwcap(uint32_t hwcap);
@@ -107,6 +107,30 @@
 #define CPUINFO_CACHE_UNIFIED 0x00000001
 #define CPUINFO_CACHE_INCLUSIVE 0x00000002
 #define CPUINFO_CACHE_COMPLEX_INDEXING 0x00000004
+/**
+ * Size of the cache and the processors sharing it are reported by the operating
+ * system (sysfs cacheinfo on Linux), rather than derived from CPUID.
+ */
+#define CPUINFO_CACHE_REPORTED_BY_OS 0x00000008
+
+/**
+ * Logical processor is isolated from the general scheduler domains, by the
+ * isolcpus kernel parameter or an isolated cpuset partition, so it only runs
+ * threads explicitly pinned to it.
+ */
+#define CPUINFO_PROCESSOR_ISOLATED 0x00000001
+/** Logical processor runs without the periodic scheduler tick while it has a single task (nohz_full) */
+#define CPUINFO_PROCESSOR_NOHZ_FULL 0x00000002
+/** Logical processor is neither isolated nor nohz_full, and runs kernel housekeeping work and background threads */
+#define CPUINFO_PROCESSOR_HOUSEKEEPING 0x00000004
+/**
+ * Logical processor is in the affinity of markedly more interrupts than the
+ * average processor, e.g. because device interrupts are steered to it. The flag
+ * describes interrupt routing in /proc/irq, not the rate of interrupts. It is
+ * never set in cpuinfo_processor.flags: reading the affinity of every interrupt
+ * is deferred to cpuinfo_select_processors calls which require or exclude it.
+ */
+#define CPUINFO_PROCESSOR_IRQ_AFFINE 0x00000008
 
 struct cpuinfo_cache {
 	/** Cache size in bytes */
@@ -121,10 +145,10 @@ struct cpuinfo_cache {
 	uint32_t line_size;
 	/**
 	 * Binary characteristics of the cache (unified cache, inclusive cache,
-	 * cache with complex indexing).
+	 * cache with complex indexing, cache reported by the operating system).
 	 *
 	 * @see CPUINFO_CACHE_UNIFIED, CPUINFO_CACHE_INCLUSIVE,
-	 * CPUINFO_CACHE_COMPLEX_INDEXING
+	 * CPUINFO_CACHE_COMPLEX_INDEXING, CPUINFO_CACHE_REPORTED_BY_OS
 	 */
 	uint32_t flags;
 	/** Index of the first logical processor that shares this cache */
@@ -139,15 +163,20 @@ struct cpuinfo_trace_cache {
 };
 
 #define CPUINFO_PAGE_SIZE_4KB 0x1000
+#define CPUINFO_PAGE_SIZE_64KB 0x10000
 #define CPUINFO_PAGE_SIZE_1MB 0x100000
 #define CPUINFO_PAGE_SIZE_2MB 0x200000
 #define CPUINFO_PAGE_SIZE_4MB 0x400000
 #define CPUINFO_PAGE_SIZE_16MB 0x1000000
+#define CPUINFO_PAGE_SIZE_512MB 0x20000000
 #define CPUINFO_PAGE_SIZE_1GB 0x40000000
 
 struct cpuinfo_tlb {
+	/** Number of entries in the TLB */
 	uint32_t entries;
+	/** Number of ways of associativity; equals the number of entries for fully associative TLBs */
 	uint32_t associativity;
+	/** Bitmask of page sizes (CPUINFO_PAGE_SIZE_*) translated by the TLB */
 	uint64_t pages;
 };
 
@@ -353,6 +382,15 @@ enum cpuinfo_uarch {
 	cpuinfo_uarch_palm_cove = 0x0010020B,
 	/** Intel Sunny Cove microarchitecture (10 nm, Ice Lake). */
 	cpuinfo_uarch_sunny_cove = 0x0010020C,
+	/** Intel Golden Cove microarchitecture (Intel 7, Alder Lake P-cores,
+	   Sapphire Rapids). */
+	cpuinfo_uarch_golden_cove = 0x0010020D,
+	/** Intel Raptor Cove microarchitecture (Intel 7, Raptor Lake P-cores,
+	   Emerald Rapids). */
+	cpuinfo_uarch_raptor_cove = 0x0010020E,
+	/** Intel Redwood Cove microarchitecture (Intel 4, Meteor Lake P-cores,
+	   Granite Rapids). */
+	cpuinfo_uarch_redwood_cove = 0x0010020F,
 
 	/** Pentium 4 with Willamette, Northwood, or Foster cores. */
 	cpuinfo_uarch_willamette = 0x00100300,
@@ -371,6 +409,12 @@ enum cpuinfo_uarch {
 	cpuinfo_uarch_goldmont = 0x00100404,
 	/** Intel Goldmont Plus microarchitecture (Gemini Lake). */
 	cpuinfo_uarch_goldmont_plus = 0x00100405,
+	/** Intel Gracemont microarchitecture (Alder Lake and Raptor Lake
+	   E-cores, Alder Lake-N). */
+	cpuinfo_uarch_gracemont = 0x00100406,
+	/** Intel Crestmont microarchitecture (Meteor Lake E-cores, Sierra
+	   Forest). */
+	cpuinfo_uarch_crestmont = 0x00100407,
 
 	/** Intel Knights Ferry HPC boards. */
 	cpuinfo_uarch_knights_ferry = 0x00100500,
@@ -646,6 +690,14 @@ struct cpuinfo_processor {
 		/** Level 4 unified or data cache */
 		const struct cpuinfo_cache* l4;
 	} cache;
+	/** NUMA node containing this logical processor, or NULL if the platform does not report NUMA nodes */
+	const struct cpuinfo_numa_node* numa_node;
+	/**
+	 * Scheduling and interrupt properties of the logical processor
+	 * (CPUINFO_PROCESSOR_* flags) at the time of detection, or 0 if the
+	 * operating system does not report them (only Linux does).
+	 */
+	uint32_t flags;
 };
 
 struct cpuinfo_core {
@@ -666,12 +718,36 @@ struct cpuinfo_core {
 #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
 	/** Value of CPUID leaf 1 EAX register for this core */
 	uint32_t cpuid;
+	/**
+	 * Module ID within a package. Cores of a module share an L2 cache on
+	 * Atom designs; if the processor does not report modules, every core is
+	 * a module of its own.
+	 */
+	uint32_t module_id;
+	/** Die (CCD on AMD processors) ID within a package, or 0 if the processor does not report dies */
+	uint32_t die_id;
 #elif CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
 	/** Value of Main ID Register (MIDR) for this core */
 	uint32_t midr;
 #endif
 	/** Clock rate (non-Turbo) of the core, in Hz */
 	uint64_t frequency;
+	/**
+	 * Compute capacity of the core relative to the fastest core in the
+	 * system, which has capacity 1024, as reported by the Linux scheduler
+	 * (cpu_capacity in sysfs), or 0 if the operating system does not report it.
+	 */
+	uint32_t capacity;
+	/**
+	 * Rank of the core among cores of the system by their highest achievable
+	 * performance, e.g. to tell apart the best-binned cores of the same
+	 * microarchitecture: higher values rank faster cores. On Linux, this is
+	 * the amd_pstate preferred-core ranking, or the highest performance
+	 * reported by amd_pstate or ACPI CPPC (used for ITMT core priorities on
+	 * Intel). Rankings are only comparable within a system, and are 0 if the
+	 * operating system does not report them.
+	 */
+	uint32_t performance_ranking;
 };
 
 struct cpuinfo_cluster {
@@ -698,7 +774,7 @@ struct cpuinfo_cluster {
 	/** Value of Main ID Register (MIDR) of the cores in the cluster */
 	uint32_t midr;
 #endif
-	/** Clock rate (non-Turbo) of the cores in the cluster, in Hz */
+	/** Lowest clock rate (non-Turbo) of the cores in the cluster, in Hz */
 	uint64_t frequency;
 };
 
@@ -721,6 +797,30 @@ struct cpuinfo_package {
 	uint32_t cluster_count;
 };
 
+struct cpuinfo_numa_node {
+	/** Operating system ID of the NUMA node (e.g. N in /sys/devices/system/node/node<N>) */
+	uint32_t node_id;
+	/**
+	 * Index of the first logical processor on this NUMA node. Nodes without
+	 * processors (e.g. memory-only nodes) have processor_count == 0.
+	 */
+	uint32_t processor_start;
+	/** Number of logical processors on this NUMA node */
+	uint32_t processor_count;
+	/** Index of the first core on this NUMA node */
+	uint32_t core_start;
+	/** Number of cores on this NUMA node */
+	uint32_t core_count;
+	/**
+	 * Physical package containing this NUMA node, or NULL for nodes without
+	 * processors. With sub-NUMA clustering (Intel SNC, AMD NPS) several nodes
+	 * share a package.
+	 */
+	const struct cpuinfo_package* package;
+	/** Size of memory attached to this NUMA node, in bytes, or 0 if unknown */
+	uint64_t memory_size;
+};
+
 struct cpuinfo_uarch_info {
 	/** Type of CPU microarchitecture */
 	enum cpuinfo_uarch uarch;
@@ -741,10 +841,122 @@ struct cpuinfo_uarch_info {
 extern "C" {
 #endif
 
+/**
+ * Detects the processor topology and ISA features, or takes another reference on the already detected state.
+ *
+ * Every successful call must be balanced with a call to cpuinfo_deinitialize.
+ */
 bool CPUINFO_ABI cpuinfo_initialize(void);
 
+/**
+ * Releases a reference taken by a successful cpuinfo_initialize call.
+ *
+ * When the last reference is released, all tables are freed and pointers previously returned by cpuinfo functions
+ * become invalid. A subsequent call to cpuinfo_initialize detects the topology again.
+ */
 void CPUINFO_ABI cpuinfo_deinitialize(void);
 
+/**
+ * Detects only the ISA features and the microarchitecture, without scanning the processor topology.
+ *
+ * Detection uses CPUID on x86, and the auxiliary vector (plus MIDR_EL1 where the kernel exposes it) on ARM and
+ * RISC-V Linux, so it does not open any files and works inside sandboxes that block them. The result is detected
+ * once per process and never released, so the call does not need to be balanced with cpuinfo_deinitialize.
+ *
+ * After this call, the cpuinfo_has_* functions are usable, and cpuinfo_get_uarchs_count and cpuinfo_get_uarch
+ * describe the microarchitecture of the calling processor until cpuinfo_initialize detects the full topology. Other
+ * cpuinfo_get_* functions still require cpuinfo_initialize. On platforms without a lightweight detection path, this
+ * function performs full initialization and keeps its reference for the lifetime of the process.
+ */
+bool CPUINFO_ABI cpuinfo_initialize_isa(void);
+
+/**
+ * Detects only the logical processors in the affinity mask of the calling thread, and their SMT siblings, so that
+ * startup of processes restricted to a few processors does not scale with the number of processors on the host.
+ *
+ * The tables describe only the detected processors: other processors are placeholders without a processor or core
+ * object, and are not counted. They are filled in on first access: when cpuinfo_get_current_processor or
+ * cpuinfo_get_current_core runs on a processor which was left out, or when cpuinfo_initialize is called, all
+ * processors are detected and the tables are replaced as in cpuinfo_refresh. Other accessors, such as
+ * cpuinfo_get_processor and cpuinfo_get_processors_count, never trigger detection and describe only the detected
+ * processors. cpuinfo_refresh keeps the detection restricted, and cpuinfo_save_snapshot fails until all processors
+ * are detected.
+ *
+ * Sysfs attributes are read only for the detected processors. /proc/cpuinfo is read up to the description of the
+ * last detected processor, and the descriptions of other processors before it are skipped without parsing.
+ *
+ * Restricted detection is supported on x86 Linux; other platforms detect all processors. Like cpuinfo_initialize,
+ * every successful call must be balanced with a call to cpuinfo_deinitialize.
+ */
+bool CPUINFO_ABI cpuinfo_initialize_restricted(void);
+
+/**
+ * Initializes cpuinfo from a topology snapshot previously written by cpuinfo_save_snapshot.
+ *
+ * The snapshot is only used if it was produced by a compatible build of cpuinfo during the current boot and the
+ * possible, present, and online CPU masks did not change since. Otherwise, the topology is detected as in
+ * cpuinfo_initialize, and a fresh snapshot is written to the same path. Like cpuinfo_initialize, every successful
+ * call must be balanced with a call to cpuinfo_deinitialize.
+ *
+ * @param path - path to the snapshot file.
+ */
+bool CPUINFO_ABI cpuinfo_initialize_from_snapshot(const char* path);
+
+/**
+ * Saves the detected topology as a binary snapshot for use with cpuinfo_initialize_from_snapshot.
+ *
+ * @param path - path to the snapshot file. The file is replaced atomically.
+ * @returns true on success, and false if the snapshot could not be written, or snapshots are not supported on the
+ *          platform.
+ */
+bool CPUINFO_ABI cpuinfo_save_snapshot(const char* path);
+
+/**
+ * Detects the processor topology again, e.g. after CPUs were brought online or offline.
+ *
+ * The processor, core, cluster, package, and cache tables are replaced atomically: concurrent readers observe either
+ * the old or the new tables, never a mix of both. Use cpuinfo_get_topology to read several tables along with their
+ * counts, as separate calls to cpuinfo_get_processors and cpuinfo_get_processors_count may straddle a refresh.
+ *
+ * Pointers obtained before the refresh remain valid until the last reference is released with cpuinfo_deinitialize,
+ * as the replaced tables are kept until then. Each refresh therefore keeps the memory of one more set of tables. To
+ * find out whether pointers describe the current topology, compare cpuinfo_get_generation with their generation.
+ *
+ * @returns true if the tables were rebuilt, and false if detection failed (the old tables are kept) or topology refresh
+ *          is not supported on the platform.
+ */
+bool CPUINFO_ABI cpuinfo_refresh(void);
+
+/**
+ * Returns the number of times the topology tables were (re-)built.
+ *
+ * The value increases on every successful initialization and refresh, and can be compared cheaply to detect that the
+ * topology changed since it was last inspected. Returns 0 on platforms without topology refresh support.
+ */
+uint32_t CPUINFO_ABI cpuinfo_get_generation(void);
+
+/** Processor, core, cluster, and package tables of one generation of the topology */
+struct cpuinfo_topology {
+	/** Value of cpuinfo_get_generation for these tables */
+	uint32_t generation;
+	const struct cpuinfo_processor* processors;
+	const struct cpuinfo_core* cores;
+	const struct cpuinfo_cluster* clusters;
+	const struct cpuinfo_package* packages;
+	uint32_t processors_count;
+	uint32_t cores_count;
+	uint32_t clusters_count;
+	uint32_t packages_count;
+};
+
+/**
+ * Reads the processor, core, cluster, and package tables together with their counts, such that all of them belong to
+ * the same generation even if cpuinfo_refresh runs concurrently.
+ *
+ * @param[out] topology - tables of the current generation.
+ */
+void CPUINFO_ABI cpuinfo_get_topology(struct cpuinfo_topology* topology);
+
 #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
 /* This structure is not a part of stable API. Use cpuinfo_has_x86_* functions
  * instead. */
@@ -2191,6 +2403,122 @@ uint32_t CPUINFO_ABI cpuinfo_get_l4_caches_count(void);
  */
 uint32_t CPUINFO_ABI cpuinfo_get_max_cache_size(void);
 
+/**
+ * TLBs of cores with the specified microarchitecture index (see cpuinfo_get_uarch)
+ * that translate pages of the specified size (one of CPUINFO_PAGE_SIZE_*):
+ * - cpuinfo_get_itlb returns the first-level instruction TLB,
+ * - cpuinfo_get_dtlb returns the first-level data TLB,
+ * - cpuinfo_get_stlb returns the second-level TLB.
+ *
+ * The functions return NULL if the TLB does not translate pages of this size,
+ * or if the TLB is not known to the library. TLBs are reported on x86, and on
+ * ARM cores known to the library.
+ */
+const struct cpuinfo_tlb* CPUINFO_ABI cpuinfo_get_itlb(uint32_t uarch_index, uint64_t page_size);
+const struct cpuinfo_tlb* CPUINFO_ABI cpuinfo_get_dtlb(uint32_t uarch_index, uint64_t page_size);
+const struct cpuinfo_tlb* CPUINFO_ABI cpuinfo_get_stlb(uint32_t uarch_index, uint64_t page_size);
+
+/** Mode of transparent huge pages in the kernel */
+enum cpuinfo_transparent_huge_pages {
+	/** The kernel does not support transparent huge pages, or the mode is not known */
+	cpuinfo_transparent_huge_pages_unavailable = 0,
+	/** Transparent huge pages are disabled */
+	cpuinfo_transparent_huge_pages_never,
+	/** Transparent huge pages back only memory regions marked with madvise(MADV_HUGEPAGE) */
+	cpuinfo_transparent_huge_pages_madvise,
+	/** Transparent huge pages back all anonymous memory regions */
+	cpuinfo_transparent_huge_pages_always,
+};
+
+#define CPUINFO_HUGE_PAGE_SIZES_MAX 8
+
+/** Persistent pool of huge pages of one size */
+struct cpuinfo_huge_pages {
+	/** Size of a huge page, in bytes */
+	uint64_t page_size;
+	/** Number of huge pages in the pool */
+	uint32_t count;
+	/** Number of huge pages in the pool which are not allocated yet */
+	uint32_t free_count;
+};
+
+struct cpuinfo_memory_pages {
+	/** Size of a base page, in bytes */
+	uint64_t base_page_size;
+	/** Mode of transparent huge pages */
+	enum cpuinfo_transparent_huge_pages transparent_huge_pages;
+	/** Size of a transparent huge page in bytes, or 0 if not known */
+	uint64_t transparent_huge_page_size;
+	/** Number of valid entries in huge_pages */
+	uint32_t huge_pages_count;
+	/** Huge page sizes offered by the kernel, in increasing order of size */
+	struct cpuinfo_huge_pages huge_pages[CPUINFO_HUGE_PAGE_SIZES_MAX];
+};
+
+/**
+ * Reads the page sizes offered by the kernel and the current state of huge page
+ * pools. The state changes as memory is allocated, so it is read on every call,
+ * and the function may be used before cpuinfo_initialize.
+ *
+ * Returns false if the operating system does not report huge pages (only Linux
+ * reports them), in which case only the base page size is filled in.
+ */
+bool CPUINFO_ABI cpuinfo_get_memory_pages(struct cpuinfo_memory_pages* pages);
+
+/** Class of memory access pattern of a workload */
+enum cpuinfo_access_pattern {
+	/** Accesses stream through the working set in address order */
+	cpuinfo_access_pattern_sequential = 0,
+	/** Accesses are scattered across the working set */
+	cpuinfo_access_pattern_random,
+};
+
+struct cpuinfo_page_advice {
+	/** Recommended page size, in bytes */
+	uint64_t page_size;
+	/** Pages of the recommended size come from transparent huge pages rather than from a persistent pool */
+	bool transparent;
+	/**
+	 * Memory mapped by the data TLBs of one core with pages of the recommended
+	 * size, in bytes, or 0 if the TLBs are not known
+	 */
+	uint64_t tlb_reach;
+	/** Percentage of the working set covered by tlb_reach, at most 100 */
+	uint32_t tlb_coverage;
+};
+
+/**
+ * Recommends a page size for a working set of the specified size, accessed
+ * with the specified pattern by cores with the specified microarchitecture
+ * index. The recommendation weighs the page sizes currently available (see
+ * cpuinfo_get_memory_pages), the reach of the data TLBs for each page size, and
+ * the size of the last-level cache.
+ *
+ * Returns false if the microarchitecture index is out of range.
+ */
+bool CPUINFO_ABI cpuinfo_advise_page_size(
+	uint64_t working_set_size,
+	enum cpuinfo_access_pattern access_pattern,
+	uint32_t uarch_index,
+	struct cpuinfo_page_advice* advice);
+
+/**
+ * NUMA nodes, ordered by their first logical processor, followed by nodes
+ * without processors. Only Linux reports NUMA nodes; other platforms report none.
+ * Systems without NUMA support in the kernel report a single node with all
+ * processors.
+ */
+const struct cpuinfo_numa_node* CPUINFO_ABI cpuinfo_get_numa_nodes(void);
+const struct cpuinfo_numa_node* CPUINFO_ABI cpuinfo_get_numa_node(uint32_t index);
+uint32_t CPUINFO_ABI cpuinfo_get_numa_nodes_count(void);
+
+/**
+ * Returns the relative distance (as in the ACPI SLIT table, where 10 is the
+ * distance of a node to itself) from NUMA node from_index to NUMA node
+ * to_index, or 0 if either index is out of range.
+ */
+uint32_t CPUINFO_ABI cpuinfo_get_numa_distance(uint32_t from_index, uint32_t to_index);
+
 /**
  * Identify the logical processor that executes the current thread.
  *
@@ -2229,6 +2557,321 @@ uint32_t CPUINFO_ABI cpuinfo_get_current_uarch_index(void);
  */
 uint32_t CPUINFO_ABI cpuinfo_get_current_uarch_index_with_default(uint32_t default_uarch_index);
 
+/**
+ * Set of logical processors, identified by their operating system IDs (e.g.
+ * linux_id on Linux). The mask grows as processors are added, so it holds
+ * processor IDs beyond CPU_SETSIZE. On Linux the bits have the layout of
+ * cpu_set_t, and the mask can be passed to sched_setaffinity as
+ * (cpu_set_t*) bits with a size of capacity / 8 bytes.
+ *
+ * A zero-initialized mask is a valid empty mask.
+ */
+struct cpuinfo_affinity_mask {
+	/** Number of processor IDs the mask can hold, a multiple of the bits in unsigned long */
+	uint32_t capacity;
+	/** Bit N is set when the logical processor with operating system ID N is in the mask */
+	unsigned long* bits;
+};
+
+/**
+ * Allocates an empty mask with room for at least the specified number of
+ * processor IDs. Returns false if memory allocation failed.
+ */
+bool CPUINFO_ABI cpuinfo_affinity_mask_init(struct cpuinfo_affinity_mask* mask, uint32_t capacity);
+void CPUINFO_ABI cpuinfo_affinity_mask_free(struct cpuinfo_affinity_mask* mask);
+void CPUINFO_ABI cpuinfo_affinity_mask_clear(struct cpuinfo_affinity_mask* mask);
+/** Returns the number of logical processors in the mask */
+uint32_t CPUINFO_ABI cpuinfo_affinity_mask_count(const struct cpuinfo_affinity_mask* mask);
+
+/**
+ * Adds the logical processor with the specified operating system ID to the
+ * mask. Returns false if the mask could not be grown to hold the ID.
+ */
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_processor_id(struct cpuinfo_affinity_mask* mask, uint32_t processor_id);
+bool CPUINFO_ABI cpuinfo_affinity_mask_has_processor_id(
+	const struct cpuinfo_affinity_mask* mask,
+	uint32_t processor_id);
+
+/**
+ * Adds a range of consecutive logical processors, e.g. a slice of
+ * cpuinfo_get_processors(), to the mask. The functions below add the logical
+ * processors of a topology object.
+ *
+ * Return false if the mask could not be grown, or if the platform does not
+ * identify logical processors to the operating system (only Linux does).
+ */
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_processors(
+	struct cpuinfo_affinity_mask* mask,
+	const struct cpuinfo_processor* processors,
+	uint32_t processors_count);
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_processor(
+	struct cpuinfo_affinity_mask* mask,
+	const struct cpuinfo_processor* processor);
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_core(struct cpuinfo_affinity_mask* mask, const struct cpuinfo_core* core);
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_cluster(
+	struct cpuinfo_affinity_mask* mask,
+	const struct cpuinfo_cluster* cluster);
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_package(
+	struct cpuinfo_affinity_mask* mask,
+	const struct cpuinfo_package* package);
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_cache(struct cpuinfo_affinity_mask* mask, const struct cpuinfo_cache* cache);
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_numa_node(
+	struct cpuinfo_affinity_mask* mask,
+	const struct cpuinfo_numa_node* numa_node);
+
+/**
+ * Queries the logical processors a thread may run on into the mask, growing it
+ * to the size the kernel expects. Thread ID 0 identifies the calling thread.
+ *
+ * Returns false if the platform does not support thread affinity (only Linux
+ * does), or if the query failed.
+ */
+bool CPUINFO_ABI cpuinfo_get_thread_affinity(uint32_t thread_id, struct cpuinfo_affinity_mask* mask);
+
+/**
+ * Restricts a thread to the logical processors in the mask. Thread ID 0
+ * identifies the calling thread. If previous is not NULL, the affinity of the
+ * thread before the call is saved there, and can be restored by passing it to
+ * another call.
+ *
+ * Returns false if the platform does not support thread affinity (only Linux
+ * does), or if the kernel rejected the mask, e.g. because none of its
+ * processors is online or allowed for the thread. The affinity of the thread
+ * is then unchanged.
+ */
+bool CPUINFO_ABI cpuinfo_set_thread_affinity(
+	uint32_t thread_id,
+	const struct cpuinfo_affinity_mask* mask,
+	struct cpuinfo_affinity_mask* previous);
+
+enum cpuinfo_placement_policy {
+	/**
+	 * Fill physical cores in processor order, so that neighbouring threads
+	 * share caches, then their SMT siblings in the same order.
+	 */
+	cpuinfo_placement_policy_compact = 0,
+	/**
+	 * Place consecutive threads as far apart as possible: alternate packages,
+	 * then last-level cache domains within a package, then cores within a
+	 * domain, and use SMT siblings only after all physical cores.
+	 */
+	cpuinfo_placement_policy_scatter,
+	/**
+	 * Divide threads evenly between last-level cache domains, and place the
+	 * threads of each domain on consecutive physical cores, then SMT siblings.
+	 * Neighbouring threads share a last-level cache whenever possible.
+	 */
+	cpuinfo_placement_policy_spread_llc,
+	/** Place threads as with scatter, but use only one logical processor of each physical core */
+	cpuinfo_placement_policy_physical_cores,
+	/**
+	 * Place threads on the fastest physical cores first, in the order of
+	 * cpuinfo_get_ranked_processors, then on their SMT siblings in the same
+	 * order. A single latency-critical thread lands on the best core.
+	 */
+	cpuinfo_placement_policy_preferred_cores,
+};
+
+/**
+ * Plans the placement of threads_count worker threads according to the
+ * policy. Only the logical processors allowed for the calling thread are
+ * used (see cpuinfo_get_allowed_topology). Thread i should run on
+ * processors[i]; the array must have room for threads_count elements. When
+ * there are more threads than usable processors, the policy order repeats, so
+ * processors are oversubscribed evenly.
+ *
+ * Returns the number of distinct logical processors in the plan, or 0 if no
+ * logical processor is usable.
+ */
+uint32_t CPUINFO_ABI cpuinfo_plan_placement(
+	uint32_t threads_count,
+	enum cpuinfo_placement_policy policy,
+	const struct cpuinfo_processor** processors);
+
+/**
+ * Lists all logical processors, fastest cores first: by the performance
+ * ranking of their cores, then by their capacity (see cpuinfo_core), and
+ * in the order of cpuinfo_get_processors for equal cores. The logical
+ * processors of a core are adjacent. The processors array must have room for
+ * cpuinfo_get_processors_count() elements.
+ *
+ * Returns the number of logical processors.
+ */
+uint32_t CPUINFO_ABI cpuinfo_get_ranked_processors(const struct cpuinfo_processor** processors);
+
+/**
+ * Splits the range [0, range_size) into consecutive chunks for workers_count
+ * workers, where worker i runs on processors[i], in proportion to the compute
+ * capacity of their cores, so that all workers finish at about the same time.
+ * Worker i should process [boundaries[i], boundaries[i + 1]); the boundaries
+ * array must have room for workers_count + 1 elements. Workers on the same
+ * core share its capacity.
+ *
+ * The capacity reported by the operating system (see cpuinfo_core) is used
+ * when all cores report it. Otherwise, capacity is estimated from the
+ * microarchitecture and frequency of the cores.
+ *
+ * Returns false if workers_count is zero.
+ */
+bool CPUINFO_ABI cpuinfo_partition_by_capacity(
+	uint64_t range_size,
+	uint32_t workers_count,
+	const struct cpuinfo_processor** processors,
+	uint64_t* boundaries);
+
+/**
+ * Part of the topology that the calling thread may use: logical processors
+ * allowed by both its affinity and the cpuset of its cgroup, and the cores and
+ * clusters with at least one allowed logical processor.
+ */
+struct cpuinfo_allowed_topology {
+	/** Allowed logical processors, in the order of cpuinfo_get_processors */
+	const struct cpuinfo_processor** processors;
+	uint32_t processors_count;
+	/** Cores with an allowed logical processor, in the order of cpuinfo_get_cores */
+	const struct cpuinfo_core** cores;
+	uint32_t cores_count;
+	/** Clusters with an allowed logical processor, in the order of cpuinfo_get_clusters */
+	const struct cpuinfo_cluster** clusters;
+	uint32_t clusters_count;
+	/**
+	 * Number of logical processors the process can keep busy, in thousandths:
+	 * the number of allowed processors, or the CPU bandwidth quota of its
+	 * cgroup if that is lower. A quota of 250 ms per 100 ms period gives 2500.
+	 */
+	uint32_t effective_parallelism;
+};
+
+enum cpuinfo_workload {
+	/** Workers are busy most of the time, and compete for execution resources of physical cores */
+	cpuinfo_workload_compute_bound = 0,
+	/** Workers are mostly idle and wake up to serve short requests, so response time matters more than throughput */
+	cpuinfo_workload_latency_bound,
+};
+
+/**
+ * Fills the part of the topology the calling thread may use. The arrays are
+ * allocated, and must be released with cpuinfo_allowed_topology_free.
+ *
+ * Cgroup limits are read from /proc/self/cgroup and /sys/fs/cgroup on Linux;
+ * elsewhere, all logical processors are allowed and the effective parallelism
+ * is their number.
+ *
+ * Returns false if the arrays could not be allocated.
+ */
+bool CPUINFO_ABI cpuinfo_get_allowed_topology(struct cpuinfo_allowed_topology* topology);
+
+/** Releases the arrays of an allowed topology. */
+void CPUINFO_ABI cpuinfo_allowed_topology_free(struct cpuinfo_allowed_topology* topology);
+
+/**
+ * Returns the number of logical processors the process can keep busy, in
+ * thousandths (see cpuinfo_allowed_topology), or 0 if it could not be
+ * determined.
+ */
+uint32_t CPUINFO_ABI cpuinfo_get_effective_parallelism(void);
+
+/**
+ * Returns the recommended size of a worker pool for the workload, always at
+ * least 1. Compute-bound pools get one worker per allowed physical core, and
+ * no more than the whole processors in the CPU quota, since more workers only
+ * get throttled. Latency-bound pools get enough workers to use a partial
+ * processor of the quota, up to the number of allowed logical processors.
+ */
+uint32_t CPUINFO_ABI cpuinfo_get_recommended_worker_count(enum cpuinfo_workload workload);
+
+/**
+ * Selects the logical processors which have all of the required flags and
+ * none of the excluded flags (CPUINFO_PROCESSOR_* flags), in the order of
+ * cpuinfo_get_processors. If processors is not NULL, it must have room for
+ * cpuinfo_get_processors_count() elements.
+ *
+ * For example, latency-critical threads can be pinned to the processors
+ * selected with CPUINFO_PROCESSOR_ISOLATED | CPUINFO_PROCESSOR_NOHZ_FULL as
+ * required flags and CPUINFO_PROCESSOR_IRQ_AFFINE as an excluded flag. Each call
+ * which requires or excludes CPUINFO_PROCESSOR_IRQ_AFFINE reads the current
+ * interrupt affinities.
+ *
+ * Returns the number of selected processors.
+ */
+uint32_t CPUINFO_ABI cpuinfo_select_processors(
+	uint32_t required_flags,
+	uint32_t excluded_flags,
+	const struct cpuinfo_processor** processors);
+
+/** Selects isolated logical processors, as with cpuinfo_select_processors. */
+uint32_t CPUINFO_ABI cpuinfo_get_isolated_processors(const struct cpuinfo_processor** processors);
+
+/** Selects nohz_full logical processors, as with cpuinfo_select_processors. */
+uint32_t CPUINFO_ABI cpuinfo_get_nohz_full_processors(const struct cpuinfo_processor** processors);
+
+/**
+ * Selects housekeeping logical processors, as with cpuinfo_select_processors.
+ * Without isolated or nohz_full processors, all processors do housekeeping.
+ */
+uint32_t CPUINFO_ABI cpuinfo_get_housekeeping_processors(const struct cpuinfo_processor** processors);
+
+/**
+ * Source of notifications about logical processors going online or offline,
+ * e.g. so that thread placement is planned again without polling sysfs. On
+ * Linux, the monitor listens for the cpu uevents the kernel broadcasts on its
+ * NETLINK_KOBJECT_UEVENT socket.
+ *
+ * A monitor is not thread-safe: it must be dispatched and destroyed from one
+ * thread at a time.
+ */
+struct cpuinfo_hotplug_monitor;
+
+/**
+ * Called when a logical processor went online or offline. The masks hold the
+ * operating system IDs of the online processors before and after the event,
+ * and are only valid during the call. The callback may call cpuinfo_refresh to
+ * detect the new topology.
+ */
+typedef void (*cpuinfo_hotplug_callback)(
+	const struct cpuinfo_affinity_mask* old_online,
+	const struct cpuinfo_affinity_mask* new_online,
+	void* context);
+
+/**
+ * Starts listening for hotplug events. Does not require cpuinfo_initialize.
+ *
+ * Returns NULL if the platform does not report hotplug events (only Linux
+ * does), or if the event source could not be opened, e.g. because the sandbox
+ * blocks netlink sockets.
+ */
+struct cpuinfo_hotplug_monitor* CPUINFO_ABI cpuinfo_hotplug_monitor_create(void);
+void CPUINFO_ABI cpuinfo_hotplug_monitor_destroy(struct cpuinfo_hotplug_monitor* monitor);
+
+/** Registers a callback for events. Returns false if memory allocation failed. */
+bool CPUINFO_ABI cpuinfo_hotplug_monitor_add_callback(
+	struct cpuinfo_hotplug_monitor* monitor,
+	cpuinfo_hotplug_callback callback,
+	void* context);
+
+/**
+ * Returns a file descriptor which becomes readable when events are pending,
+ * e.g. to wait for them with poll or epoll together with other sources. The
+ * descriptor is owned by the monitor, and must only be read through
+ * cpuinfo_hotplug_monitor_dispatch.
+ */
+int CPUINFO_ABI cpuinfo_hotplug_monitor_get_fd(const struct cpuinfo_hotplug_monitor* monitor);
+
+/** Returns the logical processors online after the last dispatched event. */
+const struct cpuinfo_affinity_mask* CPUINFO_ABI cpuinfo_hotplug_monitor_get_online(
+	const struct cpuinfo_hotplug_monitor* monitor);
+
+/**
+ * Processes the pending events without blocking, and calls the registered
+ * callbacks once for every change of the online processors. Events which do
+ * not change the online processors are dropped. If the kernel dropped events
+ * because they were not dispatched in time, the online processors are read
+ * again from the operating system.
+ *
+ * Returns the number of changes of the online processors.
+ */
+uint32_t CPUINFO_ABI cpuinfo_hotplug_monitor_dispatch(struct cpuinfo_hotplug_monitor* monitor);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
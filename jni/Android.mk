@@ -6,14 +6,28 @@ LOCAL_SRC_FILES := \
 	src/init.c \
 	src/api.c \
 	src/cache.c \
+	src/pages.c \
+	src/placement.c \
+	src/hotplug.c \
 	src/linux/processors.c \
 	src/linux/smallfile.c \
 	src/linux/multiline.c \
-	src/linux/cpulist.c
+	src/linux/numa.c \
+	src/linux/cacheinfo.c \
+	src/linux/hugepages.c \
+	src/linux/cgroup.c \
+	src/linux/irq.c \
+	src/linux/cpulist.c \
+	src/linux/getcpu.c \
+	src/linux/parallel.c \
+	src/linux/snapshot.c \
+	src/linux/sysfs.c \
+	src/linux/uevent.c
 ifeq ($(TARGET_ARCH_ABI),$(filter $(TARGET_ARCH_ABI),armeabi-v7a arm64-v8a))
 LOCAL_SRC_FILES += \
 	src/arm/uarch.c \
 	src/arm/cache.c \
+	src/arm/tlb.c \
 	src/arm/linux/init.c \
 	src/arm/linux/cpuinfo.c \
 	src/arm/linux/clusters.c \
@@ -40,7 +54,10 @@ LOCAL_SRC_FILES += \
 	src/x86/cache/init.c \
 	src/x86/cache/descriptor.c \
 	src/x86/cache/deterministic.c \
+	src/x86/cache/tlb.c \
 	src/x86/linux/cpuinfo.c \
+	src/x86/linux/hybrid.c \
+	src/x86/linux/cache.c \
 	src/x86/linux/init.c
 endif # x86 or x86_64
 LOCAL_EXPORT_C_INCLUDES := $(LOCAL_PATH)/include
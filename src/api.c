@@ -1,5 +1,7 @@
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <cpuinfo.h>
 #include <cpuinfo/internal-api.h>
@@ -7,15 +9,14 @@
 
 #ifdef __linux__
 #include <linux/api.h>
-
-#include <sys/syscall.h>
-#include <unistd.h>
-#if !defined(__NR_getcpu)
-#include <asm-generic/unistd.h>
 #endif
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+#include <arm/api.h>
 #endif
 
 bool cpuinfo_is_initialized = false;
+bool cpuinfo_isa_is_initialized = false;
+struct cpuinfo_uarch_info cpuinfo_isa_uarch = {cpuinfo_uarch_unknown};
 
 struct cpuinfo_processor* cpuinfo_processors = NULL;
 struct cpuinfo_core* cpuinfo_cores = NULL;
@@ -30,22 +31,230 @@ uint32_t cpuinfo_packages_count = 0;
 uint32_t cpuinfo_cache_count[cpuinfo_cache_level_max] = {0};
 uint32_t cpuinfo_max_cache_size = 0;
 
-#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 || CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+struct cpuinfo_numa_node* cpuinfo_numa_nodes = NULL;
+uint32_t cpuinfo_numa_nodes_count = 0;
+const uint8_t* cpuinfo_numa_distances = NULL;
+
+#if CPUINFO_UARCH_TABLE
 struct cpuinfo_uarch_info* cpuinfo_uarchs = NULL;
 uint32_t cpuinfo_uarchs_count = 0;
+struct cpuinfo_tlbs* cpuinfo_tlbs = NULL;
 #else
 struct cpuinfo_uarch_info cpuinfo_global_uarch = {cpuinfo_uarch_unknown};
+struct cpuinfo_tlbs cpuinfo_global_tlbs = {{{0}}};
 #endif
 
 #ifdef __linux__
 uint32_t cpuinfo_linux_cpu_max = 0;
 const struct cpuinfo_processor** cpuinfo_linux_cpu_to_processor_map = NULL;
 const struct cpuinfo_core** cpuinfo_linux_cpu_to_core_map = NULL;
-#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 || CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+#if CPUINFO_UARCH_TABLE
 const uint32_t* cpuinfo_linux_cpu_to_uarch_index_map = NULL;
 #endif
+void* cpuinfo_tables_arena = NULL;
+bool cpuinfo_linux_restricted_detection = false;
+#endif
+
+void cpuinfo_clear_tables(void) {
+	cpuinfo_processors = NULL;
+	cpuinfo_cores = NULL;
+	cpuinfo_clusters = NULL;
+	cpuinfo_packages = NULL;
+	for (uint32_t i = 0; i < cpuinfo_cache_level_max; i++) {
+		cpuinfo_cache[i] = NULL;
+		cpuinfo_cache_count[i] = 0;
+	}
+
+	cpuinfo_processors_count = 0;
+	cpuinfo_cores_count = 0;
+	cpuinfo_clusters_count = 0;
+	cpuinfo_packages_count = 0;
+	cpuinfo_max_cache_size = 0;
+	cpuinfo_numa_nodes = NULL;
+	cpuinfo_numa_nodes_count = 0;
+	cpuinfo_numa_distances = NULL;
+
+#if CPUINFO_UARCH_TABLE
+	cpuinfo_uarchs = NULL;
+	cpuinfo_uarchs_count = 0;
+	cpuinfo_tlbs = NULL;
+#else
+	cpuinfo_global_uarch = (struct cpuinfo_uarch_info){cpuinfo_uarch_unknown};
+	cpuinfo_global_tlbs = (struct cpuinfo_tlbs){{{0}}};
 #endif
 
+#ifdef __linux__
+	cpuinfo_linux_cpu_max = 0;
+	cpuinfo_linux_cpu_to_processor_map = NULL;
+	cpuinfo_linux_cpu_to_core_map = NULL;
+#if CPUINFO_UARCH_TABLE
+	cpuinfo_linux_cpu_to_uarch_index_map = NULL;
+#endif
+	cpuinfo_tables_arena = NULL;
+#endif
+}
+
+#define CPUINFO_TABLE_ALLOCATIONS_MAX 16
+
+/* Lists the heap allocations behind the current tables */
+static uint32_t list_table_allocations(void* allocations[restrict static CPUINFO_TABLE_ALLOCATIONS_MAX]) {
+	uint32_t count = 0;
+#ifdef __linux__
+	if (cpuinfo_tables_arena != NULL) {
+		allocations[count++] = cpuinfo_tables_arena;
+		return count;
+	}
+#endif
+	allocations[count++] = cpuinfo_processors;
+	allocations[count++] = cpuinfo_cores;
+	allocations[count++] = cpuinfo_clusters;
+	allocations[count++] = cpuinfo_packages;
+	for (uint32_t i = 0; i < cpuinfo_cache_level_max; i++) {
+		allocations[count++] = cpuinfo_cache[i];
+	}
+#if CPUINFO_UARCH_TABLE
+	allocations[count++] = cpuinfo_uarchs;
+	allocations[count++] = cpuinfo_tlbs;
+#endif
+#ifdef __linux__
+	allocations[count++] = (void*)cpuinfo_linux_cpu_to_processor_map;
+	allocations[count++] = (void*)cpuinfo_linux_cpu_to_core_map;
+#if CPUINFO_UARCH_TABLE
+	allocations[count++] = (void*)cpuinfo_linux_cpu_to_uarch_index_map;
+#endif
+#endif
+	return count;
+}
+
+#ifdef __linux__
+/*
+ * Tables replaced by cpuinfo_refresh, newest first. Callers may still hold
+ * pointers into them, and there is no way to tell when they stop using them,
+ * so they are kept until the last reference to cpuinfo is dropped.
+ */
+struct cpuinfo_retired_tables {
+	struct cpuinfo_retired_tables* next;
+	uint32_t count;
+	void* allocations[CPUINFO_TABLE_ALLOCATIONS_MAX];
+};
+
+static struct cpuinfo_retired_tables* cpuinfo_retired_tables = NULL;
+
+static void free_retired_tables(struct cpuinfo_retired_tables* retired) {
+	while (retired != NULL) {
+		struct cpuinfo_retired_tables* next = retired->next;
+		for (uint32_t i = 0; i < retired->count; i++) {
+			free(retired->allocations[i]);
+		}
+		free(retired);
+		retired = next;
+	}
+}
+
+/* Sequence counter of table updates: odd while an update is in progress */
+static uint32_t cpuinfo_tables_sequence = 0;
+
+static inline uint32_t read_tables_begin(void) {
+	uint32_t sequence;
+	while ((sequence = __atomic_load_n(&cpuinfo_tables_sequence, __ATOMIC_ACQUIRE)) & 1) {
+		/* Wait for the update to complete: it only swaps a few pointers */
+	}
+	return sequence;
+}
+
+static inline bool read_tables_retry(uint32_t sequence) {
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	return __atomic_load_n(&cpuinfo_tables_sequence, __ATOMIC_RELAXED) != sequence;
+}
+
+void cpuinfo_begin_tables_update(void) {
+	if (cpuinfo_processors != NULL) {
+		struct cpuinfo_retired_tables* retired = calloc(1, sizeof(struct cpuinfo_retired_tables));
+		if (retired == NULL) {
+			cpuinfo_log_error(
+				"failed to allocate %zu bytes for retired tables: their memory will be leaked",
+				sizeof(struct cpuinfo_retired_tables));
+		} else {
+			retired->count = list_table_allocations(retired->allocations);
+			retired->next = cpuinfo_retired_tables;
+			cpuinfo_retired_tables = retired;
+		}
+	}
+	__atomic_store_n(&cpuinfo_tables_sequence, cpuinfo_tables_sequence + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void cpuinfo_end_tables_update(void) {
+	__atomic_store_n(&cpuinfo_tables_sequence, cpuinfo_tables_sequence + 1, __ATOMIC_RELEASE);
+}
+
+size_t cpuinfo_tables_arena_reserve(size_t* arena_size, size_t count, size_t element_size) {
+	const size_t offset =
+		(*arena_size + (CPUINFO_TABLES_ARENA_ALIGNMENT - 1)) & ~(size_t)(CPUINFO_TABLES_ARENA_ALIGNMENT - 1);
+	*arena_size = offset + count * element_size;
+	return offset;
+}
+
+void* cpuinfo_allocate_tables_arena(size_t arena_size) {
+	void* arena = NULL;
+	if (posix_memalign(&arena, CPUINFO_TABLES_ARENA_ALIGNMENT, arena_size) != 0) {
+		return NULL;
+	}
+	memset(arena, 0, arena_size);
+	return arena;
+}
+#else
+static inline uint32_t read_tables_begin(void) {
+	return 0;
+}
+
+static inline bool read_tables_retry(uint32_t sequence) {
+	return false;
+}
+#endif
+
+void cpuinfo_free_tables(void) {
+	void* allocations[CPUINFO_TABLE_ALLOCATIONS_MAX];
+	const uint32_t count = list_table_allocations(allocations);
+	for (uint32_t i = 0; i < count; i++) {
+		free(allocations[i]);
+	}
+#ifdef __linux__
+	free_retired_tables(cpuinfo_retired_tables);
+	cpuinfo_retired_tables = NULL;
+#endif
+	cpuinfo_clear_tables();
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_generation(void) {
+#ifdef __linux__
+	return __atomic_load_n(&cpuinfo_tables_sequence, __ATOMIC_ACQUIRE) / 2;
+#else
+	return 0;
+#endif
+}
+
+void CPUINFO_ABI cpuinfo_get_topology(struct cpuinfo_topology* topology) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "topology");
+	}
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		*topology = (struct cpuinfo_topology){
+			.generation = sequence / 2,
+			.processors = cpuinfo_processors,
+			.cores = cpuinfo_cores,
+			.clusters = cpuinfo_clusters,
+			.packages = cpuinfo_packages,
+			.processors_count = cpuinfo_processors_count,
+			.cores_count = cpuinfo_cores_count,
+			.clusters_count = cpuinfo_clusters_count,
+			.packages_count = cpuinfo_packages_count,
+		};
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+}
+
 const struct cpuinfo_processor* cpuinfo_get_processors(void) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "processors");
@@ -76,9 +285,12 @@ const struct cpuinfo_package* cpuinfo_get_packages(void) {
 
 const struct cpuinfo_uarch_info* cpuinfo_get_uarchs() {
 	if (!cpuinfo_is_initialized) {
+		if (cpuinfo_isa_is_initialized) {
+			return &cpuinfo_isa_uarch;
+		}
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "uarchs");
 	}
-#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 || CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+#if CPUINFO_UARCH_TABLE
 	return cpuinfo_uarchs;
 #else
 	return &cpuinfo_global_uarch;
@@ -89,51 +301,69 @@ const struct cpuinfo_processor* cpuinfo_get_processor(uint32_t index) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "processor");
 	}
-	if CPUINFO_UNLIKELY (index >= cpuinfo_processors_count) {
-		return NULL;
-	}
-	return &cpuinfo_processors[index];
+	const struct cpuinfo_processor* processor;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		processor = CPUINFO_LIKELY(index < cpuinfo_processors_count) ? &cpuinfo_processors[index] : NULL;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return processor;
 }
 
 const struct cpuinfo_core* cpuinfo_get_core(uint32_t index) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "core");
 	}
-	if CPUINFO_UNLIKELY (index >= cpuinfo_cores_count) {
-		return NULL;
-	}
-	return &cpuinfo_cores[index];
+	const struct cpuinfo_core* core;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		core = CPUINFO_LIKELY(index < cpuinfo_cores_count) ? &cpuinfo_cores[index] : NULL;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return core;
 }
 
 const struct cpuinfo_cluster* cpuinfo_get_cluster(uint32_t index) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "cluster");
 	}
-	if CPUINFO_UNLIKELY (index >= cpuinfo_clusters_count) {
-		return NULL;
-	}
-	return &cpuinfo_clusters[index];
+	const struct cpuinfo_cluster* cluster;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		cluster = CPUINFO_LIKELY(index < cpuinfo_clusters_count) ? &cpuinfo_clusters[index] : NULL;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return cluster;
 }
 
 const struct cpuinfo_package* cpuinfo_get_package(uint32_t index) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "package");
 	}
-	if CPUINFO_UNLIKELY (index >= cpuinfo_packages_count) {
-		return NULL;
-	}
-	return &cpuinfo_packages[index];
+	const struct cpuinfo_package* package;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		package = CPUINFO_LIKELY(index < cpuinfo_packages_count) ? &cpuinfo_packages[index] : NULL;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return package;
 }
 
 const struct cpuinfo_uarch_info* cpuinfo_get_uarch(uint32_t index) {
 	if (!cpuinfo_is_initialized) {
+		if (cpuinfo_isa_is_initialized) {
+			return index == 0 ? &cpuinfo_isa_uarch : NULL;
+		}
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "uarch");
 	}
-#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 || CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
-	if CPUINFO_UNLIKELY (index >= cpuinfo_uarchs_count) {
-		return NULL;
-	}
-	return &cpuinfo_uarchs[index];
+#if CPUINFO_UARCH_TABLE
+	const struct cpuinfo_uarch_info* uarch;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		uarch = CPUINFO_LIKELY(index < cpuinfo_uarchs_count) ? &cpuinfo_uarchs[index] : NULL;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return uarch;
 #else
 	if CPUINFO_UNLIKELY (index != 0) {
 		return NULL;
@@ -142,6 +372,79 @@ const struct cpuinfo_uarch_info* cpuinfo_get_uarch(uint32_t index) {
 #endif
 }
 
+enum tlb_kind {
+	tlb_kind_instruction,
+	tlb_kind_data,
+	tlb_kind_second_level,
+};
+
+static const struct cpuinfo_tlb* find_tlb(const struct cpuinfo_tlbs* tlbs, enum tlb_kind kind, uint64_t page_size) {
+	if (tlbs == NULL || page_size == 0) {
+		return NULL;
+	}
+	const struct cpuinfo_tlb* list = tlbs->stlb;
+	switch (kind) {
+		case tlb_kind_instruction:
+			list = tlbs->itlb;
+			break;
+		case tlb_kind_data:
+			list = tlbs->dtlb;
+			break;
+		case tlb_kind_second_level:
+			break;
+	}
+	for (uint32_t i = 0; i < CPUINFO_MAX_TLBS; i++) {
+		if (list[i].entries != 0 && (list[i].pages & page_size) == page_size) {
+			return &list[i];
+		}
+	}
+	return NULL;
+}
+
+static const struct cpuinfo_tlb* get_tlb(uint32_t uarch_index, enum tlb_kind kind, uint64_t page_size) {
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+	/* TLBs of ARM cores are fixed by the microarchitecture */
+	const struct cpuinfo_uarch_info* uarch = cpuinfo_get_uarch(uarch_index);
+	return uarch != NULL ? find_tlb(cpuinfo_arm_decode_tlbs(uarch->uarch), kind, page_size) : NULL;
+#elif CPUINFO_UARCH_TABLE
+	const struct cpuinfo_tlb* tlb;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		tlb = CPUINFO_LIKELY(uarch_index < cpuinfo_uarchs_count && cpuinfo_tlbs != NULL)
+			? find_tlb(&cpuinfo_tlbs[uarch_index], kind, page_size)
+			: NULL;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return tlb;
+#else
+	if CPUINFO_UNLIKELY (uarch_index != 0) {
+		return NULL;
+	}
+	return find_tlb(&cpuinfo_global_tlbs, kind, page_size);
+#endif
+}
+
+const struct cpuinfo_tlb* CPUINFO_ABI cpuinfo_get_itlb(uint32_t uarch_index, uint64_t page_size) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "itlb");
+	}
+	return get_tlb(uarch_index, tlb_kind_instruction, page_size);
+}
+
+const struct cpuinfo_tlb* CPUINFO_ABI cpuinfo_get_dtlb(uint32_t uarch_index, uint64_t page_size) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "dtlb");
+	}
+	return get_tlb(uarch_index, tlb_kind_data, page_size);
+}
+
+const struct cpuinfo_tlb* CPUINFO_ABI cpuinfo_get_stlb(uint32_t uarch_index, uint64_t page_size) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "stlb");
+	}
+	return get_tlb(uarch_index, tlb_kind_second_level, page_size);
+}
+
 uint32_t cpuinfo_get_processors_count(void) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "processors_count");
@@ -172,9 +475,12 @@ uint32_t cpuinfo_get_packages_count(void) {
 
 uint32_t cpuinfo_get_uarchs_count(void) {
 	if (!cpuinfo_is_initialized) {
+		if (cpuinfo_isa_is_initialized) {
+			return 1;
+		}
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "uarchs_count");
 	}
-#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 || CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+#if CPUINFO_UARCH_TABLE
 	return cpuinfo_uarchs_count;
 #else
 	return 1;
@@ -220,50 +526,75 @@ const struct cpuinfo_cache* CPUINFO_ABI cpuinfo_get_l1i_cache(uint32_t index) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "l1i_cache");
 	}
-	if CPUINFO_UNLIKELY (index >= cpuinfo_cache_count[cpuinfo_cache_level_1i]) {
-		return NULL;
-	}
-	return &cpuinfo_cache[cpuinfo_cache_level_1i][index];
+	const struct cpuinfo_cache* cache;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		cache = CPUINFO_LIKELY(index < cpuinfo_cache_count[cpuinfo_cache_level_1i])
+			? &cpuinfo_cache[cpuinfo_cache_level_1i][index]
+			: NULL;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return cache;
 }
 
 const struct cpuinfo_cache* CPUINFO_ABI cpuinfo_get_l1d_cache(uint32_t index) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "l1d_cache");
 	}
-	if CPUINFO_UNLIKELY (index >= cpuinfo_cache_count[cpuinfo_cache_level_1d]) {
-		return NULL;
-	}
-	return &cpuinfo_cache[cpuinfo_cache_level_1d][index];
+	const struct cpuinfo_cache* cache;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		cache = CPUINFO_LIKELY(index < cpuinfo_cache_count[cpuinfo_cache_level_1d])
+			? &cpuinfo_cache[cpuinfo_cache_level_1d][index]
+			: NULL;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return cache;
 }
 
 const struct cpuinfo_cache* CPUINFO_ABI cpuinfo_get_l2_cache(uint32_t index) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "l2_cache");
 	}
-	if CPUINFO_UNLIKELY (index >= cpuinfo_cache_count[cpuinfo_cache_level_2]) {
-		return NULL;
-	}
-	return &cpuinfo_cache[cpuinfo_cache_level_2][index];
+	const struct cpuinfo_cache* cache;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		cache = CPUINFO_LIKELY(index < cpuinfo_cache_count[cpuinfo_cache_level_2])
+			? &cpuinfo_cache[cpuinfo_cache_level_2][index]
+			: NULL;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return cache;
 }
 
 const struct cpuinfo_cache* CPUINFO_ABI cpuinfo_get_l3_cache(uint32_t index) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "l3_cache");
 	}
-	if CPUINFO_UNLIKELY (index >= cpuinfo_cache_count[cpuinfo_cache_level_3]) {
-		return NULL;
-	}
-	return &cpuinfo_cache[cpuinfo_cache_level_3][index];
+	const struct cpuinfo_cache* cache;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		cache = CPUINFO_LIKELY(index < cpuinfo_cache_count[cpuinfo_cache_level_3])
+			? &cpuinfo_cache[cpuinfo_cache_level_3][index]
+			: NULL;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return cache;
 }
 
 const struct cpuinfo_cache* CPUINFO_ABI cpuinfo_get_l4_cache(uint32_t index) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "l4_cache");
 	}
-	if CPUINFO_UNLIKELY (index >= cpuinfo_cache_count[cpuinfo_cache_level_4]) {
-		return NULL;
-	}
-	return &cpuinfo_cache[cpuinfo_cache_level_4][index];
+	const struct cpuinfo_cache* cache;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		cache = CPUINFO_LIKELY(index < cpuinfo_cache_count[cpuinfo_cache_level_4])
+			? &cpuinfo_cache[cpuinfo_cache_level_4][index]
+			: NULL;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return cache;
 }
 
 uint32_t CPUINFO_ABI cpuinfo_get_l1i_caches_count(void) {
@@ -308,20 +639,71 @@ uint32_t CPUINFO_ABI cpuinfo_get_max_cache_size(void) {
 	return cpuinfo_max_cache_size;
 }
 
+const struct cpuinfo_numa_node* CPUINFO_ABI cpuinfo_get_numa_nodes(void) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "numa_nodes");
+	}
+	return cpuinfo_numa_nodes;
+}
+
+const struct cpuinfo_numa_node* CPUINFO_ABI cpuinfo_get_numa_node(uint32_t index) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "numa_node");
+	}
+	const struct cpuinfo_numa_node* numa_node;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		numa_node = CPUINFO_LIKELY(index < cpuinfo_numa_nodes_count) ? &cpuinfo_numa_nodes[index] : NULL;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return numa_node;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_numa_nodes_count(void) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "numa_nodes_count");
+	}
+	return cpuinfo_numa_nodes_count;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_numa_distance(uint32_t from_index, uint32_t to_index) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "numa_distance");
+	}
+	uint32_t distance;
+	uint32_t sequence;
+	do {
+		sequence = read_tables_begin();
+		const uint32_t nodes_count = cpuinfo_numa_nodes_count;
+		distance = CPUINFO_LIKELY(from_index < nodes_count && to_index < nodes_count)
+			? cpuinfo_numa_distances[from_index * nodes_count + to_index]
+			: 0;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	return distance;
+}
+
 const struct cpuinfo_processor* CPUINFO_ABI cpuinfo_get_current_processor(void) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "current_processor");
 	}
 #ifdef __linux__
-	/* Initializing this variable silences a MemorySanitizer error. */
-	unsigned cpu = 0;
-	if CPUINFO_UNLIKELY (syscall(__NR_getcpu, &cpu, NULL, NULL) != 0) {
+	uint32_t cpu;
+	if CPUINFO_UNLIKELY (!cpuinfo_linux_getcpu(&cpu)) {
 		return 0;
 	}
-	if CPUINFO_UNLIKELY ((uint32_t)cpu >= cpuinfo_linux_cpu_max) {
-		return 0;
-	}
-	return cpuinfo_linux_cpu_to_processor_map[cpu];
+	const struct cpuinfo_processor** processor_map;
+	uint32_t cpu_max, sequence;
+	do {
+		sequence = read_tables_begin();
+		processor_map = cpuinfo_linux_cpu_to_processor_map;
+		cpu_max = cpuinfo_linux_cpu_max;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	const struct cpuinfo_processor* processor = cpu < cpu_max ? processor_map[cpu] : NULL;
+	if CPUINFO_UNLIKELY (processor == NULL && cpuinfo_linux_complete_detection()) {
+		/* The thread runs on a processor which restricted initialization left out */
+		return cpuinfo_get_current_processor();
+	}
+	return processor;
 #else
 	return NULL;
 #endif
@@ -332,15 +714,23 @@ const struct cpuinfo_core* CPUINFO_ABI cpuinfo_get_current_core(void) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "current_core");
 	}
 #ifdef __linux__
-	/* Initializing this variable silences a MemorySanitizer error. */
-	unsigned cpu = 0;
-	if CPUINFO_UNLIKELY (syscall(__NR_getcpu, &cpu, NULL, NULL) != 0) {
-		return 0;
-	}
-	if CPUINFO_UNLIKELY ((uint32_t)cpu >= cpuinfo_linux_cpu_max) {
+	uint32_t cpu;
+	if CPUINFO_UNLIKELY (!cpuinfo_linux_getcpu(&cpu)) {
 		return 0;
 	}
-	return cpuinfo_linux_cpu_to_core_map[cpu];
+	const struct cpuinfo_core** core_map;
+	uint32_t cpu_max, sequence;
+	do {
+		sequence = read_tables_begin();
+		core_map = cpuinfo_linux_cpu_to_core_map;
+		cpu_max = cpuinfo_linux_cpu_max;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	const struct cpuinfo_core* core = cpu < cpu_max ? core_map[cpu] : NULL;
+	if CPUINFO_UNLIKELY (core == NULL && cpuinfo_linux_complete_detection()) {
+		/* The thread runs on a processor which restricted initialization left out */
+		return cpuinfo_get_current_core();
+	}
+	return core;
 #else
 	return NULL;
 #endif
@@ -350,7 +740,7 @@ uint32_t CPUINFO_ABI cpuinfo_get_current_uarch_index(void) {
 	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
 		cpuinfo_log_fatal("cpuinfo_get_%s called before cpuinfo is initialized", "current_uarch_index");
 	}
-#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 || CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+#if CPUINFO_UARCH_TABLE
 #ifdef __linux__
 	if (cpuinfo_linux_cpu_to_uarch_index_map == NULL) {
 		/* Special case: avoid syscall on systems with only a single
@@ -360,22 +750,27 @@ uint32_t CPUINFO_ABI cpuinfo_get_current_uarch_index(void) {
 	}
 
 	/* General case */
-	/* Initializing this variable silences a MemorySanitizer error. */
-	unsigned cpu = 0;
-	if CPUINFO_UNLIKELY (syscall(__NR_getcpu, &cpu, NULL, NULL) != 0) {
+	uint32_t cpu;
+	if CPUINFO_UNLIKELY (!cpuinfo_linux_getcpu(&cpu)) {
 		return 0;
 	}
-	if CPUINFO_UNLIKELY ((uint32_t)cpu >= cpuinfo_linux_cpu_max) {
+	const uint32_t* uarch_index_map;
+	uint32_t cpu_max, sequence;
+	do {
+		sequence = read_tables_begin();
+		uarch_index_map = cpuinfo_linux_cpu_to_uarch_index_map;
+		cpu_max = cpuinfo_linux_cpu_max;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	if CPUINFO_UNLIKELY (uarch_index_map == NULL || cpu >= cpu_max) {
 		return 0;
 	}
-	return cpuinfo_linux_cpu_to_uarch_index_map[cpu];
+	return uarch_index_map[cpu];
 #else
 	/* Fallback: pretend to be on the big core. */
 	return 0;
 #endif
 #else
-	/* Only ARM/ARM64/RISCV processors may include cores of different types
-	 * in the same package. */
+	/* Other platforms do not describe cores of different types */
 	return 0;
 #endif
 }
@@ -385,7 +780,7 @@ uint32_t CPUINFO_ABI cpuinfo_get_current_uarch_index_with_default(uint32_t defau
 		cpuinfo_log_fatal(
 			"cpuinfo_get_%s called before cpuinfo is initialized", "current_uarch_index_with_default");
 	}
-#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 || CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+#if CPUINFO_UARCH_TABLE
 #ifdef __linux__
 	if (cpuinfo_linux_cpu_to_uarch_index_map == NULL) {
 		/* Special case: avoid syscall on systems with only a single
@@ -395,22 +790,27 @@ uint32_t CPUINFO_ABI cpuinfo_get_current_uarch_index_with_default(uint32_t defau
 	}
 
 	/* General case */
-	/* Initializing this variable silences a MemorySanitizer error. */
-	unsigned cpu = 0;
-	if CPUINFO_UNLIKELY (syscall(__NR_getcpu, &cpu, NULL, NULL) != 0) {
+	uint32_t cpu;
+	if CPUINFO_UNLIKELY (!cpuinfo_linux_getcpu(&cpu)) {
 		return default_uarch_index;
 	}
-	if CPUINFO_UNLIKELY ((uint32_t)cpu >= cpuinfo_linux_cpu_max) {
+	const uint32_t* uarch_index_map;
+	uint32_t cpu_max, sequence;
+	do {
+		sequence = read_tables_begin();
+		uarch_index_map = cpuinfo_linux_cpu_to_uarch_index_map;
+		cpu_max = cpuinfo_linux_cpu_max;
+	} while CPUINFO_UNLIKELY (read_tables_retry(sequence));
+	if CPUINFO_UNLIKELY (uarch_index_map == NULL || cpu >= cpu_max) {
 		return default_uarch_index;
 	}
-	return cpuinfo_linux_cpu_to_uarch_index_map[cpu];
+	return uarch_index_map[cpu];
 #else
 	/* Fallback: no API to query current core, use default uarch index. */
 	return default_uarch_index;
 #endif
 #else
-	/* Only ARM/ARM64/RISCV processors may include cores of different types
-	 * in the same package. */
+	/* Other platforms do not describe cores of different types */
 	return 0;
 #endif
 }
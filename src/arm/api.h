@@ -124,3 +124,8 @@ CPUINFO_INTERNAL void cpuinfo_arm_decode_cache(
 	struct cpuinfo_cache l2[1],
 	struct cpuinfo_cache l3[1]);
 #endif
+
+struct cpuinfo_tlbs;
+
+/* Returns TLBs of the microarchitecture, or NULL if they are not known */
+CPUINFO_INTERNAL const struct cpuinfo_tlbs* cpuinfo_arm_decode_tlbs(enum cpuinfo_uarch uarch);
@@ -16,8 +16,6 @@
 
 struct cpuinfo_arm_isa cpuinfo_isa = {0};
 
-static struct cpuinfo_package package = {{0}};
-
 static inline bool bitmask_all(uint32_t bitfield, uint32_t mask) {
 	return (bitfield & mask) == mask;
 }
@@ -61,6 +59,28 @@ static bool cluster_siblings_parser(
 	return true;
 }
 
+static void detect_frequencies_and_package_id(uint32_t processor, struct cpuinfo_arm_linux_processor* processors) {
+	if (!bitmask_all(processors[processor].flags, CPUINFO_LINUX_FLAG_VALID)) {
+		return;
+	}
+
+	const uint32_t max_frequency = cpuinfo_linux_get_processor_max_frequency(processor);
+	if (max_frequency != 0) {
+		processors[processor].max_frequency = max_frequency;
+		processors[processor].flags |= CPUINFO_LINUX_FLAG_MAX_FREQUENCY;
+	}
+
+	const uint32_t min_frequency = cpuinfo_linux_get_processor_min_frequency(processor);
+	if (min_frequency != 0) {
+		processors[processor].min_frequency = min_frequency;
+		processors[processor].flags |= CPUINFO_LINUX_FLAG_MIN_FREQUENCY;
+	}
+
+	if (cpuinfo_linux_get_processor_package_id(processor, &processors[processor].package_id)) {
+		processors[processor].flags |= CPUINFO_LINUX_FLAG_PACKAGE_ID;
+	}
+}
+
 static int cmp_arm_linux_processor(const void* ptr_a, const void* ptr_b) {
 	const struct cpuinfo_arm_linux_processor* processor_a = (const struct cpuinfo_arm_linux_processor*)ptr_a;
 	const struct cpuinfo_arm_linux_processor* processor_b = (const struct cpuinfo_arm_linux_processor*)ptr_b;
@@ -106,9 +126,11 @@ static int cmp_arm_linux_processor(const void* ptr_a, const void* ptr_b) {
 
 void cpuinfo_arm_linux_init(void) {
 	struct cpuinfo_arm_linux_processor* arm_linux_processors = NULL;
+	void* arena = NULL;
 	struct cpuinfo_processor* processors = NULL;
 	struct cpuinfo_core* cores = NULL;
 	struct cpuinfo_cluster* clusters = NULL;
+	struct cpuinfo_package* package = NULL;
 	struct cpuinfo_uarch_info* uarchs = NULL;
 	struct cpuinfo_cache* l1i = NULL;
 	struct cpuinfo_cache* l1d = NULL;
@@ -117,6 +139,9 @@ void cpuinfo_arm_linux_init(void) {
 	const struct cpuinfo_processor** linux_cpu_to_processor_map = NULL;
 	const struct cpuinfo_core** linux_cpu_to_core_map = NULL;
 	uint32_t* linux_cpu_to_uarch_index_map = NULL;
+	struct cpuinfo_numa_node* numa_nodes = NULL;
+	uint8_t* numa_distances = NULL;
+	struct cpuinfo_linux_numa_nodes numa = {0};
 
 	const uint32_t max_processors_count = cpuinfo_linux_get_max_processors_count();
 	cpuinfo_log_debug("system maximum processors count: %" PRIu32, max_processors_count);
@@ -307,79 +332,44 @@ void cpuinfo_arm_linux_init(void) {
 #endif
 
 	/* Detect min/max frequency and package ID */
-	for (uint32_t i = 0; i < arm_linux_processors_count; i++) {
-		if (bitmask_all(arm_linux_processors[i].flags, CPUINFO_LINUX_FLAG_VALID)) {
-			const uint32_t max_frequency = cpuinfo_linux_get_processor_max_frequency(i);
-			if (max_frequency != 0) {
-				arm_linux_processors[i].max_frequency = max_frequency;
-				arm_linux_processors[i].flags |= CPUINFO_LINUX_FLAG_MAX_FREQUENCY;
-			}
-
-			const uint32_t min_frequency = cpuinfo_linux_get_processor_min_frequency(i);
-			if (min_frequency != 0) {
-				arm_linux_processors[i].min_frequency = min_frequency;
-				arm_linux_processors[i].flags |= CPUINFO_LINUX_FLAG_MIN_FREQUENCY;
-			}
-
-			if (cpuinfo_linux_get_processor_package_id(i, &arm_linux_processors[i].package_id)) {
-				arm_linux_processors[i].flags |= CPUINFO_LINUX_FLAG_PACKAGE_ID;
-			}
-		}
-	}
+	cpuinfo_linux_for_each_processor(
+		arm_linux_processors_count,
+		(cpuinfo_processor_function)detect_frequencies_and_package_id,
+		arm_linux_processors);
 
 	/* Initialize topology group IDs */
 	for (uint32_t i = 0; i < arm_linux_processors_count; i++) {
 		arm_linux_processors[i].package_leader_id = i;
 	}
 
-	/* Propagate topology group IDs among siblings */
-	bool detected_core_siblings_list_node = false;
-	bool detected_cluster_cpus_list_node = false;
+	/*
+	 * Propagate topology group IDs among siblings. Use the
+	 * cluster_cpus_list topology node if available for the first processor,
+	 * and fall back to core_siblings_list for all processors on kernels
+	 * without it, so that the missing paths are not read repeatedly.
+	 */
+	const uint32_t siblings_flags = CPUINFO_LINUX_FLAG_VALID | CPUINFO_LINUX_FLAG_PACKAGE_ID;
+	cpuinfo_siblings_detector siblings_detector = cpuinfo_linux_detect_cluster_cpus;
 	for (uint32_t i = 0; i < arm_linux_processors_count; i++) {
-		if (!bitmask_all(arm_linux_processors[i].flags, CPUINFO_LINUX_FLAG_VALID)) {
-			continue;
-		}
-
-		if (!bitmask_all(arm_linux_processors[i].flags, CPUINFO_LINUX_FLAG_PACKAGE_ID)) {
-			continue;
-		}
-
-		/* Use the cluster_cpus_list topology node if available. If not
-		 * found, cache the result to avoid repeatedly attempting to
-		 * read the non-existent paths.
-		 * */
-		if (!detected_core_siblings_list_node && !detected_cluster_cpus_list_node) {
-			if (cpuinfo_linux_detect_cluster_cpus(
+		if (bitmask_all(arm_linux_processors[i].flags, siblings_flags)) {
+			if (!cpuinfo_linux_detect_cluster_cpus(
 				    arm_linux_processors_count,
 				    i,
 				    (cpuinfo_siblings_callback)cluster_siblings_parser,
 				    arm_linux_processors)) {
-				detected_cluster_cpus_list_node = true;
-				continue;
-			} else {
-				detected_core_siblings_list_node = true;
+				siblings_detector = cpuinfo_linux_detect_core_siblings;
 			}
-		}
-
-		/* The cached result above will guarantee only one of the blocks
-		 * below will execute, with a bias towards cluster_cpus_list.
-		 **/
-		if (detected_core_siblings_list_node) {
-			cpuinfo_linux_detect_core_siblings(
-				arm_linux_processors_count,
-				i,
-				(cpuinfo_siblings_callback)cluster_siblings_parser,
-				arm_linux_processors);
-		}
-
-		if (detected_cluster_cpus_list_node) {
-			cpuinfo_linux_detect_cluster_cpus(
-				arm_linux_processors_count,
-				i,
-				(cpuinfo_siblings_callback)cluster_siblings_parser,
-				arm_linux_processors);
+			break;
 		}
 	}
+	cpuinfo_linux_detect_sibling_groups(
+		arm_linux_processors_count,
+		&arm_linux_processors->flags,
+		sizeof(struct cpuinfo_arm_linux_processor),
+		siblings_flags,
+		siblings_detector,
+		(cpuinfo_siblings_callback)cluster_siblings_parser,
+		arm_linux_processors);
 
 	/* Propagate all cluster IDs */
 	uint32_t clustered_processors = 0;
@@ -508,93 +498,75 @@ void cpuinfo_arm_linux_init(void) {
 	 * - Level 2 and level 3 cache is shared between cores in the same
 	 * cluster.
 	 */
-	cpuinfo_arm_chipset_to_string(&chipset, package.name);
-	package.processor_count = valid_processors;
-	package.core_count = valid_processors;
-	package.cluster_count = cluster_count;
-
-	processors = calloc(valid_processors, sizeof(struct cpuinfo_processor));
-	if (processors == NULL) {
-		cpuinfo_log_error(
-			"failed to allocate %zu bytes for descriptions of %" PRIu32 " logical processors",
-			valid_processors * sizeof(struct cpuinfo_processor),
-			valid_processors);
+	/*
+	 * All tables share one cache-line-aligned arena. Tables are laid out in
+	 * the order of decreasing access frequency: the Linux CPU maps and the
+	 * processor and core tables are read on every cpuinfo_get_current_* call.
+	 * The numbers of L2 and L3 caches are only known after decoding cache
+	 * parameters below, so their tables are sized for the worst case: at most
+	 * one L2 cache per core and one L3 cache per cluster.
+	 */
+	if (!cpuinfo_linux_detect_numa_nodes(arm_linux_processors_count, &numa)) {
 		goto cleanup;
 	}
 
-	cores = calloc(valid_processors, sizeof(struct cpuinfo_core));
-	if (cores == NULL) {
+	size_t arena_size = 0;
+	const size_t linux_cpu_to_processor_map_offset = cpuinfo_tables_arena_reserve(
+		&arena_size, arm_linux_processors_count, sizeof(struct cpuinfo_processor*));
+	const size_t linux_cpu_to_core_map_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, arm_linux_processors_count, sizeof(struct cpuinfo_core*));
+	const size_t linux_cpu_to_uarch_index_map_offset = cpuinfo_tables_arena_reserve(
+		&arena_size, uarchs_count > 1 ? arm_linux_processors_count : 0, sizeof(uint32_t));
+	const size_t processors_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, valid_processors, sizeof(struct cpuinfo_processor));
+	const size_t cores_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, valid_processors, sizeof(struct cpuinfo_core));
+	const size_t clusters_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, cluster_count, sizeof(struct cpuinfo_cluster));
+	const size_t uarchs_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, uarchs_count, sizeof(struct cpuinfo_uarch_info));
+	const size_t l1d_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, valid_processors, sizeof(struct cpuinfo_cache));
+	const size_t l1i_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, valid_processors, sizeof(struct cpuinfo_cache));
+	const size_t l2_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, valid_processors, sizeof(struct cpuinfo_cache));
+	const size_t l3_offset = cpuinfo_tables_arena_reserve(&arena_size, cluster_count, sizeof(struct cpuinfo_cache));
+	const size_t package_offset = cpuinfo_tables_arena_reserve(&arena_size, 1, sizeof(struct cpuinfo_package));
+	const size_t numa_nodes_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, numa.nodes_count, sizeof(struct cpuinfo_numa_node));
+	const size_t numa_distances_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, numa.nodes_count * numa.nodes_count, sizeof(uint8_t));
+
+	arena = cpuinfo_allocate_tables_arena(arena_size);
+	if (arena == NULL) {
 		cpuinfo_log_error(
-			"failed to allocate %zu bytes for descriptions of %" PRIu32 " cores",
-			valid_processors * sizeof(struct cpuinfo_core),
+			"failed to allocate %zu bytes for descriptions of %" PRIu32 " logical processors",
+			arena_size,
 			valid_processors);
 		goto cleanup;
 	}
 
-	clusters = calloc(cluster_count, sizeof(struct cpuinfo_cluster));
-	if (clusters == NULL) {
-		cpuinfo_log_error(
-			"failed to allocate %zu bytes for descriptions of %" PRIu32 " core clusters",
-			cluster_count * sizeof(struct cpuinfo_cluster),
-			cluster_count);
-		goto cleanup;
-	}
-
-	uarchs = calloc(uarchs_count, sizeof(struct cpuinfo_uarch_info));
-	if (uarchs == NULL) {
-		cpuinfo_log_error(
-			"failed to allocate %zu bytes for descriptions of %" PRIu32 " microarchitectures",
-			uarchs_count * sizeof(struct cpuinfo_uarch_info),
-			uarchs_count);
-		goto cleanup;
-	}
-
-	linux_cpu_to_processor_map = calloc(arm_linux_processors_count, sizeof(struct cpuinfo_processor*));
-	if (linux_cpu_to_processor_map == NULL) {
-		cpuinfo_log_error(
-			"failed to allocate %zu bytes for %" PRIu32 " logical processor mapping entries",
-			arm_linux_processors_count * sizeof(struct cpuinfo_processor*),
-			arm_linux_processors_count);
-		goto cleanup;
-	}
-
-	linux_cpu_to_core_map = calloc(arm_linux_processors_count, sizeof(struct cpuinfo_core*));
-	if (linux_cpu_to_core_map == NULL) {
-		cpuinfo_log_error(
-			"failed to allocate %zu bytes for %" PRIu32 " core mapping entries",
-			arm_linux_processors_count * sizeof(struct cpuinfo_core*),
-			arm_linux_processors_count);
-		goto cleanup;
-	}
-
+	linux_cpu_to_processor_map =
+		(const struct cpuinfo_processor**)((char*)arena + linux_cpu_to_processor_map_offset);
+	linux_cpu_to_core_map = (const struct cpuinfo_core**)((char*)arena + linux_cpu_to_core_map_offset);
 	if (uarchs_count > 1) {
-		linux_cpu_to_uarch_index_map = calloc(arm_linux_processors_count, sizeof(uint32_t));
-		if (linux_cpu_to_uarch_index_map == NULL) {
-			cpuinfo_log_error(
-				"failed to allocate %zu bytes for %" PRIu32 " uarch index mapping entries",
-				arm_linux_processors_count * sizeof(uint32_t),
-				arm_linux_processors_count);
-			goto cleanup;
-		}
-	}
-
-	l1i = calloc(valid_processors, sizeof(struct cpuinfo_cache));
-	if (l1i == NULL) {
-		cpuinfo_log_error(
-			"failed to allocate %zu bytes for descriptions of %" PRIu32 " L1I caches",
-			valid_processors * sizeof(struct cpuinfo_cache),
-			valid_processors);
-		goto cleanup;
-	}
-
-	l1d = calloc(valid_processors, sizeof(struct cpuinfo_cache));
-	if (l1d == NULL) {
-		cpuinfo_log_error(
-			"failed to allocate %zu bytes for descriptions of %" PRIu32 " L1D caches",
-			valid_processors * sizeof(struct cpuinfo_cache),
-			valid_processors);
-		goto cleanup;
-	}
+		linux_cpu_to_uarch_index_map = (uint32_t*)((char*)arena + linux_cpu_to_uarch_index_map_offset);
+	}
+	processors = (struct cpuinfo_processor*)((char*)arena + processors_offset);
+	cores = (struct cpuinfo_core*)((char*)arena + cores_offset);
+	clusters = (struct cpuinfo_cluster*)((char*)arena + clusters_offset);
+	uarchs = (struct cpuinfo_uarch_info*)((char*)arena + uarchs_offset);
+	l1d = (struct cpuinfo_cache*)((char*)arena + l1d_offset);
+	l1i = (struct cpuinfo_cache*)((char*)arena + l1i_offset);
+	package = (struct cpuinfo_package*)((char*)arena + package_offset);
+	numa_nodes = (struct cpuinfo_numa_node*)((char*)arena + numa_nodes_offset);
+	numa_distances = (uint8_t*)arena + numa_distances_offset;
+
+	cpuinfo_arm_chipset_to_string(&chipset, package->name);
+	package->processor_count = valid_processors;
+	package->core_count = valid_processors;
+	package->cluster_count = cluster_count;
 
 	uint32_t uarchs_index = 0;
 	for (uint32_t i = 0; i < arm_linux_processors_count; i++) {
@@ -625,7 +597,7 @@ void cpuinfo_arm_linux_init(void) {
 				.core_start = i,
 				.core_count = arm_linux_processors[i].package_processor_count,
 				.cluster_id = cluster_id,
-				.package = &package,
+				.package = package,
 				.vendor = arm_linux_processors[i].vendor,
 				.uarch = arm_linux_processors[i].uarch,
 				.midr = arm_linux_processors[i].midr,
@@ -635,7 +607,7 @@ void cpuinfo_arm_linux_init(void) {
 		processors[i].smt_id = 0;
 		processors[i].core = cores + i;
 		processors[i].cluster = clusters + cluster_id;
-		processors[i].package = &package;
+		processors[i].package = package;
 		processors[i].linux_id = (int)arm_linux_processors[i].system_processor_id;
 		processors[i].cache.l1i = l1i + i;
 		processors[i].cache.l1d = l1d + i;
@@ -645,10 +617,13 @@ void cpuinfo_arm_linux_init(void) {
 		cores[i].processor_count = 1;
 		cores[i].core_id = i;
 		cores[i].cluster = clusters + cluster_id;
-		cores[i].package = &package;
+		cores[i].package = package;
 		cores[i].vendor = arm_linux_processors[i].vendor;
 		cores[i].uarch = arm_linux_processors[i].uarch;
 		cores[i].midr = arm_linux_processors[i].midr;
+		cores[i].capacity = cpuinfo_linux_get_processor_capacity(arm_linux_processors[i].system_processor_id);
+		cores[i].performance_ranking =
+			cpuinfo_linux_get_processor_performance_ranking(arm_linux_processors[i].system_processor_id);
 		linux_cpu_to_core_map[arm_linux_processors[i].system_processor_id] = &cores[i];
 
 		if (linux_cpu_to_uarch_index_map != NULL) {
@@ -728,24 +703,9 @@ void cpuinfo_arm_linux_init(void) {
 	}
 
 	if (l2_count != 0) {
-		l2 = calloc(l2_count, sizeof(struct cpuinfo_cache));
-		if (l2 == NULL) {
-			cpuinfo_log_error(
-				"failed to allocate %zu bytes for descriptions of %" PRIu32 " L2 caches",
-				l2_count * sizeof(struct cpuinfo_cache),
-				l2_count);
-			goto cleanup;
-		}
-
+		l2 = (struct cpuinfo_cache*)((char*)arena + l2_offset);
 		if (l3_count != 0) {
-			l3 = calloc(l3_count, sizeof(struct cpuinfo_cache));
-			if (l3 == NULL) {
-				cpuinfo_log_error(
-					"failed to allocate %zu bytes for descriptions of %" PRIu32 " L3 caches",
-					l3_count * sizeof(struct cpuinfo_cache),
-					l3_count);
-				goto cleanup;
-			}
+			l3 = (struct cpuinfo_cache*)((char*)arena + l3_offset);
 		}
 	}
 
@@ -830,11 +790,19 @@ void cpuinfo_arm_linux_init(void) {
 		}
 	}
 
+	cpuinfo_linux_detect_processor_flags(arm_linux_processors_count, valid_processors, processors);
+
+	cpuinfo_linux_build_numa_nodes(
+		&numa, valid_processors, processors, valid_processors, cores, numa_nodes, numa_distances);
+
+	cpuinfo_linux_init_getcpu(max_possible_processors_count);
+
 	/* Commit */
+	cpuinfo_begin_tables_update();
 	cpuinfo_processors = processors;
 	cpuinfo_cores = cores;
 	cpuinfo_clusters = clusters;
-	cpuinfo_packages = &package;
+	cpuinfo_packages = package;
 	cpuinfo_uarchs = uarchs;
 	cpuinfo_cache[cpuinfo_cache_level_1i] = l1i;
 	cpuinfo_cache[cpuinfo_cache_level_1d] = l1d;
@@ -851,36 +819,82 @@ void cpuinfo_arm_linux_init(void) {
 	cpuinfo_cache_count[cpuinfo_cache_level_2] = l2_count;
 	cpuinfo_cache_count[cpuinfo_cache_level_3] = l3_count;
 	cpuinfo_max_cache_size = cpuinfo_arm_compute_max_cache_size(&processors[0]);
+	cpuinfo_numa_nodes = numa_nodes;
+	cpuinfo_numa_nodes_count = numa.nodes_count;
+	cpuinfo_numa_distances = numa_distances;
 
 	cpuinfo_linux_cpu_max = arm_linux_processors_count;
 	cpuinfo_linux_cpu_to_processor_map = linux_cpu_to_processor_map;
 	cpuinfo_linux_cpu_to_core_map = linux_cpu_to_core_map;
 	cpuinfo_linux_cpu_to_uarch_index_map = linux_cpu_to_uarch_index_map;
+	cpuinfo_tables_arena = arena;
 
 	__sync_synchronize();
 
 	cpuinfo_is_initialized = true;
 
-	processors = NULL;
-	cores = NULL;
-	clusters = NULL;
-	uarchs = NULL;
-	l1i = l1d = l2 = l3 = NULL;
-	linux_cpu_to_processor_map = NULL;
-	linux_cpu_to_core_map = NULL;
-	linux_cpu_to_uarch_index_map = NULL;
+	cpuinfo_end_tables_update();
+
+	arena = NULL;
 
 cleanup:
+	cpuinfo_linux_free_numa_nodes(&numa);
 	free(arm_linux_processors);
-	free(processors);
-	free(cores);
-	free(clusters);
-	free(uarchs);
-	free(l1i);
-	free(l1d);
-	free(l2);
-	free(l3);
-	free(linux_cpu_to_processor_map);
-	free(linux_cpu_to_core_map);
-	free(linux_cpu_to_uarch_index_map);
+	free(arena);
+}
+
+void cpuinfo_arm_linux_init_isa(void) {
+	/* Without /proc/cpuinfo the chipset is unknown, and chipset-specific ISA quirks are not applied */
+	const struct cpuinfo_arm_chipset chipset = {
+		.vendor = cpuinfo_arm_chipset_vendor_unknown,
+		.series = cpuinfo_arm_chipset_series_unknown,
+	};
+	uint32_t isa_features = 0, isa_features2 = 0, midr = 0;
+#if CPUINFO_ARCH_ARM
+#ifdef __ANDROID__
+	if (!cpuinfo_arm_linux_hwcap_from_getauxval(&isa_features, &isa_features2)) {
+		cpuinfo_arm_linux_hwcap_from_procfs(&isa_features, &isa_features2);
+	}
+#else
+	cpuinfo_arm_linux_hwcap_from_getauxval(&isa_features, &isa_features2);
+#endif
+	/*
+	 * The architecture version is normally parsed from /proc/cpuinfo. The
+	 * architecture targeted by the compiler is a lower bound for it.
+	 */
+#ifdef __ARM_ARCH
+	const uint32_t architecture_version = __ARM_ARCH;
+#else
+	const uint32_t architecture_version = 0;
+#endif
+	cpuinfo_arm_linux_decode_isa_from_proc_cpuinfo(
+		isa_features, isa_features2, midr, architecture_version, 0, &chipset, &cpuinfo_isa);
+#elif CPUINFO_ARCH_ARM64
+	cpuinfo_arm_linux_hwcap_from_getauxval(&isa_features, &isa_features2);
+#if !CPUINFO_MOCK
+	/* With HWCAP_CPUID the kernel emulates reads of MIDR_EL1 from user space */
+	if (isa_features & CPUINFO_ARM_LINUX_FEATURE_CPUID) {
+		uint64_t midr_el1;
+		__asm__ __volatile__("mrs %0, MIDR_EL1" : "=r"(midr_el1));
+		midr = (uint32_t)midr_el1;
+	}
+#endif
+	cpuinfo_arm64_linux_decode_isa_from_proc_cpuinfo(isa_features, isa_features2, midr, &chipset, &cpuinfo_isa);
+#endif
+
+	enum cpuinfo_vendor vendor = cpuinfo_vendor_unknown;
+	enum cpuinfo_uarch uarch = cpuinfo_uarch_unknown;
+	if (midr != 0) {
+		cpuinfo_arm_decode_vendor_uarch(
+			midr,
+#if CPUINFO_ARCH_ARM
+			!!(isa_features & CPUINFO_ARM_LINUX_FEATURE_VFPV4),
+#endif
+			&vendor,
+			&uarch);
+	}
+	cpuinfo_isa_uarch = (struct cpuinfo_uarch_info){
+		.uarch = uarch,
+		.midr = midr,
+	};
 }
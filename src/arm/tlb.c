@@ -1,154 +1,226 @@
+#include <stddef.h>
+#include <stdint.h>
 
+#include <arm/api.h>
+#include <cpuinfo.h>
+#include <cpuinfo/internal-api.h>
 
-switch (uarch) {
-	case cpuinfo_uarch_cortex_a5:
-		/*
-		 * Cortex-A5 Technical Reference Manual:
-		 * 6.3.1. Micro TLB
-		 *   The first level of caching for the page table information
-		 * is a micro TLB of 10 entries that is implemented on each of
-		 * the instruction and data sides. 6.3.2. Main TLB Misses from
-		 * the instruction and data micro TLBs are handled by a unified
-		 * main TLB. The main TLB is 128-entry two-way set-associative.
-		 */
-		break;
-	case cpuinfo_uarch_cortex_a7:
-		/*
-		 * Cortex-A7 MPCore Technical Reference Manual:
-		 * 5.3.1. Micro TLB
-		 *   The first level of caching for the page table information
-		 * is a micro TLB of 10 entries that is implemented on each of
-		 * the instruction and data sides. 5.3.2. Main TLB Misses from
-		 * the micro TLBs are handled by a unified main TLB. This is a
-		 * 256-entry 2-way set-associative structure. The main TLB
-		 * supports all the VMSAv7 page sizes of 4KB, 64KB, 1MB and 16MB
-		 * in addition to the LPAE page sizes of 2MB and 1G.
-		 */
-		break;
-	case cpuinfo_uarch_cortex_a8:
-		/*
-		 * Cortex-A8 Technical Reference Manual:
-		 * 6.1. About the MMU
-		 *    The MMU features include the following:
-		 *     - separate, fully-associative, 32-entry data and
-		 * instruction TLBs
-		 *     - TLB entries that support 4KB, 64KB, 1MB, and 16MB pages
-		 */
-		break;
-	case cpuinfo_uarch_cortex_a9:
-		/*
-		 * ARM Cortex‑A9 Technical Reference Manual:
-		 * 6.2.1 Micro TLB
-		 *    The first level of caching for the page table information
-		 * is a micro TLB of 32 entries on the data side, and
-		 * configurable 32 or 64 entries on the instruction side. 6.2.2
-		 * Main TLB The main TLB is implemented as a combination of:
-		 *     - A fully-associative, lockable array of four elements.
-		 *     - A 2-way associative structure of 2x32, 2x64, 2x128 or
-		 * 2x256 entries.
-		 */
-		break;
-	case cpuinfo_uarch_cortex_a15:
-		/*
-		 * ARM Cortex-A15 MPCore Processor Technical Reference Manual:
-		 * 5.2.1. L1 instruction TLB
-		 *    The L1 instruction TLB is a 32-entry fully-associative
-		 * structure. This TLB caches entries at the 4KB granularity of
-		 * Virtual Address (VA) to Physical Address (PA) mapping only.
-		 * If the page tables map the memory region to a larger
-		 * granularity than 4K, it only allocates one mapping for the
-		 * particular 4K region to which the current access
-		 * corresponds. 5.2.2. L1 data TLB There are two separate
-		 * 32-entry fully-associative TLBs that are used for data loads
-		 * and stores, respectively. Similar to the L1 instruction TLB,
-		 * both of these cache entries at the 4KB granularity of VA to
-		 * PA mappings only. At implementation time, the Cortex-A15
-		 * MPCore processor can be configured with the -l1tlb_1m option,
-		 * to have the L1 data TLB cache entries at both the 4KB and 1MB
-		 * granularity. With this configuration, any translation that
-		 * results in a 1MB or larger page is cached in the L1 data TLB
-		 * as a 1MB entry. Any translation that results in a page
-		 * smaller than 1MB is cached in the L1 data TLB as a 4KB entry.
-		 * By default, all translations are cached in the L1 data TLB as
-		 * a 4KB entry. 5.2.3. L2 TLB Misses from the L1 instruction and
-		 * data TLBs are handled by a unified L2 TLB. This is a
-		 * 512-entry 4-way set-associative structure. The L2 TLB
-		 * supports all the VMSAv7 page sizes of 4K, 64K, 1MB and 16MB
-		 * in addition to the LPAE page sizes of 2MB and 1GB.
-		 */
-		break;
-	case cpuinfo_uarch_cortex_a17:
-		/*
-		 * ARM Cortex-A17 MPCore Processor Technical Reference Manual:
-		 * 5.2.1. Instruction micro TLB
-		 *    The instruction micro TLB is implemented as a 32, 48 or 64
-		 * entry, fully-associative structure. This TLB caches entries
-		 * at the 4KB and 1MB granularity of Virtual Address (VA) to
-		 * Physical Address (PA) mapping only. If the translation tables
-		 * map the memory region to a larger granularity than 4KB or
-		 * 1MB, it only allocates one mapping for the particular 4KB
-		 * region to which the current access corresponds. 5.2.2. Data
-		 * micro TLB The data micro TLB is a 32 entry fully-associative
-		 * TLB that is used for data loads and stores. The cache entries
-		 * have a 4KB and 1MB granularity of VA to PA mappings
-		 * only. 5.2.3. Unified main TLB Misses from the instruction and
-		 * data micro TLBs are handled by a unified main TLB. This is a
-		 * 1024 entry 4-way set-associative structure. The main TLB
-		 * supports all the VMSAv7 page sizes of 4K, 64K, 1MB and 16MB
-		 * in addition to the LPAE page sizes of 2MB and 1GB.
-		 */
-		break;
-	case cpuinfo_uarch_cortex_a35:
-		/*
-		 * ARM Cortex‑A35 Processor Technical Reference Manual:
-		 * A6.2 TLB Organization
-		 *   Micro TLB
-		 *     The first level of caching for the translation table
-		 * information is a micro TLB of ten entries that is implemented
-		 * on each of the instruction and data sides. Main TLB A unified
-		 * main TLB handles misses from the micro TLBs. It has a
-		 * 512-entry, 2-way, set-associative structure and supports all
-		 * VMSAv8 block sizes, except 1GB. If it fetches a 1GB block,
-		 * the TLB splits it into 512MB blocks and stores the
-		 * appropriate block for the lookup.
-		 */
-		break;
-	case cpuinfo_uarch_cortex_a53:
-		/*
-		 * ARM Cortex-A53 MPCore Processor Technical Reference Manual:
-		 * 5.2.1. Micro TLB
-		 *    The first level of caching for the translation table
-		 * information is a micro TLB of ten entries that is implemented
-		 * on each of the instruction and data sides. 5.2.2. Main TLB A
-		 * unified main TLB handles misses from the micro TLBs. This is
-		 * a 512-entry, 4-way, set-associative structure. The main TLB
-		 * supports all VMSAv8 block sizes, except 1GB. If a 1GB block
-		 * is fetched, it is split into 512MB blocks and the appropriate
-		 * block for the lookup stored.
-		 */
-		break;
-	case cpuinfo_uarch_cortex_a57:
-		/*
-		 * ARM® Cortex-A57 MPCore Processor Technical Reference Manual:
-		 * 5.2.1 L1 instruction TLB
-		 *    The L1 instruction TLB is a 48-entry fully-associative
-		 * structure. This TLB caches entries of three different page
-		 * sizes, natively 4KB, 64KB, and 1MB, of VA to PA mappings. If
-		 * the page tables map the memory region to a larger granularity
-		 * than 1MB, it only allocates one mapping for the particular
-		 * 1MB region to which the current access corresponds. 5.2.2 L1
-		 * data TLB The L1 data TLB is a 32-entry fully-associative TLB
-		 * that is used for data loads and stores. This TLB caches
-		 * entries of three different page sizes, natively 4KB, 64KB,
-		 * and 1MB, of VA to PA mappings. 5.2.3 L2 TLB Misses from the
-		 * L1 instruction and data TLBs are handled by a unified L2 TLB.
-		 * This is a 1024-entry 4-way set-associative structure. The L2
-		 * TLB supports the page sizes of 4K, 64K, 1MB and 16MB. It also
-		 * supports page sizes of 2MB and 1GB for the long descriptor
-		 * format translation in AArch32 state and in AArch64 state when
-		 * using the 4KB translation granule. In addition, the L2 TLB
-		 * supports the 512MB page map size defined for the AArch64
-		 * translations that use a 64KB translation granule.
-		 */
-		break;
+/* Page sizes of the VMSAv7 short-descriptor format */
+#define ARMV7_PAGES \
+	(CPUINFO_PAGE_SIZE_4KB | CPUINFO_PAGE_SIZE_64KB | CPUINFO_PAGE_SIZE_1MB | CPUINFO_PAGE_SIZE_16MB)
+/* Page sizes of the VMSAv7 short-descriptor and Large Physical Address Extension formats */
+#define LPAE_PAGES (ARMV7_PAGES | CPUINFO_PAGE_SIZE_2MB | CPUINFO_PAGE_SIZE_1GB)
+/* Page sizes of the VMSAv8 4KB and 64KB translation granules, and of AArch32 state */
+#define ARMV8_PAGES (LPAE_PAGES | CPUINFO_PAGE_SIZE_512MB)
+/* Native page sizes of micro TLBs: larger blocks are cached as entries of these sizes */
+#define MICRO_TLB_PAGES (CPUINFO_PAGE_SIZE_4KB | CPUINFO_PAGE_SIZE_64KB | CPUINFO_PAGE_SIZE_1MB)
+
+const struct cpuinfo_tlbs* cpuinfo_arm_decode_tlbs(enum cpuinfo_uarch uarch) {
+	switch (uarch) {
+		case cpuinfo_uarch_cortex_a5: {
+			/*
+			 * Cortex-A5 Technical Reference Manual:
+			 * 6.3.1. Micro TLB
+			 *   The first level of caching for the page table information
+			 * is a micro TLB of 10 entries that is implemented on each of
+			 * the instruction and data sides. 6.3.2. Main TLB Misses from
+			 * the instruction and data micro TLBs are handled by a unified
+			 * main TLB. The main TLB is 128-entry two-way set-associative.
+			 */
+			static const struct cpuinfo_tlbs tlbs = {
+				.itlb = {{.entries = 10, .associativity = 10, .pages = ARMV7_PAGES}},
+				.dtlb = {{.entries = 10, .associativity = 10, .pages = ARMV7_PAGES}},
+				.stlb = {{.entries = 128, .associativity = 2, .pages = ARMV7_PAGES}},
+			};
+			return &tlbs;
+		}
+		case cpuinfo_uarch_cortex_a7: {
+			/*
+			 * Cortex-A7 MPCore Technical Reference Manual:
+			 * 5.3.1. Micro TLB
+			 *   The first level of caching for the page table information
+			 * is a micro TLB of 10 entries that is implemented on each of
+			 * the instruction and data sides. 5.3.2. Main TLB Misses from
+			 * the micro TLBs are handled by a unified main TLB. This is a
+			 * 256-entry 2-way set-associative structure. The main TLB
+			 * supports all the VMSAv7 page sizes of 4KB, 64KB, 1MB and 16MB
+			 * in addition to the LPAE page sizes of 2MB and 1G.
+			 */
+			static const struct cpuinfo_tlbs tlbs = {
+				.itlb = {{.entries = 10, .associativity = 10, .pages = MICRO_TLB_PAGES}},
+				.dtlb = {{.entries = 10, .associativity = 10, .pages = MICRO_TLB_PAGES}},
+				.stlb = {{.entries = 256, .associativity = 2, .pages = LPAE_PAGES}},
+			};
+			return &tlbs;
+		}
+		case cpuinfo_uarch_cortex_a8: {
+			/*
+			 * Cortex-A8 Technical Reference Manual:
+			 * 6.1. About the MMU
+			 *    The MMU features include the following:
+			 *     - separate, fully-associative, 32-entry data and
+			 * instruction TLBs
+			 *     - TLB entries that support 4KB, 64KB, 1MB, and 16MB pages
+			 */
+			static const struct cpuinfo_tlbs tlbs = {
+				.itlb = {{.entries = 32, .associativity = 32, .pages = ARMV7_PAGES}},
+				.dtlb = {{.entries = 32, .associativity = 32, .pages = ARMV7_PAGES}},
+			};
+			return &tlbs;
+		}
+		case cpuinfo_uarch_cortex_a9: {
+			/*
+			 * ARM Cortex‑A9 Technical Reference Manual:
+			 * 6.2.1 Micro TLB
+			 *    The first level of caching for the page table information
+			 * is a micro TLB of 32 entries on the data side, and
+			 * configurable 32 or 64 entries on the instruction side. 6.2.2
+			 * Main TLB The main TLB is implemented as a combination of:
+			 *     - A fully-associative, lockable array of four elements.
+			 *     - A 2-way associative structure of 2x32, 2x64, 2x128 or
+			 * 2x256 entries.
+			 */
+			/* Only the minimal configuration is reported: the size of the main TLB is unknown */
+			static const struct cpuinfo_tlbs tlbs = {
+				.itlb = {{.entries = 32, .associativity = 32, .pages = ARMV7_PAGES}},
+				.dtlb = {{.entries = 32, .associativity = 32, .pages = ARMV7_PAGES}},
+			};
+			return &tlbs;
+		}
+		case cpuinfo_uarch_cortex_a15: {
+			/*
+			 * ARM Cortex-A15 MPCore Processor Technical Reference Manual:
+			 * 5.2.1. L1 instruction TLB
+			 *    The L1 instruction TLB is a 32-entry fully-associative
+			 * structure. This TLB caches entries at the 4KB granularity of
+			 * Virtual Address (VA) to Physical Address (PA) mapping only.
+			 * If the page tables map the memory region to a larger
+			 * granularity than 4K, it only allocates one mapping for the
+			 * particular 4K region to which the current access
+			 * corresponds. 5.2.2. L1 data TLB There are two separate
+			 * 32-entry fully-associative TLBs that are used for data loads
+			 * and stores, respectively. Similar to the L1 instruction TLB,
+			 * both of these cache entries at the 4KB granularity of VA to
+			 * PA mappings only. At implementation time, the Cortex-A15
+			 * MPCore processor can be configured with the -l1tlb_1m option,
+			 * to have the L1 data TLB cache entries at both the 4KB and 1MB
+			 * granularity. With this configuration, any translation that
+			 * results in a 1MB or larger page is cached in the L1 data TLB
+			 * as a 1MB entry. Any translation that results in a page
+			 * smaller than 1MB is cached in the L1 data TLB as a 4KB entry.
+			 * By default, all translations are cached in the L1 data TLB as
+			 * a 4KB entry. 5.2.3. L2 TLB Misses from the L1 instruction and
+			 * data TLBs are handled by a unified L2 TLB. This is a
+			 * 512-entry 4-way set-associative structure. The L2 TLB
+			 * supports all the VMSAv7 page sizes of 4K, 64K, 1MB and 16MB
+			 * in addition to the LPAE page sizes of 2MB and 1GB.
+			 */
+			static const struct cpuinfo_tlbs tlbs = {
+				.itlb = {{.entries = 32, .associativity = 32, .pages = CPUINFO_PAGE_SIZE_4KB}},
+				.dtlb = {{.entries = 32, .associativity = 32, .pages = CPUINFO_PAGE_SIZE_4KB}},
+				.stlb = {{.entries = 512, .associativity = 4, .pages = LPAE_PAGES}},
+			};
+			return &tlbs;
+		}
+		case cpuinfo_uarch_cortex_a17: {
+			/*
+			 * ARM Cortex-A17 MPCore Processor Technical Reference Manual:
+			 * 5.2.1. Instruction micro TLB
+			 *    The instruction micro TLB is implemented as a 32, 48 or 64
+			 * entry, fully-associative structure. This TLB caches entries
+			 * at the 4KB and 1MB granularity of Virtual Address (VA) to
+			 * Physical Address (PA) mapping only. If the translation tables
+			 * map the memory region to a larger granularity than 4KB or
+			 * 1MB, it only allocates one mapping for the particular 4KB
+			 * region to which the current access corresponds. 5.2.2. Data
+			 * micro TLB The data micro TLB is a 32 entry fully-associative
+			 * TLB that is used for data loads and stores. The cache entries
+			 * have a 4KB and 1MB granularity of VA to PA mappings
+			 * only. 5.2.3. Unified main TLB Misses from the instruction and
+			 * data micro TLBs are handled by a unified main TLB. This is a
+			 * 1024 entry 4-way set-associative structure. The main TLB
+			 * supports all the VMSAv7 page sizes of 4K, 64K, 1MB and 16MB
+			 * in addition to the LPAE page sizes of 2MB and 1GB.
+			 */
+			static const struct cpuinfo_tlbs tlbs = {
+				.itlb = {{.entries = 32, .associativity = 32, .pages = CPUINFO_PAGE_SIZE_4KB | CPUINFO_PAGE_SIZE_1MB}},
+				.dtlb = {{.entries = 32, .associativity = 32, .pages = CPUINFO_PAGE_SIZE_4KB | CPUINFO_PAGE_SIZE_1MB}},
+				.stlb = {{.entries = 1024, .associativity = 4, .pages = LPAE_PAGES}},
+			};
+			return &tlbs;
+		}
+		case cpuinfo_uarch_cortex_a35: {
+			/*
+			 * ARM Cortex‑A35 Processor Technical Reference Manual:
+			 * A6.2 TLB Organization
+			 *   Micro TLB
+			 *     The first level of caching for the translation table
+			 * information is a micro TLB of ten entries that is implemented
+			 * on each of the instruction and data sides. Main TLB A unified
+			 * main TLB handles misses from the micro TLBs. It has a
+			 * 512-entry, 2-way, set-associative structure and supports all
+			 * VMSAv8 block sizes, except 1GB. If it fetches a 1GB block,
+			 * the TLB splits it into 512MB blocks and stores the
+			 * appropriate block for the lookup.
+			 */
+			static const struct cpuinfo_tlbs tlbs = {
+				.itlb = {{.entries = 10, .associativity = 10, .pages = MICRO_TLB_PAGES}},
+				.dtlb = {{.entries = 10, .associativity = 10, .pages = MICRO_TLB_PAGES}},
+				.stlb = {{.entries = 512, .associativity = 2, .pages = ARMV8_PAGES & ~CPUINFO_PAGE_SIZE_1GB}},
+			};
+			return &tlbs;
+		}
+		case cpuinfo_uarch_cortex_a53: {
+			/*
+			 * ARM Cortex-A53 MPCore Processor Technical Reference Manual:
+			 * 5.2.1. Micro TLB
+			 *    The first level of caching for the translation table
+			 * information is a micro TLB of ten entries that is implemented
+			 * on each of the instruction and data sides. 5.2.2. Main TLB A
+			 * unified main TLB handles misses from the micro TLBs. This is
+			 * a 512-entry, 4-way, set-associative structure. The main TLB
+			 * supports all VMSAv8 block sizes, except 1GB. If a 1GB block
+			 * is fetched, it is split into 512MB blocks and the appropriate
+			 * block for the lookup stored.
+			 */
+			static const struct cpuinfo_tlbs tlbs = {
+				.itlb = {{.entries = 10, .associativity = 10, .pages = MICRO_TLB_PAGES}},
+				.dtlb = {{.entries = 10, .associativity = 10, .pages = MICRO_TLB_PAGES}},
+				.stlb = {{.entries = 512, .associativity = 4, .pages = ARMV8_PAGES & ~CPUINFO_PAGE_SIZE_1GB}},
+			};
+			return &tlbs;
+		}
+		case cpuinfo_uarch_cortex_a57: {
+			/*
+			 * ARM® Cortex-A57 MPCore Processor Technical Reference Manual:
+			 * 5.2.1 L1 instruction TLB
+			 *    The L1 instruction TLB is a 48-entry fully-associative
+			 * structure. This TLB caches entries of three different page
+			 * sizes, natively 4KB, 64KB, and 1MB, of VA to PA mappings. If
+			 * the page tables map the memory region to a larger granularity
+			 * than 1MB, it only allocates one mapping for the particular
+			 * 1MB region to which the current access corresponds. 5.2.2 L1
+			 * data TLB The L1 data TLB is a 32-entry fully-associative TLB
+			 * that is used for data loads and stores. This TLB caches
+			 * entries of three different page sizes, natively 4KB, 64KB,
+			 * and 1MB, of VA to PA mappings. 5.2.3 L2 TLB Misses from the
+			 * L1 instruction and data TLBs are handled by a unified L2 TLB.
+			 * This is a 1024-entry 4-way set-associative structure. The L2
+			 * TLB supports the page sizes of 4K, 64K, 1MB and 16MB. It also
+			 * supports page sizes of 2MB and 1GB for the long descriptor
+			 * format translation in AArch32 state and in AArch64 state when
+			 * using the 4KB translation granule. In addition, the L2 TLB
+			 * supports the 512MB page map size defined for the AArch64
+			 * translations that use a 64KB translation granule.
+			 */
+			static const struct cpuinfo_tlbs tlbs = {
+				.itlb = {{.entries = 48, .associativity = 48, .pages = MICRO_TLB_PAGES}},
+				.dtlb = {{.entries = 32, .associativity = 32, .pages = MICRO_TLB_PAGES}},
+				.stlb = {{.entries = 1024, .associativity = 4, .pages = ARMV8_PAGES}},
+			};
+			return &tlbs;
+		}
+		default:
+			return NULL;
+	}
 }
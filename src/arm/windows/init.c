@@ -87,6 +87,18 @@ BOOL CALLBACK cpuinfo_arm_windows_init(PINIT_ONCE init_once, PVOID parameter, PV
 	return true;
 }
 
+void cpuinfo_arm_windows_deinit(void) {
+	HANDLE heap = GetProcessHeap();
+	HeapFree(heap, 0, cpuinfo_processors);
+	HeapFree(heap, 0, cpuinfo_packages);
+	HeapFree(heap, 0, cpuinfo_clusters);
+	HeapFree(heap, 0, cpuinfo_cores);
+	/* Descriptions of all cache levels share one allocation */
+	HeapFree(heap, 0, cpuinfo_cache[cpuinfo_cache_level_1i]);
+	HeapFree(heap, 0, cpuinfo_uarchs);
+	cpuinfo_clear_tables();
+}
+
 bool get_core_uarch_for_efficiency(
 	enum woa_chip_name chip,
 	BYTE EfficiencyClass,
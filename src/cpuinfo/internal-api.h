@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #if defined(_WIN32) || defined(__CYGWIN__)
@@ -20,6 +21,9 @@ enum cpuinfo_cache_level {
 };
 
 extern CPUINFO_INTERNAL bool cpuinfo_is_initialized;
+/* Set by cpuinfo_initialize_isa: cpuinfo_isa and cpuinfo_isa_uarch are valid even without the topology tables */
+extern CPUINFO_INTERNAL bool cpuinfo_isa_is_initialized;
+extern CPUINFO_INTERNAL struct cpuinfo_uarch_info cpuinfo_isa_uarch;
 
 extern CPUINFO_INTERNAL struct cpuinfo_processor* cpuinfo_processors;
 extern CPUINFO_INTERNAL struct cpuinfo_core* cpuinfo_cores;
@@ -34,17 +38,87 @@ extern CPUINFO_INTERNAL uint32_t cpuinfo_packages_count;
 extern CPUINFO_INTERNAL uint32_t cpuinfo_cache_count[cpuinfo_cache_level_max];
 extern CPUINFO_INTERNAL uint32_t cpuinfo_max_cache_size;
 
-#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 || CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+extern CPUINFO_INTERNAL struct cpuinfo_numa_node* cpuinfo_numa_nodes;
+extern CPUINFO_INTERNAL uint32_t cpuinfo_numa_nodes_count;
+/* Row-major cpuinfo_numa_nodes_count x cpuinfo_numa_nodes_count matrix of node distances */
+extern CPUINFO_INTERNAL const uint8_t* cpuinfo_numa_distances;
+
+/* TLBs of each kind per microarchitecture; unused entries have zero entries */
+#define CPUINFO_MAX_TLBS 4
+
+struct cpuinfo_tlbs {
+	struct cpuinfo_tlb itlb[CPUINFO_MAX_TLBS];
+	struct cpuinfo_tlb dtlb[CPUINFO_MAX_TLBS];
+	struct cpuinfo_tlb stlb[CPUINFO_MAX_TLBS];
+};
+
+/*
+ * Platforms which describe cores of different types with a table of
+ * microarchitectures rather than a single global microarchitecture.
+ */
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64 || CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64 || \
+	((CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64) && defined(__linux__))
+#define CPUINFO_UARCH_TABLE 1
+#else
+#define CPUINFO_UARCH_TABLE 0
+#endif
+
+#if CPUINFO_UARCH_TABLE
 extern CPUINFO_INTERNAL struct cpuinfo_uarch_info* cpuinfo_uarchs;
 extern CPUINFO_INTERNAL uint32_t cpuinfo_uarchs_count;
+/* TLBs parallel to cpuinfo_uarchs, or NULL if TLBs are not detected at runtime */
+extern CPUINFO_INTERNAL struct cpuinfo_tlbs* cpuinfo_tlbs;
 #else
 extern CPUINFO_INTERNAL struct cpuinfo_uarch_info cpuinfo_global_uarch;
+extern CPUINFO_INTERNAL struct cpuinfo_tlbs cpuinfo_global_tlbs;
 #endif
 
 #ifdef __linux__
 extern CPUINFO_INTERNAL uint32_t cpuinfo_linux_cpu_max;
 extern CPUINFO_INTERNAL const struct cpuinfo_processor** cpuinfo_linux_cpu_to_processor_map;
 extern CPUINFO_INTERNAL const struct cpuinfo_core** cpuinfo_linux_cpu_to_core_map;
+#if CPUINFO_UARCH_TABLE
+extern CPUINFO_INTERNAL const uint32_t* cpuinfo_linux_cpu_to_uarch_index_map;
+#endif
+
+/*
+ * Whether platform initialization detects only the processors allowed for the
+ * calling thread (see cpuinfo_initialize_restricted). Processors left out have
+ * NULL entries in the Linux CPU maps.
+ */
+extern CPUINFO_INTERNAL bool cpuinfo_linux_restricted_detection;
+/*
+ * Replaces the tables of restricted initialization with a detection of all
+ * processors. Returns false if detection was not restricted, or failed.
+ */
+CPUINFO_PRIVATE bool cpuinfo_linux_complete_detection(void);
+
+/*
+ * Brackets the commit of new tables. Tables committed earlier are retired rather
+ * than freed, and readers retry until the update is complete.
+ */
+CPUINFO_PRIVATE void cpuinfo_begin_tables_update(void);
+CPUINFO_PRIVATE void cpuinfo_end_tables_update(void);
+
+/*
+ * Alignment of every table in the arena: the 128-byte cache lines of Apple M-series
+ * and some ARM server processors, which is also a multiple of the 64-byte lines of others
+ */
+#define CPUINFO_TABLES_ARENA_ALIGNMENT 128
+
+/*
+ * Single allocation which backs all tables of the current initialization, or
+ * NULL if the tables were allocated separately. It is released with one free call.
+ */
+extern CPUINFO_INTERNAL void* cpuinfo_tables_arena;
+
+/*
+ * Appends a table of count elements to the arena layout described by the size
+ * at arena_size, and returns the cache-line-aligned offset of the table.
+ */
+CPUINFO_PRIVATE size_t cpuinfo_tables_arena_reserve(size_t* arena_size, size_t count, size_t element_size);
+/* Allocates a zero-initialized, cache-line-aligned arena of the layout size */
+CPUINFO_PRIVATE void* cpuinfo_allocate_tables_arena(size_t arena_size);
 #endif
 
 CPUINFO_PRIVATE void cpuinfo_x86_mach_init(void);
@@ -53,8 +127,10 @@ CPUINFO_PRIVATE void cpuinfo_x86_freebsd_init(void);
 #if defined(_WIN32) || defined(__CYGWIN__)
 #if CPUINFO_ARCH_ARM64
 CPUINFO_PRIVATE BOOL CALLBACK cpuinfo_arm_windows_init(PINIT_ONCE init_once, PVOID parameter, PVOID* context);
+CPUINFO_PRIVATE void cpuinfo_arm_windows_deinit(void);
 #else
 CPUINFO_PRIVATE BOOL CALLBACK cpuinfo_x86_windows_init(PINIT_ONCE init_once, PVOID parameter, PVOID* context);
+CPUINFO_PRIVATE void cpuinfo_x86_windows_deinit(void);
 #endif
 #endif
 CPUINFO_PRIVATE void cpuinfo_arm_mach_init(void);
@@ -62,6 +138,16 @@ CPUINFO_PRIVATE void cpuinfo_arm_linux_init(void);
 CPUINFO_PRIVATE void cpuinfo_riscv_linux_init(void);
 CPUINFO_PRIVATE void cpuinfo_emscripten_init(void);
 
+/* Detect only cpuinfo_isa and cpuinfo_isa_uarch, without opening any files */
+CPUINFO_PRIVATE void cpuinfo_x86_init_isa(void);
+CPUINFO_PRIVATE void cpuinfo_arm_linux_init_isa(void);
+CPUINFO_PRIVATE void cpuinfo_riscv_linux_init_isa(void);
+
+/* Resets the tables to their state before initialization without releasing memory */
+CPUINFO_PRIVATE void cpuinfo_clear_tables(void);
+/* Releases the tables allocated with malloc/calloc and resets them */
+CPUINFO_PRIVATE void cpuinfo_free_tables(void);
+
 CPUINFO_PRIVATE uint32_t cpuinfo_compute_max_cache_size(const struct cpuinfo_processor* processor);
 
 typedef void (*cpuinfo_processor_callback)(uint32_t);
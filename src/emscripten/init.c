@@ -12,16 +12,6 @@
 
 static const volatile float infinity = INFINITY;
 
-static struct cpuinfo_package static_package = {};
-
-static struct cpuinfo_cache static_x86_l3 = {
-	.size = 2 * 1024 * 1024,
-	.associativity = 16,
-	.sets = 2048,
-	.partitions = 1,
-	.line_size = 64,
-};
-
 void cpuinfo_emscripten_init(void) {
 	struct cpuinfo_processor* processors = NULL;
 	struct cpuinfo_core* cores = NULL;
@@ -29,6 +19,8 @@ void cpuinfo_emscripten_init(void) {
 	struct cpuinfo_cache* l1i = NULL;
 	struct cpuinfo_cache* l1d = NULL;
 	struct cpuinfo_cache* l2 = NULL;
+	struct cpuinfo_cache* l3 = NULL;
+	struct cpuinfo_package* package = NULL;
 
 	const bool is_x86 = signbit(infinity - infinity);
 
@@ -109,13 +101,33 @@ void cpuinfo_emscripten_init(void) {
 		goto cleanup;
 	}
 
-	static_package.processor_count = processor_count;
-	static_package.core_count = core_count;
-	static_package.cluster_count = cluster_count;
 	if (is_x86) {
-		strncpy(static_package.name, "x86 vCPU", CPUINFO_PACKAGE_NAME_MAX);
+		l3 = calloc(1, sizeof(struct cpuinfo_cache));
+		if (l3 == NULL) {
+			cpuinfo_log_error("failed to allocate %zu bytes for description of L3 cache", sizeof(struct cpuinfo_cache));
+			goto cleanup;
+		}
+		*l3 = (struct cpuinfo_cache){
+			.size = 2 * 1024 * 1024,
+			.associativity = 16,
+			.sets = 2048,
+			.partitions = 1,
+			.line_size = 64,
+		};
+	}
+
+	package = calloc(1, sizeof(struct cpuinfo_package));
+	if (package == NULL) {
+		cpuinfo_log_error("failed to allocate %zu bytes for description of a package", sizeof(struct cpuinfo_package));
+		goto cleanup;
+	}
+	package->processor_count = processor_count;
+	package->core_count = core_count;
+	package->cluster_count = cluster_count;
+	if (is_x86) {
+		strncpy(package->name, "x86 vCPU", CPUINFO_PACKAGE_NAME_MAX);
 	} else {
-		strncpy(static_package.name, "ARM vCPU", CPUINFO_PACKAGE_NAME_MAX);
+		strncpy(package->name, "ARM vCPU", CPUINFO_PACKAGE_NAME_MAX);
 	}
 
 	for (uint32_t i = 0; i < core_count; i++) {
@@ -124,11 +136,11 @@ void cpuinfo_emscripten_init(void) {
 				.smt_id = j,
 				.core = cores + i,
 				.cluster = clusters + (uint32_t)(i >= big_cluster_core_count),
-				.package = &static_package,
+				.package = package,
 				.cache.l1i = l1i + i,
 				.cache.l1d = l1d + i,
 				.cache.l2 = is_x86 ? l2 + i : l2 + (uint32_t)(i >= big_cluster_core_count),
-				.cache.l3 = is_x86 ? &static_x86_l3 : NULL,
+				.cache.l3 = l3,
 			};
 		}
 
@@ -137,7 +149,7 @@ void cpuinfo_emscripten_init(void) {
 			.processor_count = processors_per_core,
 			.core_id = i,
 			.cluster = clusters + (uint32_t)(i >= big_cluster_core_count),
-			.package = &static_package,
+			.package = package,
 			.vendor = cpuinfo_vendor_unknown,
 			.uarch = cpuinfo_uarch_unknown,
 			.frequency = 0,
@@ -183,13 +195,13 @@ void cpuinfo_emscripten_init(void) {
 			.core_start = 0,
 			.core_count = core_count,
 			.cluster_id = 0,
-			.package = &static_package,
+			.package = package,
 			.vendor = cpuinfo_vendor_unknown,
 			.uarch = cpuinfo_uarch_unknown,
 			.frequency = 0,
 		};
 
-		static_x86_l3.processor_count = processor_count;
+		l3->processor_count = processor_count;
 	} else {
 		clusters[0] = (struct cpuinfo_cluster){
 			.processor_start = 0,
@@ -197,7 +209,7 @@ void cpuinfo_emscripten_init(void) {
 			.core_start = 0,
 			.core_count = big_cluster_core_count,
 			.cluster_id = 0,
-			.package = &static_package,
+			.package = package,
 			.vendor = cpuinfo_vendor_unknown,
 			.uarch = cpuinfo_uarch_unknown,
 			.frequency = 0,
@@ -230,7 +242,7 @@ void cpuinfo_emscripten_init(void) {
 				.core_start = big_cluster_core_count,
 				.core_count = processor_count - big_cluster_core_count,
 				.cluster_id = 1,
-				.package = &static_package,
+				.package = package,
 				.vendor = cpuinfo_vendor_unknown,
 				.uarch = cpuinfo_uarch_unknown,
 				.frequency = 0,
@@ -243,13 +255,13 @@ void cpuinfo_emscripten_init(void) {
 	cpuinfo_cache[cpuinfo_cache_level_1d] = l1d;
 	cpuinfo_cache[cpuinfo_cache_level_2] = l2;
 	if (is_x86) {
-		cpuinfo_cache[cpuinfo_cache_level_3] = &static_x86_l3;
+		cpuinfo_cache[cpuinfo_cache_level_3] = l3;
 	}
 
 	cpuinfo_processors = processors;
 	cpuinfo_cores = cores;
 	cpuinfo_clusters = clusters;
-	cpuinfo_packages = &static_package;
+	cpuinfo_packages = package;
 
 	cpuinfo_cache_count[cpuinfo_cache_level_1i] = processor_count;
 	cpuinfo_cache_count[cpuinfo_cache_level_1d] = processor_count;
@@ -276,7 +288,8 @@ void cpuinfo_emscripten_init(void) {
 	processors = NULL;
 	cores = NULL;
 	clusters = NULL;
-	l1i = l1d = l2 = NULL;
+	l1i = l1d = l2 = l3 = NULL;
+	package = NULL;
 
 cleanup:
 	free(processors);
@@ -285,4 +298,6 @@ cleanup:
 	free(l1i);
 	free(l1d);
 	free(l2);
+	free(l3);
+	free(package);
 }
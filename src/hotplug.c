@@ -0,0 +1,204 @@
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include <cpuinfo.h>
+#include <cpuinfo/log.h>
+#if defined(__linux__)
+#include <linux/api.h>
+#endif
+
+#define MASK_WORD_BITS (sizeof(unsigned long) * CHAR_BIT)
+
+#define ONLINE_CPULIST_FILENAME "/sys/devices/system/cpu/online"
+
+/* Kernel uevents are limited to 2 KB (UEVENT_BUFFER_SIZE) */
+#define UEVENT_BUFFER_SIZE 4096
+
+struct cpuinfo_hotplug_listener {
+	cpuinfo_hotplug_callback callback;
+	void* context;
+};
+
+struct cpuinfo_hotplug_monitor {
+	int fd;
+	/* Logical processors online after the last dispatched event */
+	struct cpuinfo_affinity_mask online;
+	struct cpuinfo_hotplug_listener* listeners;
+	uint32_t listeners_count;
+};
+
+#if defined(__linux__)
+static bool online_parser(uint32_t processor_list_start, uint32_t processor_list_end, void* context) {
+	struct cpuinfo_affinity_mask* online = (struct cpuinfo_affinity_mask*)context;
+	for (uint32_t processor = processor_list_start; processor < processor_list_end; processor++) {
+		if (!cpuinfo_affinity_mask_add_processor_id(online, processor)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool read_online_processors(struct cpuinfo_affinity_mask online[restrict static 1]) {
+	cpuinfo_affinity_mask_clear(online);
+	if (!cpuinfo_linux_parse_cpulist(ONLINE_CPULIST_FILENAME, online_parser, online)) {
+		cpuinfo_log_warning("failed to parse the list of online processors in %s", ONLINE_CPULIST_FILENAME);
+		return false;
+	}
+	return true;
+}
+
+static bool copy_mask(
+	const struct cpuinfo_affinity_mask source[restrict static 1],
+	uint32_t capacity,
+	struct cpuinfo_affinity_mask copy[restrict static 1]) {
+	if (!cpuinfo_affinity_mask_init(copy, capacity > source->capacity ? capacity : source->capacity)) {
+		return false;
+	}
+	if (source->capacity != 0) {
+		memcpy(copy->bits, source->bits, source->capacity / CHAR_BIT);
+	}
+	return true;
+}
+
+static bool masks_equal(const struct cpuinfo_affinity_mask* a, const struct cpuinfo_affinity_mask* b) {
+	const uint32_t capacity = a->capacity > b->capacity ? a->capacity : b->capacity;
+	for (uint32_t word = 0; word < capacity / MASK_WORD_BITS; word++) {
+		const unsigned long a_word = word < a->capacity / MASK_WORD_BITS ? a->bits[word] : 0;
+		const unsigned long b_word = word < b->capacity / MASK_WORD_BITS ? b->bits[word] : 0;
+		if (a_word != b_word) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* Notifies the listeners, and replaces the online processors with the new mask */
+static void commit_change(
+	struct cpuinfo_hotplug_monitor monitor[restrict static 1],
+	struct cpuinfo_affinity_mask new_online[restrict static 1]) {
+	for (uint32_t i = 0; i < monitor->listeners_count; i++) {
+		monitor->listeners[i].callback(&monitor->online, new_online, monitor->listeners[i].context);
+	}
+	cpuinfo_affinity_mask_free(&monitor->online);
+	monitor->online = *new_online;
+	*new_online = (struct cpuinfo_affinity_mask){0};
+}
+#endif /* defined(__linux__) */
+
+struct cpuinfo_hotplug_monitor* CPUINFO_ABI cpuinfo_hotplug_monitor_create(void) {
+#if defined(__linux__)
+	struct cpuinfo_hotplug_monitor* monitor = calloc(1, sizeof(struct cpuinfo_hotplug_monitor));
+	if (monitor == NULL) {
+		cpuinfo_log_error(
+			"failed to allocate %zu bytes for hotplug monitor", sizeof(struct cpuinfo_hotplug_monitor));
+		return NULL;
+	}
+
+	/* Subscribe before reading the online processors, so that no change is missed in between */
+	monitor->fd = cpuinfo_linux_open_uevent_socket();
+	if (monitor->fd == -1 || !read_online_processors(&monitor->online)) {
+		cpuinfo_hotplug_monitor_destroy(monitor);
+		return NULL;
+	}
+	return monitor;
+#else
+	return NULL;
+#endif
+}
+
+void CPUINFO_ABI cpuinfo_hotplug_monitor_destroy(struct cpuinfo_hotplug_monitor* monitor) {
+	if (monitor == NULL) {
+		return;
+	}
+#if defined(__linux__)
+	if (monitor->fd != -1) {
+		close(monitor->fd);
+	}
+#endif
+	cpuinfo_affinity_mask_free(&monitor->online);
+	free(monitor->listeners);
+	free(monitor);
+}
+
+bool CPUINFO_ABI cpuinfo_hotplug_monitor_add_callback(
+	struct cpuinfo_hotplug_monitor* monitor,
+	cpuinfo_hotplug_callback callback,
+	void* context) {
+	struct cpuinfo_hotplug_listener* listeners = realloc(
+		monitor->listeners, (monitor->listeners_count + 1) * sizeof(struct cpuinfo_hotplug_listener));
+	if (listeners == NULL) {
+		cpuinfo_log_error("failed to allocate %" PRIu32 " hotplug callbacks", monitor->listeners_count + 1);
+		return false;
+	}
+	listeners[monitor->listeners_count++] = (struct cpuinfo_hotplug_listener){
+		.callback = callback,
+		.context = context,
+	};
+	monitor->listeners = listeners;
+	return true;
+}
+
+int CPUINFO_ABI cpuinfo_hotplug_monitor_get_fd(const struct cpuinfo_hotplug_monitor* monitor) {
+	return monitor->fd;
+}
+
+const struct cpuinfo_affinity_mask* CPUINFO_ABI cpuinfo_hotplug_monitor_get_online(
+	const struct cpuinfo_hotplug_monitor* monitor) {
+	return &monitor->online;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_hotplug_monitor_dispatch(struct cpuinfo_hotplug_monitor* monitor) {
+	uint32_t changes_count = 0;
+#if defined(__linux__)
+	char buffer[UEVENT_BUFFER_SIZE];
+	size_t length;
+	struct cpuinfo_affinity_mask new_online = {0};
+	for (;;) {
+		if (!cpuinfo_linux_receive_uevent(monitor->fd, sizeof(buffer), buffer, &length)) {
+			if (errno != ENOBUFS) {
+				break;
+			}
+			/* The socket overflowed and events were lost: resynchronize with the kernel */
+			cpuinfo_log_info(
+				"uevents were dropped; reading the online processors from %s", ONLINE_CPULIST_FILENAME);
+			if (read_online_processors(&new_online) && !masks_equal(&monitor->online, &new_online)) {
+				commit_change(monitor, &new_online);
+				changes_count += 1;
+			}
+			cpuinfo_affinity_mask_free(&new_online);
+			continue;
+		}
+
+		uint32_t processor;
+		bool online;
+		if (!cpuinfo_linux_parse_cpu_uevent(buffer, length, &processor, &online) ||
+		    cpuinfo_affinity_mask_has_processor_id(&monitor->online, processor) == online) {
+			/* Events queued before a resynchronization may already be reflected in the online processors */
+			continue;
+		}
+		if (!copy_mask(&monitor->online, processor + 1, &new_online)) {
+			cpuinfo_log_error("failed to allocate mask for logical processor %" PRIu32, processor);
+			break;
+		}
+		const unsigned long bit = 1UL << (processor % MASK_WORD_BITS);
+		if (online) {
+			new_online.bits[processor / MASK_WORD_BITS] |= bit;
+		} else {
+			new_online.bits[processor / MASK_WORD_BITS] &= ~bit;
+		}
+		commit_change(monitor, &new_online);
+		changes_count += 1;
+	}
+#endif
+	return changes_count;
+}
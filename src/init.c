@@ -7,61 +7,351 @@
 #include <cpuinfo.h>
 #include <cpuinfo/internal-api.h>
 #include <cpuinfo/log.h>
+#ifdef __linux__
+#include <linux/api.h>
+#endif
 
 #ifdef __APPLE__
 #include "TargetConditionals.h"
 #endif
 
 #if defined(_WIN32) || defined(__CYGWIN__)
-static INIT_ONCE init_guard = INIT_ONCE_STATIC_INIT;
+static SRWLOCK init_lock = SRWLOCK_INIT;
 #elif !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
-static pthread_once_t init_guard = PTHREAD_ONCE_INIT;
+static pthread_mutex_t init_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+static INIT_ONCE isa_init_guard = INIT_ONCE_STATIC_INIT;
+#elif !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+static pthread_once_t isa_init_guard = PTHREAD_ONCE_INIT;
 #else
-static bool init_guard = false;
+static bool isa_init_guard = false;
 #endif
 
-bool CPUINFO_ABI cpuinfo_initialize(void) {
+/* Platforms whose initialization can detect only the processors allowed for the calling thread */
+#if (CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64) && defined(__linux__)
+#define RESTRICTED_DETECTION 1
+#else
+#define RESTRICTED_DETECTION 0
+#endif
+
+/*
+ * Number of successful cpuinfo_initialize calls not yet matched by cpuinfo_deinitialize. It only changes from or to
+ * zero with the init lock held, so a non-zero count can be incremented without the lock.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+static volatile LONG64 init_count = 0;
+#else
+static uint64_t init_count = 0;
+#endif
+/* Whether platform-specific initialization was attempted since the last teardown */
+static bool init_attempted = false;
+
+static void lock_init_state(void) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+	AcquireSRWLockExclusive(&init_lock);
+#elif !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+	pthread_mutex_lock(&init_lock);
+#endif
+}
+
+static void unlock_init_state(void) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+	ReleaseSRWLockExclusive(&init_lock);
+#elif !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+	pthread_mutex_unlock(&init_lock);
+#endif
+}
+
+static uint64_t load_init_count(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	return (uint64_t)InterlockedCompareExchange64(&init_count, 0, 0);
+#else
+	return __atomic_load_n(&init_count, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/* Must be called with the init lock held */
+static void add_init_reference(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	InterlockedIncrement64(&init_count);
+#else
+	__atomic_add_fetch(&init_count, 1, __ATOMIC_RELEASE);
+#endif
+}
+
+/* Must be called with the init lock held. Returns the number of remaining references. */
+static uint64_t release_init_reference(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	return (uint64_t)InterlockedDecrement64(&init_count);
+#else
+	return __atomic_sub_fetch(&init_count, 1, __ATOMIC_ACQ_REL);
+#endif
+}
+
+/* Adds a reference without the init lock if cpuinfo is already initialized */
+static bool try_add_init_reference(void) {
+	uint64_t count = load_init_count();
+	while (count != 0) {
+#if defined(_MSC_VER) && !defined(__clang__)
+		const uint64_t previous_count =
+			(uint64_t)InterlockedCompareExchange64(&init_count, (LONG64)(count + 1), (LONG64)count);
+		if (previous_count == count) {
+			return true;
+		}
+		count = previous_count;
+#else
+		if (__atomic_compare_exchange_n(&init_count, &count, count + 1, true, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+			return true;
+		}
+#endif
+	}
+	return false;
+}
+
+static void init_platform(void) {
+#ifdef __linux__
+	const uint32_t file_syscalls = __atomic_load_n(&cpuinfo_linux_file_syscalls, __ATOMIC_RELAXED);
+#endif
 #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
 #if defined(__MACH__) && defined(__APPLE__)
-	pthread_once(&init_guard, &cpuinfo_x86_mach_init);
+	cpuinfo_x86_mach_init();
 #elif defined(__FreeBSD__)
-	pthread_once(&init_guard, &cpuinfo_x86_freebsd_init);
+	cpuinfo_x86_freebsd_init();
 #elif defined(__linux__)
-	pthread_once(&init_guard, &cpuinfo_x86_linux_init);
+	cpuinfo_x86_linux_init();
 #elif defined(_WIN32) || defined(__CYGWIN__)
-	InitOnceExecuteOnce(&init_guard, &cpuinfo_x86_windows_init, NULL, NULL);
+	cpuinfo_x86_windows_init(NULL, NULL, NULL);
 #else
 	cpuinfo_log_error("operating system is not supported in cpuinfo");
 #endif
 #elif CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
 #if defined(__linux__)
-	pthread_once(&init_guard, &cpuinfo_arm_linux_init);
+	cpuinfo_arm_linux_init();
 #elif defined(__MACH__) && defined(__APPLE__)
-	pthread_once(&init_guard, &cpuinfo_arm_mach_init);
+	cpuinfo_arm_mach_init();
 #elif defined(_WIN32)
-	InitOnceExecuteOnce(&init_guard, &cpuinfo_arm_windows_init, NULL, NULL);
+	cpuinfo_arm_windows_init(NULL, NULL, NULL);
 #else
 	cpuinfo_log_error("operating system is not supported in cpuinfo");
 #endif
 #elif CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
 #if defined(__linux__)
-	pthread_once(&init_guard, &cpuinfo_riscv_linux_init);
+	cpuinfo_riscv_linux_init();
 #else
 	cpuinfo_log_error("operating system is not supported in cpuinfo");
 #endif
 #elif CPUINFO_ARCH_ASMJS || CPUINFO_ARCH_WASM || CPUINFO_ARCH_WASMSIMD
-#if defined(__EMSCRIPTEN_PTHREADS__)
-	pthread_once(&init_guard, &cpuinfo_emscripten_init);
+	cpuinfo_emscripten_init();
 #else
-	if (!init_guard) {
-		cpuinfo_emscripten_init();
+	cpuinfo_log_error("processor architecture is not supported in cpuinfo");
+#endif
+#ifdef __linux__
+	/* Per-processor sysfs files are not read again until the next refresh */
+	cpuinfo_linux_close_processor_files();
+	cpuinfo_log_debug(
+		"detection used %" PRIu32 " file system calls",
+		__atomic_load_n(&cpuinfo_linux_file_syscalls, __ATOMIC_RELAXED) - file_syscalls);
+#endif
+}
+
+static void deinit_platform(void) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+#if CPUINFO_ARCH_ARM64
+	cpuinfo_arm_windows_deinit();
+#else
+	cpuinfo_x86_windows_deinit();
+#endif
+#else
+	cpuinfo_free_tables();
+#endif
+}
+
+#ifdef __linux__
+/* Must be called with the init lock held */
+static bool complete_detection(void) {
+	if (!cpuinfo_linux_restricted_detection) {
+		return false;
 	}
-	init_guard = true;
+	/* Detection of all processors is attempted once, even if it fails */
+	__atomic_store_n(&cpuinfo_linux_restricted_detection, false, __ATOMIC_RELEASE);
+	const uint32_t generation = cpuinfo_get_generation();
+	init_platform();
+	return cpuinfo_get_generation() != generation;
+}
+
+bool cpuinfo_linux_complete_detection(void) {
+	/* Lookups of processors outside the tables stay lock-free after full initialization */
+	if (!__atomic_load_n(&cpuinfo_linux_restricted_detection, __ATOMIC_ACQUIRE)) {
+		return false;
+	}
+	lock_init_state();
+	const bool completed = load_init_count() != 0 && complete_detection();
+	unlock_init_state();
+	return completed;
+}
 #endif
+
+static bool initialize(const char* snapshot_path, bool restricted) {
+#ifdef __linux__
+	/* Full initialization after restricted initialization needs the lock to detect the remaining processors */
+	const bool complete = restricted || !__atomic_load_n(&cpuinfo_linux_restricted_detection, __ATOMIC_ACQUIRE);
 #else
-	cpuinfo_log_error("processor architecture is not supported in cpuinfo");
+	const bool complete = true;
+#endif
+	if (complete && try_add_init_reference()) {
+		return true;
+	}
+
+	lock_init_state();
+	if (!init_attempted) {
+		/* Failed initialization is not retried until the next teardown */
+		init_attempted = true;
+#ifdef __linux__
+		cpuinfo_linux_restricted_detection = restricted && RESTRICTED_DETECTION;
+		if (snapshot_path == NULL || !cpuinfo_linux_load_snapshot(snapshot_path)) {
+			init_platform();
+			if (snapshot_path != NULL && cpuinfo_is_initialized) {
+				/* Replace the missing or stale snapshot for the next process */
+				cpuinfo_linux_save_snapshot(snapshot_path);
+			}
+		}
+#else
+		init_platform();
+#endif
+#ifdef __linux__
+	} else if (!restricted) {
+		/* Full initialization after restricted initialization describes all processors */
+		complete_detection();
+#endif
+	}
+	const bool is_initialized = cpuinfo_is_initialized;
+	if (is_initialized) {
+		add_init_reference();
+	}
+	unlock_init_state();
+	return is_initialized;
+}
+
+static void init_isa(void) {
+	lock_init_state();
+	if (cpuinfo_is_initialized) {
+		/* Full initialization already detected the ISA, with more information at hand */
+		cpuinfo_isa_uarch = *cpuinfo_get_uarch(0);
+	} else {
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+		cpuinfo_x86_init_isa();
+#elif (CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64) && defined(__linux__)
+		cpuinfo_arm_linux_init_isa();
+#elif (CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64) && defined(__linux__)
+		cpuinfo_riscv_linux_init_isa();
+#else
+		/* No lightweight detection path: keep a permanent reference on the full initialization */
+		if (!init_attempted) {
+			init_attempted = true;
+			init_platform();
+		}
+		if (!cpuinfo_is_initialized) {
+			unlock_init_state();
+			return;
+		}
+		add_init_reference();
+		cpuinfo_isa_uarch = *cpuinfo_get_uarch(0);
 #endif
-	return cpuinfo_is_initialized;
+	}
+	__sync_synchronize();
+	cpuinfo_isa_is_initialized = true;
+	unlock_init_state();
 }
 
-void CPUINFO_ABI cpuinfo_deinitialize(void) {}
+#if defined(_WIN32) || defined(__CYGWIN__)
+static BOOL CALLBACK init_isa_once(PINIT_ONCE init_once, PVOID parameter, PVOID* context) {
+	init_isa();
+	return TRUE;
+}
+#endif
+
+bool CPUINFO_ABI cpuinfo_initialize_isa(void) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+	InitOnceExecuteOnce(&isa_init_guard, init_isa_once, NULL, NULL);
+#elif !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+	pthread_once(&isa_init_guard, init_isa);
+#else
+	if (!isa_init_guard) {
+		isa_init_guard = true;
+		init_isa();
+	}
+#endif
+	return cpuinfo_isa_is_initialized;
+}
+
+bool CPUINFO_ABI cpuinfo_initialize(void) {
+	return initialize(NULL, false);
+}
+
+bool CPUINFO_ABI cpuinfo_initialize_restricted(void) {
+	return initialize(NULL, true);
+}
+
+bool CPUINFO_ABI cpuinfo_initialize_from_snapshot(const char* path) {
+	return initialize(path, false);
+}
+
+bool CPUINFO_ABI cpuinfo_save_snapshot(const char* path) {
+#ifdef __linux__
+	bool saved = false;
+	lock_init_state();
+	if (load_init_count() == 0) {
+		cpuinfo_log_error("cpuinfo_save_snapshot called before cpuinfo is initialized");
+	} else if (cpuinfo_linux_restricted_detection) {
+		cpuinfo_log_error("cpuinfo_save_snapshot called after restricted initialization, which omits processors");
+	} else {
+		saved = cpuinfo_linux_save_snapshot(path);
+	}
+	unlock_init_state();
+	return saved;
+#else
+	return false;
+#endif
+}
+
+bool CPUINFO_ABI cpuinfo_refresh(void) {
+#ifdef __linux__
+	bool refreshed = false;
+	lock_init_state();
+	if (load_init_count() != 0) {
+		const uint32_t generation = cpuinfo_get_generation();
+		init_platform();
+		refreshed = cpuinfo_get_generation() != generation;
+	} else {
+		cpuinfo_log_error("cpuinfo_refresh called before cpuinfo is initialized");
+	}
+	unlock_init_state();
+	return refreshed;
+#else
+	return false;
+#endif
+}
+
+void CPUINFO_ABI cpuinfo_deinitialize(void) {
+	lock_init_state();
+	if (load_init_count() != 0) {
+		if (release_init_reference() == 0) {
+			/*
+			 * The last reference is gone: every caller which got
+			 * pointers into the tables promised not to use them
+			 * anymore, so it is safe to release the memory.
+			 */
+			cpuinfo_is_initialized = false;
+			deinit_platform();
+		}
+	}
+	if (load_init_count() == 0) {
+		init_attempted = false;
+#ifdef __linux__
+		cpuinfo_linux_restricted_detection = false;
+#endif
+	}
+	unlock_init_state();
+}
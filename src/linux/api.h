@@ -6,6 +6,10 @@
 
 #include <cpuinfo.h>
 #include <cpuinfo/common.h>
+#include <linux/cgroup.h>
+#include <linux/cpulist.h>
+#include <linux/processors.h>
+#include <linux/sysfs.h>
 
 #define CPUINFO_LINUX_FLAG_PRESENT UINT32_C(0x00000001)
 #define CPUINFO_LINUX_FLAG_POSSIBLE UINT32_C(0x00000002)
@@ -22,12 +26,8 @@
 #define CPUINFO_LINUX_FLAG_VALID UINT32_C(0x00001000)
 #define CPUINFO_LINUX_FLAG_CUR_FREQUENCY UINT32_C(0x00002000)
 #define CPUINFO_LINUX_FLAG_CLUSTER_CLUSTER UINT32_C(0x00004000)
+#define CPUINFO_LINUX_FLAG_ALLOWED UINT32_C(0x00008000)
 
-typedef bool (*cpuinfo_cpulist_callback)(uint32_t, uint32_t, void*);
-CPUINFO_INTERNAL bool cpuinfo_linux_parse_cpulist(
-	const char* filename,
-	cpuinfo_cpulist_callback callback,
-	void* context);
 typedef bool (*cpuinfo_smallfile_callback)(const char*, const char*, const char*, void*);
 CPUINFO_INTERNAL bool cpuinfo_linux_parse_small_file(
 	const char* filename,
@@ -41,54 +41,176 @@ CPUINFO_INTERNAL bool cpuinfo_linux_parse_multiline_file(
 	cpuinfo_line_callback,
 	void* context);
 
+typedef bool (*cpuinfo_directory_callback)(const char*, void*);
+/* Calls the callback with the name of each entry in the directory, except "." and ".." */
+CPUINFO_INTERNAL bool cpuinfo_linux_list_directory(
+	const char* path,
+	cpuinfo_directory_callback callback,
+	void* context);
+
+/* Maximum length of a path relative to /sys/devices/system/cpu, including the terminating null */
+#define CPUINFO_LINUX_PROCESSOR_PATH_MAX 64
+
+/*
+ * Opens the attribute file (e.g. "topology/core_id") of a processor relative
+ * to a cached descriptor of /sys/devices/system/cpu, and stores the relative
+ * path for diagnostics. Returns -1 on failure.
+ */
+CPUINFO_INTERNAL int cpuinfo_linux_open_processor_file(
+	uint32_t processor,
+	const char* attribute,
+	char path[restrict static CPUINFO_LINUX_PROCESSOR_PATH_MAX]);
+/* Closes the cached descriptor of /sys/devices/system/cpu */
+CPUINFO_INTERNAL void cpuinfo_linux_close_processor_files(void);
+CPUINFO_INTERNAL bool cpuinfo_linux_parse_processor_small_file(
+	uint32_t processor,
+	const char* attribute,
+	size_t buffer_size,
+	cpuinfo_smallfile_callback callback,
+	void* context);
+CPUINFO_INTERNAL bool cpuinfo_linux_parse_processor_cpulist(
+	uint32_t processor,
+	const char* attribute,
+	cpuinfo_cpulist_callback callback,
+	void* context);
+
 CPUINFO_INTERNAL uint32_t cpuinfo_linux_get_max_processors_count(void);
 CPUINFO_INTERNAL uint32_t cpuinfo_linux_get_max_possible_processor(uint32_t max_processors_count);
 CPUINFO_INTERNAL uint32_t cpuinfo_linux_get_max_present_processor(uint32_t max_processors_count);
 CPUINFO_INTERNAL uint32_t cpuinfo_linux_get_processor_cur_frequency(uint32_t processor);
 CPUINFO_INTERNAL uint32_t cpuinfo_linux_get_processor_min_frequency(uint32_t processor);
 CPUINFO_INTERNAL uint32_t cpuinfo_linux_get_processor_max_frequency(uint32_t processor);
+CPUINFO_INTERNAL uint32_t cpuinfo_linux_get_processor_base_frequency(uint32_t processor);
+CPUINFO_INTERNAL uint32_t cpuinfo_linux_get_processor_scaling_max_frequency(uint32_t processor);
+CPUINFO_INTERNAL uint32_t cpuinfo_linux_get_processor_capacity(uint32_t processor);
+/*
+ * Reads the preferred-core ranking of amd_pstate, or the highest performance
+ * of amd_pstate or ACPI CPPC, or returns 0 if none is reported. Higher values
+ * rank faster cores.
+ */
+CPUINFO_INTERNAL uint32_t cpuinfo_linux_get_processor_performance_ranking(uint32_t processor);
 CPUINFO_INTERNAL bool cpuinfo_linux_get_processor_package_id(
 	uint32_t processor,
 	uint32_t package_id[restrict static 1]);
 CPUINFO_INTERNAL bool cpuinfo_linux_get_processor_core_id(uint32_t processor, uint32_t core_id[restrict static 1]);
 
-CPUINFO_INTERNAL bool cpuinfo_linux_detect_possible_processors(
+/*
+ * Sets the CPUINFO_PROCESSOR_* flags of processors, indexed by their linux_id in the kernel lists, except
+ * CPUINFO_PROCESSOR_IRQ_AFFINE, which is detected when a selection asks for it
+ */
+CPUINFO_INTERNAL void cpuinfo_linux_detect_processor_flags(
 	uint32_t max_processors_count,
-	uint32_t* processor0_flags,
-	uint32_t processor_struct_size,
-	uint32_t possible_flag);
-CPUINFO_INTERNAL bool cpuinfo_linux_detect_present_processors(
-	uint32_t max_processors_count,
-	uint32_t* processor0_flags,
-	uint32_t processor_struct_size,
-	uint32_t present_flag);
+	uint32_t processors_count,
+	struct cpuinfo_processor processors[restrict static processors_count]);
 
-typedef bool (*cpuinfo_siblings_callback)(uint32_t, uint32_t, uint32_t, void*);
-CPUINFO_INTERNAL bool cpuinfo_linux_detect_core_siblings(
-	uint32_t max_processors_count,
-	uint32_t processor,
-	cpuinfo_siblings_callback callback,
-	void* context);
-CPUINFO_INTERNAL bool cpuinfo_linux_detect_thread_siblings(
-	uint32_t max_processors_count,
-	uint32_t processor,
-	cpuinfo_siblings_callback callback,
-	void* context);
-CPUINFO_INTERNAL bool cpuinfo_linux_detect_cluster_cpus(
-	uint32_t max_processors_count,
-	uint32_t processor,
-	cpuinfo_siblings_callback callback,
+typedef void (*cpuinfo_processor_function)(uint32_t, void*);
+/*
+ * Calls the function for processors 0 to processors_count - 1. If the library
+ * is built with CPUINFO_PARALLEL_INIT and the CPUINFO_PARALLEL_INIT environment
+ * variable sets a number of threads, the calls run concurrently on that many
+ * threads, and the function must only modify the state of its processor.
+ */
+CPUINFO_INTERNAL void cpuinfo_linux_for_each_processor(
+	uint32_t processors_count,
+	cpuinfo_processor_function function,
 	void* context);
-CPUINFO_INTERNAL bool cpuinfo_linux_detect_core_cpus(
-	uint32_t max_processors_count,
+
+/* Cache of a processor as described by /sys/devices/system/cpu/cpu<N>/cache/index<M> */
+struct cpuinfo_linux_cache {
+	/* Size in bytes, or 0 if the kernel does not report the cache */
+	uint32_t size;
+	uint32_t associativity;
+	uint32_t sets;
+	uint32_t line_size;
+	/* CPUINFO_CACHE_UNIFIED for unified caches */
+	uint32_t flags;
+	/* Lowest Linux ID of the online processors which share the cache, and their number */
+	uint32_t processor_start;
+	uint32_t processor_count;
+};
+
+struct cpuinfo_linux_caches {
+	struct cpuinfo_linux_cache l1i;
+	struct cpuinfo_linux_cache l1d;
+	struct cpuinfo_linux_cache l2;
+	struct cpuinfo_linux_cache l3;
+	struct cpuinfo_linux_cache l4;
+};
+
+/* Fills the transparent huge page mode and huge page pools; returns false if the kernel reports neither */
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_memory_pages(struct cpuinfo_memory_pages pages[restrict static 1]);
+
+/*
+ * Reads the caches of a processor from sysfs cacheinfo. Caches which the
+ * kernel does not report are left unchanged, so the caches must be zeroed.
+ * Returns false if the kernel reports no caches for the processor.
+ */
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_processor_caches(
 	uint32_t processor,
-	cpuinfo_siblings_callback callback,
-	void* context);
-CPUINFO_INTERNAL bool cpuinfo_linux_detect_package_cpus(
+	struct cpuinfo_linux_caches caches[restrict static 1]);
+
+/* NUMA nodes read from /sys/devices/system/node, before they are attached to processors */
+struct cpuinfo_linux_numa_nodes {
+	uint32_t nodes_count;
+	uint32_t max_processors_count;
+	/* Linux IDs of the nodes, in increasing order */
+	uint32_t* node_ids;
+	/* Size of memory on each node in bytes, or 0 if unknown */
+	uint64_t* memory_sizes;
+	/* Row-major nodes_count x nodes_count matrix of distances between nodes */
+	uint8_t* distances;
+	/* Index of the node of each Linux processor, or UINT32_MAX if unknown */
+	uint32_t* processor_nodes;
+	/* Scratch space for cpuinfo_linux_build_numa_nodes */
+	uint32_t* first_processors;
+	uint32_t* node_positions;
+};
+
+/*
+ * Reads NUMA nodes, their distances, and the nodes of processors. If the kernel
+ * does not report NUMA nodes, describes a single node with all processors.
+ * Returns false only if memory allocation fails.
+ */
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_numa_nodes(
 	uint32_t max_processors_count,
-	uint32_t processor,
-	cpuinfo_siblings_callback callback,
-	void* context);
+	struct cpuinfo_linux_numa_nodes numa[restrict static 1]);
+/*
+ * Fills the NUMA node table and distance matrix, ordered by the first processor
+ * of each node, and links processors to their nodes.
+ */
+CPUINFO_INTERNAL void cpuinfo_linux_build_numa_nodes(
+	struct cpuinfo_linux_numa_nodes numa[restrict static 1],
+	uint32_t processors_count,
+	struct cpuinfo_processor processors[restrict static processors_count],
+	uint32_t cores_count,
+	const struct cpuinfo_core cores[restrict static cores_count],
+	struct cpuinfo_numa_node* nodes,
+	uint8_t* distances);
+CPUINFO_INTERNAL void cpuinfo_linux_free_numa_nodes(struct cpuinfo_linux_numa_nodes numa[restrict static 1]);
 
 extern CPUINFO_INTERNAL const struct cpuinfo_processor** cpuinfo_linux_cpu_to_processor_map;
 extern CPUINFO_INTERNAL const struct cpuinfo_core** cpuinfo_linux_cpu_to_core_map;
+
+#include <linux/getcpu.h>
+
+CPUINFO_INTERNAL bool cpuinfo_linux_save_snapshot(const char* path);
+CPUINFO_INTERNAL bool cpuinfo_linux_load_snapshot(const char* path);
+
+/* Opens a non-blocking socket which receives the uevents broadcast by the kernel, or returns -1 */
+CPUINFO_INTERNAL int cpuinfo_linux_open_uevent_socket(void);
+/*
+ * Receives one pending uevent without blocking, and null-terminates it. Returns
+ * false if no event is pending or the socket failed, with errno set; ENOBUFS
+ * reports that the kernel dropped events.
+ */
+CPUINFO_INTERNAL bool cpuinfo_linux_receive_uevent(
+	int fd,
+	size_t capacity,
+	char buffer[restrict static capacity],
+	size_t* length);
+/* Checks if the uevent reports a logical processor going online or offline */
+CPUINFO_INTERNAL bool cpuinfo_linux_parse_cpu_uevent(
+	const char* message,
+	size_t length,
+	uint32_t processor[restrict static 1],
+	bool online[restrict static 1]);
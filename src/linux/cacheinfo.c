@@ -0,0 +1,209 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo/log.h>
+#include <linux/api.h>
+
+#define CACHE_ATTRIBUTE_FILESIZE 32
+/* The kernel lists at most a few caches per processor, the limit only guards against a broken sysfs */
+#define MAX_CACHE_INDICES 16
+
+enum cache_type {
+	cache_type_unknown = 0,
+	cache_type_data,
+	cache_type_instruction,
+	cache_type_unified,
+};
+
+static inline bool is_whitespace(char c) {
+	switch (c) {
+		case ' ':
+		case '\t':
+		case '\n':
+		case '\r':
+			return true;
+		default:
+			return false;
+	}
+}
+
+static const char* parse_number(const char* start, const char* end, uint32_t number_ptr[restrict static 1]) {
+	uint32_t number = 0;
+	const char* parsed = start;
+	for (; parsed != end; parsed++) {
+		const uint32_t digit = (uint32_t)(uint8_t)(*parsed) - (uint32_t)'0';
+		if (digit >= 10) {
+			break;
+		}
+		number = number * UINT32_C(10) + digit;
+	}
+	*number_ptr = number;
+	return parsed;
+}
+
+static bool uint32_parser(const char* filename, const char* text_start, const char* text_end, void* context) {
+	uint32_t number = 0;
+	if (parse_number(text_start, text_end, &number) == text_start) {
+		cpuinfo_log_warning(
+			"failed to parse file %s: \"%.*s\" is not an unsigned number",
+			filename,
+			(int)(text_end - text_start),
+			text_start);
+		return false;
+	}
+	*((uint32_t*)context) = number;
+	return true;
+}
+
+/* Parses sizes in the "32K" format of the kernel */
+static bool size_parser(const char* filename, const char* text_start, const char* text_end, void* context) {
+	uint32_t size = 0;
+	const char* parsed_end = parse_number(text_start, text_end, &size);
+	if (parsed_end == text_start) {
+		cpuinfo_log_warning(
+			"failed to parse file %s: \"%.*s\" is not a size",
+			filename,
+			(int)(text_end - text_start),
+			text_start);
+		return false;
+	}
+	if (parsed_end != text_end) {
+		switch (*parsed_end) {
+			case 'K':
+				size *= UINT32_C(1024);
+				break;
+			case 'M':
+				size *= UINT32_C(1048576);
+				break;
+			default:
+				if (!is_whitespace(*parsed_end)) {
+					cpuinfo_log_warning(
+						"failed to parse file %s: unknown size suffix \"%.*s\"",
+						filename,
+						(int)(text_end - parsed_end),
+						parsed_end);
+					return false;
+				}
+		}
+	}
+	*((uint32_t*)context) = size;
+	return true;
+}
+
+static bool type_parser(const char* filename, const char* text_start, const char* text_end, void* context) {
+	while (text_end != text_start && is_whitespace(text_end[-1])) {
+		text_end--;
+	}
+	const size_t length = (size_t)(text_end - text_start);
+	enum cache_type type = cache_type_unknown;
+	if (length == 4 && memcmp(text_start, "Data", length) == 0) {
+		type = cache_type_data;
+	} else if (length == 11 && memcmp(text_start, "Instruction", length) == 0) {
+		type = cache_type_instruction;
+	} else if (length == 7 && memcmp(text_start, "Unified", length) == 0) {
+		type = cache_type_unified;
+	} else {
+		cpuinfo_log_debug("ignored cache of type \"%.*s\" in %s", (int)length, text_start, filename);
+	}
+	*((enum cache_type*)context) = type;
+	return true;
+}
+
+static bool shared_cpus_parser(uint32_t processor_list_start, uint32_t processor_list_end, void* context) {
+	struct cpuinfo_linux_cache* cache = (struct cpuinfo_linux_cache*)context;
+	if (processor_list_start < cache->processor_start) {
+		cache->processor_start = processor_list_start;
+	}
+	cache->processor_count += processor_list_end - processor_list_start;
+	return true;
+}
+
+static bool parse_cache_attribute(
+	uint32_t processor,
+	uint32_t index,
+	const char* name,
+	cpuinfo_smallfile_callback parser,
+	void* context) {
+	char attribute[CPUINFO_LINUX_PROCESSOR_PATH_MAX];
+	snprintf(attribute, sizeof(attribute), "cache/index%" PRIu32 "/%s", index, name);
+	return cpuinfo_linux_parse_processor_small_file(processor, attribute, CACHE_ATTRIBUTE_FILESIZE, parser, context);
+}
+
+bool cpuinfo_linux_detect_processor_caches(uint32_t processor, struct cpuinfo_linux_caches caches[restrict static 1]) {
+	bool detected = false;
+	for (uint32_t index = 0; index < MAX_CACHE_INDICES; index++) {
+		uint32_t level = 0;
+		if (!parse_cache_attribute(processor, index, "level", uint32_parser, &level)) {
+			/* Caches are numbered consecutively */
+			break;
+		}
+		enum cache_type type = cache_type_unknown;
+		parse_cache_attribute(processor, index, "type", type_parser, &type);
+
+		struct cpuinfo_linux_cache* cache = NULL;
+		switch (level) {
+			case 1:
+				/* A unified L1 cache is described as a data cache */
+				cache = type == cache_type_instruction ? &caches->l1i : &caches->l1d;
+				break;
+			case 2:
+				cache = &caches->l2;
+				break;
+			case 3:
+				cache = &caches->l3;
+				break;
+			case 4:
+				cache = &caches->l4;
+				break;
+		}
+		if (cache == NULL || type == cache_type_unknown) {
+			cpuinfo_log_debug(
+				"ignored cache index %" PRIu32 " of level %" PRIu32 " of processor %" PRIu32,
+				index,
+				level,
+				processor);
+			continue;
+		}
+
+		struct cpuinfo_linux_cache description = {
+			.flags = type == cache_type_unified ? CPUINFO_CACHE_UNIFIED : 0,
+			.processor_start = UINT32_MAX,
+		};
+		if (!parse_cache_attribute(processor, index, "size", size_parser, &description.size) ||
+		    description.size == 0) {
+			continue;
+		}
+		parse_cache_attribute(processor, index, "ways_of_associativity", uint32_parser, &description.associativity);
+		parse_cache_attribute(processor, index, "coherency_line_size", uint32_parser, &description.line_size);
+		if (!parse_cache_attribute(processor, index, "number_of_sets", uint32_parser, &description.sets) &&
+		    description.associativity != 0 && description.line_size != 0) {
+			description.sets = description.size / (description.associativity * description.line_size);
+		}
+
+		char attribute[CPUINFO_LINUX_PROCESSOR_PATH_MAX];
+		snprintf(attribute, sizeof(attribute), "cache/index%" PRIu32 "/shared_cpu_list", index);
+		if (!cpuinfo_linux_parse_processor_cpulist(processor, attribute, shared_cpus_parser, &description) ||
+		    description.processor_count == 0) {
+			/* Without a sharing list, assume that the cache is private */
+			description.processor_start = processor;
+			description.processor_count = 1;
+		}
+
+		cpuinfo_log_debug(
+			"processor %" PRIu32 ": L%" PRIu32 " cache of %" PRIu32 " bytes shared with %" PRIu32
+			" processors starting with processor %" PRIu32,
+			processor,
+			level,
+			description.size,
+			description.processor_count,
+			description.processor_start);
+		*cache = description;
+		detected = true;
+	}
+	return detected;
+}
@@ -0,0 +1,228 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo/log.h>
+#include <linux/api.h>
+
+#define PROC_SELF_CGROUP_FILENAME "/proc/self/cgroup"
+#define PROC_SELF_CGROUP_BUFFER_SIZE 1024
+#define CGROUP_MOUNT_POINT "/sys/fs/cgroup"
+#define CGROUP_PATH_MAX 512
+#define CGROUP_ATTRIBUTE_FILESIZE 64
+
+/* Paths of the cgroups of the calling process, relative to the root of their hierarchies */
+struct cgroup_paths {
+	/* cgroup v2 unified hierarchy */
+	bool has_unified;
+	char unified[CGROUP_PATH_MAX];
+	/* cgroup v1 hierarchies of the cpu and cpuset controllers */
+	bool has_cpu;
+	char cpu[CGROUP_PATH_MAX];
+	bool has_cpuset;
+	char cpuset[CGROUP_PATH_MAX];
+};
+
+static bool has_controller(const char* controllers_start, const char* controllers_end, const char* controller) {
+	const size_t length = strlen(controller);
+	const char* name_start = controllers_start;
+	while (name_start < controllers_end) {
+		const char* name_end = memchr(name_start, ',', (size_t)(controllers_end - name_start));
+		if (name_end == NULL) {
+			name_end = controllers_end;
+		}
+		if ((size_t)(name_end - name_start) == length && memcmp(name_start, controller, length) == 0) {
+			return true;
+		}
+		name_start = name_end + 1;
+	}
+	return false;
+}
+
+static void store_path(const char* path_start, const char* path_end, bool has_path[restrict static 1], char* path) {
+	const size_t length = (size_t)(path_end - path_start);
+	if (length >= CGROUP_PATH_MAX) {
+		cpuinfo_log_warning("ignored cgroup path \"%.*s\": too long", (int)length, path_start);
+		return;
+	}
+	memcpy(path, path_start, length);
+	path[length] = '\0';
+	*has_path = true;
+}
+
+/* Parses lines in the "hierarchy-ID:controller-list:cgroup-path" format of /proc/self/cgroup */
+static bool cgroup_line_parser(const char* line_start, const char* line_end, void* context, uint64_t line_number) {
+	struct cgroup_paths* paths = (struct cgroup_paths*)context;
+	const char* id_end = memchr(line_start, ':', (size_t)(line_end - line_start));
+	const char* controllers_end =
+		id_end != NULL ? memchr(id_end + 1, ':', (size_t)(line_end - (id_end + 1))) : NULL;
+	if (controllers_end == NULL) {
+		cpuinfo_log_info(
+			"ignored line %" PRIu64 " \"%.*s\" in %s: unexpected format",
+			line_number,
+			(int)(line_end - line_start),
+			line_start,
+			PROC_SELF_CGROUP_FILENAME);
+		return true;
+	}
+	const char* controllers_start = id_end + 1;
+	const char* path_start = controllers_end + 1;
+
+	if (id_end - line_start == 1 && line_start[0] == '0' && controllers_start == controllers_end) {
+		store_path(path_start, line_end, &paths->has_unified, paths->unified);
+	}
+	if (has_controller(controllers_start, controllers_end, "cpu")) {
+		store_path(path_start, line_end, &paths->has_cpu, paths->cpu);
+	}
+	if (has_controller(controllers_start, controllers_end, "cpuset")) {
+		store_path(path_start, line_end, &paths->has_cpuset, paths->cpuset);
+	}
+	return true;
+}
+
+static bool detect_cgroup_paths(struct cgroup_paths paths[restrict static 1]) {
+	*paths = (struct cgroup_paths){0};
+	if (!cpuinfo_linux_parse_multiline_file(
+		    PROC_SELF_CGROUP_FILENAME, PROC_SELF_CGROUP_BUFFER_SIZE, cgroup_line_parser, paths)) {
+		return false;
+	}
+	return paths->has_unified || paths->has_cpu || paths->has_cpuset;
+}
+
+/* Removes the last component of a cgroup path; returns false at the root of the hierarchy */
+static bool parent_path(char* path) {
+	char* separator = strrchr(path, '/');
+	if (separator == NULL || path[0] == '\0' || (separator == path && path[1] == '\0')) {
+		return false;
+	}
+	separator[separator == path ? 1 : 0] = '\0';
+	return true;
+}
+
+static bool uint64_parser(const char* text_start, const char* text_end, uint64_t value[restrict static 1]) {
+	uint64_t number = 0;
+	const char* parsed = text_start;
+	for (; parsed != text_end; parsed++) {
+		const uint32_t digit = (uint32_t)(uint8_t)(*parsed) - (uint32_t)'0';
+		if (digit >= 10) {
+			break;
+		}
+		number = number * UINT64_C(10) + digit;
+	}
+	*value = number;
+	return parsed != text_start;
+}
+
+struct cpu_quota {
+	uint64_t quota;
+	uint64_t period;
+};
+
+/* Parses the "$MAX $PERIOD" format of cgroup v2 cpu.max, where $MAX is "max" without a limit */
+static bool cpu_max_parser(const char* filename, const char* text_start, const char* text_end, void* context) {
+	struct cpu_quota* quota = (struct cpu_quota*)context;
+	const char* separator = memchr(text_start, ' ', (size_t)(text_end - text_start));
+	if (separator == NULL || !uint64_parser(separator + 1, text_end, &quota->period)) {
+		cpuinfo_log_warning(
+			"failed to parse file %s: \"%.*s\" is not a quota and period",
+			filename,
+			(int)(text_end - text_start),
+			text_start);
+		return false;
+	}
+	if (!uint64_parser(text_start, separator, &quota->quota)) {
+		/* "max" */
+		quota->quota = 0;
+	}
+	return true;
+}
+
+/* Parses cgroup v1 cpu.cfs_quota_us and cpu.cfs_period_us, where a quota of -1 means no limit */
+static bool cfs_parser(const char* filename, const char* text_start, const char* text_end, void* context) {
+	uint64_t* value = (uint64_t*)context;
+	if (!uint64_parser(text_start, text_end, value)) {
+		*value = 0;
+	}
+	return true;
+}
+
+static bool is_more_restrictive(const struct cpu_quota* quota, const struct cpu_quota* other) {
+	if (quota->quota == 0 || quota->period == 0) {
+		return false;
+	}
+	if (other->quota == 0 || other->period == 0) {
+		return true;
+	}
+	return quota->quota * other->period < other->quota * quota->period;
+}
+
+bool cpuinfo_linux_detect_cgroup_cpu_quota(uint64_t* quota, uint64_t* period) {
+	struct cgroup_paths paths;
+	if (!detect_cgroup_paths(&paths)) {
+		return false;
+	}
+
+	/* A quota on any ancestor limits the cgroup too */
+	struct cpu_quota limit = {0};
+	char filename[sizeof(CGROUP_MOUNT_POINT "/cpu") + CGROUP_PATH_MAX + sizeof("/cpu.cfs_period_us")];
+	if (paths.has_unified) {
+		do {
+			struct cpu_quota level = {0};
+			snprintf(filename, sizeof(filename), CGROUP_MOUNT_POINT "%s/cpu.max", paths.unified);
+			if (cpuinfo_linux_parse_small_file(filename, CGROUP_ATTRIBUTE_FILESIZE, cpu_max_parser, &level) &&
+			    is_more_restrictive(&level, &limit)) {
+				limit = level;
+			}
+		} while (parent_path(paths.unified));
+	}
+	if (limit.quota == 0 && paths.has_cpu) {
+		do {
+			struct cpu_quota level = {0};
+			snprintf(filename, sizeof(filename), CGROUP_MOUNT_POINT "/cpu%s/cpu.cfs_quota_us", paths.cpu);
+			if (!cpuinfo_linux_parse_small_file(filename, CGROUP_ATTRIBUTE_FILESIZE, cfs_parser, &level.quota)) {
+				continue;
+			}
+			snprintf(filename, sizeof(filename), CGROUP_MOUNT_POINT "/cpu%s/cpu.cfs_period_us", paths.cpu);
+			if (cpuinfo_linux_parse_small_file(filename, CGROUP_ATTRIBUTE_FILESIZE, cfs_parser, &level.period) &&
+			    is_more_restrictive(&level, &limit)) {
+				limit = level;
+			}
+		} while (parent_path(paths.cpu));
+	}
+
+	if (limit.quota == 0) {
+		return false;
+	}
+	cpuinfo_log_debug(
+		"cgroup CPU quota of %" PRIu64 " us per %" PRIu64 " us period", limit.quota, limit.period);
+	*quota = limit.quota;
+	*period = limit.period;
+	return true;
+}
+
+bool cpuinfo_linux_parse_cgroup_cpuset(cpuinfo_cpulist_callback callback, void* context) {
+	struct cgroup_paths paths;
+	if (!detect_cgroup_paths(&paths)) {
+		return false;
+	}
+
+	/* The nearest cgroup with the cpuset controller enabled has the effective list */
+	char filename[sizeof(CGROUP_MOUNT_POINT "/cpuset") + CGROUP_PATH_MAX + sizeof("/cpuset.cpus.effective")];
+	if (paths.has_unified) {
+		do {
+			snprintf(filename, sizeof(filename), CGROUP_MOUNT_POINT "%s/cpuset.cpus.effective", paths.unified);
+			if (cpuinfo_linux_parse_cpulist(filename, callback, context)) {
+				return true;
+			}
+		} while (parent_path(paths.unified));
+	}
+	if (paths.has_cpuset) {
+		snprintf(filename, sizeof(filename), CGROUP_MOUNT_POINT "/cpuset%s/cpuset.effective_cpus", paths.cpuset);
+		return cpuinfo_linux_parse_cpulist(filename, callback, context);
+	}
+	return false;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cpuinfo/common.h>
+#include <linux/cpulist.h>
+
+/*
+ * Reads the most restrictive CPU bandwidth limit of the cgroup of the calling
+ * process and its ancestors, from cgroup v2 cpu.max or cgroup v1
+ * cpu.cfs_quota_us. Returns false if no cgroup limits CPU bandwidth. The
+ * arguments are never NULL; declared as pointers so that C++ tests can include
+ * this header.
+ */
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_cgroup_cpu_quota(uint64_t* quota, uint64_t* period);
+/* Parses the effective cpuset of the cgroup of the calling process; returns false if it is not exposed */
+CPUINFO_INTERNAL bool cpuinfo_linux_parse_cgroup_cpuset(cpuinfo_cpulist_callback callback, void* context);
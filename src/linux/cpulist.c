@@ -151,34 +151,51 @@ inline static bool parse_entry(
 	return callback(first_cpu, last_cpu + 1, context);
 }
 
-bool cpuinfo_linux_parse_cpulist(const char* filename, cpuinfo_cpulist_callback callback, void* context) {
+/*
+ * Checks if the text is an empty cpu list: the kernel prints empty masks as a
+ * bare newline, and masks which were never allocated (e.g. nohz_full on
+ * kernels booted without it) as "(null)".
+ */
+static bool is_empty_list(const char* list_start, const char* list_end) {
+	for (; list_start != list_end; list_start++) {
+		if (!is_whitespace(*list_start)) {
+			break;
+		}
+	}
+	for (; list_end != list_start; list_end--) {
+		if (!is_whitespace(list_end[-1])) {
+			break;
+		}
+	}
+	const size_t list_length = (size_t)(list_end - list_start);
+	return list_length == 0 || (list_length == 6 && memcmp(list_start, "(null)", 6) == 0);
+}
+
+/*
+ * Parses the cpu list in the file and closes it. A short read ends the file if
+ * single_read is set: sysfs generates attribute files in full on the first read.
+ */
+static bool parse_cpulist(
+	int file,
+	const char* filename,
+	bool single_read,
+	cpuinfo_cpulist_callback callback,
+	void* context) {
 	bool status = true;
-	int file = -1;
 	char buffer[BUFFER_SIZE];
-#if CPUINFO_LOG_DEBUG_PARSERS
-	cpuinfo_log_debug("parsing cpu list from file %s", filename);
-#endif
-
-#if CPUINFO_MOCK
-	file = cpuinfo_mock_open(filename, O_RDONLY);
-#else
-	file = open(filename, O_RDONLY);
-#endif
-	if (file == -1) {
-		cpuinfo_log_info("failed to open %s: %s", filename, strerror(errno));
-		status = false;
-		goto cleanup;
-	}
 
 	size_t position = 0;
 	const char* buffer_end = &buffer[BUFFER_SIZE];
 	char* data_start = buffer;
-	ssize_t bytes_read;
+	bool end_of_file;
+	uint32_t entries_count = 0;
 	do {
+		const size_t bytes_requested = (size_t)(buffer_end - data_start);
 #if CPUINFO_MOCK
-		bytes_read = cpuinfo_mock_read(file, data_start, (size_t)(buffer_end - data_start));
+		const ssize_t bytes_read = cpuinfo_mock_read(file, data_start, bytes_requested);
 #else
-		bytes_read = read(file, data_start, (size_t)(buffer_end - data_start));
+		const ssize_t bytes_read = read(file, data_start, bytes_requested);
+		cpuinfo_linux_count_file_syscalls(1);
 #endif
 		if (bytes_read < 0) {
 			cpuinfo_log_info(
@@ -188,16 +205,10 @@ bool cpuinfo_linux_parse_cpulist(const char* filename, cpuinfo_cpulist_callback
 		}
 
 		position += (size_t)bytes_read;
-		const char* data_end = data_start + (size_t)bytes_read;
-		const char* entry_start = buffer;
-
-		if (bytes_read == 0) {
-			/* No more data in the file: process the remaining text
-			 * in the buffer as a single entry */
-			const char* entry_end = data_end;
-			const bool entry_status = parse_entry(entry_start, entry_end, callback, context);
-			status &= entry_status;
-		} else {
+		end_of_file = bytes_read == 0 || (single_read && (size_t)bytes_read < bytes_requested);
+		if (bytes_read != 0) {
+			const char* data_end = data_start + (size_t)bytes_read;
+			const char* entry_start = buffer;
 			const char* entry_end;
 			do {
 				/* Find the end of the entry, as indicated by a
@@ -217,6 +228,7 @@ bool cpuinfo_linux_parse_cpulist(const char* filename, cpuinfo_cpulist_callback
 					const bool entry_status =
 						parse_entry(entry_start, entry_end, callback, context);
 					status &= entry_status;
+					entries_count++;
 					entry_start = entry_end + 1;
 				}
 			} while (entry_end != data_end);
@@ -227,16 +239,55 @@ bool cpuinfo_linux_parse_cpulist(const char* filename, cpuinfo_cpulist_callback
 			memmove(buffer, entry_start, entry_length);
 			data_start = &buffer[entry_length];
 		}
-	} while (bytes_read != 0);
+		if (end_of_file && (entries_count != 0 || !is_empty_list(buffer, data_start))) {
+			/* No more data in the file: process the remaining text
+			 * in the buffer as a single entry */
+			const bool entry_status = parse_entry(buffer, data_start, callback, context);
+			status &= entry_status;
+		}
+	} while (!end_of_file);
 
 cleanup:
-	if (file != -1) {
 #if CPUINFO_MOCK
-		cpuinfo_mock_close(file);
+	cpuinfo_mock_close(file);
 #else
-		close(file);
+	close(file);
+	cpuinfo_linux_count_file_syscalls(1);
 #endif
-		file = -1;
-	}
 	return status;
 }
+
+bool cpuinfo_linux_parse_cpulist(const char* filename, cpuinfo_cpulist_callback callback, void* context) {
+#if CPUINFO_LOG_DEBUG_PARSERS
+	cpuinfo_log_debug("parsing cpu list from file %s", filename);
+#endif
+
+#if CPUINFO_MOCK
+	const int file = cpuinfo_mock_open(filename, O_RDONLY);
+#else
+	const int file = open(filename, O_RDONLY);
+	cpuinfo_linux_count_file_syscalls(1);
+#endif
+	if (file == -1) {
+		cpuinfo_log_info("failed to open %s: %s", filename, strerror(errno));
+		return false;
+	}
+	return parse_cpulist(file, filename, false, callback, context);
+}
+
+bool cpuinfo_linux_parse_processor_cpulist(
+	uint32_t processor,
+	const char* attribute,
+	cpuinfo_cpulist_callback callback,
+	void* context) {
+	char filename[CPUINFO_LINUX_PROCESSOR_PATH_MAX];
+	const int file = cpuinfo_linux_open_processor_file(processor, attribute, filename);
+#if CPUINFO_LOG_DEBUG_PARSERS
+	cpuinfo_log_debug("parsing cpu list from file %s", filename);
+#endif
+	if (file == -1) {
+		cpuinfo_log_info("failed to open %s: %s", filename, strerror(errno));
+		return false;
+	}
+	return parse_cpulist(file, filename, true, callback, context);
+}
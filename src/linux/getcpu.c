@@ -0,0 +1,187 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if !defined(__NR_getcpu)
+#include <asm-generic/unistd.h>
+#endif
+
+#include <cpuinfo.h>
+#include <cpuinfo/internal-api.h>
+#include <cpuinfo/log.h>
+#include <linux/api.h>
+
+/*
+ * Linux programs TSC_AUX (read by RDPID and RDTSCP) with (node << 12) | cpu,
+ * so only the low 12 bits identify the logical processor.
+ */
+#define TSC_AUX_CPU_MASK UINT32_C(0x00000FFF)
+#define TSC_AUX_CPU_LIMIT UINT32_C(0x00001000)
+
+/* Number of times a candidate backend is cross-checked against the syscall */
+#define GETCPU_VALIDATION_ROUNDS 4
+
+/*
+ * glibc 2.35+ registers an rseq area for every thread it creates and exports
+ * its location relative to the thread pointer. The symbols are declared weak so
+ * that the library still loads against older glibc versions.
+ */
+#if defined(__GLIBC__) && (CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64 || CPUINFO_ARCH_ARM64 || CPUINFO_ARCH_RISCV64)
+#define CPUINFO_GETCPU_HAS_RSEQ 1
+extern const ptrdiff_t __rseq_offset __attribute__((__weak__));
+extern const unsigned int __rseq_size __attribute__((__weak__));
+#else
+#define CPUINFO_GETCPU_HAS_RSEQ 0
+#endif
+
+/* Offset of the cpu_id field in struct rseq from linux/rseq.h */
+#define RSEQ_CPU_ID_OFFSET 4
+
+static bool getcpu_syscall(uint32_t cpu[restrict static 1]) {
+	/* Initializing this variable silences a MemorySanitizer error. */
+	unsigned linux_cpu = 0;
+	if CPUINFO_UNLIKELY (syscall(__NR_getcpu, &linux_cpu, NULL, NULL) != 0) {
+		return false;
+	}
+	*cpu = (uint32_t)linux_cpu;
+	return true;
+}
+
+#if CPUINFO_GETCPU_HAS_RSEQ
+static inline const volatile int32_t* rseq_cpu_id_pointer(void) {
+	const char* thread_pointer;
+#if CPUINFO_ARCH_X86_64
+	__asm__("mov %%fs:0, %0" : "=r"(thread_pointer));
+#elif CPUINFO_ARCH_X86
+	__asm__("mov %%gs:0, %0" : "=r"(thread_pointer));
+#elif CPUINFO_ARCH_ARM64
+	__asm__("mrs %0, tpidr_el0" : "=r"(thread_pointer));
+#elif CPUINFO_ARCH_RISCV64
+	__asm__("mv %0, tp" : "=r"(thread_pointer));
+#endif
+	return (const volatile int32_t*)(thread_pointer + __rseq_offset + RSEQ_CPU_ID_OFFSET);
+}
+
+static bool getcpu_rseq(uint32_t cpu[restrict static 1]) {
+	/*
+	 * The kernel stores the current processor in the rseq area on every
+	 * return to user space. Negative values mean that the area of this
+	 * thread is not (yet) registered.
+	 */
+	const int32_t rseq_cpu = *rseq_cpu_id_pointer();
+	if CPUINFO_UNLIKELY (rseq_cpu < 0) {
+		return getcpu_syscall(cpu);
+	}
+	*cpu = (uint32_t)rseq_cpu;
+	return true;
+}
+#endif
+
+static bool getcpu_vdso(uint32_t cpu[restrict static 1]) {
+	const int linux_cpu = sched_getcpu();
+	if CPUINFO_UNLIKELY (linux_cpu < 0) {
+		return false;
+	}
+	*cpu = (uint32_t)linux_cpu;
+	return true;
+}
+
+#if (CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64) && !CPUINFO_MOCK
+static bool getcpu_rdpid(uint32_t cpu[restrict static 1]) {
+	uintptr_t tsc_aux;
+	/* RDPID rax/eax; encoded manually to support older assemblers */
+	__asm__ __volatile__(".byte 0xF3, 0x0F, 0xC7, 0xF8" : "=a"(tsc_aux));
+	*cpu = (uint32_t)tsc_aux & TSC_AUX_CPU_MASK;
+	return true;
+}
+
+static bool getcpu_rdtscp(uint32_t cpu[restrict static 1]) {
+	uint32_t tsc_lo, tsc_hi, tsc_aux;
+	__asm__ __volatile__("rdtscp" : "=a"(tsc_lo), "=d"(tsc_hi), "=c"(tsc_aux));
+	*cpu = tsc_aux & TSC_AUX_CPU_MASK;
+	return true;
+}
+#endif
+
+cpuinfo_linux_getcpu_function cpuinfo_linux_getcpu = getcpu_syscall;
+
+static const char* const getcpu_method_names[cpuinfo_linux_getcpu_method_max] = {
+	[cpuinfo_linux_getcpu_method_none] = "none",
+	[cpuinfo_linux_getcpu_method_rseq] = "rseq",
+	[cpuinfo_linux_getcpu_method_vdso] = "vDSO",
+	[cpuinfo_linux_getcpu_method_rdpid] = "RDPID",
+	[cpuinfo_linux_getcpu_method_rdtscp] = "RDTSCP",
+	[cpuinfo_linux_getcpu_method_syscall] = "syscall",
+};
+
+static bool validate_getcpu_function(cpuinfo_linux_getcpu_function function) {
+	for (uint32_t round = 0; round < GETCPU_VALIDATION_ROUNDS; round++) {
+		uint32_t expected_cpu = UINT32_MAX, cpu = UINT32_MAX, confirmed_cpu = UINT32_MAX;
+		if (!getcpu_syscall(&expected_cpu) || !function(&cpu) || !getcpu_syscall(&confirmed_cpu)) {
+			return false;
+		}
+		/* Only count mismatches if the thread did not migrate in between */
+		if (expected_cpu == confirmed_cpu) {
+			return cpu == expected_cpu;
+		}
+	}
+	return false;
+}
+
+cpuinfo_linux_getcpu_function cpuinfo_linux_probe_getcpu_method(enum cpuinfo_linux_getcpu_method method) {
+	cpuinfo_linux_getcpu_function function = NULL;
+	switch (method) {
+		case cpuinfo_linux_getcpu_method_rseq:
+#if CPUINFO_GETCPU_HAS_RSEQ
+			if (&__rseq_size != NULL && &__rseq_offset != NULL && __rseq_size != 0) {
+				function = getcpu_rseq;
+			}
+#endif
+			break;
+		case cpuinfo_linux_getcpu_method_vdso:
+			function = getcpu_vdso;
+			break;
+#if (CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64) && !CPUINFO_MOCK
+		case cpuinfo_linux_getcpu_method_rdpid:
+			if (cpuinfo_isa.rdpid) {
+				function = getcpu_rdpid;
+			}
+			break;
+		case cpuinfo_linux_getcpu_method_rdtscp:
+			if (cpuinfo_isa.rdtscp) {
+				function = getcpu_rdtscp;
+			}
+			break;
+#endif
+		case cpuinfo_linux_getcpu_method_syscall:
+			return getcpu_syscall;
+		default:
+			break;
+	}
+	if (function != NULL && !validate_getcpu_function(function)) {
+		cpuinfo_log_debug("%s getcpu method is unusable", getcpu_method_names[method]);
+		function = NULL;
+	}
+	return function;
+}
+
+void cpuinfo_linux_init_getcpu(uint32_t max_possible_processors_count) {
+	for (enum cpuinfo_linux_getcpu_method method = cpuinfo_linux_getcpu_method_rseq;
+	     method < cpuinfo_linux_getcpu_method_max;
+	     method++) {
+		if ((method == cpuinfo_linux_getcpu_method_rdpid || method == cpuinfo_linux_getcpu_method_rdtscp) &&
+		    (max_possible_processors_count == 0 || max_possible_processors_count > TSC_AUX_CPU_LIMIT)) {
+			/* TSC_AUX can not encode processor numbers above 4095, including of processors onlined later */
+			continue;
+		}
+		const cpuinfo_linux_getcpu_function function = cpuinfo_linux_probe_getcpu_method(method);
+		if (function != NULL) {
+			cpuinfo_log_debug("using %s to query current processor", getcpu_method_names[method]);
+			cpuinfo_linux_getcpu = function;
+			return;
+		}
+	}
+}
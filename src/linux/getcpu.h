@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cpuinfo/common.h>
+
+enum cpuinfo_linux_getcpu_method {
+	cpuinfo_linux_getcpu_method_none = 0,
+	/* cpu_id field of the restartable sequences area registered by libc */
+	cpuinfo_linux_getcpu_method_rseq,
+	/* sched_getcpu, backed by the vDSO getcpu on most architectures */
+	cpuinfo_linux_getcpu_method_vdso,
+	/* TSC_AUX register read with RDPID instruction (x86 only) */
+	cpuinfo_linux_getcpu_method_rdpid,
+	/* TSC_AUX register read with RDTSCP instruction (x86 only) */
+	cpuinfo_linux_getcpu_method_rdtscp,
+	/* getcpu system call */
+	cpuinfo_linux_getcpu_method_syscall,
+	cpuinfo_linux_getcpu_method_max,
+};
+
+/* The argument is never NULL; declared as a pointer so that C++ benchmarks can include this header */
+typedef bool (*cpuinfo_linux_getcpu_function)(uint32_t* cpu);
+extern CPUINFO_INTERNAL cpuinfo_linux_getcpu_function cpuinfo_linux_getcpu;
+
+CPUINFO_PRIVATE cpuinfo_linux_getcpu_function cpuinfo_linux_probe_getcpu_method(
+	enum cpuinfo_linux_getcpu_method method);
+/*
+ * Selects the fastest usable method to query the current processor. The count
+ * is 1 + the maximum possible Linux processor number, or 0 if it is unknown.
+ */
+CPUINFO_INTERNAL void cpuinfo_linux_init_getcpu(uint32_t max_possible_processors_count);
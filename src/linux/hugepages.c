@@ -0,0 +1,123 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo/log.h>
+#include <linux/api.h>
+
+#define HUGEPAGES_ATTRIBUTE_FILESIZE 32
+#define THP_ENABLED_FILENAME "/sys/kernel/mm/transparent_hugepage/enabled"
+#define THP_ENABLED_FILESIZE 64
+#define THP_SIZE_FILENAME "/sys/kernel/mm/transparent_hugepage/hpage_pmd_size"
+#define HUGEPAGES_PATH_MAX 80
+
+/*
+ * Huge page sizes, in KB, which Linux offers on any architecture. Sizes are
+ * probed rather than listed from /sys/kernel/mm/hugepages so that the pools can
+ * be described through the mock filesystem.
+ */
+static const uint32_t huge_page_sizes_kb[] = {
+	64, /* ARM64 with 4KB granule: contiguous 4KB pages */
+	2048, /* x86-64, ARM64 and RISC-V with 4KB granule */
+	16384, /* POWER */
+	32768, /* ARM64 with 4KB granule: contiguous 2MB blocks */
+	524288, /* ARM64 with 64KB granule */
+	1048576, /* x86-64, ARM64 and RISC-V with 4KB granule */
+	16777216, /* POWER and ARM64 with 64KB granule: contiguous 512MB blocks */
+};
+
+static bool uint64_parser(const char* filename, const char* text_start, const char* text_end, void* context) {
+	uint64_t number = 0;
+	const char* parsed = text_start;
+	for (; parsed != text_end; parsed++) {
+		const uint32_t digit = (uint32_t)(uint8_t)(*parsed) - (uint32_t)'0';
+		if (digit >= 10) {
+			break;
+		}
+		number = number * UINT64_C(10) + digit;
+	}
+	if (parsed == text_start) {
+		cpuinfo_log_warning(
+			"failed to parse file %s: \"%.*s\" is not an unsigned number",
+			filename,
+			(int)(text_end - text_start),
+			text_start);
+		return false;
+	}
+	*((uint64_t*)context) = number;
+	return true;
+}
+
+/* Parses the mode in the "always [madvise] never" format of the kernel: the active mode is bracketed */
+static bool thp_mode_parser(const char* filename, const char* text_start, const char* text_end, void* context) {
+	const char* mode_start = memchr(text_start, '[', (size_t)(text_end - text_start));
+	const char* mode_end = mode_start != NULL ? memchr(mode_start, ']', (size_t)(text_end - mode_start)) : NULL;
+	if (mode_end == NULL) {
+		cpuinfo_log_warning(
+			"failed to parse file %s: no active mode in \"%.*s\"",
+			filename,
+			(int)(text_end - text_start),
+			text_start);
+		return false;
+	}
+	mode_start += 1;
+
+	const size_t length = (size_t)(mode_end - mode_start);
+	enum cpuinfo_transparent_huge_pages mode = cpuinfo_transparent_huge_pages_unavailable;
+	if (length == 5 && memcmp(mode_start, "never", length) == 0) {
+		mode = cpuinfo_transparent_huge_pages_never;
+	} else if (length == 7 && memcmp(mode_start, "madvise", length) == 0) {
+		mode = cpuinfo_transparent_huge_pages_madvise;
+	} else if (length == 6 && memcmp(mode_start, "always", length) == 0) {
+		mode = cpuinfo_transparent_huge_pages_always;
+	} else {
+		cpuinfo_log_info("unknown transparent huge pages mode \"%.*s\" in %s", (int)length, mode_start, filename);
+	}
+	*((enum cpuinfo_transparent_huge_pages*)context) = mode;
+	return true;
+}
+
+static bool read_pool_attribute(uint32_t size_kb, const char* attribute, uint64_t value[restrict static 1]) {
+	char path[HUGEPAGES_PATH_MAX];
+	snprintf(path, sizeof(path), "/sys/kernel/mm/hugepages/hugepages-%" PRIu32 "kB/%s", size_kb, attribute);
+	return cpuinfo_linux_parse_small_file(path, HUGEPAGES_ATTRIBUTE_FILESIZE, uint64_parser, value);
+}
+
+bool cpuinfo_linux_detect_memory_pages(struct cpuinfo_memory_pages pages[restrict static 1]) {
+	if (cpuinfo_linux_parse_small_file(
+		    THP_ENABLED_FILENAME, THP_ENABLED_FILESIZE, thp_mode_parser, &pages->transparent_huge_pages)) {
+		cpuinfo_linux_parse_small_file(
+			THP_SIZE_FILENAME,
+			HUGEPAGES_ATTRIBUTE_FILESIZE,
+			uint64_parser,
+			&pages->transparent_huge_page_size);
+	}
+
+	bool detected = pages->transparent_huge_pages != cpuinfo_transparent_huge_pages_unavailable;
+	for (size_t i = 0; i < sizeof(huge_page_sizes_kb) / sizeof(huge_page_sizes_kb[0]); i++) {
+		uint64_t count = 0, free_count = 0;
+		if (!read_pool_attribute(huge_page_sizes_kb[i], "nr_hugepages", &count)) {
+			continue;
+		}
+		read_pool_attribute(huge_page_sizes_kb[i], "free_hugepages", &free_count);
+		if (pages->huge_pages_count == CPUINFO_HUGE_PAGE_SIZES_MAX) {
+			break;
+		}
+		pages->huge_pages[pages->huge_pages_count++] = (struct cpuinfo_huge_pages){
+			.page_size = (uint64_t)huge_page_sizes_kb[i] * UINT64_C(1024),
+			.count = (uint32_t)count,
+			.free_count = (uint32_t)free_count,
+		};
+		cpuinfo_log_debug(
+			"huge pages of %" PRIu32 " KB: %" PRIu64 " in pool, %" PRIu64 " free",
+			huge_page_sizes_kb[i],
+			count,
+			free_count);
+		detected = true;
+	}
+	return detected;
+}
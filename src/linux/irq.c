@@ -0,0 +1,116 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cpuinfo/log.h>
+#include <linux/api.h>
+
+#define PROC_IRQ_DIRECTORY "/proc/irq"
+#define IRQ_NUMBER_MAX_LENGTH 10
+
+struct irq_counts_context {
+	uint32_t max_processors_count;
+	/* Number of interrupts in the affinity of each logical processor */
+	uint32_t* irq_counts;
+	uint32_t irqs_count;
+};
+
+static bool irq_affinity_parser(uint32_t processor_list_start, uint32_t processor_list_end, void* context) {
+	struct irq_counts_context* counts_context = (struct irq_counts_context*)context;
+	if (processor_list_end > counts_context->max_processors_count) {
+		processor_list_end = counts_context->max_processors_count;
+	}
+	for (uint32_t processor = processor_list_start; processor < processor_list_end; processor++) {
+		counts_context->irq_counts[processor] += 1;
+	}
+	return true;
+}
+
+static bool is_irq_number(const char* name) {
+	uint32_t length = 0;
+	for (; name[length] != '\0'; length++) {
+		if ((uint32_t)(uint8_t)name[length] - (uint32_t)'0' >= 10 || length == IRQ_NUMBER_MAX_LENGTH) {
+			return false;
+		}
+	}
+	return length != 0;
+}
+
+static bool irq_directory_parser(const char* name, void* context) {
+	/* Skip default_smp_affinity and other files */
+	if (!is_irq_number(name)) {
+		return true;
+	}
+
+	/*
+	 * The effective affinity is where the interrupt controller actually
+	 * delivers the interrupt, while the requested affinity usually allows all
+	 * processors. Kernels without CONFIG_GENERIC_IRQ_EFFECTIVE_AFF_MASK only
+	 * report the latter.
+	 */
+	char filename[sizeof(PROC_IRQ_DIRECTORY "/") + IRQ_NUMBER_MAX_LENGTH + sizeof("/effective_affinity_list")];
+	snprintf(filename, sizeof(filename), PROC_IRQ_DIRECTORY "/%s/effective_affinity_list", name);
+	if (!cpuinfo_linux_parse_cpulist(filename, irq_affinity_parser, context)) {
+		snprintf(filename, sizeof(filename), PROC_IRQ_DIRECTORY "/%s/smp_affinity_list", name);
+		if (!cpuinfo_linux_parse_cpulist(filename, irq_affinity_parser, context)) {
+			cpuinfo_log_debug("failed to parse the affinity of interrupt %s", name);
+			return true;
+		}
+	}
+	((struct irq_counts_context*)context)->irqs_count += 1;
+	return true;
+}
+
+bool cpuinfo_linux_detect_irq_affine_processors(
+	uint32_t max_processors_count,
+	uint32_t* processor0_flags,
+	uint32_t processor_struct_size,
+	uint32_t irq_affine_flag) {
+	uint32_t* irq_counts = calloc(max_processors_count, sizeof(uint32_t));
+	if (irq_counts == NULL) {
+		cpuinfo_log_error(
+			"failed to allocate %zu bytes for interrupt counts of %" PRIu32 " logical processors",
+			max_processors_count * sizeof(uint32_t),
+			max_processors_count);
+		return false;
+	}
+
+	bool status = false;
+	struct irq_counts_context context = {
+		.max_processors_count = max_processors_count,
+		.irq_counts = irq_counts,
+	};
+	if (!cpuinfo_linux_list_directory(PROC_IRQ_DIRECTORY, irq_directory_parser, &context) ||
+	    context.irqs_count == 0) {
+		cpuinfo_log_info("failed to detect interrupt affinities in %s", PROC_IRQ_DIRECTORY);
+		goto cleanup;
+	}
+
+	uint64_t total_irq_count = 0;
+	uint32_t processors_with_irqs = 0;
+	for (uint32_t processor = 0; processor < max_processors_count; processor++) {
+		total_irq_count += irq_counts[processor];
+		processors_with_irqs += (uint32_t)(irq_counts[processor] != 0);
+	}
+	/*
+	 * Interrupts allowed on all processors do not single any of them out, so
+	 * only processors above twice the average count are flagged.
+	 */
+	for (uint32_t processor = 0; processor < max_processors_count; processor++) {
+		if ((uint64_t)irq_counts[processor] * processors_with_irqs > 2 * total_irq_count) {
+			*((uint32_t*)((uintptr_t)processor0_flags + processor_struct_size * processor)) |= irq_affine_flag;
+			cpuinfo_log_debug(
+				"logical processor %" PRIu32 " is in the affinity of %" PRIu32 " of %" PRIu32 " interrupts",
+				processor,
+				irq_counts[processor],
+				context.irqs_count);
+		}
+	}
+	status = true;
+
+cleanup:
+	free(irq_counts);
+	return status;
+}
@@ -7,6 +7,7 @@
 
 #include <fcntl.h>
 #include <sched.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -19,6 +20,7 @@
 #include <arm/midr.h>
 #include <cpuinfo-mock.h>
 #include <cpuinfo/log.h>
+#include <linux/api.h>
 
 static struct cpuinfo_mock_file* cpuinfo_mock_files = NULL;
 static uint32_t cpuinfo_mock_file_count = 0;
@@ -41,6 +43,8 @@ int CPUINFO_ABI cpuinfo_mock_open(const char* path, int oflag) {
 		return open(path, oflag);
 	}
 
+	/* Mock file system calls are counted like the calls they stand in for */
+	cpuinfo_linux_count_file_syscalls(1);
 	for (uint32_t i = 0; i < cpuinfo_mock_file_count; i++) {
 		if (strcmp(cpuinfo_mock_files[i].path, path) == 0) {
 			if (oflag != O_RDONLY) {
@@ -65,6 +69,7 @@ int CPUINFO_ABI cpuinfo_mock_close(int fd) {
 		return close(fd);
 	}
 
+	cpuinfo_linux_count_file_syscalls(1);
 	if ((unsigned int)fd >= cpuinfo_mock_file_count) {
 		errno = EBADF;
 		return -1;
@@ -83,6 +88,7 @@ ssize_t CPUINFO_ABI cpuinfo_mock_read(int fd, void* buffer, size_t capacity) {
 		return read(fd, buffer, capacity);
 	}
 
+	cpuinfo_linux_count_file_syscalls(1);
 	if ((unsigned int)fd >= cpuinfo_mock_file_count) {
 		errno = EBADF;
 		return -1;
@@ -101,3 +107,154 @@ ssize_t CPUINFO_ABI cpuinfo_mock_read(int fd, void* buffer, size_t capacity) {
 	cpuinfo_mock_files[fd].offset += count;
 	return (ssize_t)count;
 }
+
+bool CPUINFO_ABI cpuinfo_mock_list_directory(const char* path, bool (*callback)(const char*, void*), void* context) {
+	if (cpuinfo_mock_files == NULL) {
+		cpuinfo_log_warning("cpuinfo_mock_list_directory called without mock filesystem");
+		errno = ENOENT;
+		return false;
+	}
+
+	/* Stands in for opendir and closedir */
+	cpuinfo_linux_count_file_syscalls(2);
+	const size_t path_length = strlen(path);
+	bool found = false;
+	for (uint32_t i = 0; i < cpuinfo_mock_file_count; i++) {
+		const char* file_path = cpuinfo_mock_files[i].path;
+		if (strncmp(file_path, path, path_length) != 0 || file_path[path_length] != '/') {
+			continue;
+		}
+		found = true;
+		const char* name_start = file_path + path_length + 1;
+		const char* name_end = strchr(name_start, '/');
+		const size_t name_length = name_end != NULL ? (size_t)(name_end - name_start) : strlen(name_start);
+
+		/* Report each entry once, on the first file under it */
+		bool reported = false;
+		for (uint32_t j = 0; j < i && !reported; j++) {
+			const char* other_path = cpuinfo_mock_files[j].path;
+			reported = strncmp(other_path, file_path, path_length + 1 + name_length) == 0 &&
+				(other_path[path_length + 1 + name_length] == '/' ||
+				 other_path[path_length + 1 + name_length] == '\0');
+		}
+		if (reported) {
+			continue;
+		}
+
+		char name[256];
+		if (name_length >= sizeof(name)) {
+			continue;
+		}
+		memcpy(name, name_start, name_length);
+		name[name_length] = '\0';
+		if (!callback(name, context)) {
+			return false;
+		}
+	}
+	if (!found) {
+		errno = ENOENT;
+	}
+	return found;
+}
+
+static unsigned long* cpuinfo_mock_affinity_set = NULL;
+static uint32_t cpuinfo_mock_affinity_processors_count = 0;
+
+#define MOCK_AFFINITY_WORD_BITS (sizeof(unsigned long) * 8)
+
+void CPUINFO_ABI cpuinfo_mock_affinity(uint32_t max_processors_count) {
+	const size_t words_count = (max_processors_count + MOCK_AFFINITY_WORD_BITS - 1) / MOCK_AFFINITY_WORD_BITS;
+	free(cpuinfo_mock_affinity_set);
+	cpuinfo_mock_affinity_set = calloc(words_count, sizeof(unsigned long));
+	if (cpuinfo_mock_affinity_set == NULL) {
+		cpuinfo_mock_affinity_processors_count = 0;
+		return;
+	}
+	for (uint32_t i = 0; i < max_processors_count; i++) {
+		cpuinfo_mock_affinity_set[i / MOCK_AFFINITY_WORD_BITS] |= 1UL << (i % MOCK_AFFINITY_WORD_BITS);
+	}
+	cpuinfo_mock_affinity_processors_count = max_processors_count;
+}
+
+int CPUINFO_ABI cpuinfo_mock_sched_getaffinity(pid_t pid, size_t set_size, void* set) {
+	if (cpuinfo_mock_affinity_set == NULL) {
+		cpuinfo_log_warning(
+			"cpuinfo_mock_sched_getaffinity called without mock affinity; redirecting to sched_getaffinity");
+		return sched_getaffinity(pid, set_size, (cpu_set_t*)set);
+	}
+
+	/* Like the kernel, reject sets which can not hold all processors */
+	const size_t words_count =
+		(cpuinfo_mock_affinity_processors_count + MOCK_AFFINITY_WORD_BITS - 1) / MOCK_AFFINITY_WORD_BITS;
+	if (set_size % sizeof(unsigned long) != 0 || set_size < words_count * sizeof(unsigned long)) {
+		errno = EINVAL;
+		return -1;
+	}
+	memset(set, 0, set_size);
+	memcpy(set, cpuinfo_mock_affinity_set, words_count * sizeof(unsigned long));
+	return 0;
+}
+
+int CPUINFO_ABI cpuinfo_mock_sched_setaffinity(pid_t pid, size_t set_size, const void* set) {
+	if (cpuinfo_mock_affinity_set == NULL) {
+		cpuinfo_log_warning(
+			"cpuinfo_mock_sched_setaffinity called without mock affinity; redirecting to sched_setaffinity");
+		return sched_setaffinity(pid, set_size, (const cpu_set_t*)set);
+	}
+
+	/* Like the kernel, ignore processors beyond the maximum, and reject sets without processors */
+	const unsigned long* words = (const unsigned long*)set;
+	const size_t words_count =
+		(cpuinfo_mock_affinity_processors_count + MOCK_AFFINITY_WORD_BITS - 1) / MOCK_AFFINITY_WORD_BITS;
+	const size_t set_words_count = set_size / sizeof(unsigned long);
+	unsigned long* affinity_set = calloc(words_count, sizeof(unsigned long));
+	if (affinity_set == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+	bool empty = true;
+	for (uint32_t i = 0; i < cpuinfo_mock_affinity_processors_count; i++) {
+		const size_t word = i / MOCK_AFFINITY_WORD_BITS;
+		const unsigned long bit = 1UL << (i % MOCK_AFFINITY_WORD_BITS);
+		if (word < set_words_count && (words[word] & bit) != 0) {
+			affinity_set[word] |= bit;
+			empty = false;
+		}
+	}
+	if (empty) {
+		free(affinity_set);
+		errno = EINVAL;
+		return -1;
+	}
+	free(cpuinfo_mock_affinity_set);
+	cpuinfo_mock_affinity_set = affinity_set;
+	return 0;
+}
+
+/* Receiving and sending ends of the local socket which stands in for the uevent netlink socket */
+static int cpuinfo_mock_uevent_fds[2] = {-1, -1};
+
+static bool open_mock_uevent_socket(void) {
+	if (cpuinfo_mock_uevent_fds[0] != -1) {
+		return true;
+	}
+	if (socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, cpuinfo_mock_uevent_fds) != 0) {
+		cpuinfo_log_warning("failed to create mock uevent socket: %s", strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+int CPUINFO_ABI cpuinfo_mock_uevent_socket(void) {
+	if (!open_mock_uevent_socket()) {
+		return -1;
+	}
+	return fcntl(cpuinfo_mock_uevent_fds[0], F_DUPFD_CLOEXEC, 0);
+}
+
+bool CPUINFO_ABI cpuinfo_mock_uevent(const char* message, size_t size) {
+	if (!open_mock_uevent_socket()) {
+		return false;
+	}
+	return send(cpuinfo_mock_uevent_fds[1], message, size, 0) == (ssize_t)size;
+}
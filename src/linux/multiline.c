@@ -29,6 +29,7 @@ bool cpuinfo_linux_parse_multiline_file(
 	file = cpuinfo_mock_open(filename, O_RDONLY);
 #else
 	file = open(filename, O_RDONLY);
+	cpuinfo_linux_count_file_syscalls(1);
 #endif
 	if (file == -1) {
 		cpuinfo_log_info("failed to open %s: %s", filename, strerror(errno));
@@ -46,6 +47,7 @@ bool cpuinfo_linux_parse_multiline_file(
 		bytes_read = cpuinfo_mock_read(file, data_start, (size_t)(buffer_end - data_start));
 #else
 		bytes_read = read(file, data_start, (size_t)(buffer_end - data_start));
+		cpuinfo_linux_count_file_syscalls(1);
 #endif
 		if (bytes_read < 0) {
 			cpuinfo_log_info(
@@ -106,6 +108,7 @@ cleanup:
 		cpuinfo_mock_close(file);
 #else
 		close(file);
+		cpuinfo_linux_count_file_syscalls(1);
 #endif
 		file = -1;
 	}
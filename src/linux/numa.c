@@ -0,0 +1,312 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo/log.h>
+#include <linux/api.h>
+
+#define NODE_ONLINE_FILENAME "/sys/devices/system/node/online"
+#define NODE_FILENAME_MAX 64
+#define NODE_MEMINFO_FILESIZE 4096
+/* Each distance takes at most 3 digits and a separator */
+#define NODE_DISTANCE_FILESIZE(nodes_count) (4 * (size_t)(nodes_count) + 64)
+
+/* Distances used by the kernel when firmware does not report them */
+#define LOCAL_DISTANCE 10
+#define REMOTE_DISTANCE 20
+#define MAX_DISTANCE 255
+
+static inline bool is_whitespace(char c) {
+	switch (c) {
+		case ' ':
+		case '\t':
+		case '\n':
+		case '\r':
+			return true;
+		default:
+			return false;
+	}
+}
+
+static const char* parse_number(const char* start, const char* end, uint64_t number_ptr[restrict static 1]) {
+	uint64_t number = 0;
+	const char* parsed = start;
+	for (; parsed != end; parsed++) {
+		const uint32_t digit = (uint32_t)(uint8_t)(*parsed) - (uint32_t)'0';
+		if (digit >= 10) {
+			break;
+		}
+		number = number * UINT64_C(10) + digit;
+	}
+	*number_ptr = number;
+	return parsed;
+}
+
+struct node_list_context {
+	uint32_t nodes_count;
+	uint32_t max_nodes_count;
+	/* NULL when only counting nodes */
+	uint32_t* node_ids;
+};
+
+static bool node_list_parser(uint32_t node_list_start, uint32_t node_list_end, void* context) {
+	struct node_list_context* node_list_context = (struct node_list_context*)context;
+	for (uint32_t node = node_list_start; node < node_list_end; node++) {
+		const uint32_t index = node_list_context->nodes_count;
+		if (node_list_context->node_ids != NULL && index < node_list_context->max_nodes_count) {
+			node_list_context->node_ids[index] = node;
+		}
+		node_list_context->nodes_count += 1;
+	}
+	return true;
+}
+
+struct node_cpus_context {
+	uint32_t max_processors_count;
+	uint32_t* processor_nodes;
+	uint32_t node_index;
+};
+
+static bool node_cpus_parser(uint32_t processor_list_start, uint32_t processor_list_end, void* context) {
+	const struct node_cpus_context* node_cpus_context = (const struct node_cpus_context*)context;
+	if (processor_list_end > node_cpus_context->max_processors_count) {
+		processor_list_end = node_cpus_context->max_processors_count;
+	}
+	for (uint32_t processor = processor_list_start; processor < processor_list_end; processor++) {
+		node_cpus_context->processor_nodes[processor] = node_cpus_context->node_index;
+	}
+	return true;
+}
+
+struct node_distance_context {
+	uint32_t nodes_count;
+	uint8_t* distances;
+};
+
+/* Parses a line of the distance matrix: distances to all online nodes, separated by spaces */
+static bool node_distance_parser(const char* filename, const char* text_start, const char* text_end, void* context) {
+	const struct node_distance_context* node_distance_context = (const struct node_distance_context*)context;
+	uint32_t node = 0;
+	for (const char* text = text_start; text != text_end;) {
+		if (is_whitespace(*text)) {
+			text++;
+			continue;
+		}
+		uint64_t distance;
+		const char* parsed_end = parse_number(text, text_end, &distance);
+		if (parsed_end == text) {
+			cpuinfo_log_warning(
+				"failed to parse file %s: unexpected \"%.*s\"", filename, (int)(text_end - text), text);
+			return true;
+		}
+		if (node < node_distance_context->nodes_count) {
+			node_distance_context->distances[node] =
+				(uint8_t)(distance < MAX_DISTANCE ? distance : MAX_DISTANCE);
+		}
+		node++;
+		text = parsed_end;
+	}
+	if (node != node_distance_context->nodes_count) {
+		cpuinfo_log_warning(
+			"file %s lists %" PRIu32 " distances for %" PRIu32 " nodes",
+			filename,
+			node,
+			node_distance_context->nodes_count);
+	}
+	return true;
+}
+
+/* Parses the "Node N MemTotal: X kB" line of the node meminfo file */
+static bool node_meminfo_parser(const char* filename, const char* text_start, const char* text_end, void* context) {
+	static const char mem_total[] = "MemTotal:";
+	const size_t mem_total_length = sizeof(mem_total) - 1;
+	for (const char* text = text_start; (size_t)(text_end - text) >= mem_total_length; text++) {
+		if (memcmp(text, mem_total, mem_total_length) == 0) {
+			text += mem_total_length;
+			while (text != text_end && is_whitespace(*text)) {
+				text++;
+			}
+			uint64_t memory_size_kb;
+			if (parse_number(text, text_end, &memory_size_kb) != text) {
+				*((uint64_t*)context) = memory_size_kb * UINT64_C(1024);
+			}
+			return true;
+		}
+	}
+	cpuinfo_log_info("failed to find MemTotal in %s", filename);
+	return true;
+}
+
+bool cpuinfo_linux_detect_numa_nodes(
+	uint32_t max_processors_count,
+	struct cpuinfo_linux_numa_nodes numa[restrict static 1]) {
+	memset(numa, 0, sizeof(struct cpuinfo_linux_numa_nodes));
+
+	struct node_list_context node_list_context = {0};
+	bool has_nodes = cpuinfo_linux_parse_cpulist(NODE_ONLINE_FILENAME, node_list_parser, &node_list_context) &&
+		node_list_context.nodes_count != 0;
+	const uint32_t nodes_count = has_nodes ? node_list_context.nodes_count : 1;
+
+	/* All arrays share one allocation, with 64-bit memory sizes first for alignment */
+	const size_t allocation_size = nodes_count * sizeof(uint64_t) +
+		(3 * (size_t)nodes_count + max_processors_count) * sizeof(uint32_t) +
+		(size_t)nodes_count * nodes_count * sizeof(uint8_t);
+	char* allocation = malloc(allocation_size);
+	if (allocation == NULL) {
+		cpuinfo_log_error(
+			"failed to allocate %zu bytes for descriptions of %" PRIu32 " NUMA nodes",
+			allocation_size,
+			nodes_count);
+		return false;
+	}
+	numa->nodes_count = nodes_count;
+	numa->max_processors_count = max_processors_count;
+	numa->memory_sizes = (uint64_t*)allocation;
+	numa->node_ids = (uint32_t*)(numa->memory_sizes + nodes_count);
+	numa->first_processors = numa->node_ids + nodes_count;
+	numa->node_positions = numa->first_processors + nodes_count;
+	numa->processor_nodes = numa->node_positions + nodes_count;
+	numa->distances = (uint8_t*)(numa->processor_nodes + max_processors_count);
+
+	memset(numa->memory_sizes, 0, nodes_count * sizeof(uint64_t));
+	for (uint32_t i = 0; i < nodes_count; i++) {
+		for (uint32_t j = 0; j < nodes_count; j++) {
+			numa->distances[i * nodes_count + j] = i == j ? LOCAL_DISTANCE : REMOTE_DISTANCE;
+		}
+	}
+
+	if (has_nodes) {
+		node_list_context = (struct node_list_context){
+			.max_nodes_count = nodes_count,
+			.node_ids = numa->node_ids,
+		};
+		if (!cpuinfo_linux_parse_cpulist(NODE_ONLINE_FILENAME, node_list_parser, &node_list_context) ||
+		    node_list_context.nodes_count != nodes_count) {
+			cpuinfo_log_warning("list of NUMA nodes in %s changed during detection", NODE_ONLINE_FILENAME);
+			has_nodes = false;
+		}
+	}
+	if (!has_nodes) {
+		cpuinfo_log_debug("no NUMA nodes reported in %s, assuming a single node", NODE_ONLINE_FILENAME);
+		numa->nodes_count = 1;
+		numa->node_ids[0] = 0;
+		for (uint32_t i = 0; i < max_processors_count; i++) {
+			numa->processor_nodes[i] = 0;
+		}
+		return true;
+	}
+
+	for (uint32_t i = 0; i < max_processors_count; i++) {
+		numa->processor_nodes[i] = UINT32_MAX;
+	}
+	for (uint32_t i = 0; i < nodes_count; i++) {
+		char filename[NODE_FILENAME_MAX];
+
+		snprintf(filename, NODE_FILENAME_MAX, "/sys/devices/system/node/node%" PRIu32 "/cpulist", numa->node_ids[i]);
+		struct node_cpus_context node_cpus_context = {
+			.max_processors_count = max_processors_count,
+			.processor_nodes = numa->processor_nodes,
+			.node_index = i,
+		};
+		cpuinfo_linux_parse_cpulist(filename, node_cpus_parser, &node_cpus_context);
+
+		snprintf(filename, NODE_FILENAME_MAX, "/sys/devices/system/node/node%" PRIu32 "/distance", numa->node_ids[i]);
+		struct node_distance_context node_distance_context = {
+			.nodes_count = nodes_count,
+			.distances = &numa->distances[i * nodes_count],
+		};
+		cpuinfo_linux_parse_small_file(
+			filename, NODE_DISTANCE_FILESIZE(nodes_count), node_distance_parser, &node_distance_context);
+
+		snprintf(filename, NODE_FILENAME_MAX, "/sys/devices/system/node/node%" PRIu32 "/meminfo", numa->node_ids[i]);
+		cpuinfo_linux_parse_small_file(filename, NODE_MEMINFO_FILESIZE, node_meminfo_parser, &numa->memory_sizes[i]);
+
+		cpuinfo_log_debug(
+			"NUMA node %" PRIu32 ": %" PRIu64 " bytes of memory", numa->node_ids[i], numa->memory_sizes[i]);
+	}
+	return true;
+}
+
+void cpuinfo_linux_build_numa_nodes(
+	struct cpuinfo_linux_numa_nodes numa[restrict static 1],
+	uint32_t processors_count,
+	struct cpuinfo_processor processors[restrict static processors_count],
+	uint32_t cores_count,
+	const struct cpuinfo_core cores[restrict static cores_count],
+	struct cpuinfo_numa_node* nodes,
+	uint8_t* distances) {
+	const uint32_t nodes_count = numa->nodes_count;
+	uint32_t* first_processors = numa->first_processors;
+	uint32_t* node_positions = numa->node_positions;
+
+	for (uint32_t i = 0; i < nodes_count; i++) {
+		first_processors[i] = UINT32_MAX;
+	}
+	for (uint32_t i = processors_count; i != 0; i--) {
+		const uint32_t linux_id = (uint32_t)processors[i - 1].linux_id;
+		if (linux_id < numa->max_processors_count && numa->processor_nodes[linux_id] < nodes_count) {
+			first_processors[numa->processor_nodes[linux_id]] = i - 1;
+		}
+	}
+
+	/* Order nodes by their first processor; nodes without processors go last, by ID */
+	for (uint32_t i = 0; i < nodes_count; i++) {
+		uint32_t position = 0;
+		for (uint32_t j = 0; j < nodes_count; j++) {
+			if (first_processors[j] < first_processors[i] ||
+			    (first_processors[j] == first_processors[i] && numa->node_ids[j] < numa->node_ids[i])) {
+				position++;
+			}
+		}
+		node_positions[i] = position;
+		nodes[position] = (struct cpuinfo_numa_node){
+			.node_id = numa->node_ids[i],
+			.processor_start = first_processors[i] != UINT32_MAX ? first_processors[i] : 0,
+			.package = first_processors[i] != UINT32_MAX ? processors[first_processors[i]].package : NULL,
+			.memory_size = numa->memory_sizes[i],
+		};
+	}
+	for (uint32_t i = 0; i < nodes_count; i++) {
+		for (uint32_t j = 0; j < nodes_count; j++) {
+			distances[node_positions[i] * nodes_count + node_positions[j]] =
+				numa->distances[i * nodes_count + j];
+		}
+	}
+
+	bool contiguous = true;
+	for (uint32_t i = 0; i < processors_count; i++) {
+		const uint32_t linux_id = (uint32_t)processors[i].linux_id;
+		if (linux_id >= numa->max_processors_count || numa->processor_nodes[linux_id] >= nodes_count) {
+			cpuinfo_log_warning("failed to detect NUMA node of processor %" PRIu32, linux_id);
+			continue;
+		}
+		struct cpuinfo_numa_node* node = &nodes[node_positions[numa->processor_nodes[linux_id]]];
+		if (contiguous && node->processor_start + node->processor_count != i) {
+			cpuinfo_log_warning(
+				"processors of NUMA node %" PRIu32 " are not contiguous in the processor table",
+				node->node_id);
+			contiguous = false;
+		}
+		node->processor_count += 1;
+		processors[i].numa_node = node;
+	}
+	for (uint32_t i = 0; i < cores_count; i++) {
+		struct cpuinfo_numa_node* node = (struct cpuinfo_numa_node*)processors[cores[i].processor_start].numa_node;
+		if (node != NULL) {
+			if (node->core_count == 0) {
+				node->core_start = i;
+			}
+			node->core_count += 1;
+		}
+	}
+}
+
+void cpuinfo_linux_free_numa_nodes(struct cpuinfo_linux_numa_nodes numa[restrict static 1]) {
+	free(numa->memory_sizes);
+	memset(numa, 0, sizeof(struct cpuinfo_linux_numa_nodes));
+}
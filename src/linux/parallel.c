@@ -0,0 +1,111 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if CPUINFO_PARALLEL_INIT
+#include <pthread.h>
+#endif
+
+#include <cpuinfo/log.h>
+#include <linux/api.h>
+
+#if CPUINFO_PARALLEL_INIT
+#define PARALLEL_INIT_VARIABLE "CPUINFO_PARALLEL_INIT"
+#define MAX_WORKERS 64
+/* Workers with fewer processors to detect do not pay off the thread creation */
+#define MIN_PROCESSORS_PER_WORKER 16
+/* Number of consecutive processors a worker claims at once */
+#define PROCESSORS_PER_CHUNK 8
+
+struct worker_pool {
+	uint32_t next_processor;
+	uint32_t processors_count;
+	cpuinfo_processor_function function;
+	void* context;
+};
+
+static void run_worker(struct worker_pool* pool) {
+	const uint32_t processors_count = pool->processors_count;
+	for (;;) {
+		const uint32_t chunk_start =
+			__atomic_fetch_add(&pool->next_processor, PROCESSORS_PER_CHUNK, __ATOMIC_RELAXED);
+		if (chunk_start >= processors_count) {
+			return;
+		}
+		uint32_t chunk_end = chunk_start + PROCESSORS_PER_CHUNK;
+		if (chunk_end > processors_count) {
+			chunk_end = processors_count;
+		}
+		for (uint32_t processor = chunk_start; processor < chunk_end; processor++) {
+			pool->function(processor, pool->context);
+		}
+	}
+}
+
+static void* worker_thread(void* pool) {
+	run_worker((struct worker_pool*)pool);
+	return NULL;
+}
+
+static uint32_t get_workers_count(uint32_t processors_count) {
+	const char* value = getenv(PARALLEL_INIT_VARIABLE);
+	if (value == NULL || *value == '\0') {
+		return 1;
+	}
+
+	char* value_end = NULL;
+	unsigned long workers_count = strtoul(value, &value_end, 10);
+	if (*value_end != '\0') {
+		cpuinfo_log_warning("ignored invalid %s value \"%s\"", PARALLEL_INIT_VARIABLE, value);
+		return 1;
+	}
+	if (workers_count > MAX_WORKERS) {
+		workers_count = MAX_WORKERS;
+	}
+	if (workers_count > processors_count / MIN_PROCESSORS_PER_WORKER) {
+		workers_count = processors_count / MIN_PROCESSORS_PER_WORKER;
+	}
+	return workers_count != 0 ? (uint32_t)workers_count : 1;
+}
+#endif
+
+void cpuinfo_linux_for_each_processor(
+	uint32_t processors_count,
+	cpuinfo_processor_function function,
+	void* context) {
+#if CPUINFO_PARALLEL_INIT
+	const uint32_t workers_count = get_workers_count(processors_count);
+	if (workers_count > 1) {
+		struct worker_pool pool = {
+			.next_processor = 0,
+			.processors_count = processors_count,
+			.function = function,
+			.context = context,
+		};
+		pthread_t threads[MAX_WORKERS - 1];
+		uint32_t threads_count = 0;
+		while (threads_count < workers_count - 1) {
+			if (pthread_create(&threads[threads_count], NULL, worker_thread, &pool) != 0) {
+				cpuinfo_log_warning(
+					"failed to create detection thread, continuing with %" PRIu32 " threads",
+					threads_count + 1);
+				break;
+			}
+			threads_count += 1;
+		}
+
+		/* The calling thread takes part in detection, and also finishes it if no thread started */
+		run_worker(&pool);
+		for (uint32_t i = 0; i < threads_count; i++) {
+			pthread_join(threads[i], NULL);
+		}
+		cpuinfo_log_debug(
+			"detected %" PRIu32 " processors on %" PRIu32 " threads", processors_count, threads_count + 1);
+		return;
+	}
+#endif
+
+	for (uint32_t processor = 0; processor < processors_count; processor++) {
+		function(processor, context);
+	}
+}
@@ -15,41 +15,36 @@
 #include <cpuinfo/log.h>
 #include <linux/api.h>
 
-#define STRINGIFY(token) #token
-
 #define KERNEL_MAX_FILENAME "/sys/devices/system/cpu/kernel_max"
 #define KERNEL_MAX_FILESIZE 32
-#define FREQUENCY_FILENAME_SIZE \
-	(sizeof("/sys/devices/system/cpu/cpu" STRINGIFY(UINT32_MAX) "/cpufreq/cpuinfo_max_freq"))
-#define CUR_FREQUENCY_FILENAME_FORMAT "/sys/devices/system/cpu/cpu%" PRIu32 "/cpufreq/cpuinfo_cur_freq"
-#define MAX_FREQUENCY_FILENAME_FORMAT "/sys/devices/system/cpu/cpu%" PRIu32 "/cpufreq/cpuinfo_max_freq"
-#define MIN_FREQUENCY_FILENAME_FORMAT "/sys/devices/system/cpu/cpu%" PRIu32 "/cpufreq/cpuinfo_min_freq"
+#define CUR_FREQUENCY_ATTRIBUTE "cpufreq/cpuinfo_cur_freq"
+#define MAX_FREQUENCY_ATTRIBUTE "cpufreq/cpuinfo_max_freq"
+#define MIN_FREQUENCY_ATTRIBUTE "cpufreq/cpuinfo_min_freq"
+#define BASE_FREQUENCY_ATTRIBUTE "cpufreq/base_frequency"
+#define SCALING_MAX_FREQUENCY_ATTRIBUTE "cpufreq/scaling_max_freq"
 #define FREQUENCY_FILESIZE 32
-#define PACKAGE_ID_FILENAME_SIZE \
-	(sizeof("/sys/devices/system/cpu/cpu" STRINGIFY(UINT32_MAX) "/topology/physical_package_id"))
-#define PACKAGE_ID_FILENAME_FORMAT "/sys/devices/system/cpu/cpu%" PRIu32 "/topology/physical_package_id"
+#define CAPACITY_ATTRIBUTE "cpu_capacity"
+#define CAPACITY_FILESIZE 32
+#define PREFCORE_RANKING_ATTRIBUTE "cpufreq/amd_pstate_prefcore_ranking"
+#define AMD_PSTATE_HIGHEST_PERF_ATTRIBUTE "cpufreq/amd_pstate_highest_perf"
+#define CPPC_HIGHEST_PERF_ATTRIBUTE "acpi_cppc/highest_perf"
+#define PERFORMANCE_FILESIZE 32
+#define PACKAGE_ID_ATTRIBUTE "topology/physical_package_id"
 #define PACKAGE_ID_FILESIZE 32
-#define CORE_ID_FILENAME_SIZE (sizeof("/sys/devices/system/cpu/cpu" STRINGIFY(UINT32_MAX) "/topology/core_id"))
-#define CORE_ID_FILENAME_FORMAT "/sys/devices/system/cpu/cpu%" PRIu32 "/topology/core_id"
+#define CORE_ID_ATTRIBUTE "topology/core_id"
 #define CORE_ID_FILESIZE 32
 
-#define CORE_CPUS_FILENAME_SIZE (sizeof("/sys/devices/system/cpu/cpu" STRINGIFY(UINT32_MAX) "/topology/core_cpus_list"))
-#define CORE_CPUS_FILENAME_FORMAT "/sys/devices/system/cpu/cpu%" PRIu32 "/topology/core_cpus_list"
-#define CORE_SIBLINGS_FILENAME_SIZE \
-	(sizeof("/sys/devices/system/cpu/cpu" STRINGIFY(UINT32_MAX) "/topology/core_siblings_list"))
-#define CORE_SIBLINGS_FILENAME_FORMAT "/sys/devices/system/cpu/cpu%" PRIu32 "/topology/core_siblings_list"
-#define CLUSTER_CPUS_FILENAME_SIZE \
-	(sizeof("/sys/devices/system/cpu/cpu" STRINGIFY(UINT32_MAX) "/topology/cluster_cpus_list"))
-#define CLUSTER_CPUS_FILENAME_FORMAT "/sys/devices/system/cpu/cpu%" PRIu32 "/topology/cluster_cpus_list"
-#define PACKAGE_CPUS_FILENAME_SIZE \
-	(sizeof("/sys/devices/system/cpu/cpu" STRINGIFY(UINT32_MAX) "/topology/package_cpus_list"))
-#define PACKAGE_CPUS_FILENAME_FORMAT "/sys/devices/system/cpu/cpu%" PRIu32 "/topology/package_cpus_list"
-#define THREAD_SIBLINGS_FILENAME_SIZE \
-	(sizeof("/sys/devices/system/cpu/cpu" STRINGIFY(UINT32_MAX) "/topology/thread_siblings_list"))
-#define THREAD_SIBLINGS_FILENAME_FORMAT "/sys/devices/system/cpu/cpu%" PRIu32 "/topology/thread_siblings_list"
+#define CORE_CPUS_ATTRIBUTE "topology/core_cpus_list"
+#define CORE_SIBLINGS_ATTRIBUTE "topology/core_siblings_list"
+#define CLUSTER_CPUS_ATTRIBUTE "topology/cluster_cpus_list"
+#define PACKAGE_CPUS_ATTRIBUTE "topology/package_cpus_list"
+#define THREAD_SIBLINGS_ATTRIBUTE "topology/thread_siblings_list"
 
 #define POSSIBLE_CPULIST_FILENAME "/sys/devices/system/cpu/possible"
 #define PRESENT_CPULIST_FILENAME "/sys/devices/system/cpu/present"
+#define ISOLATED_CPULIST_FILENAME "/sys/devices/system/cpu/isolated"
+#define NOHZ_FULL_CPULIST_FILENAME "/sys/devices/system/cpu/nohz_full"
+#define CGROUP_ISOLATED_CPULIST_FILENAME "/sys/fs/cgroup/cpuset.cpus.isolated"
 
 inline static const char* parse_number(const char* start, const char* end, uint32_t number_ptr[restrict static 1]) {
 	uint32_t number = 0;
@@ -148,73 +143,52 @@ uint32_t cpuinfo_linux_get_max_processors_count(void) {
 }
 
 uint32_t cpuinfo_linux_get_processor_cur_frequency(uint32_t processor) {
-	char cur_frequency_filename[FREQUENCY_FILENAME_SIZE];
-	const int chars_formatted =
-		snprintf(cur_frequency_filename, FREQUENCY_FILENAME_SIZE, CUR_FREQUENCY_FILENAME_FORMAT, processor);
-	if ((unsigned int)chars_formatted >= FREQUENCY_FILENAME_SIZE) {
-		cpuinfo_log_warning("failed to format filename for current frequency of processor %" PRIu32, processor);
-		return 0;
-	}
-
 	uint32_t cur_frequency;
-	if (cpuinfo_linux_parse_small_file(cur_frequency_filename, FREQUENCY_FILESIZE, uint32_parser, &cur_frequency)) {
+	if (cpuinfo_linux_parse_processor_small_file(
+		    processor, CUR_FREQUENCY_ATTRIBUTE, FREQUENCY_FILESIZE, uint32_parser, &cur_frequency)) {
 		cpuinfo_log_debug(
 			"parsed currrent frequency value of %" PRIu32 " KHz for logical processor %" PRIu32 " from %s",
 			cur_frequency,
 			processor,
-			cur_frequency_filename);
+			CUR_FREQUENCY_ATTRIBUTE);
 		return cur_frequency;
 	} else {
 		cpuinfo_log_warning(
 			"failed to parse current frequency for processor %" PRIu32 " from %s",
 			processor,
-			cur_frequency_filename);
+			CUR_FREQUENCY_ATTRIBUTE);
 		return 0;
 	}
 }
 
 uint32_t cpuinfo_linux_get_processor_max_frequency(uint32_t processor) {
-	char max_frequency_filename[FREQUENCY_FILENAME_SIZE];
-	const int chars_formatted =
-		snprintf(max_frequency_filename, FREQUENCY_FILENAME_SIZE, MAX_FREQUENCY_FILENAME_FORMAT, processor);
-	if ((unsigned int)chars_formatted >= FREQUENCY_FILENAME_SIZE) {
-		cpuinfo_log_warning("failed to format filename for max frequency of processor %" PRIu32, processor);
-		return 0;
-	}
-
 	uint32_t max_frequency;
-	if (cpuinfo_linux_parse_small_file(max_frequency_filename, FREQUENCY_FILESIZE, uint32_parser, &max_frequency)) {
+	if (cpuinfo_linux_parse_processor_small_file(
+		    processor, MAX_FREQUENCY_ATTRIBUTE, FREQUENCY_FILESIZE, uint32_parser, &max_frequency)) {
 		cpuinfo_log_debug(
 			"parsed max frequency value of %" PRIu32 " KHz for logical processor %" PRIu32 " from %s",
 			max_frequency,
 			processor,
-			max_frequency_filename);
+			MAX_FREQUENCY_ATTRIBUTE);
 		return max_frequency;
 	} else {
 		cpuinfo_log_warning(
 			"failed to parse max frequency for processor %" PRIu32 " from %s",
 			processor,
-			max_frequency_filename);
+			MAX_FREQUENCY_ATTRIBUTE);
 		return 0;
 	}
 }
 
 uint32_t cpuinfo_linux_get_processor_min_frequency(uint32_t processor) {
-	char min_frequency_filename[FREQUENCY_FILENAME_SIZE];
-	const int chars_formatted =
-		snprintf(min_frequency_filename, FREQUENCY_FILENAME_SIZE, MIN_FREQUENCY_FILENAME_FORMAT, processor);
-	if ((unsigned int)chars_formatted >= FREQUENCY_FILENAME_SIZE) {
-		cpuinfo_log_warning("failed to format filename for min frequency of processor %" PRIu32, processor);
-		return 0;
-	}
-
 	uint32_t min_frequency;
-	if (cpuinfo_linux_parse_small_file(min_frequency_filename, FREQUENCY_FILESIZE, uint32_parser, &min_frequency)) {
+	if (cpuinfo_linux_parse_processor_small_file(
+		    processor, MIN_FREQUENCY_ATTRIBUTE, FREQUENCY_FILESIZE, uint32_parser, &min_frequency)) {
 		cpuinfo_log_debug(
 			"parsed min frequency value of %" PRIu32 " KHz for logical processor %" PRIu32 " from %s",
 			min_frequency,
 			processor,
-			min_frequency_filename);
+			MIN_FREQUENCY_ATTRIBUTE);
 		return min_frequency;
 	} else {
 		/*
@@ -225,57 +199,132 @@ uint32_t cpuinfo_linux_get_processor_min_frequency(uint32_t processor) {
 		cpuinfo_log_info(
 			"failed to parse min frequency for processor %" PRIu32 " from %s",
 			processor,
-			min_frequency_filename);
+			MIN_FREQUENCY_ATTRIBUTE);
 		return 0;
 	}
 }
 
-bool cpuinfo_linux_get_processor_core_id(uint32_t processor, uint32_t core_id_ptr[restrict static 1]) {
-	char core_id_filename[PACKAGE_ID_FILENAME_SIZE];
-	const int chars_formatted =
-		snprintf(core_id_filename, CORE_ID_FILENAME_SIZE, CORE_ID_FILENAME_FORMAT, processor);
-	if ((unsigned int)chars_formatted >= CORE_ID_FILENAME_SIZE) {
-		cpuinfo_log_warning("failed to format filename for core id of processor %" PRIu32, processor);
+uint32_t cpuinfo_linux_get_processor_base_frequency(uint32_t processor) {
+	uint32_t base_frequency;
+	if (cpuinfo_linux_parse_processor_small_file(
+		    processor, BASE_FREQUENCY_ATTRIBUTE, FREQUENCY_FILESIZE, uint32_parser, &base_frequency)) {
+		cpuinfo_log_debug(
+			"parsed base frequency value of %" PRIu32 " KHz for logical processor %" PRIu32 " from %s",
+			base_frequency,
+			processor,
+			BASE_FREQUENCY_ATTRIBUTE);
+		return base_frequency;
+	} else {
+		/* Only some cpufreq drivers (e.g. intel_pstate) report base frequency */
+		cpuinfo_log_debug(
+			"failed to parse base frequency for processor %" PRIu32 " from %s",
+			processor,
+			BASE_FREQUENCY_ATTRIBUTE);
 		return 0;
 	}
+}
+
+uint32_t cpuinfo_linux_get_processor_scaling_max_frequency(uint32_t processor) {
+	uint32_t scaling_max_frequency;
+	if (cpuinfo_linux_parse_processor_small_file(
+		    processor,
+		    SCALING_MAX_FREQUENCY_ATTRIBUTE,
+		    FREQUENCY_FILESIZE,
+		    uint32_parser,
+		    &scaling_max_frequency)) {
+		cpuinfo_log_debug(
+			"parsed scaling max frequency value of %" PRIu32 " KHz for logical processor %" PRIu32 " from %s",
+			scaling_max_frequency,
+			processor,
+			SCALING_MAX_FREQUENCY_ATTRIBUTE);
+		return scaling_max_frequency;
+	} else {
+		cpuinfo_log_info(
+			"failed to parse scaling max frequency for processor %" PRIu32 " from %s",
+			processor,
+			SCALING_MAX_FREQUENCY_ATTRIBUTE);
+		return 0;
+	}
+}
+
+uint32_t cpuinfo_linux_get_processor_capacity(uint32_t processor) {
+	uint32_t capacity;
+	if (cpuinfo_linux_parse_processor_small_file(
+		    processor, CAPACITY_ATTRIBUTE, CAPACITY_FILESIZE, uint32_parser, &capacity)) {
+		cpuinfo_log_debug(
+			"parsed capacity value of %" PRIu32 " for logical processor %" PRIu32 " from %s",
+			capacity,
+			processor,
+			CAPACITY_ATTRIBUTE);
+		return capacity;
+	} else {
+		/* Only kernels with the generic arch topology driver (e.g. ARM, RISC-V) report capacity */
+		cpuinfo_log_debug(
+			"failed to parse capacity for processor %" PRIu32 " from %s", processor, CAPACITY_ATTRIBUTE);
+		return 0;
+	}
+}
+
+uint32_t cpuinfo_linux_get_processor_performance_ranking(uint32_t processor) {
+	/*
+	 * amd_pstate ranks cores by their binning when preferred core support is
+	 * enabled, and otherwise reports the highest performance of each core.
+	 * The ACPI CPPC highest performance is what the ITMT scheduler support
+	 * on Intel uses as the core priority.
+	 */
+	static const char* const attributes[] = {
+		PREFCORE_RANKING_ATTRIBUTE,
+		AMD_PSTATE_HIGHEST_PERF_ATTRIBUTE,
+		CPPC_HIGHEST_PERF_ATTRIBUTE,
+	};
+	for (size_t i = 0; i < sizeof(attributes) / sizeof(attributes[0]); i++) {
+		uint32_t ranking;
+		if (cpuinfo_linux_parse_processor_small_file(
+			    processor, attributes[i], PERFORMANCE_FILESIZE, uint32_parser, &ranking)) {
+			cpuinfo_log_debug(
+				"parsed performance ranking of %" PRIu32 " for logical processor %" PRIu32 " from %s",
+				ranking,
+				processor,
+				attributes[i]);
+			return ranking;
+		}
+	}
+	cpuinfo_log_debug("failed to parse performance ranking for processor %" PRIu32, processor);
+	return 0;
+}
 
+bool cpuinfo_linux_get_processor_core_id(uint32_t processor, uint32_t core_id_ptr[restrict static 1]) {
 	uint32_t core_id;
-	if (cpuinfo_linux_parse_small_file(core_id_filename, CORE_ID_FILESIZE, uint32_parser, &core_id)) {
+	if (cpuinfo_linux_parse_processor_small_file(
+		    processor, CORE_ID_ATTRIBUTE, CORE_ID_FILESIZE, uint32_parser, &core_id)) {
 		cpuinfo_log_debug(
 			"parsed core id value of %" PRIu32 " for logical processor %" PRIu32 " from %s",
 			core_id,
 			processor,
-			core_id_filename);
+			CORE_ID_ATTRIBUTE);
 		*core_id_ptr = core_id;
 		return true;
 	} else {
 		cpuinfo_log_info(
-			"failed to parse core id for processor %" PRIu32 " from %s", processor, core_id_filename);
+			"failed to parse core id for processor %" PRIu32 " from %s", processor, CORE_ID_ATTRIBUTE);
 		return false;
 	}
 }
 
 bool cpuinfo_linux_get_processor_package_id(uint32_t processor, uint32_t package_id_ptr[restrict static 1]) {
-	char package_id_filename[PACKAGE_ID_FILENAME_SIZE];
-	const int chars_formatted =
-		snprintf(package_id_filename, PACKAGE_ID_FILENAME_SIZE, PACKAGE_ID_FILENAME_FORMAT, processor);
-	if ((unsigned int)chars_formatted >= PACKAGE_ID_FILENAME_SIZE) {
-		cpuinfo_log_warning("failed to format filename for package id of processor %" PRIu32, processor);
-		return 0;
-	}
-
 	uint32_t package_id;
-	if (cpuinfo_linux_parse_small_file(package_id_filename, PACKAGE_ID_FILESIZE, uint32_parser, &package_id)) {
+	if (cpuinfo_linux_parse_processor_small_file(
+		    processor, PACKAGE_ID_ATTRIBUTE, PACKAGE_ID_FILESIZE, uint32_parser, &package_id)) {
 		cpuinfo_log_debug(
 			"parsed package id value of %" PRIu32 " for logical processor %" PRIu32 " from %s",
 			package_id,
 			processor,
-			package_id_filename);
+			PACKAGE_ID_ATTRIBUTE);
 		*package_id_ptr = package_id;
 		return true;
 	} else {
 		cpuinfo_log_info(
-			"failed to parse package id for processor %" PRIu32 " from %s", processor, package_id_filename);
+			"failed to parse package id for processor %" PRIu32 " from %s", processor, PACKAGE_ID_ATTRIBUTE);
 		return false;
 	}
 }
@@ -393,6 +442,112 @@ bool cpuinfo_linux_detect_present_processors(
 	}
 }
 
+bool cpuinfo_linux_detect_isolated_processors(
+	uint32_t max_processors_count,
+	uint32_t* processor0_flags,
+	uint32_t processor_struct_size,
+	uint32_t isolated_flag) {
+	struct detect_processors_context context = {
+		.max_processors_count = max_processors_count,
+		.processor0_flags = processor0_flags,
+		.processor_struct_size = processor_struct_size,
+		.detected_flag = isolated_flag,
+	};
+	/* isolcpus= processors, and processors of isolated cpuset partitions in cgroup v2 */
+	const bool isolcpus_status =
+		cpuinfo_linux_parse_cpulist(ISOLATED_CPULIST_FILENAME, detect_processor_parser, &context);
+	const bool partitions_status =
+		cpuinfo_linux_parse_cpulist(CGROUP_ISOLATED_CPULIST_FILENAME, detect_processor_parser, &context);
+	if (!isolcpus_status && !partitions_status) {
+		cpuinfo_log_info("failed to parse the list of isolated processors in %s", ISOLATED_CPULIST_FILENAME);
+		return false;
+	}
+	return true;
+}
+
+bool cpuinfo_linux_detect_nohz_full_processors(
+	uint32_t max_processors_count,
+	uint32_t* processor0_flags,
+	uint32_t processor_struct_size,
+	uint32_t nohz_full_flag) {
+	struct detect_processors_context context = {
+		.max_processors_count = max_processors_count,
+		.processor0_flags = processor0_flags,
+		.processor_struct_size = processor_struct_size,
+		.detected_flag = nohz_full_flag,
+	};
+	if (cpuinfo_linux_parse_cpulist(NOHZ_FULL_CPULIST_FILENAME, detect_processor_parser, &context)) {
+		return true;
+	} else {
+		cpuinfo_log_info("failed to parse the list of nohz_full processors in %s", NOHZ_FULL_CPULIST_FILENAME);
+		return false;
+	}
+}
+
+void cpuinfo_linux_detect_processor_flags(
+	uint32_t max_processors_count,
+	uint32_t processors_count,
+	struct cpuinfo_processor processors[restrict static processors_count]) {
+	uint32_t* linux_flags = calloc(max_processors_count, sizeof(uint32_t));
+	if (linux_flags == NULL) {
+		cpuinfo_log_error(
+			"failed to allocate %zu bytes for flags of %" PRIu32 " logical processors",
+			max_processors_count * sizeof(uint32_t),
+			max_processors_count);
+		return;
+	}
+
+	cpuinfo_linux_detect_isolated_processors(
+		max_processors_count, linux_flags, sizeof(uint32_t), CPUINFO_PROCESSOR_ISOLATED);
+	cpuinfo_linux_detect_nohz_full_processors(
+		max_processors_count, linux_flags, sizeof(uint32_t), CPUINFO_PROCESSOR_NOHZ_FULL);
+
+	for (uint32_t i = 0; i < processors_count; i++) {
+		const uint32_t linux_id = (uint32_t)processors[i].linux_id;
+		uint32_t flags = linux_id < max_processors_count ? linux_flags[linux_id] : 0;
+		if ((flags & (CPUINFO_PROCESSOR_ISOLATED | CPUINFO_PROCESSOR_NOHZ_FULL)) == 0) {
+			flags |= CPUINFO_PROCESSOR_HOUSEKEEPING;
+		}
+		processors[i].flags = flags;
+	}
+	free(linux_flags);
+}
+
+static bool allowed_siblings_parser(uint32_t processor, uint32_t siblings_start, uint32_t siblings_end, void* context) {
+	return detect_processor_parser(siblings_start, siblings_end, context);
+}
+
+bool cpuinfo_linux_detect_allowed_processors(
+	uint32_t max_processors_count,
+	uint32_t* processor0_flags,
+	uint32_t processor_struct_size,
+	uint32_t allowed_flag) {
+	struct cpuinfo_affinity_mask affinity = {0};
+	if (!cpuinfo_get_thread_affinity(0, &affinity)) {
+		return false;
+	}
+	struct detect_processors_context context = {
+		.max_processors_count = max_processors_count,
+		.processor0_flags = processor0_flags,
+		.processor_struct_size = processor_struct_size,
+		.detected_flag = allowed_flag,
+	};
+	for (uint32_t processor = 0; processor < max_processors_count; processor++) {
+		const uint32_t flags = *((const uint32_t*)((uintptr_t)processor0_flags + processor_struct_size * processor));
+		if ((flags & allowed_flag) != 0 || !cpuinfo_affinity_mask_has_processor_id(&affinity, processor)) {
+			/* Skip processors already marked as siblings of an allowed processor */
+			continue;
+		}
+		/* Cores are described completely, so SMT siblings are detected even if they are not allowed */
+		if (!cpuinfo_linux_detect_thread_siblings(
+			    max_processors_count, processor, allowed_siblings_parser, &context)) {
+			detect_processor_parser(processor, processor + 1, &context);
+		}
+	}
+	cpuinfo_affinity_mask_free(&affinity);
+	return true;
+}
+
 struct siblings_context {
 	const char* group_name;
 	uint32_t max_processors_count;
@@ -424,14 +579,6 @@ bool cpuinfo_linux_detect_core_cpus(
 	uint32_t processor,
 	cpuinfo_siblings_callback callback,
 	void* context) {
-	char core_cpus_filename[CORE_CPUS_FILENAME_SIZE];
-	const int chars_formatted =
-		snprintf(core_cpus_filename, CORE_CPUS_FILENAME_SIZE, CORE_CPUS_FILENAME_FORMAT, processor);
-	if ((unsigned int)chars_formatted >= CORE_CPUS_FILENAME_SIZE) {
-		cpuinfo_log_warning("failed to format filename for core cpus of processor %" PRIu32, processor);
-		return false;
-	}
-
 	struct siblings_context siblings_context = {
 		.group_name = "cpus",
 		.max_processors_count = max_processors_count,
@@ -439,14 +586,17 @@ bool cpuinfo_linux_detect_core_cpus(
 		.callback = callback,
 		.callback_context = context,
 	};
-	if (cpuinfo_linux_parse_cpulist(
-		    core_cpus_filename, (cpuinfo_cpulist_callback)siblings_parser, &siblings_context)) {
+	if (cpuinfo_linux_parse_processor_cpulist(
+		    processor,
+		    CORE_CPUS_ATTRIBUTE,
+		    (cpuinfo_cpulist_callback)siblings_parser,
+		    &siblings_context)) {
 		return true;
 	} else {
 		cpuinfo_log_info(
 			"failed to parse the list of core cpus for processor %" PRIu32 " from %s",
 			processor,
-			core_cpus_filename);
+			CORE_CPUS_ATTRIBUTE);
 		return false;
 	}
 }
@@ -456,14 +606,6 @@ bool cpuinfo_linux_detect_core_siblings(
 	uint32_t processor,
 	cpuinfo_siblings_callback callback,
 	void* context) {
-	char core_siblings_filename[CORE_SIBLINGS_FILENAME_SIZE];
-	const int chars_formatted =
-		snprintf(core_siblings_filename, CORE_SIBLINGS_FILENAME_SIZE, CORE_SIBLINGS_FILENAME_FORMAT, processor);
-	if ((unsigned int)chars_formatted >= CORE_SIBLINGS_FILENAME_SIZE) {
-		cpuinfo_log_warning("failed to format filename for core siblings of processor %" PRIu32, processor);
-		return false;
-	}
-
 	struct siblings_context siblings_context = {
 		.group_name = "package",
 		.max_processors_count = max_processors_count,
@@ -471,14 +613,17 @@ bool cpuinfo_linux_detect_core_siblings(
 		.callback = callback,
 		.callback_context = context,
 	};
-	if (cpuinfo_linux_parse_cpulist(
-		    core_siblings_filename, (cpuinfo_cpulist_callback)siblings_parser, &siblings_context)) {
+	if (cpuinfo_linux_parse_processor_cpulist(
+		    processor,
+		    CORE_SIBLINGS_ATTRIBUTE,
+		    (cpuinfo_cpulist_callback)siblings_parser,
+		    &siblings_context)) {
 		return true;
 	} else {
 		cpuinfo_log_info(
 			"failed to parse the list of core siblings for processor %" PRIu32 " from %s",
 			processor,
-			core_siblings_filename);
+			CORE_SIBLINGS_ATTRIBUTE);
 		return false;
 	}
 }
@@ -488,14 +633,6 @@ bool cpuinfo_linux_detect_thread_siblings(
 	uint32_t processor,
 	cpuinfo_siblings_callback callback,
 	void* context) {
-	char thread_siblings_filename[THREAD_SIBLINGS_FILENAME_SIZE];
-	const int chars_formatted = snprintf(
-		thread_siblings_filename, THREAD_SIBLINGS_FILENAME_SIZE, THREAD_SIBLINGS_FILENAME_FORMAT, processor);
-	if ((unsigned int)chars_formatted >= THREAD_SIBLINGS_FILENAME_SIZE) {
-		cpuinfo_log_warning("failed to format filename for thread siblings of processor %" PRIu32, processor);
-		return false;
-	}
-
 	struct siblings_context siblings_context = {
 		.group_name = "core",
 		.max_processors_count = max_processors_count,
@@ -503,14 +640,17 @@ bool cpuinfo_linux_detect_thread_siblings(
 		.callback = callback,
 		.callback_context = context,
 	};
-	if (cpuinfo_linux_parse_cpulist(
-		    thread_siblings_filename, (cpuinfo_cpulist_callback)siblings_parser, &siblings_context)) {
+	if (cpuinfo_linux_parse_processor_cpulist(
+		    processor,
+		    THREAD_SIBLINGS_ATTRIBUTE,
+		    (cpuinfo_cpulist_callback)siblings_parser,
+		    &siblings_context)) {
 		return true;
 	} else {
 		cpuinfo_log_info(
 			"failed to parse the list of thread siblings for processor %" PRIu32 " from %s",
 			processor,
-			thread_siblings_filename);
+			THREAD_SIBLINGS_ATTRIBUTE);
 		return false;
 	}
 }
@@ -520,14 +660,6 @@ bool cpuinfo_linux_detect_cluster_cpus(
 	uint32_t processor,
 	cpuinfo_siblings_callback callback,
 	void* context) {
-	char cluster_cpus_filename[CLUSTER_CPUS_FILENAME_SIZE];
-	const int chars_formatted =
-		snprintf(cluster_cpus_filename, CLUSTER_CPUS_FILENAME_SIZE, CLUSTER_CPUS_FILENAME_FORMAT, processor);
-	if ((unsigned int)chars_formatted >= CLUSTER_CPUS_FILENAME_SIZE) {
-		cpuinfo_log_warning("failed to format filename for cluster cpus of processor %" PRIu32, processor);
-		return false;
-	}
-
 	struct siblings_context siblings_context = {
 		.group_name = "cluster",
 		.max_processors_count = max_processors_count,
@@ -535,14 +667,17 @@ bool cpuinfo_linux_detect_cluster_cpus(
 		.callback = callback,
 		.callback_context = context,
 	};
-	if (cpuinfo_linux_parse_cpulist(
-		    cluster_cpus_filename, (cpuinfo_cpulist_callback)siblings_parser, &siblings_context)) {
+	if (cpuinfo_linux_parse_processor_cpulist(
+		    processor,
+		    CLUSTER_CPUS_ATTRIBUTE,
+		    (cpuinfo_cpulist_callback)siblings_parser,
+		    &siblings_context)) {
 		return true;
 	} else {
 		cpuinfo_log_info(
 			"failed to parse the list of cluster cpus for processor %" PRIu32 " from %s",
 			processor,
-			cluster_cpus_filename);
+			CLUSTER_CPUS_ATTRIBUTE);
 		return false;
 	}
 }
@@ -552,14 +687,6 @@ bool cpuinfo_linux_detect_package_cpus(
 	uint32_t processor,
 	cpuinfo_siblings_callback callback,
 	void* context) {
-	char package_cpus_filename[PACKAGE_CPUS_FILENAME_SIZE];
-	const int chars_formatted =
-		snprintf(package_cpus_filename, PACKAGE_CPUS_FILENAME_SIZE, PACKAGE_CPUS_FILENAME_FORMAT, processor);
-	if ((unsigned int)chars_formatted >= PACKAGE_CPUS_FILENAME_SIZE) {
-		cpuinfo_log_warning("failed to format filename for package cpus of processor %" PRIu32, processor);
-		return false;
-	}
-
 	struct siblings_context siblings_context = {
 		.group_name = "package",
 		.max_processors_count = max_processors_count,
@@ -567,14 +694,93 @@ bool cpuinfo_linux_detect_package_cpus(
 		.callback = callback,
 		.callback_context = context,
 	};
-	if (cpuinfo_linux_parse_cpulist(
-		    package_cpus_filename, (cpuinfo_cpulist_callback)siblings_parser, &siblings_context)) {
+	if (cpuinfo_linux_parse_processor_cpulist(
+		    processor,
+		    PACKAGE_CPUS_ATTRIBUTE,
+		    (cpuinfo_cpulist_callback)siblings_parser,
+		    &siblings_context)) {
 		return true;
 	} else {
 		cpuinfo_log_info(
 			"failed to parse the list of package cpus for processor %" PRIu32 " from %s",
 			processor,
-			package_cpus_filename);
+			PACKAGE_CPUS_ATTRIBUTE);
 		return false;
 	}
 }
+
+struct sibling_groups_context {
+	uint32_t* grouped_processors;
+	cpuinfo_siblings_callback callback;
+	void* callback_context;
+};
+
+static inline bool bitmap_test(const uint32_t* bitmap, uint32_t index) {
+	return (bitmap[index / 32] & (UINT32_C(1) << (index % 32))) != 0;
+}
+
+static inline void bitmap_set(uint32_t* bitmap, uint32_t index) {
+	bitmap[index / 32] |= UINT32_C(1) << (index % 32);
+}
+
+static bool sibling_groups_parser(
+	uint32_t processor,
+	uint32_t siblings_start,
+	uint32_t siblings_end,
+	struct sibling_groups_context* context) {
+	for (uint32_t sibling = siblings_start; sibling < siblings_end; sibling++) {
+		bitmap_set(context->grouped_processors, sibling);
+	}
+	return context->callback(processor, siblings_start, siblings_end, context->callback_context);
+}
+
+bool cpuinfo_linux_detect_sibling_groups(
+	uint32_t max_processors_count,
+	const uint32_t* processor0_flags,
+	uint32_t processor_struct_size,
+	uint32_t required_flags,
+	cpuinfo_siblings_detector detector,
+	cpuinfo_siblings_callback callback,
+	void* context) {
+	const size_t bitmap_size = (max_processors_count + 31) / 32 * sizeof(uint32_t);
+	uint32_t* grouped_processors = calloc(1, bitmap_size);
+	if (grouped_processors == NULL) {
+		cpuinfo_log_error(
+			"failed to allocate %zu bytes for bitmap of %" PRIu32 " processors",
+			bitmap_size,
+			max_processors_count);
+		return false;
+	}
+
+	struct sibling_groups_context groups_context = {
+		.grouped_processors = grouped_processors,
+		.callback = callback,
+		.callback_context = context,
+	};
+	bool status = true;
+	uint32_t groups_count = 0;
+	for (uint32_t processor = 0; processor < max_processors_count; processor++) {
+		const uint32_t flags =
+			*((const uint32_t*)((uintptr_t)processor0_flags + processor_struct_size * processor));
+		if ((flags & required_flags) != required_flags || bitmap_test(grouped_processors, processor)) {
+			continue;
+		}
+
+		if (!detector(
+			    max_processors_count,
+			    processor,
+			    (cpuinfo_siblings_callback)sibling_groups_parser,
+			    &groups_context)) {
+			status = false;
+			break;
+		}
+		/* Never parse the list twice, even if it does not name the processor itself */
+		bitmap_set(grouped_processors, processor);
+		groups_count += 1;
+	}
+	cpuinfo_log_debug(
+		"parsed %" PRIu32 " siblings lists for %" PRIu32 " processors", groups_count, max_processors_count);
+
+	free(grouped_processors);
+	return status;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cpuinfo/common.h>
+
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_possible_processors(
+	uint32_t max_processors_count,
+	uint32_t* processor0_flags,
+	uint32_t processor_struct_size,
+	uint32_t possible_flag);
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_present_processors(
+	uint32_t max_processors_count,
+	uint32_t* processor0_flags,
+	uint32_t processor_struct_size,
+	uint32_t present_flag);
+/*
+ * Marks the logical processors allowed for the calling thread, and their SMT
+ * siblings, with the allowed flag. Returns false if the affinity is unknown.
+ */
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_allowed_processors(
+	uint32_t max_processors_count,
+	uint32_t* processor0_flags,
+	uint32_t processor_struct_size,
+	uint32_t allowed_flag);
+
+/* Marks the logical processors isolated by isolcpus or in isolated cpuset partitions */
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_isolated_processors(
+	uint32_t max_processors_count,
+	uint32_t* processor0_flags,
+	uint32_t processor_struct_size,
+	uint32_t isolated_flag);
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_nohz_full_processors(
+	uint32_t max_processors_count,
+	uint32_t* processor0_flags,
+	uint32_t processor_struct_size,
+	uint32_t nohz_full_flag);
+/*
+ * Marks the logical processors which are in the affinity of more than twice the
+ * average number of interrupts per processor, among processors with interrupts.
+ */
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_irq_affine_processors(
+	uint32_t max_processors_count,
+	uint32_t* processor0_flags,
+	uint32_t processor_struct_size,
+	uint32_t irq_affine_flag);
+
+typedef bool (*cpuinfo_siblings_callback)(uint32_t, uint32_t, uint32_t, void*);
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_core_siblings(
+	uint32_t max_processors_count,
+	uint32_t processor,
+	cpuinfo_siblings_callback callback,
+	void* context);
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_thread_siblings(
+	uint32_t max_processors_count,
+	uint32_t processor,
+	cpuinfo_siblings_callback callback,
+	void* context);
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_cluster_cpus(
+	uint32_t max_processors_count,
+	uint32_t processor,
+	cpuinfo_siblings_callback callback,
+	void* context);
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_core_cpus(
+	uint32_t max_processors_count,
+	uint32_t processor,
+	cpuinfo_siblings_callback callback,
+	void* context);
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_package_cpus(
+	uint32_t max_processors_count,
+	uint32_t processor,
+	cpuinfo_siblings_callback callback,
+	void* context);
+
+typedef bool (*cpuinfo_siblings_detector)(uint32_t, uint32_t, cpuinfo_siblings_callback, void*);
+/*
+ * Calls the detector once per group of processors with the same siblings list.
+ * Processors without all of required_flags, or named in an already parsed list,
+ * are skipped, so each distinct list is parsed only once.
+ */
+CPUINFO_INTERNAL bool cpuinfo_linux_detect_sibling_groups(
+	uint32_t max_processors_count,
+	const uint32_t* processor0_flags,
+	uint32_t processor_struct_size,
+	uint32_t required_flags,
+	cpuinfo_siblings_detector detector,
+	cpuinfo_siblings_callback callback,
+	void* context);
@@ -16,36 +16,30 @@
 #include <cpuinfo/log.h>
 #include <linux/api.h>
 
-bool cpuinfo_linux_parse_small_file(
+/*
+ * Reads the whole file into a buffer on the stack, passes it to the callback,
+ * and closes the file. A short read ends the file if single_read is set:
+ * sysfs generates attribute files in full on the first read.
+ */
+static bool parse_small_file(
+	int file,
 	const char* filename,
 	size_t buffer_size,
+	bool single_read,
 	cpuinfo_smallfile_callback callback,
 	void* context) {
-	int file = -1;
 	bool status = false;
 	char* buffer = (char*)alloca(buffer_size);
 
-#if CPUINFO_LOG_DEBUG_PARSERS
-	cpuinfo_log_debug("parsing small file %s", filename);
-#endif
-
-#if CPUINFO_MOCK
-	file = cpuinfo_mock_open(filename, O_RDONLY);
-#else
-	file = open(filename, O_RDONLY);
-#endif
-	if (file == -1) {
-		cpuinfo_log_info("failed to open %s: %s", filename, strerror(errno));
-		goto cleanup;
-	}
-
 	size_t buffer_position = 0;
 	ssize_t bytes_read;
 	do {
+		const size_t bytes_requested = buffer_size - buffer_position;
 #if CPUINFO_MOCK
-		bytes_read = cpuinfo_mock_read(file, &buffer[buffer_position], buffer_size - buffer_position);
+		bytes_read = cpuinfo_mock_read(file, &buffer[buffer_position], bytes_requested);
 #else
-		bytes_read = read(file, &buffer[buffer_position], buffer_size - buffer_position);
+		bytes_read = read(file, &buffer[buffer_position], bytes_requested);
+		cpuinfo_linux_count_file_syscalls(1);
 #endif
 		if (bytes_read < 0) {
 			cpuinfo_log_info(
@@ -61,18 +55,59 @@ bool cpuinfo_linux_parse_small_file(
 				"failed to read file %s: insufficient buffer of size %zu", filename, buffer_size);
 			goto cleanup;
 		}
+		if (single_read && (size_t)bytes_read < bytes_requested) {
+			break;
+		}
 	} while (bytes_read != 0);
 
 	status = callback(filename, buffer, &buffer[buffer_position], context);
 
 cleanup:
-	if (file != -1) {
 #if CPUINFO_MOCK
-		cpuinfo_mock_close(file);
+	cpuinfo_mock_close(file);
 #else
-		close(file);
+	close(file);
+	cpuinfo_linux_count_file_syscalls(1);
 #endif
-		file = -1;
-	}
 	return status;
 }
+
+bool cpuinfo_linux_parse_small_file(
+	const char* filename,
+	size_t buffer_size,
+	cpuinfo_smallfile_callback callback,
+	void* context) {
+#if CPUINFO_LOG_DEBUG_PARSERS
+	cpuinfo_log_debug("parsing small file %s", filename);
+#endif
+
+#if CPUINFO_MOCK
+	const int file = cpuinfo_mock_open(filename, O_RDONLY);
+#else
+	const int file = open(filename, O_RDONLY);
+	cpuinfo_linux_count_file_syscalls(1);
+#endif
+	if (file == -1) {
+		cpuinfo_log_info("failed to open %s: %s", filename, strerror(errno));
+		return false;
+	}
+	return parse_small_file(file, filename, buffer_size, false, callback, context);
+}
+
+bool cpuinfo_linux_parse_processor_small_file(
+	uint32_t processor,
+	const char* attribute,
+	size_t buffer_size,
+	cpuinfo_smallfile_callback callback,
+	void* context) {
+	char filename[CPUINFO_LINUX_PROCESSOR_PATH_MAX];
+	const int file = cpuinfo_linux_open_processor_file(processor, attribute, filename);
+#if CPUINFO_LOG_DEBUG_PARSERS
+	cpuinfo_log_debug("parsing small file %s", filename);
+#endif
+	if (file == -1) {
+		cpuinfo_log_info("failed to open %s: %s", filename, strerror(errno));
+		return false;
+	}
+	return parse_small_file(file, filename, buffer_size, true, callback, context);
+}
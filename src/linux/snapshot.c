@@ -0,0 +1,746 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo/internal-api.h>
+#include <cpuinfo/log.h>
+#include <linux/api.h>
+
+/*
+ * Snapshot file layout (native byte order, every section aligned to 8 bytes):
+ * - struct snapshot_header
+ * - processors, cores, clusters, packages, NUMA nodes: in-memory structures with every
+ *   pointer replaced by (index + 1) into the referenced table, or 0 for NULL
+ * - NUMA distance matrix
+ * - L1I, L1D, L2, L3, L4 caches
+ * - microarchitectures (a single entry on x86)
+ * - TLBs of each microarchitecture (if SNAPSHOT_FLAG_TLBS is set)
+ * - Linux CPU to processor and core maps (indices, UINT32_MAX for none)
+ * - Linux CPU to microarchitecture index map (if SNAPSHOT_FLAG_UARCH_INDEX_MAP is set)
+ *
+ * Structure sizes are recorded in the header, so a snapshot is only accepted by a
+ * build with the same ABI.
+ */
+
+#define SNAPSHOT_MAGIC "CPUINFO"
+#define SNAPSHOT_VERSION 6
+#define SNAPSHOT_ALIGNMENT 8
+
+#define SNAPSHOT_FLAG_UARCH_INDEX_MAP UINT32_C(0x00000001)
+#define SNAPSHOT_FLAG_TLBS UINT32_C(0x00000002)
+
+#define BOOT_ID_FILENAME "/proc/sys/kernel/random/boot_id"
+#define BOOT_ID_SIZE 40
+#define BOOT_ID_FILESIZE 64
+#define POSSIBLE_CPULIST_FILENAME "/sys/devices/system/cpu/possible"
+#define PRESENT_CPULIST_FILENAME "/sys/devices/system/cpu/present"
+#define ONLINE_CPULIST_FILENAME "/sys/devices/system/cpu/online"
+#define CPULIST_FILESIZE 4096
+
+#define FNV1A_OFFSET_BASIS UINT64_C(0xCBF29CE484222325)
+#define FNV1A_PRIME UINT64_C(0x00000100000001B3)
+
+#if CPUINFO_ARCH_X86
+#define SNAPSHOT_ABI 1
+#elif CPUINFO_ARCH_X86_64
+#define SNAPSHOT_ABI 2
+#elif CPUINFO_ARCH_ARM
+#define SNAPSHOT_ABI 3
+#elif CPUINFO_ARCH_ARM64
+#define SNAPSHOT_ABI 4
+#elif CPUINFO_ARCH_RISCV32
+#define SNAPSHOT_ABI 5
+#elif CPUINFO_ARCH_RISCV64
+#define SNAPSHOT_ABI 6
+#else
+#define SNAPSHOT_ABI 0
+#endif
+
+struct snapshot_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t abi;
+	uint32_t header_size;
+	uint32_t processor_size;
+	uint32_t core_size;
+	uint32_t cluster_size;
+	uint32_t package_size;
+	uint32_t numa_node_size;
+	uint32_t cache_size;
+	uint32_t uarch_size;
+	uint32_t tlbs_size;
+	char boot_id[BOOT_ID_SIZE];
+	uint64_t possible_cpus_hash;
+	uint64_t present_cpus_hash;
+	uint64_t online_cpus_hash;
+	uint32_t processors_count;
+	uint32_t cores_count;
+	uint32_t clusters_count;
+	uint32_t packages_count;
+	uint32_t numa_nodes_count;
+	uint32_t cache_count[cpuinfo_cache_level_max];
+	uint32_t uarchs_count;
+	uint32_t linux_cpu_max;
+	uint32_t max_cache_size;
+	uint32_t flags;
+	uint64_t size;
+};
+
+struct snapshot_layout {
+	uint64_t processors;
+	uint64_t cores;
+	uint64_t clusters;
+	uint64_t packages;
+	uint64_t numa_nodes;
+	uint64_t numa_distances;
+	uint64_t cache[cpuinfo_cache_level_max];
+	uint64_t uarchs;
+	uint64_t tlbs;
+	uint64_t processor_map;
+	uint64_t core_map;
+	uint64_t uarch_index_map;
+	uint64_t size;
+};
+
+/* Identity of the running system: the snapshot is only valid for the same boot and CPU masks */
+struct snapshot_identity {
+	char boot_id[BOOT_ID_SIZE];
+	uint64_t possible_cpus_hash;
+	uint64_t present_cpus_hash;
+	uint64_t online_cpus_hash;
+};
+
+static inline uint64_t reserve(uint64_t offset[restrict static 1], uint64_t count, uint64_t element_size) {
+	const uint64_t start = (*offset + (SNAPSHOT_ALIGNMENT - 1)) & -(uint64_t)SNAPSHOT_ALIGNMENT;
+	*offset = start + count * element_size;
+	return start;
+}
+
+static void compute_layout(const struct snapshot_header* header, struct snapshot_layout* layout) {
+	uint64_t offset = sizeof(struct snapshot_header);
+	layout->processors = reserve(&offset, header->processors_count, sizeof(struct cpuinfo_processor));
+	layout->cores = reserve(&offset, header->cores_count, sizeof(struct cpuinfo_core));
+	layout->clusters = reserve(&offset, header->clusters_count, sizeof(struct cpuinfo_cluster));
+	layout->packages = reserve(&offset, header->packages_count, sizeof(struct cpuinfo_package));
+	layout->numa_nodes = reserve(&offset, header->numa_nodes_count, sizeof(struct cpuinfo_numa_node));
+	layout->numa_distances =
+		reserve(&offset, (uint64_t)header->numa_nodes_count * header->numa_nodes_count, sizeof(uint8_t));
+	for (uint32_t i = 0; i < cpuinfo_cache_level_max; i++) {
+		layout->cache[i] = reserve(&offset, header->cache_count[i], sizeof(struct cpuinfo_cache));
+	}
+	layout->uarchs = reserve(&offset, header->uarchs_count, sizeof(struct cpuinfo_uarch_info));
+	const uint32_t tlbs_count = (header->flags & SNAPSHOT_FLAG_TLBS) ? header->uarchs_count : 0;
+	layout->tlbs = reserve(&offset, tlbs_count, sizeof(struct cpuinfo_tlbs));
+	layout->processor_map = reserve(&offset, header->linux_cpu_max, sizeof(uint32_t));
+	layout->core_map = reserve(&offset, header->linux_cpu_max, sizeof(uint32_t));
+	const uint32_t uarch_index_map_count =
+		(header->flags & SNAPSHOT_FLAG_UARCH_INDEX_MAP) ? header->linux_cpu_max : 0;
+	layout->uarch_index_map = reserve(&offset, uarch_index_map_count, sizeof(uint32_t));
+	layout->size = offset;
+}
+
+static bool boot_id_parser(const char* filename, const char* text_start, const char* text_end, void* context) {
+	char* boot_id = (char*)context;
+	size_t length = (size_t)(text_end - text_start);
+	while (length != 0 && (text_start[length - 1] == '\n' || text_start[length - 1] == ' ')) {
+		length--;
+	}
+	if (length == 0 || length >= BOOT_ID_SIZE) {
+		cpuinfo_log_info("unexpected boot ID length %zu in %s", length, filename);
+		return false;
+	}
+	memcpy(boot_id, text_start, length);
+	return true;
+}
+
+static bool hash_parser(const char* filename, const char* text_start, const char* text_end, void* context) {
+	uint64_t hash = FNV1A_OFFSET_BASIS;
+	for (const char* c = text_start; c != text_end; c++) {
+		hash = (hash ^ (uint64_t)(uint8_t)*c) * FNV1A_PRIME;
+	}
+	*((uint64_t*)context) = hash;
+	return true;
+}
+
+static bool read_identity(struct snapshot_identity identity[restrict static 1]) {
+	memset(identity, 0, sizeof(struct snapshot_identity));
+	if (!cpuinfo_linux_parse_small_file(BOOT_ID_FILENAME, BOOT_ID_FILESIZE, boot_id_parser, identity->boot_id)) {
+		cpuinfo_log_info("failed to read boot ID from %s", BOOT_ID_FILENAME);
+		return false;
+	}
+	if (!cpuinfo_linux_parse_small_file(
+		    POSSIBLE_CPULIST_FILENAME, CPULIST_FILESIZE, hash_parser, &identity->possible_cpus_hash)) {
+		return false;
+	}
+	if (!cpuinfo_linux_parse_small_file(
+		    PRESENT_CPULIST_FILENAME, CPULIST_FILESIZE, hash_parser, &identity->present_cpus_hash)) {
+		return false;
+	}
+	if (!cpuinfo_linux_parse_small_file(
+		    ONLINE_CPULIST_FILENAME, CPULIST_FILESIZE, hash_parser, &identity->online_cpus_hash)) {
+		return false;
+	}
+	return true;
+}
+
+static inline uintptr_t encode_pointer(const void* pointer, const void* table, size_t element_size) {
+	if (pointer == NULL) {
+		return 0;
+	}
+	return (uintptr_t)((const char*)pointer - (const char*)table) / element_size + 1;
+}
+
+static inline uint32_t encode_index(const void* pointer, const void* table, size_t element_size) {
+	if (pointer == NULL) {
+		return UINT32_MAX;
+	}
+	return (uint32_t)((uintptr_t)((const char*)pointer - (const char*)table) / element_size);
+}
+
+/* Decodes a pointer encoded with encode_pointer in place; returns false if the index is out of range */
+/* Checks that [start, start + count) is within a table of table_count elements */
+static inline bool is_valid_range(uint32_t start, uint32_t count, uint32_t table_count) {
+	return start <= table_count && count <= table_count - start;
+}
+
+static inline bool decode_pointer(const void** pointer, const void* table, uint32_t count, size_t element_size) {
+	const uintptr_t encoded = (uintptr_t)*pointer;
+	if (encoded == 0) {
+		*pointer = NULL;
+		return true;
+	}
+	if (encoded > count) {
+		return false;
+	}
+	*pointer = (const char*)table + (encoded - 1) * element_size;
+	return true;
+}
+
+bool cpuinfo_linux_save_snapshot(const char* path) {
+	char* buffer = NULL;
+	char* temp_path = NULL;
+	int file = -1;
+	bool status = false;
+
+	struct snapshot_header header = {
+		.magic = SNAPSHOT_MAGIC,
+		.version = SNAPSHOT_VERSION,
+		.abi = SNAPSHOT_ABI,
+		.header_size = sizeof(struct snapshot_header),
+		.processor_size = sizeof(struct cpuinfo_processor),
+		.core_size = sizeof(struct cpuinfo_core),
+		.cluster_size = sizeof(struct cpuinfo_cluster),
+		.package_size = sizeof(struct cpuinfo_package),
+		.numa_node_size = sizeof(struct cpuinfo_numa_node),
+		.cache_size = sizeof(struct cpuinfo_cache),
+		.uarch_size = sizeof(struct cpuinfo_uarch_info),
+		.tlbs_size = sizeof(struct cpuinfo_tlbs),
+		.processors_count = cpuinfo_processors_count,
+		.cores_count = cpuinfo_cores_count,
+		.clusters_count = cpuinfo_clusters_count,
+		.packages_count = cpuinfo_packages_count,
+		.numa_nodes_count = cpuinfo_numa_nodes_count,
+#if CPUINFO_UARCH_TABLE
+		.uarchs_count = cpuinfo_uarchs_count,
+		.flags = (cpuinfo_linux_cpu_to_uarch_index_map != NULL ? SNAPSHOT_FLAG_UARCH_INDEX_MAP : 0) |
+			(cpuinfo_tlbs != NULL ? SNAPSHOT_FLAG_TLBS : 0),
+#else
+		.uarchs_count = 1,
+#endif
+		.linux_cpu_max = cpuinfo_linux_cpu_max,
+		.max_cache_size = cpuinfo_max_cache_size,
+	};
+	memcpy(header.cache_count, cpuinfo_cache_count, sizeof(header.cache_count));
+
+	struct snapshot_identity identity;
+	if (!read_identity(&identity)) {
+		goto cleanup;
+	}
+	memcpy(header.boot_id, identity.boot_id, BOOT_ID_SIZE);
+	header.possible_cpus_hash = identity.possible_cpus_hash;
+	header.present_cpus_hash = identity.present_cpus_hash;
+	header.online_cpus_hash = identity.online_cpus_hash;
+
+	struct snapshot_layout layout;
+	compute_layout(&header, &layout);
+	header.size = layout.size;
+
+	buffer = calloc(1, (size_t)layout.size);
+	if (buffer == NULL) {
+		cpuinfo_log_error("failed to allocate %" PRIu64 " bytes for topology snapshot", layout.size);
+		goto cleanup;
+	}
+	memcpy(buffer, &header, sizeof(header));
+
+	struct cpuinfo_processor* processors = (struct cpuinfo_processor*)(buffer + layout.processors);
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		processors[i] = cpuinfo_processors[i];
+		processors[i].core = (const struct cpuinfo_core*)encode_pointer(
+			cpuinfo_processors[i].core, cpuinfo_cores, sizeof(struct cpuinfo_core));
+		processors[i].cluster = (const struct cpuinfo_cluster*)encode_pointer(
+			cpuinfo_processors[i].cluster, cpuinfo_clusters, sizeof(struct cpuinfo_cluster));
+		processors[i].package = (const struct cpuinfo_package*)encode_pointer(
+			cpuinfo_processors[i].package, cpuinfo_packages, sizeof(struct cpuinfo_package));
+		processors[i].numa_node = (const struct cpuinfo_numa_node*)encode_pointer(
+			cpuinfo_processors[i].numa_node, cpuinfo_numa_nodes, sizeof(struct cpuinfo_numa_node));
+		processors[i].cache.l1i = (const struct cpuinfo_cache*)encode_pointer(
+			cpuinfo_processors[i].cache.l1i, cpuinfo_cache[cpuinfo_cache_level_1i], sizeof(struct cpuinfo_cache));
+		processors[i].cache.l1d = (const struct cpuinfo_cache*)encode_pointer(
+			cpuinfo_processors[i].cache.l1d, cpuinfo_cache[cpuinfo_cache_level_1d], sizeof(struct cpuinfo_cache));
+		processors[i].cache.l2 = (const struct cpuinfo_cache*)encode_pointer(
+			cpuinfo_processors[i].cache.l2, cpuinfo_cache[cpuinfo_cache_level_2], sizeof(struct cpuinfo_cache));
+		processors[i].cache.l3 = (const struct cpuinfo_cache*)encode_pointer(
+			cpuinfo_processors[i].cache.l3, cpuinfo_cache[cpuinfo_cache_level_3], sizeof(struct cpuinfo_cache));
+		processors[i].cache.l4 = (const struct cpuinfo_cache*)encode_pointer(
+			cpuinfo_processors[i].cache.l4, cpuinfo_cache[cpuinfo_cache_level_4], sizeof(struct cpuinfo_cache));
+	}
+
+	struct cpuinfo_core* cores = (struct cpuinfo_core*)(buffer + layout.cores);
+	for (uint32_t i = 0; i < cpuinfo_cores_count; i++) {
+		cores[i] = cpuinfo_cores[i];
+		cores[i].cluster = (const struct cpuinfo_cluster*)encode_pointer(
+			cpuinfo_cores[i].cluster, cpuinfo_clusters, sizeof(struct cpuinfo_cluster));
+		cores[i].package = (const struct cpuinfo_package*)encode_pointer(
+			cpuinfo_cores[i].package, cpuinfo_packages, sizeof(struct cpuinfo_package));
+	}
+
+	struct cpuinfo_cluster* clusters = (struct cpuinfo_cluster*)(buffer + layout.clusters);
+	for (uint32_t i = 0; i < cpuinfo_clusters_count; i++) {
+		clusters[i] = cpuinfo_clusters[i];
+		clusters[i].package = (const struct cpuinfo_package*)encode_pointer(
+			cpuinfo_clusters[i].package, cpuinfo_packages, sizeof(struct cpuinfo_package));
+	}
+
+	memcpy(buffer + layout.packages, cpuinfo_packages, cpuinfo_packages_count * sizeof(struct cpuinfo_package));
+	struct cpuinfo_numa_node* numa_nodes = (struct cpuinfo_numa_node*)(buffer + layout.numa_nodes);
+	for (uint32_t i = 0; i < cpuinfo_numa_nodes_count; i++) {
+		numa_nodes[i] = cpuinfo_numa_nodes[i];
+		numa_nodes[i].package = (const struct cpuinfo_package*)encode_pointer(
+			cpuinfo_numa_nodes[i].package, cpuinfo_packages, sizeof(struct cpuinfo_package));
+	}
+	if (cpuinfo_numa_nodes_count != 0) {
+		memcpy(buffer + layout.numa_distances,
+		       cpuinfo_numa_distances,
+		       cpuinfo_numa_nodes_count * cpuinfo_numa_nodes_count * sizeof(uint8_t));
+	}
+	for (uint32_t i = 0; i < cpuinfo_cache_level_max; i++) {
+		if (cpuinfo_cache_count[i] != 0) {
+			memcpy(buffer + layout.cache[i], cpuinfo_cache[i], cpuinfo_cache_count[i] * sizeof(struct cpuinfo_cache));
+		}
+	}
+#if CPUINFO_UARCH_TABLE
+	memcpy(buffer + layout.uarchs, cpuinfo_uarchs, cpuinfo_uarchs_count * sizeof(struct cpuinfo_uarch_info));
+	if (header.flags & SNAPSHOT_FLAG_TLBS) {
+		memcpy(buffer + layout.tlbs, cpuinfo_tlbs, cpuinfo_uarchs_count * sizeof(struct cpuinfo_tlbs));
+	}
+#else
+	memcpy(buffer + layout.uarchs, &cpuinfo_global_uarch, sizeof(struct cpuinfo_uarch_info));
+#endif
+
+	uint32_t* processor_map = (uint32_t*)(buffer + layout.processor_map);
+	uint32_t* core_map = (uint32_t*)(buffer + layout.core_map);
+	for (uint32_t i = 0; i < cpuinfo_linux_cpu_max; i++) {
+		processor_map[i] = encode_index(
+			cpuinfo_linux_cpu_to_processor_map[i], cpuinfo_processors, sizeof(struct cpuinfo_processor));
+		core_map[i] = encode_index(cpuinfo_linux_cpu_to_core_map[i], cpuinfo_cores, sizeof(struct cpuinfo_core));
+	}
+#if CPUINFO_UARCH_TABLE
+	if (header.flags & SNAPSHOT_FLAG_UARCH_INDEX_MAP) {
+		memcpy(buffer + layout.uarch_index_map,
+		       cpuinfo_linux_cpu_to_uarch_index_map,
+		       cpuinfo_linux_cpu_max * sizeof(uint32_t));
+	}
+#endif
+
+	/* Write to a temporary file and rename it so that concurrent loaders never see a partial snapshot */
+	const size_t temp_path_size = strlen(path) + sizeof(".tmp.") + 3 * sizeof(pid_t);
+	temp_path = malloc(temp_path_size);
+	if (temp_path == NULL) {
+		cpuinfo_log_error("failed to allocate %zu bytes for snapshot file name", temp_path_size);
+		goto cleanup;
+	}
+	snprintf(temp_path, temp_path_size, "%s.tmp.%ld", path, (long)getpid());
+
+	file = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (file == -1) {
+		cpuinfo_log_warning("failed to create topology snapshot %s: %s", temp_path, strerror(errno));
+		goto cleanup;
+	}
+	for (size_t position = 0; position < layout.size;) {
+		const ssize_t bytes_written = write(file, buffer + position, (size_t)layout.size - position);
+		if (bytes_written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			cpuinfo_log_warning("failed to write topology snapshot %s: %s", temp_path, strerror(errno));
+			unlink(temp_path);
+			goto cleanup;
+		}
+		position += (size_t)bytes_written;
+	}
+	close(file);
+	file = -1;
+
+	if (rename(temp_path, path) != 0) {
+		cpuinfo_log_warning("failed to rename %s to %s: %s", temp_path, path, strerror(errno));
+		unlink(temp_path);
+		goto cleanup;
+	}
+	status = true;
+
+cleanup:
+	if (file != -1) {
+		close(file);
+	}
+	free(temp_path);
+	free(buffer);
+	return status;
+}
+
+bool cpuinfo_linux_load_snapshot(const char* path) {
+	void* arena = NULL;
+	struct cpuinfo_processor* processors = NULL;
+	struct cpuinfo_core* cores = NULL;
+	struct cpuinfo_cluster* clusters = NULL;
+	struct cpuinfo_package* packages = NULL;
+	struct cpuinfo_numa_node* numa_nodes = NULL;
+	uint8_t* numa_distances = NULL;
+	struct cpuinfo_cache* caches[cpuinfo_cache_level_max] = {NULL};
+	struct cpuinfo_uarch_info* uarchs = NULL;
+	struct cpuinfo_tlbs* tlbs = NULL;
+	const struct cpuinfo_processor** linux_cpu_to_processor_map = NULL;
+	const struct cpuinfo_core** linux_cpu_to_core_map = NULL;
+	uint32_t* linux_cpu_to_uarch_index_map = NULL;
+	const char* data = MAP_FAILED;
+	size_t data_size = 0;
+	bool status = false;
+
+	const int file = open(path, O_RDONLY | O_CLOEXEC);
+	if (file == -1) {
+		cpuinfo_log_info("failed to open topology snapshot %s: %s", path, strerror(errno));
+		return false;
+	}
+
+	struct stat file_stat;
+	if (fstat(file, &file_stat) != 0 || file_stat.st_size < (off_t)sizeof(struct snapshot_header)) {
+		cpuinfo_log_info("topology snapshot %s is truncated", path);
+		goto cleanup;
+	}
+	data_size = (size_t)file_stat.st_size;
+	data = mmap(NULL, data_size, PROT_READ, MAP_PRIVATE, file, 0);
+	if (data == MAP_FAILED) {
+		cpuinfo_log_info("failed to map topology snapshot %s: %s", path, strerror(errno));
+		goto cleanup;
+	}
+
+	struct snapshot_header header;
+	memcpy(&header, data, sizeof(header));
+	if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || header.version != SNAPSHOT_VERSION ||
+	    header.abi != SNAPSHOT_ABI || header.header_size != sizeof(struct snapshot_header) ||
+	    header.processor_size != sizeof(struct cpuinfo_processor) ||
+	    header.core_size != sizeof(struct cpuinfo_core) || header.cluster_size != sizeof(struct cpuinfo_cluster) ||
+	    header.package_size != sizeof(struct cpuinfo_package) ||
+	    header.numa_node_size != sizeof(struct cpuinfo_numa_node) ||
+	    header.cache_size != sizeof(struct cpuinfo_cache) ||
+	    header.uarch_size != sizeof(struct cpuinfo_uarch_info) || header.tlbs_size != sizeof(struct cpuinfo_tlbs)) {
+		cpuinfo_log_info("topology snapshot %s was produced by an incompatible version of cpuinfo", path);
+		goto cleanup;
+	}
+	if (header.processors_count == 0 || header.cores_count == 0 || header.clusters_count == 0 ||
+	    header.packages_count == 0 || header.uarchs_count == 0 || header.linux_cpu_max == 0) {
+		cpuinfo_log_info("topology snapshot %s is empty", path);
+		goto cleanup;
+	}
+#if !CPUINFO_UARCH_TABLE
+	if (header.uarchs_count != 1 || (header.flags & SNAPSHOT_FLAG_TLBS)) {
+		cpuinfo_log_info("topology snapshot %s is malformed", path);
+		goto cleanup;
+	}
+#endif
+
+	struct snapshot_layout layout;
+	compute_layout(&header, &layout);
+	if (header.size != layout.size || layout.size != data_size) {
+		cpuinfo_log_info("topology snapshot %s is malformed", path);
+		goto cleanup;
+	}
+
+	struct snapshot_identity identity;
+	if (!read_identity(&identity)) {
+		goto cleanup;
+	}
+	if (memcmp(header.boot_id, identity.boot_id, BOOT_ID_SIZE) != 0) {
+		cpuinfo_log_info("topology snapshot %s was produced before the last reboot", path);
+		goto cleanup;
+	}
+	if (header.possible_cpus_hash != identity.possible_cpus_hash ||
+	    header.present_cpus_hash != identity.present_cpus_hash ||
+	    header.online_cpus_hash != identity.online_cpus_hash) {
+		cpuinfo_log_info("topology snapshot %s does not match the current CPU masks", path);
+		goto cleanup;
+	}
+
+	/* Same arena layout as produced by the platform initialization */
+	size_t arena_size = 0;
+	const size_t linux_cpu_to_processor_map_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, header.linux_cpu_max, sizeof(struct cpuinfo_processor*));
+	const size_t linux_cpu_to_core_map_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, header.linux_cpu_max, sizeof(struct cpuinfo_core*));
+	const size_t linux_cpu_to_uarch_index_map_offset = cpuinfo_tables_arena_reserve(
+		&arena_size,
+		(header.flags & SNAPSHOT_FLAG_UARCH_INDEX_MAP) ? header.linux_cpu_max : 0,
+		sizeof(uint32_t));
+	const size_t processors_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, header.processors_count, sizeof(struct cpuinfo_processor));
+	const size_t cores_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, header.cores_count, sizeof(struct cpuinfo_core));
+	const size_t clusters_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, header.clusters_count, sizeof(struct cpuinfo_cluster));
+	const size_t uarchs_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, header.uarchs_count, sizeof(struct cpuinfo_uarch_info));
+	const size_t tlbs_offset = cpuinfo_tables_arena_reserve(
+		&arena_size, (header.flags & SNAPSHOT_FLAG_TLBS) ? header.uarchs_count : 0, sizeof(struct cpuinfo_tlbs));
+	const enum cpuinfo_cache_level cache_order[cpuinfo_cache_level_max] = {
+		cpuinfo_cache_level_1d,
+		cpuinfo_cache_level_1i,
+		cpuinfo_cache_level_2,
+		cpuinfo_cache_level_3,
+		cpuinfo_cache_level_4,
+	};
+	size_t cache_offsets[cpuinfo_cache_level_max];
+	for (uint32_t i = 0; i < cpuinfo_cache_level_max; i++) {
+		cache_offsets[cache_order[i]] = cpuinfo_tables_arena_reserve(
+			&arena_size, header.cache_count[cache_order[i]], sizeof(struct cpuinfo_cache));
+	}
+	const size_t packages_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, header.packages_count, sizeof(struct cpuinfo_package));
+	const size_t numa_nodes_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, header.numa_nodes_count, sizeof(struct cpuinfo_numa_node));
+	const size_t numa_distances_offset = cpuinfo_tables_arena_reserve(
+		&arena_size, header.numa_nodes_count * header.numa_nodes_count, sizeof(uint8_t));
+
+	arena = cpuinfo_allocate_tables_arena(arena_size);
+	if (arena == NULL) {
+		cpuinfo_log_error(
+			"failed to allocate %zu bytes for descriptions of %" PRIu32 " logical processors",
+			arena_size,
+			header.processors_count);
+		goto cleanup;
+	}
+
+	linux_cpu_to_processor_map =
+		(const struct cpuinfo_processor**)((char*)arena + linux_cpu_to_processor_map_offset);
+	linux_cpu_to_core_map = (const struct cpuinfo_core**)((char*)arena + linux_cpu_to_core_map_offset);
+#if CPUINFO_UARCH_TABLE
+	if (header.flags & SNAPSHOT_FLAG_UARCH_INDEX_MAP) {
+		linux_cpu_to_uarch_index_map = (uint32_t*)((char*)arena + linux_cpu_to_uarch_index_map_offset);
+	}
+	uarchs = (struct cpuinfo_uarch_info*)((char*)arena + uarchs_offset);
+	if (header.flags & SNAPSHOT_FLAG_TLBS) {
+		tlbs = (struct cpuinfo_tlbs*)((char*)arena + tlbs_offset);
+	}
+#endif
+	processors = (struct cpuinfo_processor*)((char*)arena + processors_offset);
+	cores = (struct cpuinfo_core*)((char*)arena + cores_offset);
+	clusters = (struct cpuinfo_cluster*)((char*)arena + clusters_offset);
+	for (uint32_t i = 0; i < cpuinfo_cache_level_max; i++) {
+		if (header.cache_count[i] != 0) {
+			caches[i] = (struct cpuinfo_cache*)((char*)arena + cache_offsets[i]);
+		}
+	}
+	packages = (struct cpuinfo_package*)((char*)arena + packages_offset);
+	if (header.numa_nodes_count != 0) {
+		numa_nodes = (struct cpuinfo_numa_node*)((char*)arena + numa_nodes_offset);
+		numa_distances = (uint8_t*)arena + numa_distances_offset;
+	}
+
+	memcpy(processors, data + layout.processors, header.processors_count * sizeof(struct cpuinfo_processor));
+	memcpy(cores, data + layout.cores, header.cores_count * sizeof(struct cpuinfo_core));
+	memcpy(clusters, data + layout.clusters, header.clusters_count * sizeof(struct cpuinfo_cluster));
+	memcpy(packages, data + layout.packages, header.packages_count * sizeof(struct cpuinfo_package));
+	if (header.numa_nodes_count != 0) {
+		memcpy(numa_nodes, data + layout.numa_nodes, header.numa_nodes_count * sizeof(struct cpuinfo_numa_node));
+		memcpy(numa_distances,
+		       data + layout.numa_distances,
+		       header.numa_nodes_count * header.numa_nodes_count * sizeof(uint8_t));
+	}
+	for (uint32_t i = 0; i < cpuinfo_cache_level_max; i++) {
+		if (header.cache_count[i] != 0) {
+			memcpy(caches[i], data + layout.cache[i], header.cache_count[i] * sizeof(struct cpuinfo_cache));
+		}
+	}
+
+	bool valid = true;
+	for (uint32_t i = 0; i < header.processors_count; i++) {
+		valid &= decode_pointer(
+			(const void**)&processors[i].core, cores, header.cores_count, sizeof(struct cpuinfo_core));
+		valid &= decode_pointer(
+			(const void**)&processors[i].cluster, clusters, header.clusters_count, sizeof(struct cpuinfo_cluster));
+		valid &= decode_pointer(
+			(const void**)&processors[i].package, packages, header.packages_count, sizeof(struct cpuinfo_package));
+		valid &= decode_pointer(
+			(const void**)&processors[i].numa_node,
+			numa_nodes,
+			header.numa_nodes_count,
+			sizeof(struct cpuinfo_numa_node));
+		valid &= decode_pointer(
+			(const void**)&processors[i].cache.l1i,
+			caches[cpuinfo_cache_level_1i],
+			header.cache_count[cpuinfo_cache_level_1i],
+			sizeof(struct cpuinfo_cache));
+		valid &= decode_pointer(
+			(const void**)&processors[i].cache.l1d,
+			caches[cpuinfo_cache_level_1d],
+			header.cache_count[cpuinfo_cache_level_1d],
+			sizeof(struct cpuinfo_cache));
+		valid &= decode_pointer(
+			(const void**)&processors[i].cache.l2,
+			caches[cpuinfo_cache_level_2],
+			header.cache_count[cpuinfo_cache_level_2],
+			sizeof(struct cpuinfo_cache));
+		valid &= decode_pointer(
+			(const void**)&processors[i].cache.l3,
+			caches[cpuinfo_cache_level_3],
+			header.cache_count[cpuinfo_cache_level_3],
+			sizeof(struct cpuinfo_cache));
+		valid &= decode_pointer(
+			(const void**)&processors[i].cache.l4,
+			caches[cpuinfo_cache_level_4],
+			header.cache_count[cpuinfo_cache_level_4],
+			sizeof(struct cpuinfo_cache));
+	}
+	for (uint32_t i = 0; i < header.cores_count; i++) {
+		valid &= is_valid_range(cores[i].processor_start, cores[i].processor_count, header.processors_count);
+		valid &= decode_pointer(
+			(const void**)&cores[i].cluster, clusters, header.clusters_count, sizeof(struct cpuinfo_cluster));
+		valid &= decode_pointer(
+			(const void**)&cores[i].package, packages, header.packages_count, sizeof(struct cpuinfo_package));
+	}
+	for (uint32_t i = 0; i < header.clusters_count; i++) {
+		valid &= is_valid_range(clusters[i].processor_start, clusters[i].processor_count, header.processors_count);
+		valid &= is_valid_range(clusters[i].core_start, clusters[i].core_count, header.cores_count);
+		valid &= decode_pointer(
+			(const void**)&clusters[i].package, packages, header.packages_count, sizeof(struct cpuinfo_package));
+	}
+	for (uint32_t i = 0; i < header.numa_nodes_count; i++) {
+		valid &= decode_pointer(
+			(const void**)&numa_nodes[i].package, packages, header.packages_count, sizeof(struct cpuinfo_package));
+		valid &= is_valid_range(numa_nodes[i].processor_start, numa_nodes[i].processor_count, header.processors_count);
+		valid &= is_valid_range(numa_nodes[i].core_start, numa_nodes[i].core_count, header.cores_count);
+	}
+	for (uint32_t i = 0; i < header.packages_count; i++) {
+		valid &= is_valid_range(packages[i].processor_start, packages[i].processor_count, header.processors_count);
+		valid &= is_valid_range(packages[i].core_start, packages[i].core_count, header.cores_count);
+		valid &= is_valid_range(packages[i].cluster_start, packages[i].cluster_count, header.clusters_count);
+	}
+	for (uint32_t i = 0; i < cpuinfo_cache_level_max; i++) {
+		for (uint32_t j = 0; j < header.cache_count[i]; j++) {
+			valid &= is_valid_range(
+				caches[i][j].processor_start, caches[i][j].processor_count, header.processors_count);
+		}
+	}
+
+	const uint32_t* processor_map = (const uint32_t*)(data + layout.processor_map);
+	const uint32_t* core_map = (const uint32_t*)(data + layout.core_map);
+	for (uint32_t i = 0; i < header.linux_cpu_max; i++) {
+		if (processor_map[i] != UINT32_MAX) {
+			valid &= processor_map[i] < header.processors_count;
+			linux_cpu_to_processor_map[i] = &processors[processor_map[i] % header.processors_count];
+		}
+		if (core_map[i] != UINT32_MAX) {
+			valid &= core_map[i] < header.cores_count;
+			linux_cpu_to_core_map[i] = &cores[core_map[i] % header.cores_count];
+		}
+	}
+	if (linux_cpu_to_uarch_index_map != NULL) {
+		memcpy(linux_cpu_to_uarch_index_map,
+		       data + layout.uarch_index_map,
+		       header.linux_cpu_max * sizeof(uint32_t));
+		for (uint32_t i = 0; i < header.linux_cpu_max; i++) {
+			valid &= linux_cpu_to_uarch_index_map[i] < header.uarchs_count;
+		}
+	}
+	if (!valid) {
+		cpuinfo_log_info("topology snapshot %s contains out-of-range references", path);
+		goto cleanup;
+	}
+
+	/* Commit */
+	cpuinfo_begin_tables_update();
+	cpuinfo_processors = processors;
+	cpuinfo_cores = cores;
+	cpuinfo_clusters = clusters;
+	cpuinfo_packages = packages;
+	for (uint32_t i = 0; i < cpuinfo_cache_level_max; i++) {
+		cpuinfo_cache[i] = caches[i];
+		cpuinfo_cache_count[i] = header.cache_count[i];
+	}
+
+	cpuinfo_processors_count = header.processors_count;
+	cpuinfo_cores_count = header.cores_count;
+	cpuinfo_clusters_count = header.clusters_count;
+	cpuinfo_packages_count = header.packages_count;
+	cpuinfo_numa_nodes = numa_nodes;
+	cpuinfo_numa_nodes_count = header.numa_nodes_count;
+	cpuinfo_numa_distances = numa_distances;
+	cpuinfo_max_cache_size = header.max_cache_size;
+
+#if CPUINFO_UARCH_TABLE
+	memcpy(uarchs, data + layout.uarchs, header.uarchs_count * sizeof(struct cpuinfo_uarch_info));
+	cpuinfo_uarchs = uarchs;
+	cpuinfo_uarchs_count = header.uarchs_count;
+	if (tlbs != NULL) {
+		memcpy(tlbs, data + layout.tlbs, header.uarchs_count * sizeof(struct cpuinfo_tlbs));
+	}
+	cpuinfo_tlbs = tlbs;
+	cpuinfo_linux_cpu_to_uarch_index_map = linux_cpu_to_uarch_index_map;
+#else
+	memcpy(&cpuinfo_global_uarch, data + layout.uarchs, sizeof(struct cpuinfo_uarch_info));
+#endif
+	/*
+	 * ISA features are detected again rather than restored: instructions which the snapshot advertises, but the
+	 * running processor lacks, would fault.
+	 */
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+	cpuinfo_x86_init_isa();
+#elif CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+	cpuinfo_arm_linux_init_isa();
+#elif CPUINFO_ARCH_RISCV32 || CPUINFO_ARCH_RISCV64
+	cpuinfo_riscv_linux_init_isa();
+#endif
+
+	cpuinfo_linux_cpu_max = header.linux_cpu_max;
+	cpuinfo_linux_cpu_to_processor_map = linux_cpu_to_processor_map;
+	cpuinfo_linux_cpu_to_core_map = linux_cpu_to_core_map;
+	cpuinfo_tables_arena = arena;
+
+	cpuinfo_linux_init_getcpu(header.linux_cpu_max);
+
+	__sync_synchronize();
+
+	cpuinfo_is_initialized = true;
+
+	cpuinfo_end_tables_update();
+
+	arena = NULL;
+	status = true;
+
+cleanup:
+	if (data != MAP_FAILED) {
+		munmap((void*)data, data_size);
+	}
+	close(file);
+	free(arena);
+	return status;
+}
@@ -0,0 +1,114 @@
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#if CPUINFO_MOCK
+#include <cpuinfo-mock.h>
+#endif
+#include <cpuinfo/log.h>
+#include <linux/api.h>
+
+#define SYSFS_CPU_DIRECTORY "/sys/devices/system/cpu"
+
+uint32_t cpuinfo_linux_file_syscalls = 0;
+
+#if !CPUINFO_MOCK
+/*
+ * Descriptor of /sys/devices/system/cpu. Per-processor files are opened relative
+ * to it, so the kernel walks two or three path components instead of seven.
+ */
+static int sysfs_cpu_directory = -1;
+
+static int get_sysfs_cpu_directory(void) {
+	int directory = __atomic_load_n(&sysfs_cpu_directory, __ATOMIC_ACQUIRE);
+	if (directory == -1) {
+		const int new_directory = open(SYSFS_CPU_DIRECTORY, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		cpuinfo_linux_count_file_syscalls(1);
+		if (new_directory == -1) {
+			cpuinfo_log_info("failed to open %s: %s", SYSFS_CPU_DIRECTORY, strerror(errno));
+			return -1;
+		}
+		if (__atomic_compare_exchange_n(
+			    &sysfs_cpu_directory, &directory, new_directory, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+			directory = new_directory;
+		} else {
+			/* Another thread opened the directory first */
+			close(new_directory);
+			cpuinfo_linux_count_file_syscalls(1);
+		}
+	}
+	return directory;
+}
+#endif
+
+int cpuinfo_linux_open_processor_file(
+	uint32_t processor,
+	const char* attribute,
+	char path[restrict static CPUINFO_LINUX_PROCESSOR_PATH_MAX]) {
+	const int chars_formatted =
+		snprintf(path, CPUINFO_LINUX_PROCESSOR_PATH_MAX, "cpu%" PRIu32 "/%s", processor, attribute);
+	if ((unsigned int)chars_formatted >= CPUINFO_LINUX_PROCESSOR_PATH_MAX) {
+		cpuinfo_log_warning("failed to format filename for %s of processor %" PRIu32, attribute, processor);
+		errno = ENAMETOOLONG;
+		return -1;
+	}
+
+#if CPUINFO_MOCK
+	/* Mock file systems are keyed by absolute paths */
+	char absolute_path[sizeof(SYSFS_CPU_DIRECTORY "/") + CPUINFO_LINUX_PROCESSOR_PATH_MAX];
+	snprintf(absolute_path, sizeof(absolute_path), SYSFS_CPU_DIRECTORY "/%s", path);
+	return cpuinfo_mock_open(absolute_path, O_RDONLY);
+#else
+	const int directory = get_sysfs_cpu_directory();
+	if (directory == -1) {
+		return -1;
+	}
+	cpuinfo_linux_count_file_syscalls(1);
+	return openat(directory, path, O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+void cpuinfo_linux_close_processor_files(void) {
+#if !CPUINFO_MOCK
+	const int directory = __atomic_exchange_n(&sysfs_cpu_directory, -1, __ATOMIC_ACQ_REL);
+	if (directory != -1) {
+		close(directory);
+		cpuinfo_linux_count_file_syscalls(1);
+	}
+#endif
+}
+
+bool cpuinfo_linux_list_directory(const char* path, cpuinfo_directory_callback callback, void* context) {
+#if CPUINFO_MOCK
+	return cpuinfo_mock_list_directory(path, callback, context);
+#else
+	DIR* directory = opendir(path);
+	cpuinfo_linux_count_file_syscalls(1);
+	if (directory == NULL) {
+		cpuinfo_log_info("failed to open directory %s: %s", path, strerror(errno));
+		return false;
+	}
+	bool status = true;
+	for (const struct dirent* entry = readdir(directory); entry != NULL; entry = readdir(directory)) {
+		if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+			continue;
+		}
+		if (!callback(entry->d_name, context)) {
+			status = false;
+			break;
+		}
+	}
+	closedir(directory);
+	cpuinfo_linux_count_file_syscalls(1);
+	return status;
+#endif
+}
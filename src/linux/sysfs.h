@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cpuinfo/common.h>
+
+/* Number of open, read, and close calls made by the file parsers */
+extern CPUINFO_INTERNAL uint32_t cpuinfo_linux_file_syscalls;
+
+static inline void cpuinfo_linux_count_file_syscalls(uint32_t count) {
+	__atomic_fetch_add(&cpuinfo_linux_file_syscalls, count, __ATOMIC_RELAXED);
+}
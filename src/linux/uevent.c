@@ -0,0 +1,130 @@
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#if CPUINFO_MOCK
+#include <cpuinfo-mock.h>
+#endif
+#include <cpuinfo/log.h>
+#include <linux/api.h>
+
+/* Multicast group of uevents broadcast by the kernel, as opposed to those re-broadcast by udev */
+#define UEVENT_KERNEL_GROUP 1
+
+#define CPU_DEVPATH_PREFIX "/devices/system/cpu/cpu"
+
+int cpuinfo_linux_open_uevent_socket(void) {
+#if CPUINFO_MOCK
+	return cpuinfo_mock_uevent_socket();
+#else
+	const int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+	if (fd == -1) {
+		cpuinfo_log_info("failed to open uevent netlink socket: %s", strerror(errno));
+		return -1;
+	}
+	const struct sockaddr_nl address = {
+		.nl_family = AF_NETLINK,
+		.nl_groups = UEVENT_KERNEL_GROUP,
+	};
+	if (bind(fd, (const struct sockaddr*)&address, sizeof(address)) != 0) {
+		cpuinfo_log_info("failed to bind uevent netlink socket: %s", strerror(errno));
+		close(fd);
+		return -1;
+	}
+	return fd;
+#endif
+}
+
+bool cpuinfo_linux_receive_uevent(int fd, size_t capacity, char buffer[restrict static capacity], size_t* length) {
+	for (;;) {
+#if CPUINFO_MOCK
+		const ssize_t bytes_received = recv(fd, buffer, capacity - 1, MSG_DONTWAIT);
+#else
+		struct sockaddr_nl sender = {0};
+		socklen_t sender_size = sizeof(sender);
+		const ssize_t bytes_received = recvfrom(
+			fd, buffer, capacity - 1, MSG_DONTWAIT, (struct sockaddr*)&sender, &sender_size);
+		if (bytes_received >= 0 && sender.nl_pid != 0) {
+			/* Only the kernel sends uevents: ignore messages from user space */
+			continue;
+		}
+#endif
+		if (bytes_received < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno != EAGAIN && errno != EWOULDBLOCK) {
+				cpuinfo_log_warning("failed to receive uevent: %s", strerror(errno));
+			}
+			return false;
+		}
+		/* Terminate the last field of truncated messages */
+		buffer[bytes_received] = '\0';
+		*length = (size_t)bytes_received;
+		return true;
+	}
+}
+
+static bool parse_processor_number(const char* text, uint32_t processor[restrict static 1]) {
+	uint32_t number = 0;
+	const char* digits = text;
+	for (; *digits != '\0'; digits++) {
+		const uint32_t digit = (uint32_t)(uint8_t)(*digits) - (uint32_t)'0';
+		if (digit >= 10 || number > (UINT32_MAX - digit) / 10) {
+			return false;
+		}
+		number = number * 10 + digit;
+	}
+	*processor = number;
+	return digits != text;
+}
+
+/*
+ * Kernel uevents are a "ACTION@DEVPATH" header followed by "KEY=VALUE" fields,
+ * all null-terminated, e.g. "offline@/devices/system/cpu/cpu3", "ACTION=offline",
+ * "DEVPATH=/devices/system/cpu/cpu3", "SUBSYSTEM=cpu", "SEQNUM=4213".
+ */
+bool cpuinfo_linux_parse_cpu_uevent(
+	const char* message,
+	size_t length,
+	uint32_t processor[restrict static 1],
+	bool online[restrict static 1]) {
+	const char* action = NULL;
+	const char* devpath = NULL;
+	const char* subsystem = NULL;
+	for (const char* field = message; field < message + length; field += strlen(field) + 1) {
+		if (strncmp(field, "ACTION=", strlen("ACTION=")) == 0) {
+			action = field + strlen("ACTION=");
+		} else if (strncmp(field, "DEVPATH=", strlen("DEVPATH=")) == 0) {
+			devpath = field + strlen("DEVPATH=");
+		} else if (strncmp(field, "SUBSYSTEM=", strlen("SUBSYSTEM=")) == 0) {
+			subsystem = field + strlen("SUBSYSTEM=");
+		}
+	}
+	if (action == NULL || devpath == NULL || subsystem == NULL || strcmp(subsystem, "cpu") != 0) {
+		return false;
+	}
+	if (strncmp(devpath, CPU_DEVPATH_PREFIX, strlen(CPU_DEVPATH_PREFIX)) != 0 ||
+	    !parse_processor_number(devpath + strlen(CPU_DEVPATH_PREFIX), processor)) {
+		return false;
+	}
+
+	/* "add" only registers a processor device, which comes up offline */
+	if (strcmp(action, "online") == 0) {
+		*online = true;
+	} else if (strcmp(action, "offline") == 0 || strcmp(action, "remove") == 0) {
+		*online = false;
+	} else {
+		return false;
+	}
+	cpuinfo_log_debug("parsed %s uevent for logical processor %" PRIu32, action, *processor);
+	return true;
+}
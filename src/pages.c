@@ -0,0 +1,174 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cpuinfo.h>
+#include <cpuinfo/internal-api.h>
+#include <cpuinfo/log.h>
+#ifdef __linux__
+#include <linux/api.h>
+#endif
+
+/* Candidate page sizes: the base page, persistent pools, and transparent huge pages */
+#define MAX_PAGE_CANDIDATES (CPUINFO_HUGE_PAGE_SIZES_MAX + 2)
+
+struct page_candidate {
+	uint64_t page_size;
+	bool transparent;
+	uint64_t tlb_reach;
+};
+
+static uint64_t get_base_page_size(void) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+	SYSTEM_INFO system_info;
+	GetSystemInfo(&system_info);
+	return system_info.dwPageSize;
+#else
+	const long page_size = sysconf(_SC_PAGESIZE);
+	return page_size > 0 ? (uint64_t)page_size : UINT64_C(4096);
+#endif
+}
+
+bool CPUINFO_ABI cpuinfo_get_memory_pages(struct cpuinfo_memory_pages* pages) {
+	*pages = (struct cpuinfo_memory_pages){
+		.base_page_size = get_base_page_size(),
+	};
+#ifdef __linux__
+	return cpuinfo_linux_detect_memory_pages(pages);
+#else
+	return false;
+#endif
+}
+
+/* Memory mapped by the largest data TLB of the microarchitecture for pages of the specified size */
+static uint64_t get_tlb_reach(uint32_t uarch_index, uint64_t page_size) {
+	const struct cpuinfo_tlb* dtlb = cpuinfo_get_dtlb(uarch_index, page_size);
+	const struct cpuinfo_tlb* stlb = cpuinfo_get_stlb(uarch_index, page_size);
+	uint32_t entries = dtlb != NULL ? dtlb->entries : 0;
+	if (stlb != NULL && stlb->entries > entries) {
+		entries = stlb->entries;
+	}
+	return (uint64_t)entries * page_size;
+}
+
+static uint64_t get_last_level_cache_size(const struct cpuinfo_uarch_info* uarch) {
+	for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+		const struct cpuinfo_processor* processor = cpuinfo_get_processor(i);
+		if (processor != NULL && processor->core != NULL && processor->core->uarch == uarch->uarch) {
+			return cpuinfo_compute_max_cache_size(processor);
+		}
+	}
+	return cpuinfo_get_max_cache_size();
+}
+
+static void add_candidate(
+	struct page_candidate candidates[restrict static MAX_PAGE_CANDIDATES],
+	uint32_t candidates_count[restrict static 1],
+	uint64_t page_size,
+	bool transparent) {
+	/* Keep candidates sorted by page size, preferring the first source of a size */
+	uint32_t position = 0;
+	while (position < *candidates_count && candidates[position].page_size < page_size) {
+		position++;
+	}
+	if (position < *candidates_count && candidates[position].page_size == page_size) {
+		return;
+	}
+	for (uint32_t i = *candidates_count; i > position; i--) {
+		candidates[i] = candidates[i - 1];
+	}
+	candidates[position] = (struct page_candidate){
+		.page_size = page_size,
+		.transparent = transparent,
+	};
+	*candidates_count += 1;
+}
+
+bool CPUINFO_ABI cpuinfo_advise_page_size(
+	uint64_t working_set_size,
+	enum cpuinfo_access_pattern access_pattern,
+	uint32_t uarch_index,
+	struct cpuinfo_page_advice* advice) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_%s called before cpuinfo is initialized", "advise_page_size");
+	}
+	const struct cpuinfo_uarch_info* uarch = cpuinfo_get_uarch(uarch_index);
+	if (uarch == NULL) {
+		return false;
+	}
+
+	struct cpuinfo_memory_pages pages;
+	cpuinfo_get_memory_pages(&pages);
+
+	struct page_candidate candidates[MAX_PAGE_CANDIDATES];
+	uint32_t candidates_count = 0;
+	add_candidate(candidates, &candidates_count, pages.base_page_size, false);
+	/* Persistent pools are preferred over transparent huge pages, which the kernel may fail to assemble */
+	for (uint32_t i = 0; i < pages.huge_pages_count; i++) {
+		const struct cpuinfo_huge_pages* pool = &pages.huge_pages[i];
+		if (pool->free_count != 0 && (uint64_t)pool->free_count * pool->page_size >= working_set_size) {
+			add_candidate(candidates, &candidates_count, pool->page_size, false);
+		}
+	}
+	if ((pages.transparent_huge_pages == cpuinfo_transparent_huge_pages_madvise ||
+	     pages.transparent_huge_pages == cpuinfo_transparent_huge_pages_always) &&
+	    pages.transparent_huge_page_size != 0) {
+		add_candidate(candidates, &candidates_count, pages.transparent_huge_page_size, true);
+	}
+
+	bool tlb_known = false;
+	for (uint32_t i = 0; i < candidates_count; i++) {
+		candidates[i].tlb_reach = get_tlb_reach(uarch_index, candidates[i].page_size);
+		tlb_known |= candidates[i].tlb_reach != 0;
+	}
+
+	/*
+	 * Sequential accesses take a TLB miss once per page, and hardware
+	 * prefetchers overlap the page walk with the stream, so base pages
+	 * suffice. Random accesses need the working set to fit in the TLB reach:
+	 * take the smallest page size which covers it, or the page size with the
+	 * largest reach otherwise. Without TLB geometry, base pages are kept while
+	 * the working set fits in the last-level cache, where page walks are cheap.
+	 */
+	uint32_t choice = 0;
+	if (access_pattern == cpuinfo_access_pattern_random) {
+		if (tlb_known) {
+			while (choice < candidates_count && candidates[choice].tlb_reach < working_set_size) {
+				choice++;
+			}
+			if (choice == candidates_count) {
+				choice = 0;
+				for (uint32_t i = 1; i < candidates_count; i++) {
+					if (candidates[i].tlb_reach > candidates[choice].tlb_reach) {
+						choice = i;
+					}
+				}
+			}
+		} else if (working_set_size > get_last_level_cache_size(uarch)) {
+			for (uint32_t i = 1; i < candidates_count; i++) {
+				if (candidates[i].page_size <= working_set_size) {
+					choice = i;
+				}
+			}
+		}
+	}
+
+	const struct page_candidate* candidate = &candidates[choice];
+	uint64_t coverage = 100;
+	if (working_set_size != 0 && candidate->tlb_reach < working_set_size) {
+		coverage = candidate->tlb_reach * 100 / working_set_size;
+	}
+	*advice = (struct cpuinfo_page_advice){
+		.page_size = candidate->page_size,
+		.transparent = candidate->transparent,
+		.tlb_reach = candidate->tlb_reach,
+		.tlb_coverage = candidate->tlb_reach != 0 ? (uint32_t)coverage : 0,
+	};
+	return true;
+}
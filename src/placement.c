@@ -0,0 +1,765 @@
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/types.h>
+#endif
+
+#include <cpuinfo.h>
+#include <cpuinfo/internal-api.h>
+#include <cpuinfo/log.h>
+#if defined(__linux__)
+#include <linux/api.h>
+#endif
+#if CPUINFO_MOCK && defined(__linux__)
+#include <cpuinfo-mock.h>
+#endif
+
+#define MASK_WORD_BITS (sizeof(unsigned long) * CHAR_BIT)
+
+/* Initial capacity for affinity queries: the CPU_SETSIZE of glibc */
+#define DEFAULT_AFFINITY_CAPACITY 1024
+
+/* Upper bound for affinity queries, well above the largest NR_CPUS of Linux kernels */
+#define MAX_AFFINITY_CAPACITY 1048576
+
+static bool grow_mask(struct cpuinfo_affinity_mask mask[restrict static 1], uint32_t capacity) {
+	if (capacity <= mask->capacity) {
+		return true;
+	}
+	/* Double the capacity to amortize growth when processors are added one by one */
+	uint32_t new_capacity = mask->capacity != 0 ? mask->capacity : MASK_WORD_BITS;
+	while (new_capacity < capacity) {
+		new_capacity *= 2;
+	}
+	const size_t words_count = mask->capacity / MASK_WORD_BITS;
+	const size_t new_words_count = new_capacity / MASK_WORD_BITS;
+	unsigned long* bits = realloc(mask->bits, new_words_count * sizeof(unsigned long));
+	if (bits == NULL) {
+		cpuinfo_log_error(
+			"failed to allocate %zu bytes for affinity mask of %" PRIu32 " processors",
+			new_words_count * sizeof(unsigned long),
+			new_capacity);
+		return false;
+	}
+	memset(bits + words_count, 0, (new_words_count - words_count) * sizeof(unsigned long));
+	mask->bits = bits;
+	mask->capacity = new_capacity;
+	return true;
+}
+
+bool CPUINFO_ABI cpuinfo_affinity_mask_init(struct cpuinfo_affinity_mask* mask, uint32_t capacity) {
+	*mask = (struct cpuinfo_affinity_mask){0};
+	return grow_mask(mask, capacity != 0 ? capacity : 1);
+}
+
+void CPUINFO_ABI cpuinfo_affinity_mask_free(struct cpuinfo_affinity_mask* mask) {
+	free(mask->bits);
+	*mask = (struct cpuinfo_affinity_mask){0};
+}
+
+void CPUINFO_ABI cpuinfo_affinity_mask_clear(struct cpuinfo_affinity_mask* mask) {
+	if (mask->bits != NULL) {
+		memset(mask->bits, 0, mask->capacity / MASK_WORD_BITS * sizeof(unsigned long));
+	}
+}
+
+uint32_t CPUINFO_ABI cpuinfo_affinity_mask_count(const struct cpuinfo_affinity_mask* mask) {
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < mask->capacity / MASK_WORD_BITS; i++) {
+		for (unsigned long word = mask->bits[i]; word != 0; word &= word - 1) {
+			count++;
+		}
+	}
+	return count;
+}
+
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_processor_id(struct cpuinfo_affinity_mask* mask, uint32_t processor_id) {
+	if (processor_id >= MAX_AFFINITY_CAPACITY || !grow_mask(mask, processor_id + 1)) {
+		return false;
+	}
+	mask->bits[processor_id / MASK_WORD_BITS] |= 1UL << (processor_id % MASK_WORD_BITS);
+	return true;
+}
+
+bool CPUINFO_ABI cpuinfo_affinity_mask_has_processor_id(
+	const struct cpuinfo_affinity_mask* mask,
+	uint32_t processor_id) {
+	if (processor_id >= mask->capacity) {
+		return false;
+	}
+	return (mask->bits[processor_id / MASK_WORD_BITS] >> (processor_id % MASK_WORD_BITS)) & 1;
+}
+
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_processors(
+	struct cpuinfo_affinity_mask* mask,
+	const struct cpuinfo_processor* processors,
+	uint32_t processors_count) {
+#if defined(__linux__)
+	for (uint32_t i = 0; i < processors_count; i++) {
+		if (!cpuinfo_affinity_mask_add_processor_id(mask, (uint32_t)processors[i].linux_id)) {
+			return false;
+		}
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+/* Adds the logical processors of a topology object, which spans consecutive processors */
+static bool add_processor_range(
+	struct cpuinfo_affinity_mask mask[restrict static 1],
+	uint32_t processor_start,
+	uint32_t processor_count) {
+	if (processor_count == 0) {
+		return true;
+	}
+	return cpuinfo_affinity_mask_add_processors(mask, cpuinfo_get_processor(processor_start), processor_count);
+}
+
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_processor(
+	struct cpuinfo_affinity_mask* mask,
+	const struct cpuinfo_processor* processor) {
+	return cpuinfo_affinity_mask_add_processors(mask, processor, 1);
+}
+
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_core(struct cpuinfo_affinity_mask* mask, const struct cpuinfo_core* core) {
+	return add_processor_range(mask, core->processor_start, core->processor_count);
+}
+
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_cluster(
+	struct cpuinfo_affinity_mask* mask,
+	const struct cpuinfo_cluster* cluster) {
+	return add_processor_range(mask, cluster->processor_start, cluster->processor_count);
+}
+
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_package(
+	struct cpuinfo_affinity_mask* mask,
+	const struct cpuinfo_package* package) {
+	return add_processor_range(mask, package->processor_start, package->processor_count);
+}
+
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_cache(
+	struct cpuinfo_affinity_mask* mask,
+	const struct cpuinfo_cache* cache) {
+	return add_processor_range(mask, cache->processor_start, cache->processor_count);
+}
+
+bool CPUINFO_ABI cpuinfo_affinity_mask_add_numa_node(
+	struct cpuinfo_affinity_mask* mask,
+	const struct cpuinfo_numa_node* numa_node) {
+	return add_processor_range(mask, numa_node->processor_start, numa_node->processor_count);
+}
+
+#if defined(__linux__)
+static int get_affinity(pid_t thread_id, size_t set_size, unsigned long* set) {
+#if CPUINFO_MOCK
+	return cpuinfo_mock_sched_getaffinity(thread_id, set_size, set);
+#else
+	return sched_getaffinity(thread_id, set_size, (cpu_set_t*)set);
+#endif
+}
+
+static int set_affinity(pid_t thread_id, size_t set_size, const unsigned long* set) {
+#if CPUINFO_MOCK
+	return cpuinfo_mock_sched_setaffinity(thread_id, set_size, set);
+#else
+	return sched_setaffinity(thread_id, set_size, (const cpu_set_t*)set);
+#endif
+}
+#endif /* defined(__linux__) */
+
+bool CPUINFO_ABI cpuinfo_get_thread_affinity(uint32_t thread_id, struct cpuinfo_affinity_mask* mask) {
+#if defined(__linux__)
+	/* The kernel rejects masks smaller than its maximum number of processors, which it does not report */
+	uint32_t capacity = mask->capacity > DEFAULT_AFFINITY_CAPACITY ? mask->capacity : DEFAULT_AFFINITY_CAPACITY;
+	for (; capacity <= MAX_AFFINITY_CAPACITY; capacity *= 2) {
+		if (!grow_mask(mask, capacity)) {
+			return false;
+		}
+		cpuinfo_affinity_mask_clear(mask);
+		if (get_affinity((pid_t)thread_id, mask->capacity / CHAR_BIT, mask->bits) == 0) {
+			return true;
+		}
+		if (errno != EINVAL) {
+			break;
+		}
+	}
+	cpuinfo_log_warning("failed to query affinity of thread %" PRIu32 ": %s", thread_id, strerror(errno));
+	return false;
+#else
+	return false;
+#endif
+}
+
+bool CPUINFO_ABI cpuinfo_set_thread_affinity(
+	uint32_t thread_id,
+	const struct cpuinfo_affinity_mask* mask,
+	struct cpuinfo_affinity_mask* previous) {
+#if defined(__linux__)
+	struct cpuinfo_affinity_mask saved = {0};
+	if (previous != NULL && !cpuinfo_get_thread_affinity(thread_id, &saved)) {
+		return false;
+	}
+	if (mask->capacity == 0 || set_affinity((pid_t)thread_id, mask->capacity / CHAR_BIT, mask->bits) != 0) {
+		cpuinfo_log_warning(
+			"failed to set affinity of thread %" PRIu32 " to %" PRIu32 " processors: %s",
+			thread_id,
+			cpuinfo_affinity_mask_count(mask),
+			mask->capacity == 0 ? strerror(EINVAL) : strerror(errno));
+		cpuinfo_affinity_mask_free(&saved);
+		return false;
+	}
+	if (previous != NULL) {
+		cpuinfo_affinity_mask_free(previous);
+		*previous = saved;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+#if defined(__linux__)
+static bool cpuset_parser(uint32_t processor_list_start, uint32_t processor_list_end, void* context) {
+	struct cpuinfo_affinity_mask* cpuset = (struct cpuinfo_affinity_mask*)context;
+	for (uint32_t processor = processor_list_start; processor < processor_list_end; processor++) {
+		if (!cpuinfo_affinity_mask_add_processor_id(cpuset, processor)) {
+			return false;
+		}
+	}
+	return true;
+}
+#endif /* defined(__linux__) */
+
+/*
+ * Queries the processors allowed for the calling thread: its affinity, narrowed
+ * to the effective cpuset of its cgroup. The kernel applies the cpuset to the
+ * affinity of new threads, but not to threads which set their affinity before
+ * the cpuset changed. Returns false if neither is known, i.e. all processors
+ * are allowed.
+ */
+static bool get_allowed_mask(struct cpuinfo_affinity_mask allowed[restrict static 1]) {
+#if defined(__linux__)
+	bool restricted = cpuinfo_get_thread_affinity(0, allowed);
+	struct cpuinfo_affinity_mask cpuset = {0};
+	if (cpuinfo_linux_parse_cgroup_cpuset(cpuset_parser, &cpuset) && cpuinfo_affinity_mask_count(&cpuset) != 0) {
+		if (!restricted) {
+			cpuinfo_affinity_mask_free(allowed);
+			*allowed = cpuset;
+			return true;
+		}
+		const uint32_t words_count = allowed->capacity / MASK_WORD_BITS;
+		const uint32_t cpuset_words_count = cpuset.capacity / MASK_WORD_BITS;
+		unsigned long overlap = 0;
+		for (uint32_t i = 0; i < words_count && i < cpuset_words_count; i++) {
+			overlap |= allowed->bits[i] & cpuset.bits[i];
+		}
+		/* Ignore a cpuset which disagrees with the affinity, as the kernel would run the thread anyway */
+		if (overlap != 0) {
+			for (uint32_t i = 0; i < words_count; i++) {
+				allowed->bits[i] &= i < cpuset_words_count ? cpuset.bits[i] : 0;
+			}
+		}
+	}
+	cpuinfo_affinity_mask_free(&cpuset);
+	return restricted;
+#else
+	return false;
+#endif
+}
+
+static bool is_allowed(
+	const struct cpuinfo_affinity_mask allowed[restrict static 1],
+	bool restricted,
+	const struct cpuinfo_processor* processor) {
+#if defined(__linux__)
+	return !restricted || cpuinfo_affinity_mask_has_processor_id(allowed, (uint32_t)processor->linux_id);
+#else
+	return true;
+#endif
+}
+
+/* Limits the parallelism of allowed processors to the CPU bandwidth quota of the cgroup */
+static uint32_t get_effective_parallelism(uint32_t allowed_processors_count) {
+	uint32_t parallelism = allowed_processors_count * 1000;
+#if defined(__linux__)
+	uint64_t quota = 0, period = 0;
+	if (cpuinfo_linux_detect_cgroup_cpu_quota(&quota, &period)) {
+		const uint64_t quota_parallelism = quota * 1000 / period;
+		if (quota_parallelism < parallelism) {
+			parallelism = quota_parallelism != 0 ? (uint32_t)quota_parallelism : 1;
+		}
+	}
+#endif
+	return parallelism;
+}
+
+static bool has_allowed_processor(
+	const struct cpuinfo_affinity_mask allowed[restrict static 1],
+	bool restricted,
+	const struct cpuinfo_processor* processors,
+	uint32_t processor_start,
+	uint32_t processor_count) {
+	for (uint32_t i = 0; i < processor_count; i++) {
+		if (is_allowed(allowed, restricted, &processors[processor_start + i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool CPUINFO_ABI cpuinfo_get_allowed_topology(struct cpuinfo_allowed_topology* topology) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_%s called before cpuinfo is initialized", "get_allowed_topology");
+	}
+
+	*topology = (struct cpuinfo_allowed_topology){0};
+	/* Tables and counts of one generation, as cpuinfo_refresh may replace them concurrently */
+	struct cpuinfo_topology tables;
+	cpuinfo_get_topology(&tables);
+	const uint32_t processors_count = tables.processors_count;
+	const uint32_t cores_count = tables.cores_count;
+	const uint32_t clusters_count = tables.clusters_count;
+	struct cpuinfo_affinity_mask allowed = {0};
+	bool success = false;
+
+	topology->processors = calloc(processors_count, sizeof(const struct cpuinfo_processor*));
+	topology->cores = calloc(cores_count, sizeof(const struct cpuinfo_core*));
+	topology->clusters = calloc(clusters_count, sizeof(const struct cpuinfo_cluster*));
+	if (topology->processors == NULL || topology->cores == NULL || topology->clusters == NULL) {
+		cpuinfo_log_error("failed to allocate allowed topology of %" PRIu32 " processors", processors_count);
+		goto cleanup;
+	}
+
+	const bool restricted = get_allowed_mask(&allowed);
+	for (uint32_t i = 0; i < processors_count; i++) {
+		const struct cpuinfo_processor* processor = &tables.processors[i];
+		if (is_allowed(&allowed, restricted, processor)) {
+			topology->processors[topology->processors_count++] = processor;
+		}
+	}
+	for (uint32_t i = 0; i < cores_count; i++) {
+		const struct cpuinfo_core* core = &tables.cores[i];
+		if (has_allowed_processor(
+			    &allowed, restricted, tables.processors, core->processor_start, core->processor_count)) {
+			topology->cores[topology->cores_count++] = core;
+		}
+	}
+	for (uint32_t i = 0; i < clusters_count; i++) {
+		const struct cpuinfo_cluster* cluster = &tables.clusters[i];
+		if (has_allowed_processor(
+			    &allowed, restricted, tables.processors, cluster->processor_start, cluster->processor_count)) {
+			topology->clusters[topology->clusters_count++] = cluster;
+		}
+	}
+	topology->effective_parallelism = get_effective_parallelism(topology->processors_count);
+	success = true;
+
+cleanup:
+	cpuinfo_affinity_mask_free(&allowed);
+	if (!success) {
+		cpuinfo_allowed_topology_free(topology);
+	}
+	return success;
+}
+
+void CPUINFO_ABI cpuinfo_allowed_topology_free(struct cpuinfo_allowed_topology* topology) {
+	free((void*)topology->processors);
+	free((void*)topology->cores);
+	free((void*)topology->clusters);
+	*topology = (struct cpuinfo_allowed_topology){0};
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_effective_parallelism(void) {
+	struct cpuinfo_allowed_topology topology;
+	if (!cpuinfo_get_allowed_topology(&topology)) {
+		return 0;
+	}
+	const uint32_t parallelism = topology.effective_parallelism;
+	cpuinfo_allowed_topology_free(&topology);
+	return parallelism;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_recommended_worker_count(enum cpuinfo_workload workload) {
+	struct cpuinfo_allowed_topology topology;
+	if (!cpuinfo_get_allowed_topology(&topology)) {
+		return 1;
+	}
+	uint32_t workers_count;
+	switch (workload) {
+		case cpuinfo_workload_latency_bound:
+			/* A partial processor of the quota still serves requests, so round up */
+			workers_count = (topology.effective_parallelism + 999) / 1000;
+			if (workers_count > topology.processors_count) {
+				workers_count = topology.processors_count;
+			}
+			break;
+		default:
+			/* Workers beyond the whole processors of the quota only get throttled, so round down */
+			workers_count = topology.effective_parallelism / 1000;
+			if (workers_count > topology.cores_count) {
+				workers_count = topology.cores_count;
+			}
+			break;
+	}
+	cpuinfo_allowed_topology_free(&topology);
+	return workers_count != 0 ? workers_count : 1;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_select_processors(
+	uint32_t required_flags,
+	uint32_t excluded_flags,
+	const struct cpuinfo_processor** processors) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_%s called before cpuinfo is initialized", "select_processors");
+	}
+
+	uint32_t selected_count = 0;
+	/* Tables and counts of one generation, as cpuinfo_refresh may replace them concurrently */
+	struct cpuinfo_topology tables;
+	cpuinfo_get_topology(&tables);
+	const uint32_t processors_count = tables.processors_count;
+#if defined(__linux__)
+	/* Interrupt affinities are read only for selections which ask for them, rather than on every initialization */
+	uint32_t* linux_irq_flags = NULL;
+	uint32_t linux_irq_flags_count = 0;
+	if ((required_flags | excluded_flags) & CPUINFO_PROCESSOR_IRQ_AFFINE) {
+		for (uint32_t i = 0; i < processors_count; i++) {
+			const uint32_t linux_id = (uint32_t)tables.processors[i].linux_id;
+			if (linux_id >= linux_irq_flags_count) {
+				linux_irq_flags_count = linux_id + 1;
+			}
+		}
+		linux_irq_flags = calloc(linux_irq_flags_count, sizeof(uint32_t));
+		if (linux_irq_flags == NULL) {
+			cpuinfo_log_error(
+				"failed to allocate %zu bytes for interrupt flags of %" PRIu32 " logical processors",
+				linux_irq_flags_count * sizeof(uint32_t),
+				linux_irq_flags_count);
+			return 0;
+		}
+		cpuinfo_linux_detect_irq_affine_processors(
+			linux_irq_flags_count, linux_irq_flags, sizeof(uint32_t), CPUINFO_PROCESSOR_IRQ_AFFINE);
+	}
+#endif
+	for (uint32_t i = 0; i < processors_count; i++) {
+		const struct cpuinfo_processor* processor = &tables.processors[i];
+		uint32_t flags = processor->flags;
+#if defined(__linux__)
+		if (linux_irq_flags != NULL) {
+			flags |= linux_irq_flags[processor->linux_id];
+		}
+#endif
+		if ((flags & required_flags) != required_flags || (flags & excluded_flags) != 0) {
+			continue;
+		}
+		if (processors != NULL) {
+			processors[selected_count] = processor;
+		}
+		selected_count += 1;
+	}
+#if defined(__linux__)
+	free(linux_irq_flags);
+#endif
+	return selected_count;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_isolated_processors(const struct cpuinfo_processor** processors) {
+	return cpuinfo_select_processors(CPUINFO_PROCESSOR_ISOLATED, 0, processors);
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_nohz_full_processors(const struct cpuinfo_processor** processors) {
+	return cpuinfo_select_processors(CPUINFO_PROCESSOR_NOHZ_FULL, 0, processors);
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_housekeeping_processors(const struct cpuinfo_processor** processors) {
+	/* Also selects all processors on systems which do not report the flags */
+	return cpuinfo_select_processors(0, CPUINFO_PROCESSOR_ISOLATED | CPUINFO_PROCESSOR_NOHZ_FULL, processors);
+}
+
+/* Position of a usable processor in the placement order, compared lexicographically */
+struct placement_slot {
+	const struct cpuinfo_processor* processor;
+	uint32_t key[4];
+};
+
+static int compare_placement_slots(const void* a, const void* b) {
+	const struct placement_slot* slot_a = (const struct placement_slot*)a;
+	const struct placement_slot* slot_b = (const struct placement_slot*)b;
+	for (uint32_t i = 0; i < 4; i++) {
+		if (slot_a->key[i] != slot_b->key[i]) {
+			return slot_a->key[i] < slot_b->key[i] ? -1 : 1;
+		}
+	}
+	return 0;
+}
+
+/* Sets two placement keys which order the processors of faster cores first */
+static void set_core_speed_keys(const struct cpuinfo_core* core, uint32_t key[restrict static 2]) {
+	key[0] = UINT32_MAX - core->performance_ranking;
+	key[1] = UINT32_MAX - core->capacity;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_ranked_processors(const struct cpuinfo_processor** processors) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_%s called before cpuinfo is initialized", "get_ranked_processors");
+	}
+
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+	struct placement_slot* slots = calloc(processors_count, sizeof(struct placement_slot));
+	if (slots == NULL) {
+		cpuinfo_log_error("failed to allocate ranking state for %" PRIu32 " processors", processors_count);
+		return 0;
+	}
+	const struct cpuinfo_processor* all_processors = cpuinfo_get_processors();
+	for (uint32_t i = 0; i < processors_count; i++) {
+		const struct cpuinfo_processor* processor = &all_processors[i];
+		slots[i].processor = processor;
+		set_core_speed_keys(processor->core, &slots[i].key[0]);
+		slots[i].key[2] = (uint32_t)(processor->core - cpuinfo_get_cores());
+		slots[i].key[3] = i;
+	}
+	qsort(slots, processors_count, sizeof(struct placement_slot), compare_placement_slots);
+	for (uint32_t i = 0; i < processors_count; i++) {
+		processors[i] = slots[i].processor;
+	}
+	free(slots);
+	return processors_count;
+}
+
+/*
+ * Index of the last-level cache domain of a processor among the caches of its
+ * level, offset past lower levels so that indices of different levels never
+ * collide. Processors without L2 or L3 caches form a domain per package.
+ */
+static uint32_t get_llc_domain(const struct cpuinfo_processor* processor) {
+	if (processor->cache.l3 != NULL) {
+		return (uint32_t)(processor->cache.l3 - cpuinfo_get_l3_caches());
+	} else if (processor->cache.l2 != NULL) {
+		return cpuinfo_get_l3_caches_count() + (uint32_t)(processor->cache.l2 - cpuinfo_get_l2_caches());
+	} else {
+		return cpuinfo_get_l3_caches_count() + cpuinfo_get_l2_caches_count() +
+			(uint32_t)(processor->package - cpuinfo_get_packages());
+	}
+}
+
+uint32_t CPUINFO_ABI cpuinfo_plan_placement(
+	uint32_t threads_count,
+	enum cpuinfo_placement_policy policy,
+	const struct cpuinfo_processor** processors) {
+	if CPUINFO_UNLIKELY (!cpuinfo_is_initialized) {
+		cpuinfo_log_fatal("cpuinfo_%s called before cpuinfo is initialized", "plan_placement");
+	}
+
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+	const uint32_t cores_count = cpuinfo_get_cores_count();
+	const uint32_t packages_count = cpuinfo_get_packages_count();
+	const uint32_t domains_count = cpuinfo_get_l3_caches_count() + cpuinfo_get_l2_caches_count() + packages_count;
+	uint32_t distinct_count = 0;
+	struct placement_slot* slots = NULL;
+	uint32_t* counters = NULL;
+	struct cpuinfo_affinity_mask allowed = {0};
+	if (threads_count == 0 || processors_count == 0) {
+		goto cleanup;
+	}
+
+	slots = calloc(processors_count, sizeof(struct placement_slot));
+	/* Per core: usable siblings seen, rank in the domain; per domain: cores seen, rank in the package, slots */
+	counters = calloc(2 * cores_count + 3 * domains_count + packages_count, sizeof(uint32_t));
+	if (slots == NULL || counters == NULL) {
+		cpuinfo_log_error("failed to allocate placement state for %" PRIu32 " processors", processors_count);
+		goto cleanup;
+	}
+	uint32_t* core_siblings = counters;
+	uint32_t* core_ranks = core_siblings + cores_count;
+	uint32_t* domain_cores = core_ranks + cores_count;
+	uint32_t* domain_ranks = domain_cores + domains_count;
+	uint32_t* domain_slots = domain_ranks + domains_count;
+	uint32_t* package_domains = domain_slots + domains_count;
+
+	const bool restricted = get_allowed_mask(&allowed);
+	const struct cpuinfo_processor* all_processors = cpuinfo_get_processors();
+	const struct cpuinfo_core* cores = cpuinfo_get_cores();
+	uint32_t slots_count = 0, domains_used = 0;
+	for (uint32_t i = 0; i < processors_count; i++) {
+		const struct cpuinfo_processor* processor = &all_processors[i];
+		if (!is_allowed(&allowed, restricted, processor)) {
+			continue;
+		}
+		const uint32_t core = (uint32_t)(processor->core - cores);
+		const uint32_t domain = get_llc_domain(processor);
+		const uint32_t package = (uint32_t)(processor->package - cpuinfo_get_packages());
+		if (domain_cores[domain] == 0) {
+			domain_ranks[domain] = package_domains[package]++;
+			domains_used++;
+		}
+		if (core_siblings[core] == 0) {
+			core_ranks[core] = domain_cores[domain]++;
+		}
+		const uint32_t smt_rank = core_siblings[core]++;
+		if (policy == cpuinfo_placement_policy_physical_cores && smt_rank != 0) {
+			continue;
+		}
+
+		struct placement_slot* slot = &slots[slots_count++];
+		slot->processor = processor;
+		switch (policy) {
+			case cpuinfo_placement_policy_compact:
+				slot->key[0] = smt_rank;
+				slot->key[1] = i;
+				break;
+			case cpuinfo_placement_policy_spread_llc:
+				/* Alternate packages between domains, so that a share of a few threads stays balanced */
+				slot->key[0] = domain_ranks[domain];
+				slot->key[1] = package;
+				slot->key[2] = smt_rank;
+				slot->key[3] = core_ranks[core];
+				domain_slots[domain]++;
+				break;
+			case cpuinfo_placement_policy_preferred_cores:
+				slot->key[0] = smt_rank;
+				set_core_speed_keys(processor->core, &slot->key[1]);
+				slot->key[3] = i;
+				break;
+			default:
+				slot->key[0] = smt_rank;
+				slot->key[1] = core_ranks[core];
+				slot->key[2] = domain_ranks[domain];
+				slot->key[3] = package;
+				break;
+		}
+	}
+	if (slots_count == 0) {
+		cpuinfo_log_warning("no logical processors are allowed for the calling thread");
+		goto cleanup;
+	}
+	qsort(slots, slots_count, sizeof(struct placement_slot), compare_placement_slots);
+
+	if (policy != cpuinfo_placement_policy_spread_llc) {
+		for (uint32_t i = 0; i < threads_count; i++) {
+			processors[i] = slots[i % slots_count].processor;
+		}
+		distinct_count = threads_count < slots_count ? threads_count : slots_count;
+		goto cleanup;
+	}
+
+	/* Slots are grouped by domain: give each domain an equal share of threads, and fill it in order */
+	uint32_t thread = 0, domain_index = 0;
+	for (uint32_t first_slot = 0; first_slot < slots_count; domain_index++) {
+		const uint32_t domain_size = domain_slots[get_llc_domain(slots[first_slot].processor)];
+		const uint32_t domain_threads =
+			threads_count / domains_used + (domain_index < threads_count % domains_used ? 1 : 0);
+		for (uint32_t i = 0; i < domain_threads; i++) {
+			processors[thread++] = slots[first_slot + i % domain_size].processor;
+		}
+		distinct_count += domain_threads < domain_size ? domain_threads : domain_size;
+		first_slot += domain_size;
+	}
+
+cleanup:
+	cpuinfo_affinity_mask_free(&allowed);
+	free(slots);
+	free(counters);
+	return distinct_count;
+}
+
+/*
+ * Work per clock cycle of a microarchitecture relative to big out-of-order
+ * cores, which have 1024. The estimate only separates the small in-order or
+ * narrow efficiency designs, which run at about a quarter to two thirds of the
+ * throughput of big cores at the same frequency.
+ */
+static uint32_t get_uarch_performance(enum cpuinfo_uarch uarch) {
+	switch (uarch) {
+		case cpuinfo_uarch_cortex_a5:
+		case cpuinfo_uarch_cortex_a7:
+		case cpuinfo_uarch_cortex_a32:
+		case cpuinfo_uarch_cortex_a35:
+			return 256;
+		case cpuinfo_uarch_cortex_a53:
+		case cpuinfo_uarch_cortex_a55r0:
+		case cpuinfo_uarch_cortex_a55:
+		case cpuinfo_uarch_cortex_a510:
+		case cpuinfo_uarch_cortex_a520:
+		case cpuinfo_uarch_bonnell:
+		case cpuinfo_uarch_saltwell:
+			return 384;
+		case cpuinfo_uarch_silvermont:
+		case cpuinfo_uarch_airmont:
+		case cpuinfo_uarch_goldmont:
+		case cpuinfo_uarch_goldmont_plus:
+			return 512;
+		case cpuinfo_uarch_gracemont:
+		case cpuinfo_uarch_crestmont:
+			return 640;
+		default:
+			return 1024;
+	}
+}
+
+bool CPUINFO_ABI cpuinfo_partition_by_capacity(
+	uint64_t range_size,
+	uint32_t workers_count,
+	const struct cpuinfo_processor** processors,
+	uint64_t* boundaries) {
+	if (workers_count == 0) {
+		return false;
+	}
+
+	/* Mixing reported and estimated capacities would skew the split, so pick one source for all workers */
+	bool reported = true, frequency_known = true;
+	for (uint32_t i = 0; i < workers_count; i++) {
+		reported &= processors[i]->core->capacity != 0;
+		frequency_known &= processors[i]->core->frequency != 0;
+	}
+	uint64_t max_capacity = 0;
+	for (uint32_t i = 0; i < workers_count; i++) {
+		const struct cpuinfo_core* core = processors[i]->core;
+		uint64_t capacity = core->capacity;
+		if (!reported) {
+			capacity = get_uarch_performance(core->uarch);
+			if (frequency_known) {
+				capacity *= core->frequency / UINT64_C(1000000);
+			}
+		}
+		if (capacity > max_capacity) {
+			max_capacity = capacity;
+		}
+		/* Stash the raw capacity until it can be normalized */
+		boundaries[i + 1] = capacity;
+	}
+
+	/* Normalize weights to at most 1024 per worker, so that the sum times the range remainder can not overflow */
+	uint64_t total_weight = 0;
+	for (uint32_t i = 0; i < workers_count; i++) {
+		uint32_t sharing_workers = 0;
+		for (uint32_t j = 0; j < workers_count; j++) {
+			sharing_workers += processors[j]->core == processors[i]->core;
+		}
+		uint64_t weight = max_capacity != 0 ? boundaries[i + 1] * 1024 / max_capacity / sharing_workers : 1;
+		if (weight == 0) {
+			weight = 1;
+		}
+		boundaries[i + 1] = weight;
+		total_weight += weight;
+	}
+
+	const uint64_t quotient = range_size / total_weight;
+	const uint64_t remainder = range_size % total_weight;
+	uint64_t cumulative_weight = 0;
+	boundaries[0] = 0;
+	for (uint32_t i = 0; i < workers_count; i++) {
+		cumulative_weight += boundaries[i + 1];
+		boundaries[i + 1] = quotient * cumulative_weight + remainder * cumulative_weight / total_weight;
+	}
+	return true;
+}
@@ -1,3 +1,4 @@
+#include <sched.h>
 #include <string.h>
 
 #include <cpuinfo/internal-api.h>
@@ -23,8 +24,9 @@ static int compare_riscv_linux_processors(const void* a, const void* b) {
 }
 
 /**
- * Parses the core cpus list for each processor. This function is called once
- * per-processor, with the IDs of all other processors in the core list.
+ * Parses the core cpus list of each core. This function is called once per
+ * core, for its first processor, with the IDs of all other processors in the
+ * core list.
  *
  * The 'processor_[start|count]' are populated in the processor's 'core'
  * attribute, with 'start' being the smallest ID in the core list.
@@ -83,8 +85,9 @@ static bool core_cpus_parser(
 }
 
 /**
- * Parses the cluster cpu list for each processor. This function is called once
- * per-processor, with the IDs of all other processors in the cluster.
+ * Parses the cluster cpu list of each cluster. This function is called once
+ * per cluster, for its first processor, with the IDs of all other processors
+ * in the cluster.
  *
  * The 'cluster_leader_id' of each processor is set to the smallest ID in it's
  * cluster CPU list.
@@ -149,8 +152,9 @@ static bool cluster_cpus_parser(
 }
 
 /**
- * Parses the package cpus list for each processor. This function is called once
- * per-processor, with the IDs of all other processors in the package list.
+ * Parses the package cpus list of each package. This function is called once
+ * per package, for its first processor, with the IDs of all other processors
+ * in the package list.
  *
  * The 'processor_[start|count]' are populated in the processor's 'package'
  * attribute, with 'start' being the smallest ID in the package list.
@@ -222,6 +226,39 @@ static bool package_cpus_parser(
 	return true;
 }
 
+/**
+ * Populates the core ID, vendor, uarch and frequency of a processor's core.
+ * This function only modifies the entry of the processor itself, and may be
+ * called for different processors concurrently.
+ */
+static void populate_core_information(uint32_t processor, struct cpuinfo_riscv_linux_processor* processors) {
+	if (!bitmask_all(processors[processor].flags, CPUINFO_LINUX_FLAG_VALID)) {
+		return;
+	}
+
+	/* Populate core ID information. */
+	if (cpuinfo_linux_get_processor_core_id(processor, &processors[processor].core.core_id)) {
+		processors[processor].flags |= CPUINFO_LINUX_FLAG_CORE_ID;
+	}
+
+	/**
+	 * Populate the vendor and uarch of this core from this processor. When
+	 * the final 'cores' list is constructed, only the values from the core
+	 * leader will be honored.
+	 */
+	cpuinfo_riscv_linux_decode_vendor_uarch_from_hwprobe(
+		processor, &processors[processor].core.vendor, &processors[processor].core.uarch);
+
+	/* Populate frequency information of this core. */
+	uint32_t frequency = cpuinfo_linux_get_processor_cur_frequency(processor);
+	if (frequency != 0) {
+		processors[processor].core.frequency = frequency;
+		processors[processor].flags |= CPUINFO_LINUX_FLAG_CUR_FREQUENCY;
+	}
+	processors[processor].core.capacity = cpuinfo_linux_get_processor_capacity(processor);
+	processors[processor].core.performance_ranking = cpuinfo_linux_get_processor_performance_ranking(processor);
+}
+
 /* Initialization for the RISC-V Linux system. */
 void cpuinfo_riscv_linux_init(void) {
 	struct cpuinfo_riscv_linux_processor* riscv_linux_processors = NULL;
@@ -233,6 +270,9 @@ void cpuinfo_riscv_linux_init(void) {
 	const struct cpuinfo_processor** linux_cpu_to_processor_map = NULL;
 	const struct cpuinfo_core** linux_cpu_to_core_map = NULL;
 	uint32_t* linux_cpu_to_uarch_index_map = NULL;
+	struct cpuinfo_numa_node* numa_nodes = NULL;
+	uint8_t* numa_distances = NULL;
+	struct cpuinfo_linux_numa_nodes numa = {0};
 
 	/**
 	 * The interesting set of processors are the number of 'present'
@@ -291,58 +331,39 @@ void cpuinfo_riscv_linux_init(void) {
 		riscv_linux_processors[processor].processor.linux_id = processor;
 	}
 
-	/* Populate core information. */
-	for (size_t processor = 0; processor < max_processor_id; processor++) {
-		if (!bitmask_all(riscv_linux_processors[processor].flags, CPUINFO_LINUX_FLAG_VALID)) {
-			continue;
-		}
-
-		/* Populate processor start and count information. */
-		if (!cpuinfo_linux_detect_core_cpus(
-			    max_processor_id,
-			    processor,
-			    (cpuinfo_siblings_callback)core_cpus_parser,
-			    riscv_linux_processors)) {
-			cpuinfo_log_error("failed to detect core cpus for processor %zu.", processor);
-			goto cleanup;
-		}
-
-		/* Populate core ID information. */
-		if (cpuinfo_linux_get_processor_core_id(processor, &riscv_linux_processors[processor].core.core_id)) {
-			riscv_linux_processors[processor].flags |= CPUINFO_LINUX_FLAG_CORE_ID;
-		}
-
-		/**
-		 * Populate the vendor and uarch of this core from this
-		 * processor. When the final 'cores' list is constructed, only
-		 * the values from the core leader will be honored.
-		 */
-		cpuinfo_riscv_linux_decode_vendor_uarch_from_hwprobe(
-			processor,
-			&riscv_linux_processors[processor].core.vendor,
-			&riscv_linux_processors[processor].core.uarch);
-
-		/* Populate frequency information of this core. */
-		uint32_t frequency = cpuinfo_linux_get_processor_cur_frequency(processor);
-		if (frequency != 0) {
-			riscv_linux_processors[processor].core.frequency = frequency;
-			riscv_linux_processors[processor].flags |= CPUINFO_LINUX_FLAG_CUR_FREQUENCY;
-		}
+	/* Populate processor start and count information of each core. */
+	if (!cpuinfo_linux_detect_sibling_groups(
+		    max_processor_id,
+		    &riscv_linux_processors->flags,
+		    sizeof(struct cpuinfo_riscv_linux_processor),
+		    CPUINFO_LINUX_FLAG_VALID,
+		    cpuinfo_linux_detect_core_cpus,
+		    (cpuinfo_siblings_callback)core_cpus_parser,
+		    riscv_linux_processors)) {
+		cpuinfo_log_error("failed to detect core cpus.");
+		goto cleanup;
 	}
 
+	/* Populate core information. */
+	cpuinfo_linux_for_each_processor(
+		max_processor_id, (cpuinfo_processor_function)populate_core_information, riscv_linux_processors);
+
 	/* Populate cluster information. */
+	if (!cpuinfo_linux_detect_sibling_groups(
+		    max_processor_id,
+		    &riscv_linux_processors->flags,
+		    sizeof(struct cpuinfo_riscv_linux_processor),
+		    CPUINFO_LINUX_FLAG_VALID,
+		    cpuinfo_linux_detect_cluster_cpus,
+		    (cpuinfo_siblings_callback)cluster_cpus_parser,
+		    riscv_linux_processors)) {
+		cpuinfo_log_warning("failed to detect cluster cpus.");
+		goto cleanup;
+	}
 	for (size_t processor = 0; processor < max_processor_id; processor++) {
 		if (!bitmask_all(riscv_linux_processors[processor].flags, CPUINFO_LINUX_FLAG_VALID)) {
 			continue;
 		}
-		if (!cpuinfo_linux_detect_cluster_cpus(
-			    max_processor_id,
-			    processor,
-			    (cpuinfo_siblings_callback)cluster_cpus_parser,
-			    riscv_linux_processors)) {
-			cpuinfo_log_warning("failed to detect cluster cpus for processor %zu.", processor);
-			goto cleanup;
-		}
 
 		/**
 		 * Populate the vendor, uarch and frequency of this cluster from
@@ -356,18 +377,16 @@ void cpuinfo_riscv_linux_init(void) {
 	}
 
 	/* Populate package information. */
-	for (size_t processor = 0; processor < max_processor_id; processor++) {
-		if (!bitmask_all(riscv_linux_processors[processor].flags, CPUINFO_LINUX_FLAG_VALID)) {
-			continue;
-		}
-		if (!cpuinfo_linux_detect_package_cpus(
-			    max_processor_id,
-			    processor,
-			    (cpuinfo_siblings_callback)package_cpus_parser,
-			    riscv_linux_processors)) {
-			cpuinfo_log_warning("failed to detect package cpus for processor %zu.", processor);
-			goto cleanup;
-		}
+	if (!cpuinfo_linux_detect_sibling_groups(
+		    max_processor_id,
+		    &riscv_linux_processors->flags,
+		    sizeof(struct cpuinfo_riscv_linux_processor),
+		    CPUINFO_LINUX_FLAG_VALID,
+		    cpuinfo_linux_detect_package_cpus,
+		    (cpuinfo_siblings_callback)package_cpus_parser,
+		    riscv_linux_processors)) {
+		cpuinfo_log_warning("failed to detect package cpus.");
+		goto cleanup;
 	}
 
 	/* Populate ISA structure with hwcap information. */
@@ -503,6 +522,27 @@ void cpuinfo_riscv_linux_init(void) {
 		goto cleanup;
 	}
 
+	if (!cpuinfo_linux_detect_numa_nodes(max_processor_id, &numa)) {
+		goto cleanup;
+	}
+
+	numa_nodes = calloc(numa.nodes_count, sizeof(struct cpuinfo_numa_node));
+	if (numa_nodes == NULL) {
+		cpuinfo_log_error(
+			"failed to allocate %zu bytes for %" PRIu32 " NUMA nodes.",
+			numa.nodes_count * sizeof(struct cpuinfo_numa_node),
+			numa.nodes_count);
+		goto cleanup;
+	}
+
+	numa_distances = calloc(numa.nodes_count * numa.nodes_count, sizeof(uint8_t));
+	if (numa_distances == NULL) {
+		cpuinfo_log_error(
+			"failed to allocate %zu bytes for NUMA distances.",
+			numa.nodes_count * numa.nodes_count * sizeof(uint8_t));
+		goto cleanup;
+	}
+
 	/* Transfer contents of processor list to ABI structures. */
 	size_t valid_processors_index = 0;
 	size_t valid_cores_index = 0;
@@ -575,7 +615,15 @@ void cpuinfo_riscv_linux_init(void) {
 		linux_cpu_to_uarch_index_map[linux_id] = valid_uarchs_index - 1;
 	}
 
+	cpuinfo_linux_detect_processor_flags(max_processor_id, valid_processors_count, processors);
+
+	cpuinfo_linux_build_numa_nodes(
+		&numa, valid_processors_count, processors, valid_cores_count, cores, numa_nodes, numa_distances);
+
+	cpuinfo_linux_init_getcpu(max_processor_id);
+
 	/* Commit */
+	cpuinfo_begin_tables_update();
 	cpuinfo_processors = processors;
 	cpuinfo_processors_count = valid_processors_count;
 	cpuinfo_cores = cores;
@@ -586,6 +634,9 @@ void cpuinfo_riscv_linux_init(void) {
 	cpuinfo_packages_count = valid_packages_count;
 	cpuinfo_uarchs = uarchs;
 	cpuinfo_uarchs_count = valid_uarchs_count;
+	cpuinfo_numa_nodes = numa_nodes;
+	cpuinfo_numa_nodes_count = numa.nodes_count;
+	cpuinfo_numa_distances = numa_distances;
 
 	cpuinfo_linux_cpu_max = max_processor_id;
 	cpuinfo_linux_cpu_to_processor_map = linux_cpu_to_processor_map;
@@ -596,6 +647,8 @@ void cpuinfo_riscv_linux_init(void) {
 
 	cpuinfo_is_initialized = true;
 
+	cpuinfo_end_tables_update();
+
 	/* Mark all public structures NULL to prevent cleanup from erasing them.
 	 */
 	processors = NULL;
@@ -606,7 +659,10 @@ void cpuinfo_riscv_linux_init(void) {
 	linux_cpu_to_processor_map = NULL;
 	linux_cpu_to_core_map = NULL;
 	linux_cpu_to_uarch_index_map = NULL;
+	numa_nodes = NULL;
+	numa_distances = NULL;
 cleanup:
+	cpuinfo_linux_free_numa_nodes(&numa);
 	free(riscv_linux_processors);
 	free(processors);
 	free(cores);
@@ -616,4 +672,20 @@ cleanup:
 	free(linux_cpu_to_processor_map);
 	free(linux_cpu_to_core_map);
 	free(linux_cpu_to_uarch_index_map);
+	free(numa_nodes);
+	free(numa_distances);
+}
+
+void cpuinfo_riscv_linux_init_isa(void) {
+	cpuinfo_riscv_linux_decode_isa_from_hwcap(&cpuinfo_isa);
+
+	enum cpuinfo_vendor vendor = cpuinfo_vendor_unknown;
+	enum cpuinfo_uarch uarch = cpuinfo_uarch_unknown;
+	/* Describe the processor the caller runs on: processor 0 may be offline */
+	const int current_processor = sched_getcpu();
+	cpuinfo_riscv_linux_decode_vendor_uarch_from_hwprobe(
+		current_processor >= 0 ? (uint32_t)current_processor : 0, &vendor, &uarch);
+	cpuinfo_isa_uarch = (struct cpuinfo_uarch_info){
+		.uarch = uarch,
+	};
 }
@@ -51,32 +51,58 @@ struct cpuinfo_x86_topology {
 	uint32_t thread_bits_length;
 	uint32_t core_bits_offset;
 	uint32_t core_bits_length;
+	/* Levels between cores and the package in CPUID leaf 0x1F; zero length if not reported */
+	uint32_t module_bits_offset;
+	uint32_t module_bits_length;
+	uint32_t tile_bits_offset;
+	uint32_t tile_bits_length;
+	uint32_t die_bits_offset;
+	uint32_t die_bits_length;
+	/* Bits of APIC ID below this offset identify the logical processor within its package */
+	uint32_t package_bits_offset;
+};
+
+/* Sub-leaves of CPUID leaves 0xB and 0x1F read during topology detection, including the terminating one */
+#define CPUINFO_X86_MAX_TOPOLOGY_LEVELS 8
+
+/* Core types reported in bits 24-31 of CPUID leaf 0x1A on hybrid processors */
+#define CPUINFO_X86_CORE_TYPE_ATOM UINT32_C(0x20)
+#define CPUINFO_X86_CORE_TYPE_CORE UINT32_C(0x40)
+
+struct cpuinfo_x86_tlbs {
+	struct cpuinfo_tlb itlb_4KB;
+	struct cpuinfo_tlb itlb_2MB;
+	struct cpuinfo_tlb itlb_4MB;
+	struct cpuinfo_tlb dtlb0_4KB;
+	struct cpuinfo_tlb dtlb0_2MB;
+	struct cpuinfo_tlb dtlb0_4MB;
+	struct cpuinfo_tlb dtlb_4KB;
+	struct cpuinfo_tlb dtlb_2MB;
+	struct cpuinfo_tlb dtlb_4MB;
+	struct cpuinfo_tlb dtlb_1GB;
+	struct cpuinfo_tlb stlb2_4KB;
+	struct cpuinfo_tlb stlb2_2MB;
+	struct cpuinfo_tlb stlb2_1GB;
 };
 
 struct cpuinfo_x86_processor {
 	uint32_t cpuid;
 	enum cpuinfo_vendor vendor;
 	enum cpuinfo_uarch uarch;
+	/* Core type of the processor that ran CPUID, or 0 if the processor is not hybrid */
+	uint32_t core_type;
 #ifdef __linux__
 	int linux_id;
 #endif
 	struct cpuinfo_x86_caches cache;
-	struct {
-		struct cpuinfo_tlb itlb_4KB;
-		struct cpuinfo_tlb itlb_2MB;
-		struct cpuinfo_tlb itlb_4MB;
-		struct cpuinfo_tlb dtlb0_4KB;
-		struct cpuinfo_tlb dtlb0_2MB;
-		struct cpuinfo_tlb dtlb0_4MB;
-		struct cpuinfo_tlb dtlb_4KB;
-		struct cpuinfo_tlb dtlb_2MB;
-		struct cpuinfo_tlb dtlb_4MB;
-		struct cpuinfo_tlb dtlb_1GB;
-		struct cpuinfo_tlb stlb2_4KB;
-		struct cpuinfo_tlb stlb2_2MB;
-		struct cpuinfo_tlb stlb2_1GB;
-	} tlb;
+	struct cpuinfo_x86_tlbs tlb;
 	struct cpuinfo_x86_topology topology;
+	/* Frequencies from CPUID leaf 0x16, in MHz, or 0 if not reported */
+	struct {
+		uint32_t base;
+		uint32_t max;
+		uint32_t bus;
+	} frequency;
 	char brand_string[CPUINFO_PACKAGE_NAME_MAX];
 };
 
@@ -87,6 +113,7 @@ CPUINFO_INTERNAL struct cpuinfo_x86_model_info cpuinfo_x86_decode_model_info(uin
 CPUINFO_INTERNAL enum cpuinfo_uarch cpuinfo_x86_decode_uarch(
 	enum cpuinfo_vendor vendor,
 	const struct cpuinfo_x86_model_info* model_info);
+CPUINFO_INTERNAL enum cpuinfo_uarch cpuinfo_x86_decode_hybrid_uarch(enum cpuinfo_uarch uarch, uint32_t core_type);
 
 CPUINFO_INTERNAL struct cpuinfo_x86_isa cpuinfo_x86_detect_isa(
 	const struct cpuid_regs basic_info,
@@ -101,6 +128,27 @@ CPUINFO_INTERNAL void cpuinfo_x86_detect_topology(
 	uint32_t max_extended_index,
 	struct cpuid_regs leaf1,
 	struct cpuinfo_x86_topology* topology);
+/* Refines topology with AMD leaves 0x8000001E and 0x80000026 on processors with topology extensions */
+CPUINFO_INTERNAL void cpuinfo_x86_detect_amd_topology(
+	uint32_t max_extended_index,
+	enum cpuinfo_uarch uarch,
+	const struct cpuinfo_x86_caches* cache,
+	struct cpuinfo_x86_topology* topology);
+/*
+ * Refines topology with the registers of AMD leaf 0x8000001E, or NULL if it is not supported, and the levels
+ * of leaf 0x80000026 up to its first invalid level
+ */
+CPUINFO_INTERNAL void cpuinfo_x86_decode_amd_topology(
+	const struct cpuid_regs* leaf0x8000001E,
+	uint32_t levels_count,
+	const struct cpuid_regs* levels,
+	enum cpuinfo_uarch uarch,
+	const struct cpuinfo_x86_caches* cache,
+	struct cpuinfo_x86_topology* topology);
+CPUINFO_INTERNAL void cpuinfo_x86_decode_extended_topology(
+	uint32_t levels_count,
+	const struct cpuid_regs* levels,
+	struct cpuinfo_x86_topology* topology);
 
 CPUINFO_INTERNAL void cpuinfo_x86_detect_cache(
 	uint32_t max_base_index,
@@ -151,6 +199,26 @@ CPUINFO_INTERNAL bool cpuinfo_x86_decode_deterministic_cache_parameters(
 
 CPUINFO_INTERNAL bool cpuinfo_x86_decode_cache_properties(struct cpuid_regs regs, struct cpuinfo_x86_caches* cache);
 
+/* Replaces TLBs from CPUID leaf 2 with TLBs from Intel leaf 0x18 or AMD leaves 0x80000005, 0x80000006, 0x80000019 */
+CPUINFO_INTERNAL void cpuinfo_x86_detect_tlb(
+	uint32_t max_base_index,
+	uint32_t max_extended_index,
+	enum cpuinfo_vendor vendor,
+	struct cpuinfo_x86_tlbs* tlb);
+CPUINFO_INTERNAL bool cpuinfo_x86_decode_deterministic_tlb_parameters(
+	struct cpuid_regs regs,
+	struct cpuinfo_x86_tlbs* tlb);
+CPUINFO_INTERNAL void cpuinfo_x86_decode_amd_tlbs(
+	struct cpuid_regs leaf0x80000005,
+	struct cpuid_regs leaf0x80000006,
+	struct cpuid_regs leaf0x80000019,
+	struct cpuinfo_x86_tlbs* tlb);
+
+struct cpuinfo_tlbs;
+
+/* Lists TLBs of a core type for the public API */
+CPUINFO_INTERNAL void cpuinfo_x86_describe_tlbs(const struct cpuinfo_x86_tlbs* x86_tlbs, struct cpuinfo_tlbs* tlbs);
+
 CPUINFO_INTERNAL uint32_t cpuinfo_x86_normalize_brand_string(const char raw_name[48], char normalized_name[48]);
 
 CPUINFO_INTERNAL uint32_t cpuinfo_x86_format_package_name(
@@ -0,0 +1,279 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo/internal-api.h>
+#include <cpuinfo/log.h>
+#include <x86/api.h>
+#include <x86/cpuid.h>
+
+/* Guards against a broken hypervisor reporting an unreasonable number of sub-leaves of leaf 0x18 */
+#define MAX_TLB_SUBLEAVES 64
+
+enum tlb_type {
+	tlb_type_none = 0,
+	tlb_type_data = 1,
+	tlb_type_instruction = 2,
+	tlb_type_unified = 3,
+	tlb_type_load_only = 4,
+	tlb_type_store_only = 5,
+};
+
+static void assign_tlb(
+	struct cpuinfo_tlb tlb,
+	struct cpuinfo_tlb* tlb_4KB,
+	struct cpuinfo_tlb* tlb_2MB,
+	struct cpuinfo_tlb* tlb_4MB,
+	struct cpuinfo_tlb* tlb_1GB) {
+	if (tlb_4KB != NULL && (tlb.pages & CPUINFO_PAGE_SIZE_4KB)) {
+		*tlb_4KB = tlb;
+	}
+	if (tlb_2MB != NULL && (tlb.pages & CPUINFO_PAGE_SIZE_2MB)) {
+		*tlb_2MB = tlb;
+	}
+	if (tlb_4MB != NULL && (tlb.pages & CPUINFO_PAGE_SIZE_4MB)) {
+		*tlb_4MB = tlb;
+	}
+	if (tlb_1GB != NULL && (tlb.pages & CPUINFO_PAGE_SIZE_1GB)) {
+		*tlb_1GB = tlb;
+	}
+}
+
+bool cpuinfo_x86_decode_deterministic_tlb_parameters(struct cpuid_regs regs, struct cpuinfo_x86_tlbs* tlb) {
+	const enum tlb_type type = (enum tlb_type)(regs.edx & UINT32_C(0x0000001F));
+	if (type == tlb_type_none) {
+		return false;
+	}
+
+	/*
+	 * Intel 64 and IA-32 Architectures Software Developer’s Manual,
+	 * Volume 2A: Deterministic Address Translation Parameters Leaf
+	 * - EBX[bits 0-3]: 4K, 2M, 4M and 1G page sizes supported
+	 * - EBX[bits 16-31]: ways of associativity
+	 * - ECX: number of sets
+	 * - EDX[bits 5-7]: translation cache level, starting at 1
+	 * - EDX[bit 8]: fully associative structure
+	 */
+	uint64_t pages = 0;
+	if (regs.ebx & UINT32_C(0x00000001)) {
+		pages |= CPUINFO_PAGE_SIZE_4KB;
+	}
+	if (regs.ebx & UINT32_C(0x00000002)) {
+		pages |= CPUINFO_PAGE_SIZE_2MB;
+	}
+	if (regs.ebx & UINT32_C(0x00000004)) {
+		pages |= CPUINFO_PAGE_SIZE_4MB;
+	}
+	if (regs.ebx & UINT32_C(0x00000008)) {
+		pages |= CPUINFO_PAGE_SIZE_1GB;
+	}
+	const uint32_t ways = regs.ebx >> 16;
+	const uint32_t entries = ways * regs.ecx;
+	const uint32_t level = (regs.edx >> 5) & UINT32_C(0x00000007);
+	const bool fully_associative = !!(regs.edx & UINT32_C(0x00000100));
+	if (pages == 0 || entries == 0) {
+		return true;
+	}
+
+	const struct cpuinfo_tlb description = {
+		.entries = entries,
+		.associativity = fully_associative ? entries : ways,
+		.pages = pages,
+	};
+	cpuinfo_log_debug(
+		"CPUID leaf 0x18: L%" PRIu32 " TLB of type %d with %" PRIu32 " entries, %" PRIu32
+		"-way, page sizes 0x%" PRIx64,
+		level,
+		(int)type,
+		description.entries,
+		description.associativity,
+		description.pages);
+	switch (level) {
+		case 1:
+			switch (type) {
+				case tlb_type_instruction:
+					assign_tlb(description, &tlb->itlb_4KB, &tlb->itlb_2MB, &tlb->itlb_4MB, NULL);
+					break;
+				case tlb_type_unified:
+					assign_tlb(description, &tlb->itlb_4KB, &tlb->itlb_2MB, &tlb->itlb_4MB, NULL);
+					/* fall through */
+				case tlb_type_data:
+				case tlb_type_load_only:
+					assign_tlb(
+						description, &tlb->dtlb_4KB, &tlb->dtlb_2MB, &tlb->dtlb_4MB, &tlb->dtlb_1GB);
+					break;
+				default:
+					/* Store-only TLBs do not limit the reach of loads */
+					break;
+			}
+			break;
+		case 2:
+			if (type != tlb_type_instruction && type != tlb_type_store_only) {
+				assign_tlb(description, &tlb->stlb2_4KB, &tlb->stlb2_2MB, NULL, &tlb->stlb2_1GB);
+			}
+			break;
+	}
+	return true;
+}
+
+/* Decodes associativity encoded as in the L2 cache fields of AMD leaf 0x80000006 */
+static uint32_t decode_amd_associativity(uint32_t encoding, uint32_t entries) {
+	switch (encoding) {
+		case 0x1:
+			return 1;
+		case 0x2:
+			return 2;
+		case 0x3:
+			return 3;
+		case 0x4:
+			return 4;
+		case 0x5:
+			return 6;
+		case 0x6:
+			return 8;
+		case 0x8:
+			return 16;
+		case 0xA:
+			return 32;
+		case 0xB:
+			return 48;
+		case 0xC:
+			return 64;
+		case 0xD:
+			return 96;
+		case 0xE:
+			return 128;
+		case 0xF:
+			return entries;
+		default:
+			return 0;
+	}
+}
+
+/* Decodes an 8-bit TLB descriptor of AMD leaf 0x80000005: entries in bits 0-7, associativity in bits 8-15 */
+static struct cpuinfo_tlb decode_amd_l1_tlb(uint32_t descriptor, uint64_t pages) {
+	const uint32_t entries = descriptor & UINT32_C(0x000000FF);
+	const uint32_t associativity = (descriptor >> 8) & UINT32_C(0x000000FF);
+	if (entries == 0 || associativity == 0) {
+		return (struct cpuinfo_tlb){0};
+	}
+	return (struct cpuinfo_tlb){
+		.entries = entries,
+		.associativity = associativity == UINT32_C(0x000000FF) ? entries : associativity,
+		.pages = pages,
+	};
+}
+
+/* Decodes a 16-bit TLB descriptor of AMD leaves 0x80000006 and 0x80000019: entries in bits 0-11 */
+static struct cpuinfo_tlb decode_amd_l2_tlb(uint32_t descriptor, uint64_t pages) {
+	const uint32_t entries = descriptor & UINT32_C(0x00000FFF);
+	const uint32_t associativity = decode_amd_associativity((descriptor >> 12) & UINT32_C(0x0000000F), entries);
+	if (entries == 0 || associativity == 0) {
+		return (struct cpuinfo_tlb){0};
+	}
+	return (struct cpuinfo_tlb){
+		.entries = entries,
+		.associativity = associativity,
+		.pages = pages,
+	};
+}
+
+void cpuinfo_x86_decode_amd_tlbs(
+	struct cpuid_regs leaf0x80000005,
+	struct cpuid_regs leaf0x80000006,
+	struct cpuid_regs leaf0x80000019,
+	struct cpuinfo_x86_tlbs* tlb) {
+	/*
+	 * AMD64 Architecture Programmer's Manual, Volume 3: the low half of each
+	 * register describes the instruction TLB, and the high half describes the
+	 * data TLB. Entries of the 2MB TLBs are shared with 4MB pages, which use
+	 * two entries each, so only 2MB pages are reported. Instruction TLBs for
+	 * 1GB pages and the L2 instruction TLBs have no counterpart in the
+	 * descriptors of CPUID leaf 2 and are ignored.
+	 */
+	tlb->itlb_4KB = decode_amd_l1_tlb(leaf0x80000005.ebx, CPUINFO_PAGE_SIZE_4KB);
+	tlb->itlb_2MB = decode_amd_l1_tlb(leaf0x80000005.eax, CPUINFO_PAGE_SIZE_2MB);
+	tlb->dtlb_4KB = decode_amd_l1_tlb(leaf0x80000005.ebx >> 16, CPUINFO_PAGE_SIZE_4KB);
+	tlb->dtlb_2MB = decode_amd_l1_tlb(leaf0x80000005.eax >> 16, CPUINFO_PAGE_SIZE_2MB);
+	tlb->dtlb_1GB = decode_amd_l2_tlb(leaf0x80000019.eax >> 16, CPUINFO_PAGE_SIZE_1GB);
+	tlb->stlb2_4KB = decode_amd_l2_tlb(leaf0x80000006.ebx >> 16, CPUINFO_PAGE_SIZE_4KB);
+	tlb->stlb2_2MB = decode_amd_l2_tlb(leaf0x80000006.eax >> 16, CPUINFO_PAGE_SIZE_2MB);
+	tlb->stlb2_1GB = decode_amd_l2_tlb(leaf0x80000019.ebx >> 16, CPUINFO_PAGE_SIZE_1GB);
+}
+
+static bool has_tlbs(const struct cpuinfo_x86_tlbs* tlb) {
+	const struct cpuinfo_tlb* tlbs = (const struct cpuinfo_tlb*)tlb;
+	for (size_t i = 0; i < sizeof(struct cpuinfo_x86_tlbs) / sizeof(struct cpuinfo_tlb); i++) {
+		if (tlbs[i].entries != 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void cpuinfo_x86_detect_tlb(
+	uint32_t max_base_index,
+	uint32_t max_extended_index,
+	enum cpuinfo_vendor vendor,
+	struct cpuinfo_x86_tlbs* tlb) {
+	struct cpuinfo_x86_tlbs detected_tlb;
+	memset(&detected_tlb, 0, sizeof(detected_tlb));
+	if (vendor == cpuinfo_vendor_amd || vendor == cpuinfo_vendor_hygon) {
+		if (max_extended_index >= UINT32_C(0x80000006)) {
+			const struct cpuid_regs leaf0x80000019 = max_extended_index >= UINT32_C(0x80000019)
+				? cpuid(UINT32_C(0x80000019))
+				: (struct cpuid_regs){0, 0, 0, 0};
+			cpuinfo_x86_decode_amd_tlbs(
+				cpuid(UINT32_C(0x80000005)), cpuid(UINT32_C(0x80000006)), leaf0x80000019, &detected_tlb);
+		}
+	} else if (max_base_index >= UINT32_C(0x18)) {
+		/* Sub-leaf 0 reports the last valid sub-leaf, and sub-leaves in between may be empty */
+		const struct cpuid_regs leaf0x18 = cpuidex(UINT32_C(0x18), 0);
+		const uint32_t max_subleaf = leaf0x18.eax < MAX_TLB_SUBLEAVES ? leaf0x18.eax : MAX_TLB_SUBLEAVES - 1;
+		cpuinfo_x86_decode_deterministic_tlb_parameters(leaf0x18, &detected_tlb);
+		for (uint32_t subleaf = 1; subleaf <= max_subleaf; subleaf++) {
+			cpuinfo_x86_decode_deterministic_tlb_parameters(cpuidex(UINT32_C(0x18), subleaf), &detected_tlb);
+		}
+	}
+
+	if (has_tlbs(&detected_tlb)) {
+		*tlb = detected_tlb;
+	}
+}
+
+static void append_tlb(struct cpuinfo_tlb list[restrict static CPUINFO_MAX_TLBS], const struct cpuinfo_tlb* tlb) {
+	if (tlb->entries == 0) {
+		return;
+	}
+	for (uint32_t i = 0; i < CPUINFO_MAX_TLBS; i++) {
+		if (list[i].entries == 0) {
+			list[i] = *tlb;
+			return;
+		}
+		/* A TLB shared by several page sizes is referenced by each of them */
+		if (list[i].entries == tlb->entries && list[i].associativity == tlb->associativity &&
+		    list[i].pages == tlb->pages) {
+			return;
+		}
+	}
+	cpuinfo_log_debug("ignored TLB with %" PRIu32 " entries: too many TLBs of the same kind", tlb->entries);
+}
+
+void cpuinfo_x86_describe_tlbs(const struct cpuinfo_x86_tlbs* x86_tlbs, struct cpuinfo_tlbs* tlbs) {
+	append_tlb(tlbs->itlb, &x86_tlbs->itlb_4KB);
+	append_tlb(tlbs->itlb, &x86_tlbs->itlb_2MB);
+	append_tlb(tlbs->itlb, &x86_tlbs->itlb_4MB);
+
+	/* Prefer DTLB over the smaller DTLB0 in front of it on processors which report both */
+	append_tlb(tlbs->dtlb, x86_tlbs->dtlb_4KB.entries != 0 ? &x86_tlbs->dtlb_4KB : &x86_tlbs->dtlb0_4KB);
+	append_tlb(tlbs->dtlb, x86_tlbs->dtlb_2MB.entries != 0 ? &x86_tlbs->dtlb_2MB : &x86_tlbs->dtlb0_2MB);
+	append_tlb(tlbs->dtlb, x86_tlbs->dtlb_4MB.entries != 0 ? &x86_tlbs->dtlb_4MB : &x86_tlbs->dtlb0_4MB);
+	append_tlb(tlbs->dtlb, &x86_tlbs->dtlb_1GB);
+
+	append_tlb(tlbs->stlb, &x86_tlbs->stlb2_4KB);
+	append_tlb(tlbs->stlb, &x86_tlbs->stlb2_2MB);
+	append_tlb(tlbs->stlb, &x86_tlbs->stlb2_1GB);
+}
@@ -3,6 +3,7 @@
 
 #include <cpuinfo.h>
 #include <cpuinfo/common.h>
+#include <cpuinfo/internal-api.h>
 #include <cpuinfo/log.h>
 #include <cpuinfo/utils.h>
 #include <x86/api.h>
@@ -29,7 +30,14 @@ void cpuinfo_x86_init_processor(struct cpuinfo_x86_processor* processor) {
 		processor->cpuid = leaf1.eax;
 
 		const struct cpuinfo_x86_model_info model_info = cpuinfo_x86_decode_model_info(leaf1.eax);
-		const enum cpuinfo_uarch uarch = processor->uarch = cpuinfo_x86_decode_uarch(vendor, &model_info);
+		enum cpuinfo_uarch uarch = cpuinfo_x86_decode_uarch(vendor, &model_info);
+
+		/* Hybrid processors: edx[bit 15] in structured feature info */
+		if (max_base_index >= UINT32_C(0x1A) && (cpuidex(7, 0).edx & UINT32_C(0x00008000))) {
+			processor->core_type = cpuidex(UINT32_C(0x1A), 0).eax >> 24;
+			uarch = cpuinfo_x86_decode_hybrid_uarch(uarch, processor->core_type);
+		}
+		processor->uarch = uarch;
 
 		cpuinfo_x86_clflush_size = ((leaf1.ebx >> 8) & UINT32_C(0x000000FF)) * 8;
 
@@ -61,12 +69,28 @@ void cpuinfo_x86_init_processor(struct cpuinfo_x86_processor* processor) {
 			&processor->tlb.stlb2_2MB,
 			&processor->tlb.stlb2_1GB,
 			&processor->topology.core_bits_length);
+		cpuinfo_x86_detect_tlb(max_base_index, max_extended_index, vendor, &processor->tlb);
 
 		cpuinfo_x86_detect_topology(max_base_index, max_extended_index, leaf1, &processor->topology);
+		if (amd_topology_extensions) {
+			cpuinfo_x86_detect_amd_topology(max_extended_index, uarch, &processor->cache, &processor->topology);
+		}
 
 		cpuinfo_isa = cpuinfo_x86_detect_isa(
 			leaf1, leaf0x80000001, max_base_index, max_extended_index, vendor, uarch);
 	}
+	if (max_base_index >= UINT32_C(0x16)) {
+		const struct cpuid_regs leaf0x16 = cpuid(UINT32_C(0x16));
+		processor->frequency.base = leaf0x16.eax & UINT32_C(0x0000FFFF);
+		processor->frequency.max = leaf0x16.ebx & UINT32_C(0x0000FFFF);
+		processor->frequency.bus = leaf0x16.ecx & UINT32_C(0x0000FFFF);
+		cpuinfo_log_debug(
+			"CPUID leaf 0x16: base frequency %" PRIu32 " MHz, max frequency %" PRIu32 " MHz, bus frequency %" PRIu32
+			" MHz",
+			processor->frequency.base,
+			processor->frequency.max,
+			processor->frequency.bus);
+	}
 	if (max_extended_index >= UINT32_C(0x80000004)) {
 		struct cpuid_regs brand_string[3];
 		for (uint32_t i = 0; i < 3; i++) {
@@ -76,3 +100,32 @@ void cpuinfo_x86_init_processor(struct cpuinfo_x86_processor* processor) {
 		cpuinfo_log_debug("raw CPUID brand string: \"%48s\"", processor->brand_string);
 	}
 }
+
+void cpuinfo_x86_init_isa(void) {
+	const struct cpuid_regs leaf0 = cpuid(0);
+	const uint32_t max_base_index = leaf0.eax;
+	const enum cpuinfo_vendor vendor = cpuinfo_x86_decode_vendor(leaf0.ebx, leaf0.ecx, leaf0.edx);
+
+	const struct cpuid_regs leaf0x80000000 = cpuid(UINT32_C(0x80000000));
+	const uint32_t max_extended_index = leaf0x80000000.eax >= UINT32_C(0x80000000) ? leaf0x80000000.eax : 0;
+
+	const struct cpuid_regs leaf0x80000001 = max_extended_index >= UINT32_C(0x80000001)
+		? cpuid(UINT32_C(0x80000001))
+		: (struct cpuid_regs){0, 0, 0, 0};
+
+	if (max_base_index >= 1) {
+		const struct cpuid_regs leaf1 = cpuid(1);
+		const struct cpuinfo_x86_model_info model_info = cpuinfo_x86_decode_model_info(leaf1.eax);
+		enum cpuinfo_uarch uarch = cpuinfo_x86_decode_uarch(vendor, &model_info);
+		if (max_base_index >= UINT32_C(0x1A) && (cpuidex(7, 0).edx & UINT32_C(0x00008000))) {
+			uarch = cpuinfo_x86_decode_hybrid_uarch(uarch, cpuidex(UINT32_C(0x1A), 0).eax >> 24);
+		}
+
+		cpuinfo_isa = cpuinfo_x86_detect_isa(
+			leaf1, leaf0x80000001, max_base_index, max_extended_index, vendor, uarch);
+		cpuinfo_isa_uarch = (struct cpuinfo_uarch_info){
+			.uarch = uarch,
+			.cpuid = leaf1.eax,
+		};
+	}
+}
@@ -8,12 +8,66 @@
 #include <linux/api.h>
 #include <x86/api.h>
 
+/* Maximum number of distinct core types on a hybrid processor */
+#define CPUINFO_X86_LINUX_MAX_CORE_TYPES 4
+
 struct cpuinfo_x86_linux_processor {
 	uint32_t apic_id;
 	uint32_t linux_id;
 	uint32_t flags;
+	/* Core type from CPUID leaf 0x1A, or 0 on non-hybrid processors */
+	uint32_t core_type;
+	/* Index of the core type description, and of the microarchitecture */
+	uint32_t uarch_index;
+	/* Non-Turbo frequency from cpufreq, in KHz, or 0 if cpufreq does not report it */
+	uint32_t frequency;
+	/* Caches of the processor, from sysfs or from CPUID of its core type */
+	struct cpuinfo_x86_caches cache;
+	/* Consecutive processors with the same cache ID share the cache */
+	struct {
+		uint32_t l1i;
+		uint32_t l1d;
+		uint32_t l2;
+		uint32_t l3;
+		uint32_t l4;
+	} cache_id;
 };
 
+/*
+ * Parses /proc/cpuinfo for processors below parsed_processors_count, and stops
+ * reading the file at the first processor listed past them. Only the processor
+ * numbers are parsed for processors without all of parsed_processor_flags. Pass
+ * max_processors_count as parsed_processors_count and 0 as parsed_processor_flags
+ * to parse all processors.
+ */
 CPUINFO_INTERNAL bool cpuinfo_x86_linux_parse_proc_cpuinfo(
 	uint32_t max_processors_count,
+	uint32_t parsed_processors_count,
+	uint32_t parsed_processor_flags,
 	struct cpuinfo_x86_linux_processor processors[restrict static max_processors_count]);
+
+/*
+ * Detects the core type of every valid processor of a hybrid processor and
+ * describes each core type by running CPUID on one of its processors. Core
+ * types are ordered from the most to the least performant one, and
+ * processors[i].uarch_index refers to them. Processors must be indexed by
+ * Linux processor ID.
+ *
+ * @returns the number of core type descriptions stored in core_types.
+ */
+CPUINFO_INTERNAL uint32_t cpuinfo_x86_linux_detect_core_types(
+	uint32_t max_processors_count,
+	struct cpuinfo_x86_linux_processor processors[restrict static max_processors_count],
+	const struct cpuinfo_x86_processor boot_processor[restrict static 1],
+	struct cpuinfo_x86_processor core_types[restrict static CPUINFO_X86_LINUX_MAX_CORE_TYPES]);
+
+/*
+ * Describes the caches of every valid processor. A cache level is described by
+ * sysfs cacheinfo if the kernel reports it for all valid processors, and by
+ * CPUID of the core type of each processor otherwise. Processors must be sorted
+ * by APIC ID.
+ */
+CPUINFO_INTERNAL void cpuinfo_x86_linux_detect_caches(
+	uint32_t processors_count,
+	struct cpuinfo_x86_linux_processor processors[restrict static processors_count],
+	const struct cpuinfo_x86_processor core_types[restrict static 1]);
@@ -0,0 +1,186 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo/log.h>
+#include <linux/api.h>
+#include <x86/api.h>
+#include <x86/linux/api.h>
+
+static inline uint32_t bit_mask(uint32_t bits) {
+	return (UINT32_C(1) << bits) - UINT32_C(1);
+}
+
+static inline bool bitmask_all(uint32_t bitfield, uint32_t mask) {
+	return (bitfield & mask) == mask;
+}
+
+struct cache_level {
+	const char* name;
+	/* Offsets of the level in struct cpuinfo_x86_caches and in struct cpuinfo_linux_caches */
+	size_t x86_offset;
+	size_t linux_offset;
+	/* Offset of the cache ID in struct cpuinfo_x86_linux_processor */
+	size_t id_offset;
+};
+
+static const struct cache_level cache_levels[] = {
+	{
+		.name = "L1I",
+		.x86_offset = offsetof(struct cpuinfo_x86_caches, l1i),
+		.linux_offset = offsetof(struct cpuinfo_linux_caches, l1i),
+		.id_offset = offsetof(struct cpuinfo_x86_linux_processor, cache_id.l1i),
+	},
+	{
+		.name = "L1D",
+		.x86_offset = offsetof(struct cpuinfo_x86_caches, l1d),
+		.linux_offset = offsetof(struct cpuinfo_linux_caches, l1d),
+		.id_offset = offsetof(struct cpuinfo_x86_linux_processor, cache_id.l1d),
+	},
+	{
+		.name = "L2",
+		.x86_offset = offsetof(struct cpuinfo_x86_caches, l2),
+		.linux_offset = offsetof(struct cpuinfo_linux_caches, l2),
+		.id_offset = offsetof(struct cpuinfo_x86_linux_processor, cache_id.l2),
+	},
+	{
+		.name = "L3",
+		.x86_offset = offsetof(struct cpuinfo_x86_caches, l3),
+		.linux_offset = offsetof(struct cpuinfo_linux_caches, l3),
+		.id_offset = offsetof(struct cpuinfo_x86_linux_processor, cache_id.l3),
+	},
+	{
+		.name = "L4",
+		.x86_offset = offsetof(struct cpuinfo_x86_caches, l4),
+		.linux_offset = offsetof(struct cpuinfo_linux_caches, l4),
+		.id_offset = offsetof(struct cpuinfo_x86_linux_processor, cache_id.l4),
+	},
+};
+
+struct sysfs_caches_context {
+	const struct cpuinfo_x86_linux_processor* processors;
+	struct cpuinfo_linux_caches* caches;
+};
+
+static void detect_sysfs_caches(uint32_t i, struct sysfs_caches_context* context) {
+	const struct cpuinfo_x86_linux_processor* processor = &context->processors[i];
+	if (bitmask_all(processor->flags, CPUINFO_LINUX_FLAG_VALID)) {
+		cpuinfo_linux_detect_processor_caches(processor->linux_id, &context->caches[i]);
+	}
+}
+
+static void reconcile_cache_level(
+	const struct cache_level level[restrict static 1],
+	uint32_t processors_count,
+	struct cpuinfo_x86_linux_processor processors[restrict static processors_count],
+	const struct cpuinfo_x86_processor core_types[restrict static 1],
+	const struct cpuinfo_linux_caches* sysfs_caches) {
+	/* Mixing sources within a level could split or merge cache instances */
+	bool use_sysfs = sysfs_caches != NULL;
+	for (uint32_t i = 0; use_sysfs && i < processors_count; i++) {
+		if (bitmask_all(processors[i].flags, CPUINFO_LINUX_FLAG_VALID)) {
+			const struct cpuinfo_linux_cache* sysfs_cache =
+				(const struct cpuinfo_linux_cache*)((const char*)&sysfs_caches[i] + level->linux_offset);
+			use_sysfs = sysfs_cache->size != 0;
+		}
+	}
+
+	uint32_t size_mismatch_index = UINT32_MAX;
+	bool sharing_mismatch = false;
+	uint32_t last_sysfs_id = UINT32_MAX, last_cpuid_id = UINT32_MAX;
+	for (uint32_t i = 0; i < processors_count; i++) {
+		struct cpuinfo_x86_linux_processor* processor = &processors[i];
+		if (!bitmask_all(processor->flags, CPUINFO_LINUX_FLAG_VALID)) {
+			continue;
+		}
+
+		const struct cpuinfo_x86_cache* cpuid_cache =
+			(const struct cpuinfo_x86_cache*)((const char*)&core_types[processor->uarch_index].cache +
+							  level->x86_offset);
+		struct cpuinfo_x86_cache* cache = (struct cpuinfo_x86_cache*)((char*)&processor->cache + level->x86_offset);
+		uint32_t* cache_id = (uint32_t*)((char*)processor + level->id_offset);
+		const uint32_t cpuid_id = processor->apic_id & ~bit_mask(cpuid_cache->apic_bits);
+		if (!use_sysfs) {
+			*cache = *cpuid_cache;
+			*cache_id = cpuid_id;
+			continue;
+		}
+
+		const struct cpuinfo_linux_cache* sysfs_cache =
+			(const struct cpuinfo_linux_cache*)((const char*)&sysfs_caches[i] + level->linux_offset);
+		const bool same_size = sysfs_cache->size == cpuid_cache->size;
+		*cache = (struct cpuinfo_x86_cache){
+			.size = sysfs_cache->size,
+			.associativity = sysfs_cache->associativity,
+			.sets = sysfs_cache->sets,
+			/* sysfs does not report partitions, inclusiveness and indexing of caches */
+			.partitions = same_size ? cpuid_cache->partitions : 1,
+			.line_size = sysfs_cache->line_size,
+			.flags = sysfs_cache->flags | (same_size ? cpuid_cache->flags & ~CPUINFO_CACHE_UNIFIED : 0) |
+				CPUINFO_CACHE_REPORTED_BY_OS,
+			.apic_bits = cpuid_cache->apic_bits,
+		};
+		*cache_id = sysfs_cache->processor_start;
+
+		if (cpuid_cache->size != 0) {
+			if (!same_size && size_mismatch_index == UINT32_MAX) {
+				size_mismatch_index = i;
+			}
+			/* Both sources must start a new cache instance on the same processors */
+			if ((*cache_id != last_sysfs_id) != (cpuid_id != last_cpuid_id)) {
+				sharing_mismatch = true;
+			}
+		}
+		last_sysfs_id = *cache_id;
+		last_cpuid_id = cpuid_id;
+	}
+
+	if (size_mismatch_index != UINT32_MAX) {
+		const struct cpuinfo_x86_linux_processor* processor = &processors[size_mismatch_index];
+		const struct cpuinfo_x86_cache* cpuid_cache =
+			(const struct cpuinfo_x86_cache*)((const char*)&core_types[processor->uarch_index].cache +
+							  level->x86_offset);
+		const struct cpuinfo_x86_cache* cache =
+			(const struct cpuinfo_x86_cache*)((const char*)&processor->cache + level->x86_offset);
+		cpuinfo_log_warning(
+			"%s cache of processor %" PRIu32 " has %" PRIu32 " bytes according to sysfs, but %" PRIu32
+			" bytes according to CPUID; using sysfs",
+			level->name,
+			processor->linux_id,
+			cache->size,
+			cpuid_cache->size);
+	}
+	if (sharing_mismatch) {
+		cpuinfo_log_warning(
+			"processors sharing %s caches according to sysfs differ from CPUID topology; using sysfs", level->name);
+	}
+	cpuinfo_log_debug("%s caches described by %s", level->name, use_sysfs ? "sysfs" : "CPUID");
+}
+
+void cpuinfo_x86_linux_detect_caches(
+	uint32_t processors_count,
+	struct cpuinfo_x86_linux_processor processors[restrict static processors_count],
+	const struct cpuinfo_x86_processor core_types[restrict static 1]) {
+	struct cpuinfo_linux_caches* sysfs_caches = calloc(processors_count, sizeof(struct cpuinfo_linux_caches));
+	if (sysfs_caches != NULL) {
+		struct sysfs_caches_context context = {
+			.processors = processors,
+			.caches = sysfs_caches,
+		};
+		cpuinfo_linux_for_each_processor(
+			processors_count, (cpuinfo_processor_function)detect_sysfs_caches, &context);
+	} else {
+		cpuinfo_log_warning(
+			"failed to allocate %zu bytes for sysfs cache descriptions of %" PRIu32
+			" processors, using CPUID caches",
+			processors_count * sizeof(struct cpuinfo_linux_caches),
+			processors_count);
+	}
+
+	for (size_t k = 0; k < sizeof(cache_levels) / sizeof(cache_levels[0]); k++) {
+		reconcile_cache_level(&cache_levels[k], processors_count, processors, core_types, sysfs_caches);
+	}
+	free(sysfs_caches);
+}
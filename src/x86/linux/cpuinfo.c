@@ -72,6 +72,11 @@ static void parse_apic_id(
 struct proc_cpuinfo_parser_state {
 	uint32_t processor_index;
 	uint32_t max_processors_count;
+	uint32_t parsed_processors_count;
+	/* Flags of processors whose lines are parsed; only processor numbers are parsed for the others */
+	uint32_t parsed_processor_flags;
+	/* Set when parsing stopped at the first processor at or above parsed_processors_count */
+	bool stopped;
 	struct cpuinfo_x86_linux_processor* processors;
 	struct cpuinfo_x86_linux_processor dummy_processor;
 };
@@ -90,6 +95,14 @@ static bool parse_line(
 		return true;
 	}
 
+	/* Skim over the description of a processor which is not parsed until the next processor number */
+	const uint32_t parsed_processor_flags = state->parsed_processor_flags;
+	if (state->processor_index < state->max_processors_count &&
+	    (state->processors[state->processor_index].flags & parsed_processor_flags) != parsed_processor_flags &&
+	    ((size_t)(line_end - line_start) < 9 || memcmp(line_start, "processor", 9) != 0)) {
+		return true;
+	}
+
 	/* Search for ':' on the line. */
 	const char* separator = line_start;
 	for (; separator != line_end; separator++) {
@@ -183,6 +196,12 @@ static bool parse_line(
 						new_processor_index,
 						processor_index);
 				}
+				if (new_processor_index >= state->parsed_processors_count &&
+				    new_processor_index < max_processors_count) {
+					/* Processors are listed in order: the rest of the file describes no wanted processors */
+					state->stopped = true;
+					return false;
+				}
 				if (new_processor_index >= max_processors_count) {
 					/* Log and ignore processor */
 					cpuinfo_log_warning(
@@ -208,12 +227,17 @@ static bool parse_line(
 
 bool cpuinfo_x86_linux_parse_proc_cpuinfo(
 	uint32_t max_processors_count,
+	uint32_t parsed_processors_count,
+	uint32_t parsed_processor_flags,
 	struct cpuinfo_x86_linux_processor processors[restrict static max_processors_count]) {
 	struct proc_cpuinfo_parser_state state = {
 		.processor_index = 0,
 		.max_processors_count = max_processors_count,
+		.parsed_processors_count = parsed_processors_count,
+		.parsed_processor_flags = parsed_processor_flags,
 		.processors = processors,
 	};
 	return cpuinfo_linux_parse_multiline_file(
-		"/proc/cpuinfo", BUFFER_SIZE, (cpuinfo_line_callback)parse_line, &state);
+		       "/proc/cpuinfo", BUFFER_SIZE, (cpuinfo_line_callback)parse_line, &state) ||
+		state.stopped;
 }
@@ -0,0 +1,225 @@
+#include <errno.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo/log.h>
+#include <linux/api.h>
+#include <x86/api.h>
+#include <x86/cpuid.h>
+#include <x86/linux/api.h>
+
+/* The hybrid PMU driver (Linux 5.13+) lists processors of each core type */
+#define CORE_PMU_CPUS_FILENAME "/sys/devices/cpu_core/cpus"
+#define ATOM_PMU_CPUS_FILENAME "/sys/devices/cpu_atom/cpus"
+
+static inline bool bitmask_all(uint32_t bitfield, uint32_t mask) {
+	return (bitfield & mask) == mask;
+}
+
+struct core_type_context {
+	uint32_t max_processors_count;
+	struct cpuinfo_x86_linux_processor* processors;
+	uint32_t core_type;
+};
+
+static bool core_type_parser(uint32_t processor_list_start, uint32_t processor_list_end, void* context) {
+	const struct core_type_context* core_type_context = (const struct core_type_context*)context;
+	if (processor_list_end > core_type_context->max_processors_count) {
+		processor_list_end = core_type_context->max_processors_count;
+	}
+	for (uint32_t processor = processor_list_start; processor < processor_list_end; processor++) {
+		core_type_context->processors[processor].core_type = core_type_context->core_type;
+	}
+	return true;
+}
+
+static bool detect_core_types_from_pmu(
+	uint32_t max_processors_count,
+	struct cpuinfo_x86_linux_processor processors[restrict static max_processors_count]) {
+	struct core_type_context context = {
+		.max_processors_count = max_processors_count,
+		.processors = processors,
+		.core_type = CPUINFO_X86_CORE_TYPE_CORE,
+	};
+	if (!cpuinfo_linux_parse_cpulist(CORE_PMU_CPUS_FILENAME, core_type_parser, &context)) {
+		return false;
+	}
+	context.core_type = CPUINFO_X86_CORE_TYPE_ATOM;
+	return cpuinfo_linux_parse_cpulist(ATOM_PMU_CPUS_FILENAME, core_type_parser, &context);
+}
+
+/*
+ * CPUID reports properties of the processor it runs on, so detection binds the
+ * calling thread to processors of each core type and restores its affinity mask
+ * when done. Mock builds never rebind the thread.
+ */
+struct affinity {
+	cpu_set_t* saved_set;
+	cpu_set_t* pinned_set;
+	size_t set_size;
+};
+
+static bool save_affinity(uint32_t max_processors_count, struct affinity affinity[restrict static 1]) {
+#if CPUINFO_MOCK
+	return false;
+#else
+	affinity->set_size = CPU_ALLOC_SIZE(max_processors_count);
+	affinity->saved_set = CPU_ALLOC(max_processors_count);
+	affinity->pinned_set = CPU_ALLOC(max_processors_count);
+	if (affinity->saved_set == NULL || affinity->pinned_set == NULL) {
+		cpuinfo_log_warning("failed to allocate CPU sets for %" PRIu32 " processors", max_processors_count);
+		goto cleanup;
+	}
+	if (sched_getaffinity(0, affinity->set_size, affinity->saved_set) != 0) {
+		cpuinfo_log_warning("failed to query thread affinity: %s", strerror(errno));
+		goto cleanup;
+	}
+	return true;
+
+cleanup:
+	CPU_FREE(affinity->saved_set);
+	CPU_FREE(affinity->pinned_set);
+	affinity->saved_set = affinity->pinned_set = NULL;
+	return false;
+#endif
+}
+
+static bool pin_to_processor(const struct affinity affinity[restrict static 1], uint32_t processor) {
+#if CPUINFO_MOCK
+	return false;
+#else
+	if (!CPU_ISSET_S(processor, affinity->set_size, affinity->saved_set)) {
+		/* The thread is not allowed to run there */
+		return false;
+	}
+	CPU_ZERO_S(affinity->set_size, affinity->pinned_set);
+	CPU_SET_S(processor, affinity->set_size, affinity->pinned_set);
+	if (sched_setaffinity(0, affinity->set_size, affinity->pinned_set) != 0) {
+		cpuinfo_log_info("failed to bind thread to processor %" PRIu32 ": %s", processor, strerror(errno));
+		return false;
+	}
+	return true;
+#endif
+}
+
+static void restore_affinity(struct affinity affinity[restrict static 1]) {
+#if !CPUINFO_MOCK
+	if (sched_setaffinity(0, affinity->set_size, affinity->saved_set) != 0) {
+		cpuinfo_log_warning("failed to restore thread affinity: %s", strerror(errno));
+	}
+	CPU_FREE(affinity->saved_set);
+	CPU_FREE(affinity->pinned_set);
+	affinity->saved_set = affinity->pinned_set = NULL;
+#endif
+}
+
+uint32_t cpuinfo_x86_linux_detect_core_types(
+	uint32_t max_processors_count,
+	struct cpuinfo_x86_linux_processor processors[restrict static max_processors_count],
+	const struct cpuinfo_x86_processor boot_processor[restrict static 1],
+	struct cpuinfo_x86_processor core_types[restrict static CPUINFO_X86_LINUX_MAX_CORE_TYPES]) {
+	struct affinity affinity = {0};
+	const bool can_pin = save_affinity(max_processors_count, &affinity);
+
+	if (!detect_core_types_from_pmu(max_processors_count, processors)) {
+		cpuinfo_log_debug("no hybrid PMU lists, querying core type of each processor with CPUID");
+		for (uint32_t i = 0; i < max_processors_count; i++) {
+			if (bitmask_all(processors[i].flags, CPUINFO_LINUX_FLAG_VALID) && can_pin &&
+			    pin_to_processor(&affinity, i)) {
+				processors[i].core_type = cpuidex(UINT32_C(0x1A), 0).eax >> 24;
+			}
+		}
+	}
+
+	/* Core types sorted in decreasing order, i.e. performance cores first */
+	uint32_t core_types_list[CPUINFO_X86_LINUX_MAX_CORE_TYPES];
+	uint32_t core_types_count = 0;
+	for (uint32_t i = 0; i < max_processors_count; i++) {
+		if (!bitmask_all(processors[i].flags, CPUINFO_LINUX_FLAG_VALID)) {
+			continue;
+		}
+		if (processors[i].core_type == 0) {
+			/* Not listed by the PMU driver, or could not run on the processor */
+			processors[i].core_type = boot_processor->core_type;
+		}
+
+		const uint32_t core_type = processors[i].core_type;
+		uint32_t position = 0;
+		while (position < core_types_count && core_types_list[position] > core_type) {
+			position++;
+		}
+		if (position < core_types_count && core_types_list[position] == core_type) {
+			continue;
+		}
+		if (core_types_count == CPUINFO_X86_LINUX_MAX_CORE_TYPES) {
+			cpuinfo_log_warning(
+				"ignored core type 0x%02" PRIx32 " of processor %" PRIu32 ": too many core types",
+				core_type,
+				i);
+			processors[i].core_type = boot_processor->core_type;
+			continue;
+		}
+		memmove(&core_types_list[position + 1],
+			&core_types_list[position],
+			(core_types_count - position) * sizeof(uint32_t));
+		core_types_list[position] = core_type;
+		core_types_count++;
+	}
+
+	if (core_types_count == 0) {
+		core_types_list[core_types_count++] = boot_processor->core_type;
+	}
+
+	const struct cpuinfo_x86_isa isa = cpuinfo_isa;
+	for (uint32_t k = 0; k < core_types_count; k++) {
+		const uint32_t core_type = core_types_list[k];
+		bool detected = core_type == boot_processor->core_type;
+		if (detected) {
+			core_types[k] = *boot_processor;
+		} else if (can_pin) {
+			for (uint32_t i = 0; i < max_processors_count; i++) {
+				if (bitmask_all(processors[i].flags, CPUINFO_LINUX_FLAG_VALID) &&
+				    processors[i].core_type == core_type && pin_to_processor(&affinity, i)) {
+					memset(&core_types[k], 0, sizeof(struct cpuinfo_x86_processor));
+					cpuinfo_x86_init_processor(&core_types[k]);
+					detected = core_types[k].core_type == core_type;
+					break;
+				}
+			}
+		}
+		if (!detected) {
+			/* Reuse caches of the boot processor, but report the microarchitecture of the core type */
+			cpuinfo_log_warning(
+				"failed to run CPUID on core type 0x%02" PRIx32 ", assuming caches of the calling processor",
+				core_type);
+			const struct cpuinfo_x86_model_info model_info =
+				cpuinfo_x86_decode_model_info(boot_processor->cpuid);
+			core_types[k] = *boot_processor;
+			core_types[k].core_type = core_type;
+			core_types[k].uarch = cpuinfo_x86_decode_hybrid_uarch(
+				cpuinfo_x86_decode_uarch(boot_processor->vendor, &model_info), core_type);
+		}
+		cpuinfo_log_debug(
+			"core type 0x%02" PRIx32 ": uarch 0x%08" PRIx32 ", L2 %" PRIu32 " bytes",
+			core_type,
+			(uint32_t)core_types[k].uarch,
+			core_types[k].cache.l2.size);
+
+		for (uint32_t i = 0; i < max_processors_count; i++) {
+			if (processors[i].core_type == core_type) {
+				processors[i].uarch_index = k;
+			}
+		}
+	}
+	/* ISA is reported for the processor which initialized the library */
+	cpuinfo_isa = isa;
+
+	if (can_pin) {
+		restore_affinity(&affinity);
+	}
+	return core_types_count;
+}
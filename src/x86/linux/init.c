@@ -43,90 +43,171 @@ static int cmp_x86_linux_processor(const void* ptr_a, const void* ptr_b) {
 	return cmp(id_a, id_b);
 }
 
+/* Masks of APIC ID bits which identify the topology objects containing a logical processor */
+struct apic_masks {
+	uint32_t core;
+	uint32_t module;
+	uint32_t die;
+	uint32_t package;
+	/* Offsets of module and die IDs in APIC ID */
+	uint32_t module_offset;
+	uint32_t die_offset;
+};
+
+static struct apic_masks get_apic_masks(const struct cpuinfo_x86_topology topology[restrict static 1]) {
+	/* Without a module level every core is a module, and without a die level the package is a single die */
+	const uint32_t module_offset =
+		topology->module_bits_length != 0 ? topology->module_bits_offset : topology->core_bits_offset;
+	const uint32_t die_offset =
+		topology->die_bits_length != 0 ? topology->die_bits_offset : topology->package_bits_offset;
+	return (struct apic_masks){
+		.core = ~(bit_mask(topology->thread_bits_length) << topology->thread_bits_offset),
+		.module = ~bit_mask(module_offset),
+		.die = ~bit_mask(die_offset),
+		.package = ~bit_mask(topology->package_bits_offset),
+		.module_offset = module_offset,
+		.die_offset = die_offset,
+	};
+}
+
+/*
+ * ID of the last level cache of a logical processor, as reconciled with sysfs cacheinfo, or UINT32_MAX if it has no
+ * caches. Consecutive processors with the same ID share the cache.
+ */
+static uint32_t get_llc_id(const struct cpuinfo_x86_linux_processor processor[restrict static 1]) {
+	if (processor->cache.l4.size != 0) {
+		return processor->cache_id.l4;
+	} else if (processor->cache.l3.size != 0) {
+		return processor->cache_id.l3;
+	} else if (processor->cache.l2.size != 0) {
+		return processor->cache_id.l2;
+	} else if (processor->cache.l1d.size != 0) {
+		return processor->cache_id.l1d;
+	}
+	return UINT32_MAX;
+}
+
+static void detect_frequency(uint32_t processor, struct cpuinfo_x86_linux_processor* processors) {
+	if (!bitmask_all(processors[processor].flags, CPUINFO_LINUX_FLAG_VALID)) {
+		return;
+	}
+	/* Core frequency excludes Turbo, which only base frequency (intel_pstate) reliably leaves out */
+	uint32_t frequency = cpuinfo_linux_get_processor_base_frequency(processor);
+	if (frequency == 0) {
+		frequency = cpuinfo_linux_get_processor_max_frequency(processor);
+	}
+	if (frequency == 0) {
+		frequency = cpuinfo_linux_get_processor_scaling_max_frequency(processor);
+	}
+	processors[processor].frequency = frequency;
+}
+
+/* Frequency of a logical processor in Hz, from cpufreq or else from CPUID leaf 0x16 of its core type */
+static uint64_t get_frequency(
+	const struct cpuinfo_x86_linux_processor processor[restrict static 1],
+	const struct cpuinfo_x86_processor core_type[restrict static 1]) {
+	if (processor->frequency != 0) {
+		return (uint64_t)processor->frequency * UINT64_C(1000);
+	}
+	const uint32_t frequency_mhz =
+		core_type->frequency.base != 0 ? core_type->frequency.base : core_type->frequency.max;
+	return (uint64_t)frequency_mhz * UINT64_C(1000000);
+}
+
 static void cpuinfo_x86_count_objects(
 	uint32_t linux_processors_count,
 	const struct cpuinfo_x86_linux_processor linux_processors[restrict static linux_processors_count],
-	const struct cpuinfo_x86_processor processor[restrict static 1],
 	uint32_t valid_processor_mask,
-	uint32_t llc_apic_bits,
+	const struct apic_masks apic_masks[restrict static 1],
 	uint32_t cores_count_ptr[restrict static 1],
+	uint32_t modules_count_ptr[restrict static 1],
 	uint32_t clusters_count_ptr[restrict static 1],
+	uint32_t dies_count_ptr[restrict static 1],
 	uint32_t packages_count_ptr[restrict static 1],
 	uint32_t l1i_count_ptr[restrict static 1],
 	uint32_t l1d_count_ptr[restrict static 1],
 	uint32_t l2_count_ptr[restrict static 1],
 	uint32_t l3_count_ptr[restrict static 1],
 	uint32_t l4_count_ptr[restrict static 1]) {
-	const uint32_t core_apic_mask =
-		~(bit_mask(processor->topology.thread_bits_length) << processor->topology.thread_bits_offset);
-	const uint32_t package_apic_mask = core_apic_mask &
-		~(bit_mask(processor->topology.core_bits_length) << processor->topology.core_bits_offset);
-	const uint32_t llc_apic_mask = ~bit_mask(llc_apic_bits);
-	const uint32_t cluster_apic_mask = package_apic_mask | llc_apic_mask;
-
-	uint32_t cores_count = 0, clusters_count = 0, packages_count = 0;
+	uint32_t cores_count = 0, modules_count = 0, clusters_count = 0, dies_count = 0, packages_count = 0;
 	uint32_t l1i_count = 0, l1d_count = 0, l2_count = 0, l3_count = 0, l4_count = 0;
-	uint32_t last_core_id = UINT32_MAX, last_cluster_id = UINT32_MAX, last_package_id = UINT32_MAX;
+	uint32_t last_core_id = UINT32_MAX, last_module_id = UINT32_MAX;
+	uint32_t last_cluster_llc_id = UINT32_MAX, last_cluster_die_id = UINT32_MAX;
+	uint32_t last_die_id = UINT32_MAX, last_package_id = UINT32_MAX;
 	uint32_t last_l1i_id = UINT32_MAX, last_l1d_id = UINT32_MAX;
 	uint32_t last_l2_id = UINT32_MAX, last_l3_id = UINT32_MAX, last_l4_id = UINT32_MAX;
+	uint32_t last_uarch_index = UINT32_MAX;
 	for (uint32_t i = 0; i < linux_processors_count; i++) {
 		if (bitmask_all(linux_processors[i].flags, valid_processor_mask)) {
 			const uint32_t apic_id = linux_processors[i].apic_id;
+			const uint32_t uarch_index = linux_processors[i].uarch_index;
+			const struct cpuinfo_x86_caches* cache = &linux_processors[i].cache;
 			cpuinfo_log_debug(
 				"APID ID %" PRIu32 ": system processor %" PRIu32,
 				apic_id,
 				linux_processors[i].linux_id);
 
 			/* All bits of APIC ID except thread ID mask */
-			const uint32_t core_id = apic_id & core_apic_mask;
+			const uint32_t core_id = apic_id & apic_masks->core;
 			if (core_id != last_core_id) {
 				last_core_id = core_id;
 				cores_count++;
 			}
-			/* All bits of APIC ID except thread ID and core ID
-			 * masks */
-			const uint32_t package_id = apic_id & package_apic_mask;
+			const uint32_t module_id = apic_id & apic_masks->module;
+			if (module_id != last_module_id) {
+				last_module_id = module_id;
+				modules_count++;
+			}
+			const uint32_t die_id = apic_id & apic_masks->die;
+			if (die_id != last_die_id) {
+				last_die_id = die_id;
+				dies_count++;
+			}
+			/* All bits of APIC ID above the bits of levels within a package */
+			const uint32_t package_id = apic_id & apic_masks->package;
 			if (package_id != last_package_id) {
 				last_package_id = package_id;
 				packages_count++;
 			}
-			/* Bits of APIC ID which are part of either LLC or
-			 * package ID mask */
-			const uint32_t cluster_id = apic_id & cluster_apic_mask;
-			if (cluster_id != last_cluster_id) {
-				last_cluster_id = cluster_id;
+			/* Clusters share the last level cache, and never span dies */
+			const uint32_t llc_id = get_llc_id(&linux_processors[i]);
+			if (llc_id != last_cluster_llc_id || die_id != last_cluster_die_id ||
+			    uarch_index != last_uarch_index) {
+				last_cluster_llc_id = llc_id;
+				last_cluster_die_id = die_id;
+				last_uarch_index = uarch_index;
 				clusters_count++;
 			}
-			if (processor->cache.l1i.size != 0) {
-				const uint32_t l1i_id = apic_id & ~bit_mask(processor->cache.l1i.apic_bits);
+			if (cache->l1i.size != 0) {
+				const uint32_t l1i_id = linux_processors[i].cache_id.l1i;
 				if (l1i_id != last_l1i_id) {
 					last_l1i_id = l1i_id;
 					l1i_count++;
 				}
 			}
-			if (processor->cache.l1d.size != 0) {
-				const uint32_t l1d_id = apic_id & ~bit_mask(processor->cache.l1d.apic_bits);
+			if (cache->l1d.size != 0) {
+				const uint32_t l1d_id = linux_processors[i].cache_id.l1d;
 				if (l1d_id != last_l1d_id) {
 					last_l1d_id = l1d_id;
 					l1d_count++;
 				}
 			}
-			if (processor->cache.l2.size != 0) {
-				const uint32_t l2_id = apic_id & ~bit_mask(processor->cache.l2.apic_bits);
+			if (cache->l2.size != 0) {
+				const uint32_t l2_id = linux_processors[i].cache_id.l2;
 				if (l2_id != last_l2_id) {
 					last_l2_id = l2_id;
 					l2_count++;
 				}
 			}
-			if (processor->cache.l3.size != 0) {
-				const uint32_t l3_id = apic_id & ~bit_mask(processor->cache.l3.apic_bits);
+			if (cache->l3.size != 0) {
+				const uint32_t l3_id = linux_processors[i].cache_id.l3;
 				if (l3_id != last_l3_id) {
 					last_l3_id = l3_id;
 					l3_count++;
 				}
 			}
-			if (processor->cache.l4.size != 0) {
-				const uint32_t l4_id = apic_id & ~bit_mask(processor->cache.l4.apic_bits);
+			if (cache->l4.size != 0) {
+				const uint32_t l4_id = linux_processors[i].cache_id.l4;
 				if (l4_id != last_l4_id) {
 					last_l4_id = l4_id;
 					l4_count++;
@@ -135,7 +216,9 @@ static void cpuinfo_x86_count_objects(
 		}
 	}
 	*cores_count_ptr = cores_count;
+	*modules_count_ptr = modules_count;
 	*clusters_count_ptr = clusters_count;
+	*dies_count_ptr = dies_count;
 	*packages_count_ptr = packages_count;
 	*l1i_count_ptr = l1i_count;
 	*l1d_count_ptr = l1d_count;
@@ -146,17 +229,24 @@ static void cpuinfo_x86_count_objects(
 
 void cpuinfo_x86_linux_init(void) {
 	struct cpuinfo_x86_linux_processor* x86_linux_processors = NULL;
+	void* arena = NULL;
 	struct cpuinfo_processor* processors = NULL;
 	struct cpuinfo_core* cores = NULL;
 	struct cpuinfo_cluster* clusters = NULL;
+	struct cpuinfo_uarch_info* uarchs = NULL;
+	struct cpuinfo_tlbs* tlbs = NULL;
 	struct cpuinfo_package* packages = NULL;
 	const struct cpuinfo_processor** linux_cpu_to_processor_map = NULL;
 	const struct cpuinfo_core** linux_cpu_to_core_map = NULL;
+	uint32_t* linux_cpu_to_uarch_index_map = NULL;
 	struct cpuinfo_cache* l1i = NULL;
 	struct cpuinfo_cache* l1d = NULL;
 	struct cpuinfo_cache* l2 = NULL;
 	struct cpuinfo_cache* l3 = NULL;
 	struct cpuinfo_cache* l4 = NULL;
+	struct cpuinfo_numa_node* numa_nodes = NULL;
+	uint8_t* numa_distances = NULL;
+	struct cpuinfo_linux_numa_nodes numa = {0};
 
 	const uint32_t max_processors_count = cpuinfo_linux_get_max_processors_count();
 	cpuinfo_log_debug("system maximum processors count: %" PRIu32, max_processors_count);
@@ -205,7 +295,26 @@ void cpuinfo_x86_linux_init(void) {
 			CPUINFO_LINUX_FLAG_PRESENT);
 	}
 
-	if (!cpuinfo_x86_linux_parse_proc_cpuinfo(x86_linux_processors_count, x86_linux_processors)) {
+	/* Restricted detection describes only allowed processors and their siblings, and leaves out the rest */
+	uint32_t parsed_processors_count = x86_linux_processors_count;
+	uint32_t parsed_processor_flags = 0;
+	if (cpuinfo_linux_restricted_detection &&
+	    cpuinfo_linux_detect_allowed_processors(
+		    x86_linux_processors_count,
+		    &x86_linux_processors->flags,
+		    sizeof(struct cpuinfo_x86_linux_processor),
+		    CPUINFO_LINUX_FLAG_ALLOWED)) {
+		valid_processor_mask |= CPUINFO_LINUX_FLAG_ALLOWED;
+		parsed_processor_flags = CPUINFO_LINUX_FLAG_ALLOWED;
+		while (parsed_processors_count != 0 &&
+		       !bitmask_all(x86_linux_processors[parsed_processors_count - 1].flags, CPUINFO_LINUX_FLAG_ALLOWED)) {
+			parsed_processors_count--;
+		}
+		cpuinfo_log_debug("restricted detection to processors below %" PRIu32, parsed_processors_count);
+	}
+
+	if (!cpuinfo_x86_linux_parse_proc_cpuinfo(
+		    x86_linux_processors_count, parsed_processors_count, parsed_processor_flags, x86_linux_processors)) {
 		cpuinfo_log_error("failed to parse processor information from /proc/cpuinfo");
 		return;
 	}
@@ -216,12 +325,26 @@ void cpuinfo_x86_linux_init(void) {
 		}
 	}
 
+	cpuinfo_linux_for_each_processor(
+		x86_linux_processors_count, (cpuinfo_processor_function)detect_frequency, x86_linux_processors);
+
 	struct cpuinfo_x86_processor x86_processor;
 	memset(&x86_processor, 0, sizeof(x86_processor));
 	cpuinfo_x86_init_processor(&x86_processor);
 	char brand_string[48];
 	cpuinfo_x86_normalize_brand_string(x86_processor.brand_string, brand_string);
 
+	/* Processors of each core type of a hybrid processor have their own microarchitecture and caches */
+	struct cpuinfo_x86_processor core_types[CPUINFO_X86_LINUX_MAX_CORE_TYPES];
+	uint32_t uarchs_count = 1;
+	if (x86_processor.core_type != 0) {
+		uarchs_count = cpuinfo_x86_linux_detect_core_types(
+			x86_linux_processors_count, x86_linux_processors, &x86_processor, core_types);
+	} else {
+		core_types[0] = x86_processor;
+	}
+	cpuinfo_log_debug("detected %" PRIu32 " core types", uarchs_count);
+
 	uint32_t processors_count = 0;
 	for (uint32_t i = 0; i < x86_linux_processors_count; i++) {
 		if (bitmask_all(x86_linux_processors[i].flags, CPUINFO_LINUX_FLAG_VALID)) {
@@ -235,35 +358,20 @@ void cpuinfo_x86_linux_init(void) {
 	      sizeof(struct cpuinfo_x86_linux_processor),
 	      cmp_x86_linux_processor);
 
-	processors = calloc(processors_count, sizeof(struct cpuinfo_processor));
-	if (processors == NULL) {
-		cpuinfo_log_error(
-			"failed to allocate %zu bytes for descriptions of %" PRIu32 " logical processors",
-			processors_count * sizeof(struct cpuinfo_processor),
-			processors_count);
-		goto cleanup;
-	}
+	cpuinfo_x86_linux_detect_caches(x86_linux_processors_count, x86_linux_processors, core_types);
 
-	uint32_t llc_apic_bits = 0;
-	if (x86_processor.cache.l4.size != 0) {
-		llc_apic_bits = x86_processor.cache.l4.apic_bits;
-	} else if (x86_processor.cache.l3.size != 0) {
-		llc_apic_bits = x86_processor.cache.l3.apic_bits;
-	} else if (x86_processor.cache.l2.size != 0) {
-		llc_apic_bits = x86_processor.cache.l2.apic_bits;
-	} else if (x86_processor.cache.l1d.size != 0) {
-		llc_apic_bits = x86_processor.cache.l1d.apic_bits;
-	}
-	uint32_t packages_count = 0, clusters_count = 0, cores_count = 0;
+	const struct apic_masks apic_masks = get_apic_masks(&x86_processor.topology);
+	uint32_t packages_count = 0, dies_count = 0, clusters_count = 0, modules_count = 0, cores_count = 0;
 	uint32_t l1i_count = 0, l1d_count = 0, l2_count = 0, l3_count = 0, l4_count = 0;
 	cpuinfo_x86_count_objects(
 		x86_linux_processors_count,
 		x86_linux_processors,
-		&x86_processor,
 		valid_processor_mask,
-		llc_apic_bits,
+		&apic_masks,
 		&cores_count,
+		&modules_count,
 		&clusters_count,
+		&dies_count,
 		&packages_count,
 		&l1i_count,
 		&l1d_count,
@@ -272,7 +380,9 @@ void cpuinfo_x86_linux_init(void) {
 		&l4_count);
 
 	cpuinfo_log_debug("detected %" PRIu32 " cores", cores_count);
+	cpuinfo_log_debug("detected %" PRIu32 " modules", modules_count);
 	cpuinfo_log_debug("detected %" PRIu32 " clusters", clusters_count);
+	cpuinfo_log_debug("detected %" PRIu32 " dies", dies_count);
 	cpuinfo_log_debug("detected %" PRIu32 " packages", packages_count);
 	cpuinfo_log_debug("detected %" PRIu32 " L1I caches", l1i_count);
 	cpuinfo_log_debug("detected %" PRIu32 " L1D caches", l1d_count);
@@ -280,140 +390,132 @@ void cpuinfo_x86_linux_init(void) {
 	cpuinfo_log_debug("detected %" PRIu32 " L3 caches", l3_count);
 	cpuinfo_log_debug("detected %" PRIu32 " L4 caches", l4_count);
 
-	linux_cpu_to_processor_map = calloc(x86_linux_processors_count, sizeof(struct cpuinfo_processor*));
-	if (linux_cpu_to_processor_map == NULL) {
-		cpuinfo_log_error(
-			"failed to allocate %zu bytes for mapping entries of %" PRIu32 " logical processors",
-			x86_linux_processors_count * sizeof(struct cpuinfo_processor*),
-			x86_linux_processors_count);
+	if (!cpuinfo_linux_detect_numa_nodes(x86_linux_processors_count, &numa)) {
 		goto cleanup;
 	}
-
-	linux_cpu_to_core_map = calloc(x86_linux_processors_count, sizeof(struct cpuinfo_core*));
-	if (linux_cpu_to_core_map == NULL) {
+	cpuinfo_log_debug("detected %" PRIu32 " NUMA nodes", numa.nodes_count);
+
+	/*
+	 * All tables share one cache-line-aligned arena. Tables are laid out in
+	 * the order of decreasing access frequency: the Linux CPU maps and the
+	 * processor and core tables are read on every cpuinfo_get_current_* call.
+	 */
+	size_t arena_size = 0;
+	const size_t linux_cpu_to_processor_map_offset = cpuinfo_tables_arena_reserve(
+		&arena_size, x86_linux_processors_count, sizeof(struct cpuinfo_processor*));
+	const size_t linux_cpu_to_core_map_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, x86_linux_processors_count, sizeof(struct cpuinfo_core*));
+	const size_t linux_cpu_to_uarch_index_map_offset = cpuinfo_tables_arena_reserve(
+		&arena_size, uarchs_count > 1 ? x86_linux_processors_count : 0, sizeof(uint32_t));
+	const size_t processors_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, processors_count, sizeof(struct cpuinfo_processor));
+	const size_t cores_offset = cpuinfo_tables_arena_reserve(&arena_size, cores_count, sizeof(struct cpuinfo_core));
+	const size_t clusters_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, clusters_count, sizeof(struct cpuinfo_cluster));
+	const size_t uarchs_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, uarchs_count, sizeof(struct cpuinfo_uarch_info));
+	const size_t tlbs_offset = cpuinfo_tables_arena_reserve(&arena_size, uarchs_count, sizeof(struct cpuinfo_tlbs));
+	const size_t l1d_offset = cpuinfo_tables_arena_reserve(&arena_size, l1d_count, sizeof(struct cpuinfo_cache));
+	const size_t l1i_offset = cpuinfo_tables_arena_reserve(&arena_size, l1i_count, sizeof(struct cpuinfo_cache));
+	const size_t l2_offset = cpuinfo_tables_arena_reserve(&arena_size, l2_count, sizeof(struct cpuinfo_cache));
+	const size_t l3_offset = cpuinfo_tables_arena_reserve(&arena_size, l3_count, sizeof(struct cpuinfo_cache));
+	const size_t l4_offset = cpuinfo_tables_arena_reserve(&arena_size, l4_count, sizeof(struct cpuinfo_cache));
+	const size_t packages_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, packages_count, sizeof(struct cpuinfo_package));
+	const size_t numa_nodes_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, numa.nodes_count, sizeof(struct cpuinfo_numa_node));
+	const size_t numa_distances_offset =
+		cpuinfo_tables_arena_reserve(&arena_size, numa.nodes_count * numa.nodes_count, sizeof(uint8_t));
+
+	arena = cpuinfo_allocate_tables_arena(arena_size);
+	if (arena == NULL) {
 		cpuinfo_log_error(
-			"failed to allocate %zu bytes for mapping entries of %" PRIu32 " cores",
-			x86_linux_processors_count * sizeof(struct cpuinfo_core*),
-			x86_linux_processors_count);
+			"failed to allocate %zu bytes for descriptions of %" PRIu32 " logical processors",
+			arena_size,
+			processors_count);
 		goto cleanup;
 	}
 
-	cores = calloc(cores_count, sizeof(struct cpuinfo_core));
-	if (cores == NULL) {
-		cpuinfo_log_error(
-			"failed to allocate %zu bytes for descriptions of %" PRIu32 " cores",
-			cores_count * sizeof(struct cpuinfo_core),
-			cores_count);
-		goto cleanup;
+	linux_cpu_to_processor_map =
+		(const struct cpuinfo_processor**)((char*)arena + linux_cpu_to_processor_map_offset);
+	linux_cpu_to_core_map = (const struct cpuinfo_core**)((char*)arena + linux_cpu_to_core_map_offset);
+	if (uarchs_count > 1) {
+		linux_cpu_to_uarch_index_map = (uint32_t*)((char*)arena + linux_cpu_to_uarch_index_map_offset);
 	}
-
-	clusters = calloc(clusters_count, sizeof(struct cpuinfo_cluster));
-	if (clusters == NULL) {
-		cpuinfo_log_error(
-			"failed to allocate %zu bytes for descriptions of %" PRIu32 " core clusters",
-			clusters_count * sizeof(struct cpuinfo_cluster),
-			clusters_count);
-		goto cleanup;
+	processors = (struct cpuinfo_processor*)((char*)arena + processors_offset);
+	cores = (struct cpuinfo_core*)((char*)arena + cores_offset);
+	clusters = (struct cpuinfo_cluster*)((char*)arena + clusters_offset);
+	uarchs = (struct cpuinfo_uarch_info*)((char*)arena + uarchs_offset);
+	for (uint32_t i = 0; i < uarchs_count; i++) {
+		uarchs[i] = (struct cpuinfo_uarch_info){
+			.uarch = core_types[i].uarch,
+			.cpuid = core_types[i].cpuid,
+		};
 	}
-
-	packages = calloc(packages_count, sizeof(struct cpuinfo_package));
-	if (packages == NULL) {
-		cpuinfo_log_error(
-			"failed to allocate %zu bytes for descriptions of %" PRIu32 " physical packages",
-			packages_count * sizeof(struct cpuinfo_package),
-			packages_count);
-		goto cleanup;
+	tlbs = (struct cpuinfo_tlbs*)((char*)arena + tlbs_offset);
+	for (uint32_t i = 0; i < uarchs_count; i++) {
+		cpuinfo_x86_describe_tlbs(&core_types[i].tlb, &tlbs[i]);
 	}
-
+	packages = (struct cpuinfo_package*)((char*)arena + packages_offset);
+	numa_nodes = (struct cpuinfo_numa_node*)((char*)arena + numa_nodes_offset);
+	numa_distances = (uint8_t*)arena + numa_distances_offset;
 	if (l1i_count != 0) {
-		l1i = calloc(l1i_count, sizeof(struct cpuinfo_cache));
-		if (l1i == NULL) {
-			cpuinfo_log_error(
-				"failed to allocate %zu bytes for descriptions of %" PRIu32 " L1I caches",
-				l1i_count * sizeof(struct cpuinfo_cache),
-				l1i_count);
-			goto cleanup;
-		}
+		l1i = (struct cpuinfo_cache*)((char*)arena + l1i_offset);
 	}
 	if (l1d_count != 0) {
-		l1d = calloc(l1d_count, sizeof(struct cpuinfo_cache));
-		if (l1d == NULL) {
-			cpuinfo_log_error(
-				"failed to allocate %zu bytes for descriptions of %" PRIu32 " L1D caches",
-				l1d_count * sizeof(struct cpuinfo_cache),
-				l1d_count);
-			goto cleanup;
-		}
+		l1d = (struct cpuinfo_cache*)((char*)arena + l1d_offset);
 	}
 	if (l2_count != 0) {
-		l2 = calloc(l2_count, sizeof(struct cpuinfo_cache));
-		if (l2 == NULL) {
-			cpuinfo_log_error(
-				"failed to allocate %zu bytes for descriptions of %" PRIu32 " L2 caches",
-				l2_count * sizeof(struct cpuinfo_cache),
-				l2_count);
-			goto cleanup;
-		}
+		l2 = (struct cpuinfo_cache*)((char*)arena + l2_offset);
 	}
 	if (l3_count != 0) {
-		l3 = calloc(l3_count, sizeof(struct cpuinfo_cache));
-		if (l3 == NULL) {
-			cpuinfo_log_error(
-				"failed to allocate %zu bytes for descriptions of %" PRIu32 " L3 caches",
-				l3_count * sizeof(struct cpuinfo_cache),
-				l3_count);
-			goto cleanup;
-		}
+		l3 = (struct cpuinfo_cache*)((char*)arena + l3_offset);
 	}
 	if (l4_count != 0) {
-		l4 = calloc(l4_count, sizeof(struct cpuinfo_cache));
-		if (l4 == NULL) {
-			cpuinfo_log_error(
-				"failed to allocate %zu bytes for descriptions of %" PRIu32 " L4 caches",
-				l4_count * sizeof(struct cpuinfo_cache),
-				l4_count);
-			goto cleanup;
-		}
+		l4 = (struct cpuinfo_cache*)((char*)arena + l4_offset);
 	}
 
-	const uint32_t core_apic_mask =
-		~(bit_mask(x86_processor.topology.thread_bits_length) << x86_processor.topology.thread_bits_offset);
-	const uint32_t package_apic_mask = core_apic_mask &
-		~(bit_mask(x86_processor.topology.core_bits_length) << x86_processor.topology.core_bits_offset);
-	const uint32_t llc_apic_mask = ~bit_mask(llc_apic_bits);
-	const uint32_t cluster_apic_mask = package_apic_mask | llc_apic_mask;
-
 	uint32_t processor_index = UINT32_MAX, core_index = UINT32_MAX, cluster_index = UINT32_MAX,
 		 package_index = UINT32_MAX;
 	uint32_t l1i_index = UINT32_MAX, l1d_index = UINT32_MAX, l2_index = UINT32_MAX, l3_index = UINT32_MAX,
 		 l4_index = UINT32_MAX;
 	uint32_t cluster_id = 0, core_id = 0, smt_id = 0;
-	uint32_t last_apic_core_id = UINT32_MAX, last_apic_cluster_id = UINT32_MAX, last_apic_package_id = UINT32_MAX;
+	uint32_t last_apic_core_id = UINT32_MAX, last_apic_package_id = UINT32_MAX;
+	uint32_t last_cluster_llc_id = UINT32_MAX, last_cluster_apic_die_id = UINT32_MAX;
 	uint32_t last_l1i_id = UINT32_MAX, last_l1d_id = UINT32_MAX;
 	uint32_t last_l2_id = UINT32_MAX, last_l3_id = UINT32_MAX, last_l4_id = UINT32_MAX;
+	uint32_t last_uarch_index = UINT32_MAX;
 	for (uint32_t i = 0; i < x86_linux_processors_count; i++) {
 		if (bitmask_all(x86_linux_processors[i].flags, CPUINFO_LINUX_FLAG_VALID)) {
 			const uint32_t apic_id = x86_linux_processors[i].apic_id;
+			const uint32_t uarch_index = x86_linux_processors[i].uarch_index;
+			const struct cpuinfo_x86_processor* core_type = &core_types[uarch_index];
+			const struct cpuinfo_x86_caches* cache = &x86_linux_processors[i].cache;
+			const uint64_t frequency = get_frequency(&x86_linux_processors[i], core_type);
 			processor_index++;
 			smt_id++;
 
 			/* All bits of APIC ID except thread ID mask */
-			const uint32_t apid_core_id = apic_id & core_apic_mask;
+			const uint32_t apid_core_id = apic_id & apic_masks.core;
 			if (apid_core_id != last_apic_core_id) {
 				core_index++;
 				core_id++;
 				smt_id = 0;
 			}
-			/* Bits of APIC ID which are part of either LLC or
-			 * package ID mask */
-			const uint32_t apic_cluster_id = apic_id & cluster_apic_mask;
-			if (apic_cluster_id != last_apic_cluster_id) {
+			/*
+			 * Clusters share the last level cache as described by the cache tables, and never span dies.
+			 * Cores of different types share the LLC, but not a cluster.
+			 */
+			const uint32_t llc_id = get_llc_id(&x86_linux_processors[i]);
+			const uint32_t apic_die_id = apic_id & apic_masks.die;
+			const bool new_cluster = llc_id != last_cluster_llc_id || apic_die_id != last_cluster_apic_die_id ||
+				uarch_index != last_uarch_index;
+			if (new_cluster) {
 				cluster_index++;
 				cluster_id++;
 			}
-			/* All bits of APIC ID except thread ID and core ID
-			 * masks */
-			const uint32_t apic_package_id = apic_id & package_apic_mask;
+			/* All bits of APIC ID above the bits of levels within a package */
+			const uint32_t apic_package_id = apic_id & apic_masks.package;
 			if (apic_package_id != last_apic_package_id) {
 				package_index++;
 				core_id = 0;
@@ -436,34 +538,53 @@ void cpuinfo_x86_linux_init(void) {
 					.core_id = core_id,
 					.cluster = clusters + cluster_index,
 					.package = packages + package_index,
-					.vendor = x86_processor.vendor,
-					.uarch = x86_processor.uarch,
-					.cpuid = x86_processor.cpuid,
+					.vendor = core_type->vendor,
+					.uarch = core_type->uarch,
+					.cpuid = core_type->cpuid,
+					.module_id = (apic_id & ~apic_masks.package) >> apic_masks.module_offset,
+					.die_id = (apic_id & ~apic_masks.package) >> apic_masks.die_offset,
+					.capacity = cpuinfo_linux_get_processor_capacity(x86_linux_processors[i].linux_id),
+					.performance_ranking = cpuinfo_linux_get_processor_performance_ranking(
+						x86_linux_processors[i].linux_id),
+					.frequency = frequency,
 				};
 				clusters[cluster_index].core_count += 1;
 				packages[package_index].core_count += 1;
+				uarchs[uarch_index].core_count += 1;
 				last_apic_core_id = apid_core_id;
 			} else {
 				/* another logical processor on the same core */
 				cores[core_index].processor_count++;
+				/* SMT siblings share the clock of their core */
+				if (frequency != 0 && (cores[core_index].frequency == 0 || frequency < cores[core_index].frequency)) {
+					cores[core_index].frequency = frequency;
+				}
 			}
 
-			if (apic_cluster_id != last_apic_cluster_id) {
+			if (new_cluster) {
 				/* new cluster */
 				clusters[cluster_index].processor_start = processor_index;
 				clusters[cluster_index].processor_count = 1;
 				clusters[cluster_index].core_start = core_index;
 				clusters[cluster_index].cluster_id = cluster_id;
 				clusters[cluster_index].package = packages + package_index;
-				clusters[cluster_index].vendor = x86_processor.vendor;
-				clusters[cluster_index].uarch = x86_processor.uarch;
-				clusters[cluster_index].cpuid = x86_processor.cpuid;
+				clusters[cluster_index].vendor = core_type->vendor;
+				clusters[cluster_index].uarch = core_type->uarch;
+				clusters[cluster_index].cpuid = core_type->cpuid;
+				clusters[cluster_index].frequency = frequency;
 				packages[package_index].cluster_count += 1;
-				last_apic_cluster_id = apic_cluster_id;
+				last_cluster_llc_id = llc_id;
+				last_cluster_apic_die_id = apic_die_id;
+				last_uarch_index = uarch_index;
 			} else {
 				/* another logical processor on the same cluster
 				 */
 				clusters[cluster_index].processor_count++;
+				/* Processors of a cluster share the non-Turbo clock, so ignore differences in reported limits */
+				if (frequency != 0 &&
+				    (clusters[cluster_index].frequency == 0 || frequency < clusters[cluster_index].frequency)) {
+					clusters[cluster_index].frequency = frequency;
+				}
 			}
 
 			if (apic_package_id != last_apic_package_id) {
@@ -483,20 +604,24 @@ void cpuinfo_x86_linux_init(void) {
 
 			linux_cpu_to_processor_map[x86_linux_processors[i].linux_id] = processors + processor_index;
 			linux_cpu_to_core_map[x86_linux_processors[i].linux_id] = cores + core_index;
+			if (linux_cpu_to_uarch_index_map != NULL) {
+				linux_cpu_to_uarch_index_map[x86_linux_processors[i].linux_id] = uarch_index;
+			}
+			uarchs[uarch_index].processor_count += 1;
 
-			if (x86_processor.cache.l1i.size != 0) {
-				const uint32_t l1i_id = apic_id & ~bit_mask(x86_processor.cache.l1i.apic_bits);
+			if (cache->l1i.size != 0) {
+				const uint32_t l1i_id = x86_linux_processors[i].cache_id.l1i;
 				processors[i].cache.l1i = &l1i[l1i_index];
 				if (l1i_id != last_l1i_id) {
 					/* new cache */
 					last_l1i_id = l1i_id;
 					l1i[++l1i_index] = (struct cpuinfo_cache){
-						.size = x86_processor.cache.l1i.size,
-						.associativity = x86_processor.cache.l1i.associativity,
-						.sets = x86_processor.cache.l1i.sets,
-						.partitions = x86_processor.cache.l1i.partitions,
-						.line_size = x86_processor.cache.l1i.line_size,
-						.flags = x86_processor.cache.l1i.flags,
+						.size = cache->l1i.size,
+						.associativity = cache->l1i.associativity,
+						.sets = cache->l1i.sets,
+						.partitions = cache->l1i.partitions,
+						.line_size = cache->l1i.line_size,
+						.flags = cache->l1i.flags,
 						.processor_start = processor_index,
 						.processor_count = 1,
 					};
@@ -510,19 +635,19 @@ void cpuinfo_x86_linux_init(void) {
 				/* reset cache id */
 				last_l1i_id = UINT32_MAX;
 			}
-			if (x86_processor.cache.l1d.size != 0) {
-				const uint32_t l1d_id = apic_id & ~bit_mask(x86_processor.cache.l1d.apic_bits);
+			if (cache->l1d.size != 0) {
+				const uint32_t l1d_id = x86_linux_processors[i].cache_id.l1d;
 				processors[i].cache.l1d = &l1d[l1d_index];
 				if (l1d_id != last_l1d_id) {
 					/* new cache */
 					last_l1d_id = l1d_id;
 					l1d[++l1d_index] = (struct cpuinfo_cache){
-						.size = x86_processor.cache.l1d.size,
-						.associativity = x86_processor.cache.l1d.associativity,
-						.sets = x86_processor.cache.l1d.sets,
-						.partitions = x86_processor.cache.l1d.partitions,
-						.line_size = x86_processor.cache.l1d.line_size,
-						.flags = x86_processor.cache.l1d.flags,
+						.size = cache->l1d.size,
+						.associativity = cache->l1d.associativity,
+						.sets = cache->l1d.sets,
+						.partitions = cache->l1d.partitions,
+						.line_size = cache->l1d.line_size,
+						.flags = cache->l1d.flags,
 						.processor_start = processor_index,
 						.processor_count = 1,
 					};
@@ -536,19 +661,19 @@ void cpuinfo_x86_linux_init(void) {
 				/* reset cache id */
 				last_l1d_id = UINT32_MAX;
 			}
-			if (x86_processor.cache.l2.size != 0) {
-				const uint32_t l2_id = apic_id & ~bit_mask(x86_processor.cache.l2.apic_bits);
+			if (cache->l2.size != 0) {
+				const uint32_t l2_id = x86_linux_processors[i].cache_id.l2;
 				processors[i].cache.l2 = &l2[l2_index];
 				if (l2_id != last_l2_id) {
 					/* new cache */
 					last_l2_id = l2_id;
 					l2[++l2_index] = (struct cpuinfo_cache){
-						.size = x86_processor.cache.l2.size,
-						.associativity = x86_processor.cache.l2.associativity,
-						.sets = x86_processor.cache.l2.sets,
-						.partitions = x86_processor.cache.l2.partitions,
-						.line_size = x86_processor.cache.l2.line_size,
-						.flags = x86_processor.cache.l2.flags,
+						.size = cache->l2.size,
+						.associativity = cache->l2.associativity,
+						.sets = cache->l2.sets,
+						.partitions = cache->l2.partitions,
+						.line_size = cache->l2.line_size,
+						.flags = cache->l2.flags,
 						.processor_start = processor_index,
 						.processor_count = 1,
 					};
@@ -562,19 +687,19 @@ void cpuinfo_x86_linux_init(void) {
 				/* reset cache id */
 				last_l2_id = UINT32_MAX;
 			}
-			if (x86_processor.cache.l3.size != 0) {
-				const uint32_t l3_id = apic_id & ~bit_mask(x86_processor.cache.l3.apic_bits);
+			if (cache->l3.size != 0) {
+				const uint32_t l3_id = x86_linux_processors[i].cache_id.l3;
 				processors[i].cache.l3 = &l3[l3_index];
 				if (l3_id != last_l3_id) {
 					/* new cache */
 					last_l3_id = l3_id;
 					l3[++l3_index] = (struct cpuinfo_cache){
-						.size = x86_processor.cache.l3.size,
-						.associativity = x86_processor.cache.l3.associativity,
-						.sets = x86_processor.cache.l3.sets,
-						.partitions = x86_processor.cache.l3.partitions,
-						.line_size = x86_processor.cache.l3.line_size,
-						.flags = x86_processor.cache.l3.flags,
+						.size = cache->l3.size,
+						.associativity = cache->l3.associativity,
+						.sets = cache->l3.sets,
+						.partitions = cache->l3.partitions,
+						.line_size = cache->l3.line_size,
+						.flags = cache->l3.flags,
 						.processor_start = processor_index,
 						.processor_count = 1,
 					};
@@ -588,19 +713,19 @@ void cpuinfo_x86_linux_init(void) {
 				/* reset cache id */
 				last_l3_id = UINT32_MAX;
 			}
-			if (x86_processor.cache.l4.size != 0) {
-				const uint32_t l4_id = apic_id & ~bit_mask(x86_processor.cache.l4.apic_bits);
+			if (cache->l4.size != 0) {
+				const uint32_t l4_id = x86_linux_processors[i].cache_id.l4;
 				processors[i].cache.l4 = &l4[l4_index];
 				if (l4_id != last_l4_id) {
 					/* new cache */
 					last_l4_id = l4_id;
 					l4[++l4_index] = (struct cpuinfo_cache){
-						.size = x86_processor.cache.l4.size,
-						.associativity = x86_processor.cache.l4.associativity,
-						.sets = x86_processor.cache.l4.sets,
-						.partitions = x86_processor.cache.l4.partitions,
-						.line_size = x86_processor.cache.l4.line_size,
-						.flags = x86_processor.cache.l4.flags,
+						.size = cache->l4.size,
+						.associativity = cache->l4.associativity,
+						.sets = cache->l4.sets,
+						.partitions = cache->l4.partitions,
+						.line_size = cache->l4.line_size,
+						.flags = cache->l4.flags,
 						.processor_start = processor_index,
 						.processor_count = 1,
 					};
@@ -617,7 +742,15 @@ void cpuinfo_x86_linux_init(void) {
 		}
 	}
 
+	cpuinfo_linux_detect_processor_flags(x86_linux_processors_count, processors_count, processors);
+
+	cpuinfo_linux_build_numa_nodes(
+		&numa, processors_count, processors, cores_count, cores, numa_nodes, numa_distances);
+
+	cpuinfo_linux_init_getcpu(max_possible_processors_count);
+
 	/* Commit changes */
+	cpuinfo_begin_tables_update();
 	cpuinfo_processors = processors;
 	cpuinfo_cores = cores;
 	cpuinfo_clusters = clusters;
@@ -638,41 +771,30 @@ void cpuinfo_x86_linux_init(void) {
 	cpuinfo_cache_count[cpuinfo_cache_level_3] = l3_count;
 	cpuinfo_cache_count[cpuinfo_cache_level_4] = l4_count;
 	cpuinfo_max_cache_size = cpuinfo_compute_max_cache_size(&processors[0]);
+	cpuinfo_numa_nodes = numa_nodes;
+	cpuinfo_numa_nodes_count = numa.nodes_count;
+	cpuinfo_numa_distances = numa_distances;
 
-	cpuinfo_global_uarch = (struct cpuinfo_uarch_info){
-		.uarch = x86_processor.uarch,
-		.cpuid = x86_processor.cpuid,
-		.processor_count = processors_count,
-		.core_count = cores_count,
-	};
+	cpuinfo_uarchs = uarchs;
+	cpuinfo_uarchs_count = uarchs_count;
+	cpuinfo_tlbs = tlbs;
 
 	cpuinfo_linux_cpu_max = x86_linux_processors_count;
 	cpuinfo_linux_cpu_to_processor_map = linux_cpu_to_processor_map;
 	cpuinfo_linux_cpu_to_core_map = linux_cpu_to_core_map;
+	cpuinfo_linux_cpu_to_uarch_index_map = linux_cpu_to_uarch_index_map;
+	cpuinfo_tables_arena = arena;
 
 	__sync_synchronize();
 
 	cpuinfo_is_initialized = true;
 
-	processors = NULL;
-	cores = NULL;
-	clusters = NULL;
-	packages = NULL;
-	l1i = l1d = l2 = l3 = l4 = NULL;
-	linux_cpu_to_processor_map = NULL;
-	linux_cpu_to_core_map = NULL;
+	cpuinfo_end_tables_update();
+
+	arena = NULL;
 
 cleanup:
+	cpuinfo_linux_free_numa_nodes(&numa);
 	free(x86_linux_processors);
-	free(processors);
-	free(cores);
-	free(clusters);
-	free(packages);
-	free(l1i);
-	free(l1d);
-	free(l2);
-	free(l3);
-	free(l4);
-	free(linux_cpu_to_processor_map);
-	free(linux_cpu_to_core_map);
+	free(arena);
 }
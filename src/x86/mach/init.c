@@ -8,10 +8,6 @@
 #include <mach/api.h>
 #include <x86/api.h>
 
-static inline uint32_t max(uint32_t a, uint32_t b) {
-	return a > b ? a : b;
-}
-
 static inline uint32_t bit_mask(uint32_t bits) {
 	return (UINT32_C(1) << bits) - UINT32_C(1);
 }
@@ -111,9 +107,7 @@ void cpuinfo_x86_mach_init(void) {
 		/* Reconstruct APIC IDs from topology components */
 		const uint32_t thread_bits_mask = bit_mask(x86_processor.topology.thread_bits_length);
 		const uint32_t core_bits_mask = bit_mask(x86_processor.topology.core_bits_length);
-		const uint32_t package_bits_offset =
-			max(x86_processor.topology.thread_bits_offset + x86_processor.topology.thread_bits_length,
-			    x86_processor.topology.core_bits_offset + x86_processor.topology.core_bits_length);
+		const uint32_t package_bits_offset = x86_processor.topology.package_bits_offset;
 		const uint32_t apic_id = ((smt_id & thread_bits_mask) << x86_processor.topology.thread_bits_offset) |
 			((core_id & core_bits_mask) << x86_processor.topology.core_bits_offset) |
 			(package_id << package_bits_offset);
@@ -356,6 +350,7 @@ void cpuinfo_x86_mach_init(void) {
 		.processor_count = mach_topology.threads,
 		.core_count = mach_topology.cores,
 	};
+	cpuinfo_x86_describe_tlbs(&x86_processor.tlb, &cpuinfo_global_tlbs);
 
 	__sync_synchronize();
 
@@ -11,8 +11,105 @@ enum topology_type {
 	topology_type_invalid = 0,
 	topology_type_smt = 1,
 	topology_type_core = 2,
+	topology_type_module = 3,
+	topology_type_tile = 4,
+	topology_type_die = 5,
+	topology_type_die_group = 6,
 };
 
+static inline uint32_t max(uint32_t a, uint32_t b) {
+	return a > b ? a : b;
+}
+
+static const char* topology_type_name(uint32_t type) {
+	switch (type) {
+		case topology_type_smt:
+			return "SMT";
+		case topology_type_core:
+			return "core";
+		case topology_type_module:
+			return "module";
+		case topology_type_tile:
+			return "tile";
+		case topology_type_die:
+			return "die";
+		case topology_type_die_group:
+			return "die group";
+		default:
+			return "unknown";
+	}
+}
+
+void cpuinfo_x86_decode_extended_topology(
+	uint32_t levels_count,
+	const struct cpuid_regs* levels,
+	struct cpuinfo_x86_topology* topology) {
+	topology->thread_bits_offset = topology->thread_bits_length = 0;
+	topology->core_bits_offset = topology->core_bits_length = 0;
+	topology->module_bits_offset = topology->module_bits_length = 0;
+	topology->tile_bits_offset = topology->tile_bits_length = 0;
+	topology->die_bits_offset = topology->die_bits_length = 0;
+
+	/*
+	 * Each level reports the right shift of x2APIC ID which yields the ID
+	 * of the next level, so bits of a level start at the shift of the
+	 * previous level.
+	 */
+	uint32_t total_shift = 0;
+	for (uint32_t level = 0; level < levels_count; level++) {
+		const uint32_t type = (levels[level].ecx >> 8) & UINT32_C(0x000000FF);
+		if (type == topology_type_invalid) {
+			break;
+		}
+		const uint32_t level_shift = levels[level].eax & UINT32_C(0x0000001F);
+		const uint32_t bits_offset = total_shift;
+		const uint32_t bits_length = level_shift > total_shift ? level_shift - total_shift : 0;
+		topology->apic_id = levels[level].edx;
+		cpuinfo_log_debug(
+			"x2 level %" PRIu32 ": APIC ID = %08" PRIx32 ", type %s, length %" PRIu32 ", total shift %" PRIu32,
+			level,
+			topology->apic_id,
+			topology_type_name(type),
+			bits_length,
+			total_shift);
+		switch (type) {
+			case topology_type_smt:
+				topology->thread_bits_offset = bits_offset;
+				topology->thread_bits_length = bits_length;
+				break;
+			case topology_type_core:
+				topology->core_bits_offset = bits_offset;
+				topology->core_bits_length = bits_length;
+				break;
+			case topology_type_module:
+				topology->module_bits_offset = bits_offset;
+				topology->module_bits_length = bits_length;
+				break;
+			case topology_type_tile:
+				topology->tile_bits_offset = bits_offset;
+				topology->tile_bits_length = bits_length;
+				break;
+			case topology_type_die:
+				topology->die_bits_offset = bits_offset;
+				topology->die_bits_length = bits_length;
+				break;
+			case topology_type_die_group:
+				/* Die groups only extend the bits within a package */
+				break;
+			default:
+				cpuinfo_log_warning(
+					"unexpected topology type %" PRIu32 " (offset %" PRIu32 ", length %" PRIu32
+					") reported in extended topology leaf is ignored",
+					type,
+					bits_offset,
+					bits_length);
+				break;
+		}
+		total_shift = max(total_shift, level_shift);
+	}
+	topology->package_bits_offset = total_shift;
+}
+
 void cpuinfo_x86_detect_topology(
 	uint32_t max_base_index,
 	uint32_t max_extended_index,
@@ -95,69 +192,181 @@ void cpuinfo_x86_detect_topology(
 	 * - Intel: ecx[bit 21] in basic info (reserved bit on AMD CPUs).
 	 */
 	const bool x2apic = !!(leaf1.ecx & UINT32_C(0x00200000));
+	topology->apic_id = apic_id;
 	if (x2apic && (max_base_index >= UINT32_C(0xB))) {
-		uint32_t level = 0;
-		uint32_t type;
-		uint32_t total_shift = 0;
-		topology->thread_bits_offset = topology->thread_bits_length = 0;
-		topology->core_bits_offset = topology->core_bits_length = 0;
-		do {
-			const struct cpuid_regs leafB = cpuidex(UINT32_C(0xB), level);
-			type = (leafB.ecx >> 8) & UINT32_C(0x000000FF);
-			const uint32_t level_shift = leafB.eax & UINT32_C(0x0000001F);
-			const uint32_t x2apic_id = leafB.edx;
-			apic_id = x2apic_id;
-			switch (type) {
-				case topology_type_invalid:
-					break;
-				case topology_type_smt:
-					cpuinfo_log_debug(
-						"x2 level %" PRIu32 ": APIC ID = %08" PRIx32
-						", "
-						"type SMT, shift %" PRIu32 ", total shift %" PRIu32,
-						level,
-						apic_id,
-						level_shift,
-						total_shift);
-					topology->thread_bits_offset = total_shift;
-					topology->thread_bits_length = level_shift;
-					break;
-				case topology_type_core:
-					cpuinfo_log_debug(
-						"x2 level %" PRIu32 ": APIC ID = %08" PRIx32
-						", "
-						"type core, shift %" PRIu32 ", total shift %" PRIu32,
-						level,
-						apic_id,
-						level_shift,
-						total_shift);
-					topology->core_bits_offset = total_shift;
-					topology->core_bits_length = level_shift;
-					break;
-				default:
-					cpuinfo_log_warning(
-						"unexpected topology type %" PRIu32 " (offset %" PRIu32
-						", length %" PRIu32
-						") "
-						"reported in leaf 0x0000000B is ignored",
-						type,
-						total_shift,
-						level_shift);
-					break;
+		/*
+		 * V2 Extended Topology Enumeration leaf 0x1F reports module,
+		 * tile and die levels in addition to the SMT and core levels of
+		 * leaf 0xB. It is supported if EBX of its sub-leaf 0 is non-zero.
+		 */
+		uint32_t leaf = UINT32_C(0xB);
+		if (max_base_index >= UINT32_C(0x1F) && cpuidex(UINT32_C(0x1F), 0).ebx != 0) {
+			leaf = UINT32_C(0x1F);
+		}
+		struct cpuid_regs levels[CPUINFO_X86_MAX_TOPOLOGY_LEVELS];
+		uint32_t levels_count = 0;
+		while (levels_count < CPUINFO_X86_MAX_TOPOLOGY_LEVELS) {
+			const struct cpuid_regs level = cpuidex(leaf, levels_count);
+			levels[levels_count++] = level;
+			if (((level.ecx >> 8) & UINT32_C(0x000000FF)) == topology_type_invalid) {
+				break;
 			}
-			total_shift += level_shift;
-			level += 1;
-		} while (type != 0);
+		}
+		cpuinfo_log_debug("leaf 0x%08" PRIx32 " reports %" PRIu32 " topology levels", leaf, levels_count);
+		cpuinfo_x86_decode_extended_topology(levels_count, levels, topology);
 		cpuinfo_log_debug(
 			"x2APIC ID 0x%08" PRIx32
 			", "
-			"SMT offset %" PRIu32 " length %" PRIu32 ", core offset %" PRIu32 " length %" PRIu32,
-			apic_id,
+			"SMT offset %" PRIu32 " length %" PRIu32 ", core offset %" PRIu32 " length %" PRIu32
+			", package offset %" PRIu32,
+			topology->apic_id,
 			topology->thread_bits_offset,
 			topology->thread_bits_length,
 			topology->core_bits_offset,
-			topology->core_bits_length);
+			topology->core_bits_length,
+			topology->package_bits_offset);
+	} else {
+		topology->package_bits_offset =
+			max(topology->thread_bits_offset + topology->thread_bits_length,
+			    topology->core_bits_offset + topology->core_bits_length);
 	}
+}
 
-	topology->apic_id = apic_id;
+enum amd_topology_type {
+	amd_topology_type_invalid = 0,
+	amd_topology_type_core = 1,
+	amd_topology_type_complex = 2,
+	amd_topology_type_die = 3,
+	amd_topology_type_socket = 4,
+};
+
+void cpuinfo_x86_decode_amd_topology(
+	const struct cpuid_regs* leaf0x8000001E,
+	uint32_t levels_count,
+	const struct cpuid_regs* levels,
+	enum cpuinfo_uarch uarch,
+	const struct cpuinfo_x86_caches* cache,
+	struct cpuinfo_x86_topology* topology) {
+	if (leaf0x8000001E != NULL) {
+		/*
+		 * ExtendedApicId: full APIC ID of the logical processor.
+		 * - AMD: eax in leaf 0x8000001E.
+		 */
+		topology->apic_id = leaf0x8000001E->eax;
+		/*
+		 * ThreadsPerComputeUnit: number of threads per core - 1, or
+		 * number of cores per compute unit - 1 before Zen.
+		 * - AMD: ebx[bits 8-15] in leaf 0x8000001E.
+		 */
+		const uint32_t threads_per_unit = 1 + ((leaf0x8000001E->ebx >> 8) & UINT32_C(0x000000FF));
+		const uint32_t unit_bits = bit_length(threads_per_unit);
+		const bool bulldozer = uarch >= cpuinfo_uarch_bulldozer && uarch <= cpuinfo_uarch_excavator;
+		const bool zen1 = uarch == cpuinfo_uarch_zen || uarch == cpuinfo_uarch_dhyana;
+		const bool zen = zen1 || (uarch >= cpuinfo_uarch_zen2 && uarch <= cpuinfo_uarch_zen4);
+		if (zen && topology->thread_bits_length == 0 && topology->core_bits_offset == 0 &&
+		    topology->package_bits_offset >= unit_bits) {
+			/* Leaf 0x80000008 counts threads, so without leaf 0xB the thread bits are a part of core bits */
+			topology->thread_bits_length = unit_bits;
+			topology->core_bits_offset = unit_bits;
+			topology->core_bits_length = topology->package_bits_offset - unit_bits;
+		} else if (bulldozer && unit_bits != 0 && topology->package_bits_offset >= unit_bits) {
+			/* Cores of a Bulldozer-family compute unit share an L2 cache */
+			topology->module_bits_offset = unit_bits;
+			topology->module_bits_length = topology->package_bits_offset - unit_bits;
+		}
+		/*
+		 * NodesPerProcessor: number of nodes in the package - 1.
+		 * - AMD: ecx[bits 8-10] in leaf 0x8000001E.
+		 * Up to Zen nodes are dies, identified by the highest bits of
+		 * APIC ID within the package.
+		 */
+		const uint32_t nodes_per_processor = 1 + ((leaf0x8000001E->ecx >> 8) & UINT32_C(0x00000007));
+		const uint32_t node_bits = bit_length(nodes_per_processor);
+		if ((bulldozer || zen1) && topology->die_bits_length == 0 && node_bits != 0 &&
+		    topology->package_bits_offset >= node_bits) {
+			topology->die_bits_offset = topology->package_bits_offset - node_bits;
+			topology->die_bits_length = node_bits;
+		}
+		cpuinfo_log_debug(
+			"AMD extended APIC ID 0x%08" PRIx32 ", %" PRIu32 " threads per unit, %" PRIu32 " nodes",
+			topology->apic_id,
+			threads_per_unit,
+			nodes_per_processor);
+	}
+
+	if (levels_count != 0) {
+		/*
+		 * Extended CPU Topology: core, complex (CCX), die (CCD) and
+		 * socket levels. Unlike in leaf 0xB, the shift of a level
+		 * yields the ID of that level rather than of the level above,
+		 * so CCD bits start at the die shift and end at the socket shift.
+		 */
+		uint32_t complex_shift = 0, die_shift = 0, socket_shift = 0;
+		for (uint32_t level = 0; level < levels_count; level++) {
+			const uint32_t type = (levels[level].ecx >> 8) & UINT32_C(0x000000FF);
+			const uint32_t shift = levels[level].eax & UINT32_C(0x0000001F);
+			if (type == amd_topology_type_invalid) {
+				break;
+			} else if (type == amd_topology_type_complex) {
+				complex_shift = shift;
+			} else if (type == amd_topology_type_die) {
+				die_shift = shift;
+			} else if (type == amd_topology_type_socket) {
+				socket_shift = shift;
+			}
+		}
+		if (complex_shift != 0 && die_shift >= complex_shift && socket_shift >= die_shift) {
+			topology->die_bits_offset = die_shift;
+			topology->die_bits_length = socket_shift - die_shift;
+			topology->package_bits_offset = socket_shift;
+			cpuinfo_log_debug(
+				"leaf 0x80000026: CCX shift %" PRIu32 ", CCD shift %" PRIu32 ", socket shift %" PRIu32,
+				complex_shift,
+				die_shift,
+				socket_shift);
+			return;
+		}
+	}
+
+	/* Zen and Zen 2 dies (CCDs) hold two core complexes (CCXs) with their own L3 caches */
+	const bool two_ccx_dies =
+		uarch == cpuinfo_uarch_zen || uarch == cpuinfo_uarch_dhyana || uarch == cpuinfo_uarch_zen2;
+	if (topology->die_bits_length == 0 && two_ccx_dies && cache->l3.size != 0) {
+		const uint32_t ccd_bits_offset = cache->l3.apic_bits + 1;
+		if (topology->package_bits_offset > ccd_bits_offset) {
+			topology->die_bits_offset = ccd_bits_offset;
+			topology->die_bits_length = topology->package_bits_offset - ccd_bits_offset;
+		}
+	}
+}
+
+void cpuinfo_x86_detect_amd_topology(
+	uint32_t max_extended_index,
+	enum cpuinfo_uarch uarch,
+	const struct cpuinfo_x86_caches* cache,
+	struct cpuinfo_x86_topology* topology) {
+	struct cpuid_regs leaf0x8000001E;
+	if (max_extended_index >= UINT32_C(0x8000001E)) {
+		leaf0x8000001E = cpuid(UINT32_C(0x8000001E));
+	}
+
+	struct cpuid_regs levels[CPUINFO_X86_MAX_TOPOLOGY_LEVELS];
+	uint32_t levels_count = 0;
+	if (max_extended_index >= UINT32_C(0x80000026)) {
+		while (levels_count < CPUINFO_X86_MAX_TOPOLOGY_LEVELS) {
+			const struct cpuid_regs level = cpuidex(UINT32_C(0x80000026), levels_count);
+			levels[levels_count++] = level;
+			if (((level.ecx >> 8) & UINT32_C(0x000000FF)) == amd_topology_type_invalid) {
+				break;
+			}
+		}
+	}
+
+	cpuinfo_x86_decode_amd_topology(
+		max_extended_index >= UINT32_C(0x8000001E) ? &leaf0x8000001E : NULL,
+		levels_count,
+		levels,
+		uarch,
+		cache,
+		topology);
 }
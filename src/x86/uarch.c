@@ -167,6 +167,19 @@ enum cpuinfo_uarch cpuinfo_x86_decode_uarch(
 						case 0x7D: // Ice Lake-Y
 						case 0x7E: // Ice Lake-U
 							return cpuinfo_uarch_sunny_cove;
+						case 0x8F: // Sapphire Rapids
+						case 0x97: // Alder Lake-S
+						case 0x9A: // Alder Lake-P
+							return cpuinfo_uarch_golden_cove;
+						case 0xB7: // Raptor Lake-S
+						case 0xBA: // Raptor Lake-P
+						case 0xBF: // Raptor Lake-S
+						case 0xCF: // Emerald Rapids
+							return cpuinfo_uarch_raptor_cove;
+						case 0xAA: // Meteor Lake-H/U
+						case 0xAC: // Meteor Lake-S
+						case 0xAD: // Granite Rapids
+							return cpuinfo_uarch_redwood_cove;
 
 						/* Low-power cores */
 						case 0x1C: // Diamondville,
@@ -195,6 +208,10 @@ enum cpuinfo_uarch cpuinfo_x86_decode_uarch(
 							return cpuinfo_uarch_goldmont;
 						case 0x7A: // Gemini Lake
 							return cpuinfo_uarch_goldmont_plus;
+						case 0xBE: // Alder Lake-N
+							return cpuinfo_uarch_gracemont;
+						case 0xAF: // Sierra Forest
+							return cpuinfo_uarch_crestmont;
 
 						/* Knights-series cores */
 						case 0x57:
@@ -400,3 +417,19 @@ enum cpuinfo_uarch cpuinfo_x86_decode_uarch(
 	}
 	return cpuinfo_uarch_unknown;
 }
+
+enum cpuinfo_uarch cpuinfo_x86_decode_hybrid_uarch(enum cpuinfo_uarch uarch, uint32_t core_type) {
+	/* On hybrid processors CPUID leaf 1 reports the same model on all cores */
+	if (core_type == CPUINFO_X86_CORE_TYPE_ATOM) {
+		switch (uarch) {
+			case cpuinfo_uarch_golden_cove:
+			case cpuinfo_uarch_raptor_cove:
+				return cpuinfo_uarch_gracemont;
+			case cpuinfo_uarch_redwood_cove:
+				return cpuinfo_uarch_crestmont;
+			default:
+				break;
+		}
+	}
+	return uarch;
+}
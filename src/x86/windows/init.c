@@ -125,9 +125,7 @@ BOOL CALLBACK cpuinfo_x86_windows_init(PINIT_ONCE init_once, PVOID parameter, PV
 
 	const uint32_t thread_bits_mask = bit_mask(x86_processor.topology.thread_bits_length);
 	const uint32_t core_bits_mask = bit_mask(x86_processor.topology.core_bits_length);
-	const uint32_t package_bits_offset =
-		max(x86_processor.topology.thread_bits_offset + x86_processor.topology.thread_bits_length,
-		    x86_processor.topology.core_bits_offset + x86_processor.topology.core_bits_length);
+	const uint32_t package_bits_offset = x86_processor.topology.package_bits_offset;
 
 	/* WINE doesn't implement GetMaximumProcessorGroupCount and aborts when
 	 * calling it */
@@ -628,6 +626,7 @@ BOOL CALLBACK cpuinfo_x86_windows_init(PINIT_ONCE init_once, PVOID parameter, PV
 		.processor_count = processors_count,
 		.core_count = cores_count,
 	};
+	cpuinfo_x86_describe_tlbs(&x86_processor.tlb, &cpuinfo_global_tlbs);
 
 	MemoryBarrier();
 
@@ -669,3 +668,17 @@ cleanup:
 	}
 	return TRUE;
 }
+
+void cpuinfo_x86_windows_deinit(void) {
+	HANDLE heap = GetProcessHeap();
+	HeapFree(heap, 0, cpuinfo_processors);
+	HeapFree(heap, 0, cpuinfo_cores);
+	HeapFree(heap, 0, cpuinfo_clusters);
+	HeapFree(heap, 0, cpuinfo_packages);
+	for (uint32_t i = 0; i < cpuinfo_cache_level_max; i++) {
+		if (cpuinfo_cache[i] != NULL) {
+			HeapFree(heap, 0, cpuinfo_cache[i]);
+		}
+	}
+	cpuinfo_clear_tables();
+}
@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <cpuinfo.h>
+
+static void check_tables(uint32_t expected_processors_count) {
+	ASSERT_EQ(expected_processors_count, cpuinfo_get_processors_count());
+	for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+		const cpuinfo_processor* processor = cpuinfo_get_processor(i);
+		ASSERT_TRUE(processor);
+		ASSERT_TRUE(processor->core);
+		ASSERT_TRUE(processor->package);
+		EXPECT_LT(processor->core->processor_start, cpuinfo_get_processors_count());
+		if (processor->cache.l1d != nullptr) {
+			EXPECT_NE(0, processor->cache.l1d->size);
+		}
+	}
+	for (uint32_t i = 0; i < cpuinfo_get_packages_count(); i++) {
+		const cpuinfo_package* package = cpuinfo_get_package(i);
+		ASSERT_TRUE(package);
+		EXPECT_NE(0, package->processor_count);
+	}
+}
+
+TEST(DEINITIALIZE, reinitialize) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+	cpuinfo_deinitialize();
+
+	for (uint32_t iteration = 0; iteration < 100; iteration++) {
+		ASSERT_TRUE(cpuinfo_initialize());
+		check_tables(processors_count);
+		cpuinfo_deinitialize();
+	}
+}
+
+TEST(DEINITIALIZE, nested) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	ASSERT_TRUE(cpuinfo_initialize());
+	const cpuinfo_processor* processors = cpuinfo_get_processors();
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+	cpuinfo_deinitialize();
+
+	/* The outer reference keeps the tables alive */
+	EXPECT_EQ(processors, cpuinfo_get_processors());
+	check_tables(processors_count);
+	cpuinfo_deinitialize();
+}
+
+TEST(DEINITIALIZE, unbalanced) {
+	cpuinfo_deinitialize();
+	ASSERT_TRUE(cpuinfo_initialize());
+	EXPECT_NE(0, cpuinfo_get_processors_count());
+	cpuinfo_deinitialize();
+	cpuinfo_deinitialize();
+}
+
+TEST(DEINITIALIZE, concurrent) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+	cpuinfo_deinitialize();
+
+	std::vector<std::thread> threads;
+	for (uint32_t t = 0; t < 4; t++) {
+		threads.emplace_back([processors_count]() {
+			for (uint32_t iteration = 0; iteration < 50; iteration++) {
+				ASSERT_TRUE(cpuinfo_initialize());
+				check_tables(processors_count);
+				cpuinfo_deinitialize();
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+#if defined(__linux__)
+TEST(REFRESH, generation) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const uint32_t generation = cpuinfo_get_generation();
+	EXPECT_NE(0, generation);
+	ASSERT_TRUE(cpuinfo_refresh());
+	EXPECT_EQ(generation + 1, cpuinfo_get_generation());
+	cpuinfo_deinitialize();
+
+	ASSERT_TRUE(cpuinfo_initialize());
+	EXPECT_GT(cpuinfo_get_generation(), generation + 1);
+	cpuinfo_deinitialize();
+}
+
+TEST(REFRESH, old_tables_stay_valid) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+	const cpuinfo_processor* processor = cpuinfo_get_processor(0);
+	ASSERT_TRUE(processor);
+	const uint32_t core_id = processor->core->core_id;
+	/* Replaced tables are kept until deinitialization, however many refreshes follow */
+	for (uint32_t iteration = 0; iteration < 20; iteration++) {
+		ASSERT_TRUE(cpuinfo_refresh());
+		/* Read through the pointer obtained before the refreshes */
+		EXPECT_EQ(core_id, processor->core->core_id);
+	}
+	check_tables(processors_count);
+	cpuinfo_deinitialize();
+}
+
+TEST(REFRESH, concurrent_readers) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+
+	std::vector<std::thread> threads;
+	for (uint32_t t = 0; t < 4; t++) {
+		threads.emplace_back([processors_count]() {
+			for (uint32_t iteration = 0; iteration < 1000; iteration++) {
+				const cpuinfo_processor* processor = cpuinfo_get_processor(iteration % processors_count);
+				ASSERT_TRUE(processor);
+				ASSERT_TRUE(processor->core);
+				const cpuinfo_processor* current_processor = cpuinfo_get_current_processor();
+				if (current_processor != nullptr) {
+					ASSERT_TRUE(current_processor->package);
+				}
+			}
+		});
+	}
+	for (uint32_t iteration = 0; iteration < 20; iteration++) {
+		ASSERT_TRUE(cpuinfo_refresh());
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	cpuinfo_deinitialize();
+}
+
+static void check_topology(const cpuinfo_topology& topology) {
+	ASSERT_NE(0, topology.processors_count);
+	for (uint32_t i = 0; i < topology.processors_count; i++) {
+		const cpuinfo_core* core = topology.processors[i].core;
+		ASSERT_GE(core, topology.cores);
+		ASSERT_LT(core, topology.cores + topology.cores_count);
+		ASSERT_LT(core->processor_start, topology.processors_count);
+	}
+}
+
+TEST(REFRESH, consistent_topology) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const uint32_t generation = cpuinfo_get_generation();
+
+	/* Readers run until all refreshes complete, and keep using the first tables they read all along */
+	std::atomic<bool> refreshed(false);
+	std::vector<std::thread> threads;
+	for (uint32_t t = 0; t < 4; t++) {
+		threads.emplace_back([&refreshed]() {
+			cpuinfo_topology first_topology;
+			cpuinfo_get_topology(&first_topology);
+			do {
+				cpuinfo_topology topology;
+				cpuinfo_get_topology(&topology);
+				check_topology(topology);
+				check_topology(first_topology);
+			} while (!refreshed.load(std::memory_order_acquire));
+		});
+	}
+	uint32_t refreshes_count = 0;
+	for (uint32_t iteration = 0; iteration < 20; iteration++) {
+		refreshes_count += cpuinfo_refresh();
+	}
+	refreshed.store(true, std::memory_order_release);
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(20, refreshes_count);
+	EXPECT_EQ(generation + 20, cpuinfo_get_generation());
+
+	cpuinfo_topology topology;
+	cpuinfo_get_topology(&topology);
+	EXPECT_EQ(cpuinfo_get_generation(), topology.generation);
+	EXPECT_EQ(cpuinfo_get_processors(), topology.processors);
+	EXPECT_EQ(cpuinfo_get_processors_count(), topology.processors_count);
+	cpuinfo_deinitialize();
+}
+
+TEST(REFRESH, allowed_topology) {
+	ASSERT_TRUE(cpuinfo_initialize());
+
+	std::atomic<bool> refreshed(false);
+	std::vector<std::thread> threads;
+	for (uint32_t t = 0; t < 4; t++) {
+		threads.emplace_back([&refreshed]() {
+			do {
+				cpuinfo_allowed_topology topology;
+				ASSERT_TRUE(cpuinfo_get_allowed_topology(&topology));
+				EXPECT_NE(0, topology.processors_count);
+				EXPECT_NE(0, topology.cores_count);
+				cpuinfo_allowed_topology_free(&topology);
+				EXPECT_NE(0, cpuinfo_select_processors(0, 0, nullptr));
+			} while (!refreshed.load(std::memory_order_acquire));
+		});
+	}
+	uint32_t refreshes_count = 0;
+	for (uint32_t iteration = 0; iteration < 20; iteration++) {
+		refreshes_count += cpuinfo_refresh();
+	}
+	refreshed.store(true, std::memory_order_release);
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(20, refreshes_count);
+	cpuinfo_deinitialize();
+}
+
+TEST(HOTPLUG, monitor) {
+	cpuinfo_hotplug_monitor* monitor = cpuinfo_hotplug_monitor_create();
+	if (monitor == nullptr) {
+		/* Sandboxes may block netlink sockets */
+		GTEST_SKIP();
+	}
+	EXPECT_GE(cpuinfo_hotplug_monitor_get_fd(monitor), 0);
+	ASSERT_TRUE(cpuinfo_initialize());
+	const cpuinfo_affinity_mask* online = cpuinfo_hotplug_monitor_get_online(monitor);
+	EXPECT_TRUE(cpuinfo_affinity_mask_has_processor_id(online, (uint32_t)cpuinfo_get_processor(0)->linux_id));
+	cpuinfo_hotplug_monitor_dispatch(monitor);
+	EXPECT_NE(0, cpuinfo_affinity_mask_count(cpuinfo_hotplug_monitor_get_online(monitor)));
+	cpuinfo_deinitialize();
+	cpuinfo_hotplug_monitor_destroy(monitor);
+}
+
+TEST(RESTRICTED_INIT, allowed_processors) {
+	ASSERT_TRUE(cpuinfo_initialize_restricted());
+	EXPECT_NE(0, cpuinfo_get_processors_count());
+	check_tables(cpuinfo_get_processors_count());
+	EXPECT_TRUE(cpuinfo_get_current_processor());
+	EXPECT_TRUE(cpuinfo_get_current_core());
+
+	cpuinfo_affinity_mask affinity = {};
+	ASSERT_TRUE(cpuinfo_get_thread_affinity(0, &affinity));
+	uint32_t detected_count = 0;
+	for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+		detected_count +=
+			cpuinfo_affinity_mask_has_processor_id(&affinity, (uint32_t)cpuinfo_get_processor(i)->linux_id);
+	}
+	EXPECT_EQ(cpuinfo_affinity_mask_count(&affinity), detected_count);
+	cpuinfo_affinity_mask_free(&affinity);
+	cpuinfo_deinitialize();
+}
+
+TEST(RESTRICTED_INIT, completed_by_initialize) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+	cpuinfo_deinitialize();
+
+	ASSERT_TRUE(cpuinfo_initialize_restricted());
+	EXPECT_LE(cpuinfo_get_processors_count(), processors_count);
+	ASSERT_TRUE(cpuinfo_initialize());
+	check_tables(processors_count);
+	cpuinfo_deinitialize();
+	check_tables(processors_count);
+	cpuinfo_deinitialize();
+}
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+TEST(RESTRICTED_INIT, pinned_to_core) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const cpuinfo_core* core = cpuinfo_get_current_core();
+	ASSERT_TRUE(core);
+	const uint32_t core_processors_count = core->processor_count;
+	cpuinfo_affinity_mask mask = {};
+	ASSERT_TRUE(cpuinfo_affinity_mask_add_processor(&mask, cpuinfo_get_processor(core->processor_start)));
+	cpuinfo_affinity_mask previous = {};
+	ASSERT_TRUE(cpuinfo_set_thread_affinity(0, &mask, &previous));
+	cpuinfo_deinitialize();
+
+	/* SMT siblings complete the core of the only allowed processor */
+	ASSERT_TRUE(cpuinfo_initialize_restricted());
+	EXPECT_EQ(core_processors_count, cpuinfo_get_processors_count());
+	EXPECT_EQ(1, cpuinfo_get_cores_count());
+	EXPECT_TRUE(cpuinfo_get_current_processor());
+	EXPECT_FALSE(cpuinfo_save_snapshot("cpuinfo-restricted-snapshot.bin"));
+	cpuinfo_deinitialize();
+
+	ASSERT_TRUE(cpuinfo_set_thread_affinity(0, &previous, nullptr));
+	cpuinfo_affinity_mask_free(&mask);
+	cpuinfo_affinity_mask_free(&previous);
+}
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64 || CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+TEST(ARENA, cache_line_aligned_tables) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	EXPECT_EQ(0, reinterpret_cast<uintptr_t>(cpuinfo_get_processors()) % 128);
+	EXPECT_EQ(0, reinterpret_cast<uintptr_t>(cpuinfo_get_cores()) % 128);
+	EXPECT_EQ(0, reinterpret_cast<uintptr_t>(cpuinfo_get_clusters()) % 128);
+	EXPECT_EQ(0, reinterpret_cast<uintptr_t>(cpuinfo_get_packages()) % 128);
+	cpuinfo_deinitialize();
+}
+#endif
+#endif
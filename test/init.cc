@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <set>
+#include <vector>
+
 #include <cpuinfo.h>
 
 TEST(PROCESSORS_COUNT, non_zero) {
@@ -743,6 +747,110 @@ TEST(UARCH, valid_cores) {
 	cpuinfo_deinitialize();
 }
 
+TEST(UARCH, consistent_tlbs) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const uint64_t page_sizes[] = {
+		CPUINFO_PAGE_SIZE_4KB,
+		CPUINFO_PAGE_SIZE_64KB,
+		CPUINFO_PAGE_SIZE_1MB,
+		CPUINFO_PAGE_SIZE_2MB,
+		CPUINFO_PAGE_SIZE_4MB,
+		CPUINFO_PAGE_SIZE_16MB,
+		CPUINFO_PAGE_SIZE_512MB,
+		CPUINFO_PAGE_SIZE_1GB,
+	};
+	for (uint32_t i = 0; i < cpuinfo_get_uarchs_count(); i++) {
+		for (uint64_t page_size : page_sizes) {
+			const cpuinfo_tlb* tlbs[] = {
+				cpuinfo_get_itlb(i, page_size),
+				cpuinfo_get_dtlb(i, page_size),
+				cpuinfo_get_stlb(i, page_size),
+			};
+			for (const cpuinfo_tlb* tlb : tlbs) {
+				if (tlb != nullptr) {
+					EXPECT_NE(0, tlb->entries);
+					EXPECT_NE(0, tlb->associativity);
+					EXPECT_LE(tlb->associativity, tlb->entries);
+					EXPECT_EQ(page_size, tlb->pages & page_size);
+				}
+			}
+		}
+	}
+	EXPECT_FALSE(cpuinfo_get_dtlb(cpuinfo_get_uarchs_count(), CPUINFO_PAGE_SIZE_4KB));
+	cpuinfo_deinitialize();
+}
+
+TEST(UARCH, consistent_page_advice) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	cpuinfo_memory_pages pages;
+	cpuinfo_get_memory_pages(&pages);
+	EXPECT_NE(0, pages.base_page_size);
+	EXPECT_LE(pages.huge_pages_count, CPUINFO_HUGE_PAGE_SIZES_MAX);
+	for (uint32_t i = 0; i < cpuinfo_get_uarchs_count(); i++) {
+		for (uint64_t working_set_size = 4096; working_set_size != 0; working_set_size <<= 4) {
+			cpuinfo_page_advice sequential, random;
+			ASSERT_TRUE(cpuinfo_advise_page_size(working_set_size, cpuinfo_access_pattern_sequential, i, &sequential));
+			ASSERT_TRUE(cpuinfo_advise_page_size(working_set_size, cpuinfo_access_pattern_random, i, &random));
+			EXPECT_EQ(pages.base_page_size, sequential.page_size);
+			EXPECT_LE(pages.base_page_size, random.page_size);
+			EXPECT_LE(random.tlb_coverage, 100);
+		}
+	}
+	cpuinfo_page_advice advice;
+	EXPECT_FALSE(cpuinfo_advise_page_size(
+		4096, cpuinfo_access_pattern_random, cpuinfo_get_uarchs_count(), &advice));
+	cpuinfo_deinitialize();
+}
+
+TEST(NUMA_NODES_COUNT, within_bounds) {
+	ASSERT_TRUE(cpuinfo_initialize());
+#if defined(__linux__)
+	EXPECT_NE(0, cpuinfo_get_numa_nodes_count());
+#endif
+	cpuinfo_deinitialize();
+}
+
+TEST(NUMA_NODE, valid_processors) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	for (uint32_t i = 0; i < cpuinfo_get_numa_nodes_count(); i++) {
+		const cpuinfo_numa_node* node = cpuinfo_get_numa_node(i);
+		ASSERT_TRUE(node);
+
+		EXPECT_LE(node->processor_start + node->processor_count, cpuinfo_get_processors_count());
+	}
+	cpuinfo_deinitialize();
+}
+
+TEST(NUMA_NODE, consistent_processors) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	for (uint32_t i = 0; i < cpuinfo_get_numa_nodes_count(); i++) {
+		const cpuinfo_numa_node* node = cpuinfo_get_numa_node(i);
+		ASSERT_TRUE(node);
+
+		for (uint32_t j = 0; j < node->processor_count; j++) {
+			const cpuinfo_processor* processor = cpuinfo_get_processor(node->processor_start + j);
+			ASSERT_TRUE(processor);
+
+			EXPECT_EQ(node, processor->numa_node);
+		}
+	}
+	cpuinfo_deinitialize();
+}
+
+TEST(NUMA_NODE, local_distance) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	for (uint32_t i = 0; i < cpuinfo_get_numa_nodes_count(); i++) {
+		EXPECT_EQ(10, cpuinfo_get_numa_distance(i, i));
+		for (uint32_t j = 0; j < cpuinfo_get_numa_nodes_count(); j++) {
+			if (i != j) {
+				EXPECT_GT(cpuinfo_get_numa_distance(i, j), 10);
+			}
+		}
+	}
+	EXPECT_EQ(0, cpuinfo_get_numa_distance(cpuinfo_get_numa_nodes_count(), 0));
+	cpuinfo_deinitialize();
+}
+
 TEST(L1I_CACHES_COUNT, within_bounds) {
 	ASSERT_TRUE(cpuinfo_initialize());
 	EXPECT_NE(0, cpuinfo_get_l1i_caches_count());
@@ -847,7 +955,8 @@ TEST(L1I_CACHE, reasonable_line_size) {
 TEST(L1I_CACHE, valid_flags) {
 	ASSERT_TRUE(cpuinfo_initialize());
 
-	const uint32_t valid_flags = CPUINFO_CACHE_UNIFIED | CPUINFO_CACHE_INCLUSIVE | CPUINFO_CACHE_COMPLEX_INDEXING;
+	const uint32_t valid_flags = CPUINFO_CACHE_UNIFIED | CPUINFO_CACHE_INCLUSIVE | CPUINFO_CACHE_COMPLEX_INDEXING |
+		CPUINFO_CACHE_REPORTED_BY_OS;
 	for (uint32_t i = 0; i < cpuinfo_get_l1i_caches_count(); i++) {
 		const cpuinfo_cache* cache = cpuinfo_get_l1i_cache(i);
 		ASSERT_TRUE(cache);
@@ -1011,7 +1120,8 @@ TEST(L1D_CACHE, reasonable_line_size) {
 TEST(L1D_CACHE, valid_flags) {
 	ASSERT_TRUE(cpuinfo_initialize());
 
-	const uint32_t valid_flags = CPUINFO_CACHE_UNIFIED | CPUINFO_CACHE_INCLUSIVE | CPUINFO_CACHE_COMPLEX_INDEXING;
+	const uint32_t valid_flags = CPUINFO_CACHE_UNIFIED | CPUINFO_CACHE_INCLUSIVE | CPUINFO_CACHE_COMPLEX_INDEXING |
+		CPUINFO_CACHE_REPORTED_BY_OS;
 	for (uint32_t i = 0; i < cpuinfo_get_l1d_caches_count(); i++) {
 		const cpuinfo_cache* cache = cpuinfo_get_l1d_cache(i);
 		ASSERT_TRUE(cache);
@@ -1177,7 +1287,8 @@ TEST(L2_CACHE, reasonable_line_size) {
 TEST(L2_CACHE, valid_flags) {
 	ASSERT_TRUE(cpuinfo_initialize());
 
-	const uint32_t valid_flags = CPUINFO_CACHE_UNIFIED | CPUINFO_CACHE_INCLUSIVE | CPUINFO_CACHE_COMPLEX_INDEXING;
+	const uint32_t valid_flags = CPUINFO_CACHE_UNIFIED | CPUINFO_CACHE_INCLUSIVE | CPUINFO_CACHE_COMPLEX_INDEXING |
+		CPUINFO_CACHE_REPORTED_BY_OS;
 	for (uint32_t i = 0; i < cpuinfo_get_l2_caches_count(); i++) {
 		const cpuinfo_cache* cache = cpuinfo_get_l2_cache(i);
 		ASSERT_TRUE(cache);
@@ -1324,7 +1435,8 @@ TEST(L3_CACHE, reasonable_line_size) {
 TEST(L3_CACHE, valid_flags) {
 	ASSERT_TRUE(cpuinfo_initialize());
 
-	const uint32_t valid_flags = CPUINFO_CACHE_UNIFIED | CPUINFO_CACHE_INCLUSIVE | CPUINFO_CACHE_COMPLEX_INDEXING;
+	const uint32_t valid_flags = CPUINFO_CACHE_UNIFIED | CPUINFO_CACHE_INCLUSIVE | CPUINFO_CACHE_COMPLEX_INDEXING |
+		CPUINFO_CACHE_REPORTED_BY_OS;
 	for (uint32_t i = 0; i < cpuinfo_get_l3_caches_count(); i++) {
 		const cpuinfo_cache* cache = cpuinfo_get_l3_cache(i);
 		ASSERT_TRUE(cache);
@@ -1471,7 +1583,8 @@ TEST(L4_CACHE, reasonable_line_size) {
 TEST(L4_CACHE, valid_flags) {
 	ASSERT_TRUE(cpuinfo_initialize());
 
-	const uint32_t valid_flags = CPUINFO_CACHE_UNIFIED | CPUINFO_CACHE_INCLUSIVE | CPUINFO_CACHE_COMPLEX_INDEXING;
+	const uint32_t valid_flags = CPUINFO_CACHE_UNIFIED | CPUINFO_CACHE_INCLUSIVE | CPUINFO_CACHE_COMPLEX_INDEXING |
+		CPUINFO_CACHE_REPORTED_BY_OS;
 	for (uint32_t i = 0; i < cpuinfo_get_l4_caches_count(); i++) {
 		const cpuinfo_cache* cache = cpuinfo_get_l4_cache(i);
 		ASSERT_TRUE(cache);
@@ -1519,3 +1632,259 @@ TEST(L4_CACHE, consistent_processors) {
 	}
 	cpuinfo_deinitialize();
 }
+
+#if defined(__linux__)
+TEST(AFFINITY_MASK, consistent_topology) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	for (uint32_t i = 0; i < cpuinfo_get_packages_count(); i++) {
+		const cpuinfo_package* package = cpuinfo_get_package(i);
+		ASSERT_TRUE(package);
+
+		cpuinfo_affinity_mask mask = {};
+		ASSERT_TRUE(cpuinfo_affinity_mask_add_package(&mask, package));
+		EXPECT_EQ(package->processor_count, cpuinfo_affinity_mask_count(&mask));
+		for (uint32_t j = 0; j < package->processor_count; j++) {
+			const cpuinfo_processor* processor = cpuinfo_get_processor(package->processor_start + j);
+			ASSERT_TRUE(processor);
+
+			EXPECT_TRUE(cpuinfo_affinity_mask_has_processor_id(&mask, processor->linux_id));
+		}
+		cpuinfo_affinity_mask_free(&mask);
+	}
+	for (uint32_t i = 0; i < cpuinfo_get_cores_count(); i++) {
+		cpuinfo_affinity_mask mask = {};
+		ASSERT_TRUE(cpuinfo_affinity_mask_add_core(&mask, cpuinfo_get_core(i)));
+		EXPECT_EQ(cpuinfo_get_core(i)->processor_count, cpuinfo_affinity_mask_count(&mask));
+		cpuinfo_affinity_mask_free(&mask);
+	}
+	cpuinfo_deinitialize();
+}
+
+TEST(THREAD_AFFINITY, pin_and_restore) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	cpuinfo_affinity_mask allowed = {};
+	ASSERT_TRUE(cpuinfo_get_thread_affinity(0, &allowed));
+	EXPECT_NE(0, cpuinfo_affinity_mask_count(&allowed));
+
+	for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+		const cpuinfo_processor* processor = cpuinfo_get_processor(i);
+		if (!cpuinfo_affinity_mask_has_processor_id(&allowed, processor->linux_id)) {
+			continue;
+		}
+		cpuinfo_affinity_mask pinned = {};
+		cpuinfo_affinity_mask previous = {};
+		ASSERT_TRUE(cpuinfo_affinity_mask_add_processor(&pinned, processor));
+		ASSERT_TRUE(cpuinfo_set_thread_affinity(0, &pinned, &previous));
+		EXPECT_EQ(processor, cpuinfo_get_current_processor());
+		ASSERT_TRUE(cpuinfo_set_thread_affinity(0, &previous, nullptr));
+		cpuinfo_affinity_mask_free(&pinned);
+		cpuinfo_affinity_mask_free(&previous);
+		break;
+	}
+
+	cpuinfo_affinity_mask restored = {};
+	ASSERT_TRUE(cpuinfo_get_thread_affinity(0, &restored));
+	EXPECT_EQ(cpuinfo_affinity_mask_count(&allowed), cpuinfo_affinity_mask_count(&restored));
+	cpuinfo_affinity_mask_free(&allowed);
+	cpuinfo_affinity_mask_free(&restored);
+	cpuinfo_deinitialize();
+}
+#endif
+
+TEST(PLACEMENT, consistent_plans) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const cpuinfo_placement_policy policies[] = {
+		cpuinfo_placement_policy_compact,
+		cpuinfo_placement_policy_scatter,
+		cpuinfo_placement_policy_spread_llc,
+		cpuinfo_placement_policy_physical_cores,
+		cpuinfo_placement_policy_preferred_cores,
+	};
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+	const uint32_t cores_count = cpuinfo_get_cores_count();
+	std::vector<const cpuinfo_processor*> all_cores(processors_count);
+	const uint32_t usable_cores_count =
+		cpuinfo_plan_placement(processors_count, cpuinfo_placement_policy_physical_cores, all_cores.data());
+	EXPECT_LE(usable_cores_count, cores_count);
+	for (cpuinfo_placement_policy policy : policies) {
+		for (uint32_t threads_count : {1u, cores_count, processors_count, 2 * processors_count + 1}) {
+			std::vector<const cpuinfo_processor*> plan(threads_count);
+			const uint32_t distinct_count = cpuinfo_plan_placement(threads_count, policy, plan.data());
+			EXPECT_NE(0, distinct_count);
+			EXPECT_LE(distinct_count, threads_count);
+			EXPECT_LE(distinct_count, processors_count);
+			std::set<const cpuinfo_processor*> processors;
+			std::set<const cpuinfo_core*> cores;
+			for (const cpuinfo_processor* processor : plan) {
+				ASSERT_TRUE(processor);
+				EXPECT_LE(cpuinfo_get_processors(), processor);
+				EXPECT_LT(processor, cpuinfo_get_processors() + processors_count);
+				processors.insert(processor);
+				cores.insert(processor->core);
+			}
+			EXPECT_EQ(distinct_count, processors.size());
+			if (policy == cpuinfo_placement_policy_physical_cores) {
+				EXPECT_EQ(processors.size(), cores.size());
+			} else if (policy != cpuinfo_placement_policy_spread_llc && threads_count <= usable_cores_count) {
+				/* SMT siblings are used only after all physical cores */
+				EXPECT_EQ(distinct_count, cores.size());
+			}
+		}
+	}
+	EXPECT_EQ(0, cpuinfo_plan_placement(0, cpuinfo_placement_policy_compact, nullptr));
+	cpuinfo_deinitialize();
+}
+
+TEST(RANKED_PROCESSORS, fastest_cores_first) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+	std::vector<const cpuinfo_processor*> ranked(processors_count);
+	ASSERT_EQ(processors_count, cpuinfo_get_ranked_processors(ranked.data()));
+	EXPECT_EQ(processors_count, std::set<const cpuinfo_processor*>(ranked.begin(), ranked.end()).size());
+	for (uint32_t i = 1; i < processors_count; i++) {
+		const cpuinfo_core* previous_core = ranked[i - 1]->core;
+		const cpuinfo_core* core = ranked[i]->core;
+		EXPECT_GE(previous_core->performance_ranking, core->performance_ranking);
+		if (previous_core->performance_ranking == core->performance_ranking) {
+			EXPECT_GE(previous_core->capacity, core->capacity);
+		}
+	}
+
+	/* A single thread lands on the best allowed core */
+	const cpuinfo_processor* preferred = nullptr;
+	ASSERT_EQ(1, cpuinfo_plan_placement(1, cpuinfo_placement_policy_preferred_cores, &preferred));
+	cpuinfo_allowed_topology topology;
+	ASSERT_TRUE(cpuinfo_get_allowed_topology(&topology));
+	for (uint32_t i = 0; i < topology.cores_count; i++) {
+		EXPECT_GE(preferred->core->performance_ranking, topology.cores[i]->performance_ranking);
+	}
+	cpuinfo_allowed_topology_free(&topology);
+	cpuinfo_deinitialize();
+}
+
+TEST(ALLOWED_TOPOLOGY, consistent_with_topology) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	cpuinfo_allowed_topology topology;
+	ASSERT_TRUE(cpuinfo_get_allowed_topology(&topology));
+	EXPECT_NE(0, topology.processors_count);
+	EXPECT_LE(topology.processors_count, cpuinfo_get_processors_count());
+	EXPECT_NE(0, topology.cores_count);
+	EXPECT_LE(topology.cores_count, topology.processors_count);
+	EXPECT_NE(0, topology.clusters_count);
+	EXPECT_LE(topology.clusters_count, topology.cores_count);
+	std::set<const cpuinfo_core*> cores;
+	std::set<const cpuinfo_cluster*> clusters;
+	for (uint32_t i = 0; i < topology.processors_count; i++) {
+		if (i != 0) {
+			EXPECT_LT(topology.processors[i - 1], topology.processors[i]);
+		}
+		cores.insert(topology.processors[i]->core);
+		clusters.insert(topology.processors[i]->cluster);
+	}
+	EXPECT_EQ(cores, std::set<const cpuinfo_core*>(topology.cores, topology.cores + topology.cores_count));
+	EXPECT_EQ(
+		clusters,
+		std::set<const cpuinfo_cluster*>(topology.clusters, topology.clusters + topology.clusters_count));
+	EXPECT_NE(0, topology.effective_parallelism);
+	EXPECT_LE(topology.effective_parallelism, topology.processors_count * 1000);
+	EXPECT_EQ(topology.effective_parallelism, cpuinfo_get_effective_parallelism());
+	cpuinfo_allowed_topology_free(&topology);
+	EXPECT_FALSE(topology.processors);
+	cpuinfo_deinitialize();
+}
+
+TEST(RECOMMENDED_WORKER_COUNT, within_allowed_topology) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	cpuinfo_allowed_topology topology;
+	ASSERT_TRUE(cpuinfo_get_allowed_topology(&topology));
+	const uint32_t compute_workers = cpuinfo_get_recommended_worker_count(cpuinfo_workload_compute_bound);
+	const uint32_t latency_workers = cpuinfo_get_recommended_worker_count(cpuinfo_workload_latency_bound);
+	EXPECT_LE(1, compute_workers);
+	EXPECT_LE(compute_workers, topology.cores_count);
+	EXPECT_LE(compute_workers * 1000, std::max<uint32_t>(topology.effective_parallelism, 1000));
+	EXPECT_LE(compute_workers, latency_workers);
+	EXPECT_LE(latency_workers, topology.processors_count);
+	EXPECT_LT((latency_workers - 1) * 1000, topology.effective_parallelism);
+	cpuinfo_allowed_topology_free(&topology);
+	cpuinfo_deinitialize();
+}
+
+TEST(SELECT_PROCESSORS, classes_cover_processors) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+	std::vector<const cpuinfo_processor*> housekeeping(processors_count);
+	const uint32_t housekeeping_count = cpuinfo_get_housekeeping_processors(housekeeping.data());
+	EXPECT_EQ(housekeeping_count, cpuinfo_get_housekeeping_processors(nullptr));
+	const uint32_t latency_critical_count =
+		cpuinfo_select_processors(0, 0, nullptr) - housekeeping_count;
+	EXPECT_LE(cpuinfo_get_isolated_processors(nullptr), latency_critical_count);
+	EXPECT_LE(cpuinfo_get_nohz_full_processors(nullptr), latency_critical_count);
+	EXPECT_EQ(processors_count, cpuinfo_select_processors(0, 0, nullptr));
+	for (uint32_t i = 0; i < housekeeping_count; i++) {
+		EXPECT_EQ(0, housekeeping[i]->flags & (CPUINFO_PROCESSOR_ISOLATED | CPUINFO_PROCESSOR_NOHZ_FULL));
+	}
+#if defined(__linux__)
+	for (uint32_t i = 0; i < processors_count; i++) {
+		const uint32_t flags = cpuinfo_get_processor(i)->flags;
+		const bool latency_critical = (flags & (CPUINFO_PROCESSOR_ISOLATED | CPUINFO_PROCESSOR_NOHZ_FULL)) != 0;
+		EXPECT_NE(latency_critical, (flags & CPUINFO_PROCESSOR_HOUSEKEEPING) != 0);
+	}
+#endif
+	cpuinfo_deinitialize();
+}
+
+TEST(PARTITION, consistent_boundaries) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	const uint32_t processors_count = cpuinfo_get_processors_count();
+	std::vector<const cpuinfo_processor*> workers(processors_count);
+	for (uint32_t i = 0; i < processors_count; i++) {
+		workers[i] = cpuinfo_get_processor(i);
+	}
+	for (uint64_t range_size : {UINT64_C(0), UINT64_C(1), UINT64_C(1000003), UINT64_MAX}) {
+		std::vector<uint64_t> boundaries(processors_count + 1);
+		ASSERT_TRUE(cpuinfo_partition_by_capacity(range_size, processors_count, workers.data(), boundaries.data()));
+		EXPECT_EQ(0, boundaries[0]);
+		EXPECT_EQ(range_size, boundaries[processors_count]);
+		for (uint32_t i = 0; i < processors_count; i++) {
+			EXPECT_LE(boundaries[i], boundaries[i + 1]);
+		}
+	}
+	EXPECT_FALSE(cpuinfo_partition_by_capacity(1, 0, workers.data(), nullptr));
+	cpuinfo_deinitialize();
+}
+
+TEST(PARTITION, weighted_by_capacity) {
+	/* One prime core, three performance cores, four efficiency cores */
+	cpuinfo_core cores[8] = {};
+	cpuinfo_processor processors[8] = {};
+	const cpuinfo_processor* workers[8];
+	for (uint32_t i = 0; i < 8; i++) {
+		cores[i].capacity = i == 0 ? 1024 : i < 4 ? 640 : 256;
+		processors[i].core = &cores[i];
+		workers[i] = &processors[i];
+	}
+	uint64_t boundaries[9];
+	ASSERT_TRUE(cpuinfo_partition_by_capacity(1024 + 3 * 640 + 4 * 256, 8, workers, boundaries));
+	EXPECT_EQ(1024, boundaries[1] - boundaries[0]);
+	for (uint32_t i = 1; i < 4; i++) {
+		EXPECT_EQ(640, boundaries[i + 1] - boundaries[i]);
+	}
+	for (uint32_t i = 4; i < 8; i++) {
+		EXPECT_EQ(256, boundaries[i + 1] - boundaries[i]);
+	}
+
+	/* Without reported capacity, the estimate favors big out-of-order cores */
+	for (uint32_t i = 0; i < 8; i++) {
+		cores[i].capacity = 0;
+		cores[i].uarch = i < 4 ? cpuinfo_uarch_cortex_a78 : cpuinfo_uarch_cortex_a55;
+		cores[i].frequency = i < 4 ? UINT64_C(2400000000) : UINT64_C(1800000000);
+	}
+	ASSERT_TRUE(cpuinfo_partition_by_capacity(4096, 8, workers, boundaries));
+	EXPECT_GT(boundaries[1] - boundaries[0], 2 * (boundaries[5] - boundaries[4]));
+
+	/* Workers on one core share its capacity */
+	workers[1] = &processors[0];
+	ASSERT_TRUE(cpuinfo_partition_by_capacity(4096, 8, workers, boundaries));
+	EXPECT_EQ(boundaries[1] - boundaries[0], boundaries[2] - boundaries[1]);
+	EXPECT_NEAR(boundaries[2] - boundaries[0], boundaries[3] - boundaries[2], 1);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/seccomp.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <cpuinfo.h>
+
+/* Tests run in the order of declaration: ISA-only initialization must come before the full initialization */
+
+TEST(ISA_INIT, without_topology) {
+	ASSERT_TRUE(cpuinfo_initialize_isa());
+	ASSERT_TRUE(cpuinfo_initialize_isa());
+	EXPECT_EQ(1, cpuinfo_get_uarchs_count());
+	ASSERT_TRUE(cpuinfo_get_uarch(0));
+	EXPECT_FALSE(cpuinfo_get_uarch(1));
+}
+
+TEST(ISA_INIT, matches_full_initialization) {
+	ASSERT_TRUE(cpuinfo_initialize_isa());
+	const enum cpuinfo_uarch isa_uarch = cpuinfo_get_uarch(0)->uarch;
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+	const struct cpuinfo_x86_isa isa = cpuinfo_isa;
+#endif
+
+	ASSERT_TRUE(cpuinfo_initialize());
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+	EXPECT_EQ(0, memcmp(&isa, &cpuinfo_isa, sizeof(isa)));
+	EXPECT_EQ(isa_uarch, cpuinfo_get_uarch(0)->uarch);
+#else
+	bool uarch_found = isa_uarch == cpuinfo_uarch_unknown;
+	for (uint32_t i = 0; i < cpuinfo_get_uarchs_count(); i++) {
+		uarch_found |= cpuinfo_get_uarch(i)->uarch == isa_uarch;
+	}
+	EXPECT_TRUE(uarch_found);
+#endif
+	cpuinfo_deinitialize();
+
+	/* The ISA state outlives the topology tables */
+	EXPECT_EQ(1, cpuinfo_get_uarchs_count());
+}
+
+#if defined(__linux__) && !defined(__ANDROID__) && \
+	(CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64 || CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64)
+TEST(ISA_INIT, strict_seccomp) {
+	const pid_t pid = fork();
+	ASSERT_NE(-1, pid);
+	if (pid == 0) {
+		/* Only read, write, _exit, and sigreturn are allowed: any open kills the process */
+		if (prctl(PR_SET_SECCOMP, SECCOMP_MODE_STRICT) != 0) {
+			_exit(2);
+		}
+		const bool initialized = cpuinfo_initialize_isa();
+		syscall(SYS_exit, initialized ? 0 : 1);
+	}
+	int status = 0;
+	ASSERT_EQ(pid, waitpid(pid, &status, 0));
+	ASSERT_TRUE(WIFEXITED(status));
+	EXPECT_EQ(0, WEXITSTATUS(status));
+}
+#endif
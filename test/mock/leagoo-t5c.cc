@@ -127,7 +127,7 @@ TEST(CORES, cpuid) {
 	}
 }
 
-TEST(CORES, DISABLED_frequency) {
+TEST(CORES, frequency) {
 	for (uint32_t i = 0; i < cpuinfo_get_cores_count(); i++) {
 		ASSERT_EQ(UINT64_C(1872000000), cpuinfo_get_core(i)->frequency);
 	}
@@ -195,7 +195,7 @@ TEST(CLUSTERS, cpuid) {
 	}
 }
 
-TEST(CLUSTERS, DISABLED_frequency) {
+TEST(CLUSTERS, frequency) {
 	for (uint32_t i = 0; i < cpuinfo_get_clusters_count(); i++) {
 		ASSERT_EQ(UINT64_C(1872000000), cpuinfo_get_cluster(i)->frequency);
 	}
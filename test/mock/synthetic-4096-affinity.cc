@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+#include <synthetic-4096.h>
+
+TEST(AFFINITY_MASK, package_above_cpu_setsize) {
+	const std::vector<cpuinfo_processor> processors = synthetic_processors();
+	cpuinfo_affinity_mask mask = {};
+	ASSERT_TRUE(cpuinfo_affinity_mask_add_processors(&mask, &processors[2 * package_size], package_size));
+	EXPECT_LE(3 * package_size, mask.capacity);
+	EXPECT_EQ(package_size, cpuinfo_affinity_mask_count(&mask));
+	for (uint32_t i = 0; i < processors_count; i++) {
+		EXPECT_EQ(i / package_size == 2, cpuinfo_affinity_mask_has_processor_id(&mask, i));
+	}
+	EXPECT_FALSE(cpuinfo_affinity_mask_has_processor_id(&mask, mask.capacity));
+	cpuinfo_affinity_mask_free(&mask);
+	EXPECT_EQ(0, mask.capacity);
+	EXPECT_FALSE(mask.bits);
+}
+
+TEST(AFFINITY_MASK, clear) {
+	const std::vector<cpuinfo_processor> processors = synthetic_processors();
+	cpuinfo_affinity_mask mask;
+	ASSERT_TRUE(cpuinfo_affinity_mask_init(&mask, 64));
+	ASSERT_TRUE(cpuinfo_affinity_mask_add_processor(&mask, &processors[processors_count - 1]));
+	EXPECT_EQ(1, cpuinfo_affinity_mask_count(&mask));
+	cpuinfo_affinity_mask_clear(&mask);
+	EXPECT_EQ(0, cpuinfo_affinity_mask_count(&mask));
+	EXPECT_LE(processors_count, mask.capacity);
+	cpuinfo_affinity_mask_free(&mask);
+}
+
+TEST(THREAD_AFFINITY, query_grows_mask) {
+	cpuinfo_mock_affinity(processors_count);
+	cpuinfo_affinity_mask mask;
+	ASSERT_TRUE(cpuinfo_affinity_mask_init(&mask, 64));
+	ASSERT_TRUE(cpuinfo_get_thread_affinity(0, &mask));
+	EXPECT_LE(processors_count, mask.capacity);
+	EXPECT_EQ(processors_count, cpuinfo_affinity_mask_count(&mask));
+	cpuinfo_affinity_mask_free(&mask);
+}
+
+TEST(THREAD_AFFINITY, set_and_restore) {
+	cpuinfo_mock_affinity(processors_count);
+	const std::vector<cpuinfo_processor> processors = synthetic_processors();
+	cpuinfo_affinity_mask core = {};
+	ASSERT_TRUE(cpuinfo_affinity_mask_add_processors(&core, &processors[3000], core_size));
+
+	cpuinfo_affinity_mask previous = {};
+	ASSERT_TRUE(cpuinfo_set_thread_affinity(0, &core, &previous));
+	EXPECT_EQ(processors_count, cpuinfo_affinity_mask_count(&previous));
+
+	cpuinfo_affinity_mask current = {};
+	ASSERT_TRUE(cpuinfo_get_thread_affinity(0, &current));
+	EXPECT_EQ(core_size, cpuinfo_affinity_mask_count(&current));
+	EXPECT_TRUE(cpuinfo_affinity_mask_has_processor_id(&current, 3000));
+	EXPECT_TRUE(cpuinfo_affinity_mask_has_processor_id(&current, 3001));
+
+	ASSERT_TRUE(cpuinfo_set_thread_affinity(0, &previous, nullptr));
+	ASSERT_TRUE(cpuinfo_get_thread_affinity(0, &current));
+	EXPECT_EQ(processors_count, cpuinfo_affinity_mask_count(&current));
+
+	cpuinfo_affinity_mask_free(&core);
+	cpuinfo_affinity_mask_free(&previous);
+	cpuinfo_affinity_mask_free(&current);
+}
+
+TEST(THREAD_AFFINITY, rejects_offline_processors) {
+	cpuinfo_mock_affinity(package_size);
+	const std::vector<cpuinfo_processor> processors = synthetic_processors();
+	cpuinfo_affinity_mask mask = {};
+	ASSERT_TRUE(cpuinfo_affinity_mask_add_processors(&mask, &processors[package_size], package_size));
+
+	cpuinfo_affinity_mask previous = {};
+	EXPECT_FALSE(cpuinfo_set_thread_affinity(0, &mask, &previous));
+	EXPECT_EQ(0, previous.capacity);
+
+	cpuinfo_affinity_mask current = {};
+	ASSERT_TRUE(cpuinfo_get_thread_affinity(0, &current));
+	EXPECT_EQ(package_size, cpuinfo_affinity_mask_count(&current));
+
+	cpuinfo_affinity_mask_free(&mask);
+	cpuinfo_affinity_mask_free(&current);
+}
+
+int main(int argc, char* argv[]) {
+	mock_synthetic_4096();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+extern "C" {
+#include <linux/cgroup.h>
+}
+
+#include <synthetic-4096.h>
+
+TEST(CGROUP, quota_of_most_restrictive_ancestor) {
+	uint64_t quota = 0, period = 0;
+	ASSERT_TRUE(cpuinfo_linux_detect_cgroup_cpu_quota(&quota, &period));
+	EXPECT_EQ(400000, quota);
+	EXPECT_EQ(100000, period);
+}
+
+static bool cpuset_parser(uint32_t start, uint32_t end, std::vector<uint32_t>* cpuset) {
+	for (uint32_t processor = start; processor < end; processor++) {
+		cpuset->push_back(processor);
+	}
+	return true;
+}
+
+TEST(CGROUP, cpuset_of_nearest_ancestor) {
+	std::vector<uint32_t> cpuset;
+	ASSERT_TRUE(cpuinfo_linux_parse_cgroup_cpuset((cpuinfo_cpulist_callback)cpuset_parser, &cpuset));
+	EXPECT_EQ(std::vector<uint32_t>({1024, 1025, 1026, 1027, 2048, 2049, 2050, 2051}), cpuset);
+}
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+TEST(ALLOWED_TOPOLOGY, pod_cgroup) {
+	cpuinfo_mock_affinity(processors_count);
+	ASSERT_TRUE(cpuinfo_initialize());
+	/* The pod cpuset holds 2 cores of package 1 and 2 cores of package 2, and its quota is 4 processors */
+	cpuinfo_allowed_topology topology;
+	ASSERT_TRUE(cpuinfo_get_allowed_topology(&topology));
+	ASSERT_EQ(8, topology.processors_count);
+	EXPECT_EQ(1024, topology.processors[0]->linux_id);
+	EXPECT_EQ(1027, topology.processors[3]->linux_id);
+	EXPECT_EQ(2048, topology.processors[4]->linux_id);
+	EXPECT_EQ(2051, topology.processors[7]->linux_id);
+	EXPECT_EQ(4, topology.cores_count);
+	EXPECT_EQ(2, topology.clusters_count);
+	EXPECT_EQ(4000, topology.effective_parallelism);
+	cpuinfo_allowed_topology_free(&topology);
+	EXPECT_EQ(4, cpuinfo_get_recommended_worker_count(cpuinfo_workload_compute_bound));
+	EXPECT_EQ(4, cpuinfo_get_recommended_worker_count(cpuinfo_workload_latency_bound));
+
+	/* Affinity outside of the cpuset does not count, and one core is only half allowed */
+	cpuinfo_affinity_mask mask = {};
+	for (uint32_t processor : {1024, 1025, 1026, 2048, 3072}) {
+		ASSERT_TRUE(cpuinfo_affinity_mask_add_processor(&mask, cpuinfo_get_processor(processor)));
+	}
+	ASSERT_TRUE(cpuinfo_set_thread_affinity(0, &mask, nullptr));
+	cpuinfo_affinity_mask_free(&mask);
+	ASSERT_TRUE(cpuinfo_get_allowed_topology(&topology));
+	EXPECT_EQ(4, topology.processors_count);
+	EXPECT_EQ(3, topology.cores_count);
+	EXPECT_EQ(2, topology.clusters_count);
+	EXPECT_EQ(4000, topology.effective_parallelism);
+	cpuinfo_allowed_topology_free(&topology);
+	/* Compute-bound workers get one physical core each, while latency-bound workers fill the quota */
+	EXPECT_EQ(3, cpuinfo_get_recommended_worker_count(cpuinfo_workload_compute_bound));
+	EXPECT_EQ(4, cpuinfo_get_recommended_worker_count(cpuinfo_workload_latency_bound));
+	cpuinfo_deinitialize();
+	cpuinfo_mock_affinity(processors_count);
+}
+#endif
+
+int main(int argc, char* argv[]) {
+	mock_synthetic_4096();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <poll.h>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+#include <synthetic-4096.h>
+
+/* Uevents recorded from the kernel, with the null terminators of all fields */
+static const char cpu3_offline_uevent[] =
+	"offline@/devices/system/cpu/cpu3\0ACTION=offline\0DEVPATH=/devices/system/cpu/cpu3\0"
+	"SUBSYSTEM=cpu\0SEQNUM=4213";
+static const char cpu3_online_uevent[] =
+	"online@/devices/system/cpu/cpu3\0ACTION=online\0DEVPATH=/devices/system/cpu/cpu3\0"
+	"SUBSYSTEM=cpu\0SEQNUM=4215";
+static const char cpu4095_offline_uevent[] =
+	"offline@/devices/system/cpu/cpu4095\0ACTION=offline\0DEVPATH=/devices/system/cpu/cpu4095\0"
+	"SUBSYSTEM=cpu\0SEQNUM=4216";
+static const char cpu5_add_uevent[] =
+	"add@/devices/system/cpu/cpu5\0ACTION=add\0DEVPATH=/devices/system/cpu/cpu5\0"
+	"SUBSYSTEM=cpu\0SEQNUM=4214";
+static const char memory_offline_uevent[] =
+	"offline@/devices/system/memory/memory32\0ACTION=offline\0DEVPATH=/devices/system/memory/memory32\0"
+	"SUBSYSTEM=memory\0SEQNUM=4217";
+
+struct online_change {
+	uint32_t old_count;
+	uint32_t new_count;
+	bool cpu3_online;
+	bool cpu4095_online;
+};
+
+static void record_change(
+	const cpuinfo_affinity_mask* old_online,
+	const cpuinfo_affinity_mask* new_online,
+	std::vector<online_change>* changes) {
+	changes->push_back(online_change{
+		cpuinfo_affinity_mask_count(old_online),
+		cpuinfo_affinity_mask_count(new_online),
+		cpuinfo_affinity_mask_has_processor_id(new_online, 3),
+		cpuinfo_affinity_mask_has_processor_id(new_online, 4095)});
+}
+
+TEST(HOTPLUG, replayed_uevents) {
+	cpuinfo_hotplug_monitor* monitor = cpuinfo_hotplug_monitor_create();
+	ASSERT_TRUE(monitor);
+	EXPECT_EQ(processors_count, cpuinfo_affinity_mask_count(cpuinfo_hotplug_monitor_get_online(monitor)));
+	std::vector<online_change> changes;
+	ASSERT_TRUE(
+		cpuinfo_hotplug_monitor_add_callback(monitor, (cpuinfo_hotplug_callback)record_change, &changes));
+
+	pollfd fd = {cpuinfo_hotplug_monitor_get_fd(monitor), POLLIN, 0};
+	EXPECT_EQ(0, poll(&fd, 1, 0));
+	EXPECT_EQ(0, cpuinfo_hotplug_monitor_dispatch(monitor));
+
+	for (const std::string& uevent :
+	     {std::string(cpu3_offline_uevent, sizeof(cpu3_offline_uevent)),
+	      std::string(cpu3_offline_uevent, sizeof(cpu3_offline_uevent)),
+	      std::string(cpu5_add_uevent, sizeof(cpu5_add_uevent)),
+	      std::string(cpu3_online_uevent, sizeof(cpu3_online_uevent)),
+	      std::string(memory_offline_uevent, sizeof(memory_offline_uevent)),
+	      std::string(cpu4095_offline_uevent, sizeof(cpu4095_offline_uevent))}) {
+		ASSERT_TRUE(cpuinfo_mock_uevent(uevent.data(), uevent.size()));
+	}
+	EXPECT_EQ(1, poll(&fd, 1, 0));
+	/* The repeated event, processor registration, and memory event do not change the online processors */
+	EXPECT_EQ(3, cpuinfo_hotplug_monitor_dispatch(monitor));
+	ASSERT_EQ(3, changes.size());
+	EXPECT_EQ(processors_count, changes[0].old_count);
+	EXPECT_EQ(processors_count - 1, changes[0].new_count);
+	EXPECT_FALSE(changes[0].cpu3_online);
+	EXPECT_EQ(processors_count, changes[1].new_count);
+	EXPECT_TRUE(changes[1].cpu3_online);
+	EXPECT_EQ(processors_count - 1, changes[2].new_count);
+	EXPECT_FALSE(changes[2].cpu4095_online);
+	EXPECT_EQ(0, poll(&fd, 1, 0));
+	EXPECT_EQ(processors_count - 1, cpuinfo_affinity_mask_count(cpuinfo_hotplug_monitor_get_online(monitor)));
+
+	cpuinfo_hotplug_monitor_destroy(monitor);
+}
+
+int main(int argc, char* argv[]) {
+	mock_synthetic_4096();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
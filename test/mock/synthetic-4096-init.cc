@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+extern "C" {
+#include <linux/sysfs.h>
+}
+
+#include <synthetic-4096.h>
+
+static uint32_t count_init_syscalls(bool (*initialize)(void)) {
+	const uint32_t syscalls = cpuinfo_linux_file_syscalls;
+	EXPECT_TRUE(initialize());
+	return cpuinfo_linux_file_syscalls - syscalls;
+}
+
+static uint32_t count_restricted_init_syscalls(uint32_t core_start) {
+	cpuinfo_mock_affinity(processors_count);
+	const std::vector<cpuinfo_processor> processors = synthetic_processors();
+	cpuinfo_affinity_mask core = {};
+	EXPECT_TRUE(cpuinfo_affinity_mask_add_processors(&core, &processors[core_start], core_size));
+	EXPECT_TRUE(cpuinfo_set_thread_affinity(0, &core, nullptr));
+	cpuinfo_affinity_mask_free(&core);
+
+	const uint32_t syscalls = count_init_syscalls(cpuinfo_initialize_restricted);
+	EXPECT_EQ(core_size, cpuinfo_get_processors_count());
+	EXPECT_EQ(core_start, cpuinfo_get_processor(0)->linux_id);
+	cpuinfo_deinitialize();
+	return syscalls;
+}
+
+TEST(RESTRICTED_INIT, work_scales_with_allowed_processors) {
+	cpuinfo_mock_affinity(processors_count);
+	const uint32_t full_syscalls = count_init_syscalls(cpuinfo_initialize);
+	EXPECT_EQ(processors_count, cpuinfo_get_processors_count());
+	EXPECT_EQ(processors_count / core_size, cpuinfo_get_cores_count());
+	EXPECT_EQ(processors_count / package_size, cpuinfo_get_packages_count());
+	cpuinfo_deinitialize();
+
+	/* /proc/cpuinfo is read up to the last allowed processor, but other processors are not detected */
+	const uint32_t first_core_syscalls = count_restricted_init_syscalls(0);
+	const uint32_t last_core_syscalls = count_restricted_init_syscalls(processors_count - core_size);
+	EXPECT_LT(first_core_syscalls * 100, full_syscalls);
+	EXPECT_LT(last_core_syscalls * 50, full_syscalls);
+	cpuinfo_mock_affinity(processors_count);
+}
+
+TEST(FREQUENCY, per_core) {
+	cpuinfo_mock_affinity(processors_count);
+	ASSERT_TRUE(cpuinfo_initialize());
+	EXPECT_EQ(UINT64_C(2000000000), cpuinfo_get_core(0)->frequency);
+	EXPECT_EQ(UINT64_C(2050000000), cpuinfo_get_core(1)->frequency);
+	EXPECT_EQ(UINT64_C(2100000000), cpuinfo_get_core(package_size / core_size)->frequency);
+	/* The cluster of the whole package runs at the frequency of its slowest cores */
+	EXPECT_EQ(UINT64_C(2000000000), cpuinfo_get_core(1)->cluster->frequency);
+	cpuinfo_deinitialize();
+}
+
+/* Describes the tables with indices in place of pointers, so that the tables of two detections can be compared */
+static std::vector<std::string> describe_tables() {
+	std::vector<std::string> description;
+	const cpuinfo_core* cores = cpuinfo_get_cores();
+	const cpuinfo_cache* l2 = cpuinfo_get_l2_caches();
+	for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+		const cpuinfo_processor* processor = cpuinfo_get_processor(i);
+		description.push_back(
+			"processor " + std::to_string(i) + ": linux_id " + std::to_string(processor->linux_id) + ", apic_id " +
+			std::to_string(processor->apic_id) + ", core " + std::to_string(processor->core - cores) +
+			", cluster " + std::to_string(processor->cluster - cpuinfo_get_clusters()) + ", package " +
+			std::to_string(processor->package - cpuinfo_get_packages()) + ", l2 " +
+			std::to_string(processor->cache.l2 - l2) + ", flags " + std::to_string(processor->flags));
+	}
+	for (uint32_t i = 0; i < cpuinfo_get_cores_count(); i++) {
+		const cpuinfo_core* core = cpuinfo_get_core(i);
+		description.push_back(
+			"core " + std::to_string(i) + ": processors " + std::to_string(core->processor_start) + "+" +
+			std::to_string(core->processor_count) + ", core_id " + std::to_string(core->core_id) + ", uarch " +
+			std::to_string(core->uarch) + ", frequency " + std::to_string(core->frequency));
+	}
+	for (uint32_t i = 0; i < cpuinfo_get_clusters_count(); i++) {
+		const cpuinfo_cluster* cluster = cpuinfo_get_cluster(i);
+		description.push_back(
+			"cluster " + std::to_string(i) + ": cores " + std::to_string(cluster->core_start) + "+" +
+			std::to_string(cluster->core_count) + ", frequency " + std::to_string(cluster->frequency));
+	}
+	for (uint32_t i = 0; i < cpuinfo_get_packages_count(); i++) {
+		const cpuinfo_package* package = cpuinfo_get_package(i);
+		description.push_back(
+			"package " + std::to_string(i) + ": cores " + std::to_string(package->core_start) + "+" +
+			std::to_string(package->core_count) + ", name " + package->name);
+	}
+	for (uint32_t i = 0; i < cpuinfo_get_l2_caches_count(); i++) {
+		const cpuinfo_cache* cache = cpuinfo_get_l2_cache(i);
+		description.push_back(
+			"l2 " + std::to_string(i) + ": size " + std::to_string(cache->size) + ", processors " +
+			std::to_string(cache->processor_start) + "+" + std::to_string(cache->processor_count));
+	}
+	return description;
+}
+
+TEST(PARALLEL_INIT, same_tables_as_sequential) {
+	ASSERT_EQ(0, unsetenv("CPUINFO_PARALLEL_INIT"));
+	ASSERT_TRUE(cpuinfo_initialize());
+	const std::vector<std::string> sequential = describe_tables();
+	/* Packages run at different frequencies, so results stored for a processor of another package show up */
+	EXPECT_NE(cpuinfo_get_cluster(0)->frequency, cpuinfo_get_cluster(1)->frequency);
+	cpuinfo_deinitialize();
+
+	ASSERT_EQ(0, setenv("CPUINFO_PARALLEL_INIT", "16", 1));
+	ASSERT_TRUE(cpuinfo_initialize());
+	const std::vector<std::string> parallel = describe_tables();
+	cpuinfo_deinitialize();
+	ASSERT_EQ(0, unsetenv("CPUINFO_PARALLEL_INIT"));
+
+	ASSERT_EQ(sequential.size(), parallel.size());
+	for (size_t i = 0; i < sequential.size(); i++) {
+		EXPECT_EQ(sequential[i], parallel[i]);
+	}
+}
+
+int main(int argc, char* argv[]) {
+	mock_synthetic_4096();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+extern "C" {
+#include <linux/processors.h>
+}
+
+#include <synthetic-4096.h>
+
+TEST(PROCESSOR_FLAGS, isolated_partition) {
+	std::vector<uint32_t> flags(processors_count);
+	/* isolcpus is not set, but a cgroup partition is isolated */
+	ASSERT_TRUE(cpuinfo_linux_detect_isolated_processors(
+		processors_count, flags.data(), sizeof(uint32_t), CPUINFO_PROCESSOR_ISOLATED));
+	for (uint32_t i = 0; i < processors_count; i++) {
+		EXPECT_EQ(i >= 2048 && i < 2056 ? CPUINFO_PROCESSOR_ISOLATED : 0, flags[i]) << "processor " << i;
+	}
+}
+
+TEST(PROCESSOR_FLAGS, nohz_full) {
+	std::vector<uint32_t> flags(processors_count);
+	ASSERT_TRUE(cpuinfo_linux_detect_nohz_full_processors(
+		processors_count, flags.data(), sizeof(uint32_t), CPUINFO_PROCESSOR_NOHZ_FULL));
+	for (uint32_t i = 0; i < processors_count; i++) {
+		EXPECT_EQ(i >= 1024 && i < 2048 ? CPUINFO_PROCESSOR_NOHZ_FULL : 0, flags[i]) << "processor " << i;
+	}
+}
+
+TEST(PROCESSOR_FLAGS, irq_affine) {
+	std::vector<uint32_t> flags(processors_count);
+	ASSERT_TRUE(cpuinfo_linux_detect_irq_affine_processors(
+		processors_count, flags.data(), sizeof(uint32_t), CPUINFO_PROCESSOR_IRQ_AFFINE));
+	/* Processor 1 is in the affinity of one interrupt more than the others, which does not single it out */
+	EXPECT_EQ(CPUINFO_PROCESSOR_IRQ_AFFINE, flags[0]);
+	for (uint32_t i = 1; i < processors_count; i++) {
+		EXPECT_EQ(0, flags[i]) << "processor " << i;
+	}
+}
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+TEST(PROCESSOR_FLAGS, irq_affine_selection) {
+	ASSERT_TRUE(cpuinfo_initialize());
+	/* Initialization leaves the flag to the selections which ask for it */
+	EXPECT_EQ(0, cpuinfo_get_processor(0)->flags & CPUINFO_PROCESSOR_IRQ_AFFINE);
+
+	std::vector<const cpuinfo_processor*> selected(cpuinfo_get_processors_count());
+	ASSERT_EQ(1, cpuinfo_select_processors(CPUINFO_PROCESSOR_IRQ_AFFINE, 0, selected.data()));
+	EXPECT_EQ(0, selected[0]->linux_id);
+	EXPECT_EQ(
+		cpuinfo_get_processors_count() - 1,
+		cpuinfo_select_processors(0, CPUINFO_PROCESSOR_IRQ_AFFINE, selected.data()));
+	EXPECT_EQ(1, selected[0]->linux_id);
+	cpuinfo_deinitialize();
+}
+#endif
+
+int main(int argc, char* argv[]) {
+	mock_synthetic_4096();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
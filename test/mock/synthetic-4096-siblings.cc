@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+extern "C" {
+#include <linux/processors.h>
+}
+
+#include <synthetic-4096.h>
+
+static const uint32_t valid_flag = UINT32_C(0x00000001);
+
+struct processor {
+	uint32_t flags;
+	uint32_t leader;
+};
+
+struct groups {
+	std::vector<processor> processors;
+	uint32_t parsed_lists;
+};
+
+static bool group_parser(uint32_t processor, uint32_t siblings_start, uint32_t siblings_end, groups* context) {
+	context->parsed_lists += 1;
+	for (uint32_t sibling = siblings_start; sibling < siblings_end; sibling++) {
+		context->processors[sibling].leader = processor;
+	}
+	return true;
+}
+
+static groups detect_groups(uint32_t count, cpuinfo_siblings_detector detector) {
+	groups context = {std::vector<processor>(count, processor{valid_flag, UINT32_MAX}), 0};
+	EXPECT_TRUE(cpuinfo_linux_detect_sibling_groups(
+		count,
+		&context.processors[0].flags,
+		sizeof(processor),
+		valid_flag,
+		detector,
+		(cpuinfo_siblings_callback)group_parser,
+		&context));
+	return context;
+}
+
+TEST(SIBLING_GROUPS, cores) {
+	const groups context = detect_groups(processors_count, cpuinfo_linux_detect_thread_siblings);
+	EXPECT_EQ(processors_count / core_size, context.parsed_lists);
+	for (uint32_t i = 0; i < processors_count; i++) {
+		EXPECT_EQ(i - i % core_size, context.processors[i].leader);
+	}
+}
+
+TEST(SIBLING_GROUPS, clusters) {
+	const groups context = detect_groups(processors_count, cpuinfo_linux_detect_cluster_cpus);
+	EXPECT_EQ(processors_count / cluster_size, context.parsed_lists);
+	for (uint32_t i = 0; i < processors_count; i++) {
+		EXPECT_EQ(i - i % cluster_size, context.processors[i].leader);
+	}
+}
+
+TEST(SIBLING_GROUPS, packages) {
+	const groups context = detect_groups(processors_count, cpuinfo_linux_detect_package_cpus);
+	EXPECT_EQ(processors_count / package_size, context.parsed_lists);
+	for (uint32_t i = 0; i < processors_count; i++) {
+		EXPECT_EQ(i - i % package_size, context.processors[i].leader);
+	}
+}
+
+TEST(SIBLING_GROUPS, linear_in_processors) {
+	for (uint32_t count = package_size; count <= processors_count; count *= 2) {
+		const groups cores = detect_groups(count, cpuinfo_linux_detect_thread_siblings);
+		const groups clusters = detect_groups(count, cpuinfo_linux_detect_cluster_cpus);
+		const groups packages = detect_groups(count, cpuinfo_linux_detect_package_cpus);
+		EXPECT_EQ(count / core_size + count / cluster_size + count / package_size,
+			  cores.parsed_lists + clusters.parsed_lists + packages.parsed_lists);
+	}
+}
+
+TEST(SIBLING_GROUPS, invalid_processors) {
+	groups context = {std::vector<processor>(cluster_size, processor{valid_flag, UINT32_MAX}), 0};
+	context.processors[0].flags = 0;
+	ASSERT_TRUE(cpuinfo_linux_detect_sibling_groups(
+		cluster_size,
+		&context.processors[0].flags,
+		sizeof(processor),
+		valid_flag,
+		cpuinfo_linux_detect_cluster_cpus,
+		(cpuinfo_siblings_callback)group_parser,
+		&context));
+	EXPECT_EQ(1, context.parsed_lists);
+	for (uint32_t i = 0; i < cluster_size; i++) {
+		EXPECT_EQ(1, context.processors[i].leader);
+	}
+}
+
+int main(int argc, char* argv[]) {
+	mock_synthetic_4096();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
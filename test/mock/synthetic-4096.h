@@ -0,0 +1,122 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+/* Synthetic server: 4 packages of 1024 processors, 8 processors per cluster, 2 per core */
+static const uint32_t processors_count = 4096;
+static const uint32_t core_size = 2;
+static const uint32_t cluster_size = 8;
+static const uint32_t package_size = 1024;
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+/* Intel processor with 2-way SMT and x2APIC IDs equal to Linux processor numbers */
+static cpuinfo_mock_cpuid cpuid_dump[] = {
+	{0x00000000, 0, 0x0000000B, 0x756E6547, 0x6C65746E, 0x49656E69},
+	{0x00000001, 0, 0x000606A6, 0x00400800, 0x7FFEFBFF, 0xBFEBFBFF},
+	/* L1 data cache per core, L2 cache per cluster, and L3 cache per package */
+	{0x00000004, 0, 0x00004121, 0x02C0003F, 0x0000003F, 0x00000000},
+	{0x00000004, 1, 0x0001C143, 0x04C0003F, 0x000003FF, 0x00000000},
+	{0x00000004, 2, 0x0FFFC163, 0x02C0003F, 0x0000FFFF, 0x00000004},
+	{0x00000004, 3, 0x00000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x0000000B, 0, 0x00000001, 0x00000002, 0x00000100, 0x00000000},
+	{0x0000000B, 1, 0x0000000A, 0x00000400, 0x00000201, 0x00000000},
+	{0x0000000B, 2, 0x00000000, 0x00000000, 0x00000002, 0x00000000},
+};
+#endif
+
+/* Processors with the Linux IDs and SMT IDs of the synthetic server, without detection */
+static inline std::vector<cpuinfo_processor> synthetic_processors() {
+	std::vector<cpuinfo_processor> processors(processors_count);
+	for (uint32_t i = 0; i < processors_count; i++) {
+		processors[i].smt_id = i % core_size;
+		processors[i].linux_id = (int)i;
+	}
+	return processors;
+}
+
+static inline std::string cpulist(uint32_t first, uint32_t size) {
+	return std::to_string(first) + "-" + std::to_string(first + size - 1) + "\n";
+}
+
+static std::vector<std::string> paths, contents;
+static std::vector<cpuinfo_mock_file> filesystem;
+
+/*
+ * Mocks the sysfs topology, cgroups, processor flags, and interrupts of the
+ * synthetic server, and on x86 also /proc/cpuinfo, cpufreq, and CPUID.
+ */
+static inline void mock_synthetic_4096() {
+	for (uint32_t i = 0; i < processors_count; i++) {
+		const std::string topology = "/sys/devices/system/cpu/cpu" + std::to_string(i) + "/topology/";
+		paths.push_back(topology + "thread_siblings_list");
+		contents.push_back(cpulist(i - i % core_size, core_size));
+		paths.push_back(topology + "cluster_cpus_list");
+		contents.push_back(cpulist(i - i % cluster_size, cluster_size));
+		paths.push_back(topology + "package_cpus_list");
+		contents.push_back(cpulist(i - i % package_size, package_size));
+	}
+	/* Container cgroup without a quota, inside a pod limited to 4 processors and a node limited to 8 */
+	paths.push_back("/proc/self/cgroup");
+	contents.push_back("0::/kubepods/pod1/ctr\n");
+	paths.push_back("/sys/fs/cgroup/kubepods/pod1/ctr/cpu.max");
+	contents.push_back("max 100000\n");
+	paths.push_back("/sys/fs/cgroup/kubepods/pod1/cpu.max");
+	contents.push_back("400000 100000\n");
+	paths.push_back("/sys/fs/cgroup/kubepods/pod1/cpuset.cpus.effective");
+	contents.push_back("1024-1027,2048-2051\n");
+	paths.push_back("/sys/fs/cgroup/kubepods/cpu.max");
+	contents.push_back("800000 100000\n");
+	paths.push_back("/sys/devices/system/cpu/online");
+	contents.push_back(cpulist(0, processors_count));
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+	paths.push_back("/sys/devices/system/cpu/kernel_max");
+	contents.push_back(std::to_string(processors_count - 1) + "\n");
+	paths.push_back("/sys/devices/system/cpu/possible");
+	contents.push_back(cpulist(0, processors_count));
+	paths.push_back("/sys/devices/system/cpu/present");
+	contents.push_back(cpulist(0, processors_count));
+	std::string proc_cpuinfo;
+	for (uint32_t i = 0; i < processors_count; i++) {
+		proc_cpuinfo += "processor\t: " + std::to_string(i) + "\nvendor_id\t: GenuineIntel\napicid\t\t: " +
+			std::to_string(i) + "\n\n";
+	}
+	paths.push_back("/proc/cpuinfo");
+	contents.push_back(proc_cpuinfo);
+	for (uint32_t i = 0; i < processors_count; i++) {
+		paths.push_back("/sys/devices/system/cpu/cpu" + std::to_string(i) + "/cpufreq/cpuinfo_max_freq");
+		/* Packages differ in frequency, and odd cores are binned 50 MHz higher than even cores */
+		contents.push_back(std::to_string(2000000 + i / package_size * 100000 + i / core_size % 2 * 50000) + "\n");
+	}
+#endif
+	paths.push_back("/sys/devices/system/cpu/isolated");
+	contents.push_back("\n");
+	paths.push_back("/sys/fs/cgroup/cpuset.cpus.isolated");
+	contents.push_back("2048-2055\n");
+	paths.push_back("/sys/devices/system/cpu/nohz_full");
+	contents.push_back(cpulist(1024, 1024));
+	/* Interrupts 0 and 24 are delivered to processor 0 and 25 to processor 1; 1 is delivered anywhere */
+	paths.push_back("/proc/irq/0/effective_affinity_list");
+	contents.push_back("0\n");
+	paths.push_back("/proc/irq/0/smp_affinity_list");
+	contents.push_back(cpulist(0, processors_count));
+	paths.push_back("/proc/irq/1/smp_affinity_list");
+	contents.push_back(cpulist(0, processors_count));
+	paths.push_back("/proc/irq/24/effective_affinity_list");
+	contents.push_back("0\n");
+	paths.push_back("/proc/irq/25/effective_affinity_list");
+	contents.push_back("1\n");
+	paths.push_back("/proc/irq/default_smp_affinity");
+	contents.push_back("ffffffff\n");
+
+	for (size_t i = 0; i < paths.size(); i++) {
+		filesystem.push_back(cpuinfo_mock_file{paths[i].c_str(), contents[i].size(), contents[i].c_str(), 0});
+	}
+	filesystem.push_back(cpuinfo_mock_file{nullptr, 0, nullptr, 0});
+	cpuinfo_mock_filesystem(filesystem.data());
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+	cpuinfo_mock_set_cpuid(cpuid_dump, sizeof(cpuid_dump) / sizeof(cpuinfo_mock_cpuid));
+#endif
+}
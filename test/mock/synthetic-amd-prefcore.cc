@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+/*
+ * amd_pstate preferred-core rankings of the 16 cores, which bin the cores of
+ * the first CCD highest. Logical processors N and N + 16 are the threads of
+ * core N.
+ */
+static const uint32_t prefcore_rankings[16] = {
+	226, 236, 231, 221, 216, 211, 206, 201, 196, 191, 186, 181, 176, 171, 166, 161};
+
+TEST(CORES, count) {
+	ASSERT_EQ(16, cpuinfo_get_cores_count());
+	ASSERT_EQ(32, cpuinfo_get_processors_count());
+}
+
+TEST(CORES, performance_ranking) {
+	for (uint32_t i = 0; i < cpuinfo_get_cores_count(); i++) {
+		const cpuinfo_core* core = cpuinfo_get_core(i);
+		ASSERT_EQ(2, core->processor_count);
+		const uint32_t linux_id = (uint32_t)cpuinfo_get_processor(core->processor_start)->linux_id;
+		EXPECT_EQ(prefcore_rankings[linux_id % 16], core->performance_ranking) << "core " << i;
+	}
+}
+
+TEST(RANKED_PROCESSORS, best_core_first) {
+	std::vector<const cpuinfo_processor*> ranked(cpuinfo_get_processors_count());
+	ASSERT_EQ(cpuinfo_get_processors_count(), cpuinfo_get_ranked_processors(ranked.data()));
+	EXPECT_EQ(1, ranked[0]->linux_id % 16);
+	EXPECT_EQ(ranked[0]->core, ranked[1]->core);
+	for (uint32_t i = 1; i < ranked.size(); i++) {
+		EXPECT_GE(ranked[i - 1]->core->performance_ranking, ranked[i]->core->performance_ranking)
+			<< "processor " << i;
+	}
+}
+
+TEST(PLACEMENT, preferred_cores) {
+	std::vector<const cpuinfo_processor*> plan(cpuinfo_get_cores_count() + 1);
+	ASSERT_EQ(plan.size(), cpuinfo_plan_placement(plan.size(), cpuinfo_placement_policy_preferred_cores, plan.data()));
+	/* One thread on each core, fastest first, then the second thread of the fastest core */
+	EXPECT_EQ(236, plan[0]->core->performance_ranking);
+	for (uint32_t i = 1; i < cpuinfo_get_cores_count(); i++) {
+		EXPECT_GT(plan[i - 1]->core->performance_ranking, plan[i]->core->performance_ranking) << "thread " << i;
+	}
+	EXPECT_EQ(plan[0]->core, plan[cpuinfo_get_cores_count()]->core);
+	EXPECT_NE(plan[0], plan[cpuinfo_get_cores_count()]);
+}
+
+#include <synthetic-amd-prefcore.h>
+
+int main(int argc, char* argv[]) {
+	cpuinfo_mock_filesystem(filesystem);
+	cpuinfo_mock_set_cpuid(cpuid_dump, sizeof(cpuid_dump) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_mock_affinity(32);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,2084 @@
+struct cpuinfo_mock_cpuid cpuid_dump[] = {
+	{
+		.input_eax = 0x00000000,
+		.eax = 0x00000010,
+		.ebx = 0x68747541,
+		.ecx = 0x444D4163,
+		.edx = 0x69746E65,
+	},
+	{
+		.input_eax = 0x00000001,
+		.eax = 0x00A60F12,
+		.ebx = 0x00200800,
+		.ecx = 0x7EF8320B,
+		.edx = 0x178BFBFF,
+	},
+	{
+		.input_eax = 0x00000007,
+		.input_ecx = 0x00000000,
+		.eax = 0x00000001,
+		.ebx = 0xF1BF97A9,
+		.ecx = 0x00405FCE,
+		.edx = 0x10000010,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000000,
+		.eax = 0x00000001,
+		.ebx = 0x00000002,
+		.ecx = 0x00000100,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000001,
+		.eax = 0x00000005,
+		.ebx = 0x00000020,
+		.ecx = 0x00000201,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000002,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000002,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x80000000,
+		.eax = 0x8000001E,
+		.ebx = 0x68747541,
+		.ecx = 0x444D4163,
+		.edx = 0x69746E65,
+	},
+	{
+		.input_eax = 0x80000001,
+		.eax = 0x00A60F12,
+		.ebx = 0x00000000,
+		.ecx = 0x75C237FF,
+		.edx = 0x2FD3FBFF,
+	},
+	{
+		.input_eax = 0x8000001D,
+		.input_ecx = 0x00000000,
+		.eax = 0x00004121,
+		.ebx = 0x01C0003F,
+		.ecx = 0x0000003F,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x8000001D,
+		.input_ecx = 0x00000001,
+		.eax = 0x00004122,
+		.ebx = 0x01C0003F,
+		.ecx = 0x0000003F,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x8000001D,
+		.input_ecx = 0x00000002,
+		.eax = 0x00004143,
+		.ebx = 0x01C0003F,
+		.ecx = 0x000007FF,
+		.edx = 0x00000002,
+	},
+	{
+		.input_eax = 0x8000001D,
+		.input_ecx = 0x00000003,
+		.eax = 0x0003C163,
+		.ebx = 0x03C0003F,
+		.ecx = 0x00007FFF,
+		.edx = 0x00000001,
+	},
+	{
+		.input_eax = 0x8000001D,
+		.input_ecx = 0x00000004,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000000,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x8000001E,
+		.eax = 0x00000000,
+		.ebx = 0x00000100,
+		.ecx = 0x00000000,
+		.edx = 0x00000000,
+	},
+};
+struct cpuinfo_mock_file filesystem[] = {
+	{
+		.path = "/proc/cpuinfo",
+		.size = 6040,
+		.content =
+			"processor\t: 0\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 0\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 0\n"
+			"\n"
+			"processor\t: 1\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 1\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 2\n"
+			"\n"
+			"processor\t: 2\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 2\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 4\n"
+			"\n"
+			"processor\t: 3\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 3\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 6\n"
+			"\n"
+			"processor\t: 4\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 4\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 8\n"
+			"\n"
+			"processor\t: 5\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 5\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 10\n"
+			"\n"
+			"processor\t: 6\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 6\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 12\n"
+			"\n"
+			"processor\t: 7\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 7\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 14\n"
+			"\n"
+			"processor\t: 8\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 8\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 16\n"
+			"\n"
+			"processor\t: 9\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 9\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 18\n"
+			"\n"
+			"processor\t: 10\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 10\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 20\n"
+			"\n"
+			"processor\t: 11\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 11\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 22\n"
+			"\n"
+			"processor\t: 12\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 12\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 24\n"
+			"\n"
+			"processor\t: 13\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 13\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 26\n"
+			"\n"
+			"processor\t: 14\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 14\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 28\n"
+			"\n"
+			"processor\t: 15\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 15\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 30\n"
+			"\n"
+			"processor\t: 16\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 0\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 1\n"
+			"\n"
+			"processor\t: 17\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 1\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 3\n"
+			"\n"
+			"processor\t: 18\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 2\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 5\n"
+			"\n"
+			"processor\t: 19\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 3\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 7\n"
+			"\n"
+			"processor\t: 20\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 4\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 9\n"
+			"\n"
+			"processor\t: 21\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 5\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 11\n"
+			"\n"
+			"processor\t: 22\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 6\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 13\n"
+			"\n"
+			"processor\t: 23\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 7\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 15\n"
+			"\n"
+			"processor\t: 24\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 8\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 17\n"
+			"\n"
+			"processor\t: 25\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 9\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 19\n"
+			"\n"
+			"processor\t: 26\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 10\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 21\n"
+			"\n"
+			"processor\t: 27\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 11\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 23\n"
+			"\n"
+			"processor\t: 28\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 12\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 25\n"
+			"\n"
+			"processor\t: 29\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 13\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 27\n"
+			"\n"
+			"processor\t: 30\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 14\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 29\n"
+			"\n"
+			"processor\t: 31\n"
+			"vendor_id\t: AuthenticAMD\n"
+			"cpu family\t: 25\n"
+			"model\t\t: 97\n"
+			"model name\t: AMD Ryzen 9 7950X 16-Core Processor\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 15\n"
+			"cpu cores\t: 16\n"
+			"apicid\t\t: 31\n"
+			"\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/possible",
+		.size = 5,
+		.content = "0-31\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/present",
+		.size = 5,
+		.content = "0-31\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/online",
+		.size = 5,
+		.content = "0-31\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "226\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "226\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/topology/core_id",
+		.size = 2,
+		.content = "0\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/topology/thread_siblings_list",
+		.size = 5,
+		.content = "0,16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "236\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "236\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/topology/core_id",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/topology/thread_siblings_list",
+		.size = 5,
+		.content = "1,17\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "231\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "231\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/topology/core_id",
+		.size = 2,
+		.content = "2\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/topology/thread_siblings_list",
+		.size = 5,
+		.content = "2,18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "221\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "221\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/topology/core_id",
+		.size = 2,
+		.content = "3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/topology/thread_siblings_list",
+		.size = 5,
+		.content = "3,19\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "216\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "216\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/topology/core_id",
+		.size = 2,
+		.content = "4\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/topology/thread_siblings_list",
+		.size = 5,
+		.content = "4,20\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "211\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "211\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/topology/core_id",
+		.size = 2,
+		.content = "5\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/topology/thread_siblings_list",
+		.size = 5,
+		.content = "5,21\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "206\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "206\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/topology/core_id",
+		.size = 2,
+		.content = "6\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/topology/thread_siblings_list",
+		.size = 5,
+		.content = "6,22\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "201\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "201\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/topology/core_id",
+		.size = 2,
+		.content = "7\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/topology/thread_siblings_list",
+		.size = 5,
+		.content = "7,23\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "196\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "196\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/topology/core_id",
+		.size = 2,
+		.content = "8\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/topology/thread_siblings_list",
+		.size = 5,
+		.content = "8,24\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "191\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "191\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/topology/core_id",
+		.size = 2,
+		.content = "9\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/topology/thread_siblings_list",
+		.size = 5,
+		.content = "9,25\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "186\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "186\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/topology/core_id",
+		.size = 3,
+		.content = "10\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/topology/thread_siblings_list",
+		.size = 6,
+		.content = "10,26\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "181\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "181\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/topology/core_id",
+		.size = 3,
+		.content = "11\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/topology/thread_siblings_list",
+		.size = 6,
+		.content = "11,27\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "176\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "176\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/topology/core_id",
+		.size = 3,
+		.content = "12\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/topology/thread_siblings_list",
+		.size = 6,
+		.content = "12,28\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "171\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "171\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/topology/core_id",
+		.size = 3,
+		.content = "13\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/topology/thread_siblings_list",
+		.size = 6,
+		.content = "13,29\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/topology/core_id",
+		.size = 3,
+		.content = "14\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/topology/thread_siblings_list",
+		.size = 6,
+		.content = "14,30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "161\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "161\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/topology/core_id",
+		.size = 3,
+		.content = "15\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/topology/thread_siblings_list",
+		.size = 6,
+		.content = "15,31\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "226\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "226\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/topology/core_id",
+		.size = 2,
+		.content = "0\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/topology/thread_siblings_list",
+		.size = 5,
+		.content = "0,16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "236\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "236\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/topology/core_id",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/topology/thread_siblings_list",
+		.size = 5,
+		.content = "1,17\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "231\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "231\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/topology/core_id",
+		.size = 2,
+		.content = "2\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/topology/thread_siblings_list",
+		.size = 5,
+		.content = "2,18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "221\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "221\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/topology/core_id",
+		.size = 2,
+		.content = "3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/topology/thread_siblings_list",
+		.size = 5,
+		.content = "3,19\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "216\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "216\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/topology/core_id",
+		.size = 2,
+		.content = "4\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/topology/thread_siblings_list",
+		.size = 5,
+		.content = "4,20\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "211\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "211\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/topology/core_id",
+		.size = 2,
+		.content = "5\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/topology/thread_siblings_list",
+		.size = 5,
+		.content = "5,21\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "206\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "206\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/topology/core_id",
+		.size = 2,
+		.content = "6\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/topology/thread_siblings_list",
+		.size = 5,
+		.content = "6,22\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "201\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "201\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/topology/core_id",
+		.size = 2,
+		.content = "7\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/topology/thread_siblings_list",
+		.size = 5,
+		.content = "7,23\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "196\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "196\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/topology/core_id",
+		.size = 2,
+		.content = "8\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/topology/thread_siblings_list",
+		.size = 5,
+		.content = "8,24\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "191\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "191\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/topology/core_id",
+		.size = 2,
+		.content = "9\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/topology/thread_siblings_list",
+		.size = 5,
+		.content = "9,25\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "186\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "186\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/topology/core_id",
+		.size = 3,
+		.content = "10\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/topology/thread_siblings_list",
+		.size = 6,
+		.content = "10,26\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "181\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "181\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/topology/core_id",
+		.size = 3,
+		.content = "11\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/topology/thread_siblings_list",
+		.size = 6,
+		.content = "11,27\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "176\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "176\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/topology/core_id",
+		.size = 3,
+		.content = "12\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/topology/thread_siblings_list",
+		.size = 6,
+		.content = "12,28\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "171\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "171\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/topology/core_id",
+		.size = 3,
+		.content = "13\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/topology/thread_siblings_list",
+		.size = 6,
+		.content = "13,29\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/topology/core_id",
+		.size = 3,
+		.content = "14\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/topology/thread_siblings_list",
+		.size = 6,
+		.content = "14,30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/acpi_cppc/highest_perf",
+		.size = 4,
+		.content = "161\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/acpi_cppc/lowest_perf",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/acpi_cppc/nominal_perf",
+		.size = 4,
+		.content = "115\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/cpufreq/amd_pstate_highest_perf",
+		.size = 4,
+		.content = "166\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/cpufreq/amd_pstate_hw_prefcore",
+		.size = 8,
+		.content = "enabled\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/cpufreq/amd_pstate_max_freq",
+		.size = 8,
+		.content = "5881000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/cpufreq/amd_pstate_prefcore_ranking",
+		.size = 4,
+		.content = "161\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/cpufreq/scaling_driver",
+		.size = 15,
+		.content = "amd-pstate-epp\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/topology/core_id",
+		.size = 3,
+		.content = "15\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/topology/thread_siblings_list",
+		.size = 6,
+		.content = "15,31\n",
+	},
+	{NULL},
+};
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+#include <synthetic-hugepages.h>
+
+/*
+ * 2 cores with 2 threads each. CPUID leaf 0x18 reports 64-entry 4 KB, 32-entry
+ * 2 MB and 8-entry 1 GB load DTLBs, and a 2048-entry STLB for 4 KB and 2 MB
+ * pages next to a 1024-entry STLB for 1 GB pages.
+ */
+static const uint64_t KB = UINT64_C(1024);
+static const uint64_t MB = UINT64_C(1024) * KB;
+static const uint64_t GB = UINT64_C(1024) * MB;
+
+static void set_file(const char* path, const char* content) {
+	for (cpuinfo_mock_file* file = filesystem; file->path != nullptr; file++) {
+		if (strcmp(file->path, path) == 0) {
+			file->content = content;
+			file->size = strlen(content);
+			return;
+		}
+	}
+	FAIL() << "no mock file " << path;
+}
+
+/* Sets the transparent huge pages mode and the free pages of the 2 MB and 1 GB pools */
+static void set_memory_pages(const char* thp_enabled, const char* free_2mb_pages, const char* free_1gb_pages) {
+	set_file("/sys/kernel/mm/transparent_hugepage/enabled", thp_enabled);
+	set_file("/sys/kernel/mm/hugepages/hugepages-2048kB/free_hugepages", free_2mb_pages);
+	set_file("/sys/kernel/mm/hugepages/hugepages-1048576kB/free_hugepages", free_1gb_pages);
+	cpuinfo_mock_filesystem(filesystem);
+}
+
+static cpuinfo_page_advice advise(uint64_t working_set_size, cpuinfo_access_pattern access_pattern) {
+	cpuinfo_page_advice advice = {};
+	EXPECT_TRUE(cpuinfo_advise_page_size(working_set_size, access_pattern, 0, &advice));
+	return advice;
+}
+
+TEST(MEMORY_PAGES, pools) {
+	set_memory_pages("always [madvise] never\n", "256\n", "2\n");
+	cpuinfo_memory_pages pages;
+	ASSERT_TRUE(cpuinfo_get_memory_pages(&pages));
+	EXPECT_EQ(cpuinfo_transparent_huge_pages_madvise, pages.transparent_huge_pages);
+	EXPECT_EQ(2 * MB, pages.transparent_huge_page_size);
+	ASSERT_EQ(2, pages.huge_pages_count);
+	EXPECT_EQ(2 * MB, pages.huge_pages[0].page_size);
+	EXPECT_EQ(512, pages.huge_pages[0].count);
+	EXPECT_EQ(256, pages.huge_pages[0].free_count);
+	EXPECT_EQ(1 * GB, pages.huge_pages[1].page_size);
+	EXPECT_EQ(4, pages.huge_pages[1].count);
+	EXPECT_EQ(2, pages.huge_pages[1].free_count);
+}
+
+TEST(MEMORY_PAGES, thp_modes) {
+	cpuinfo_memory_pages pages;
+	set_memory_pages("[always] madvise never\n", "256\n", "2\n");
+	ASSERT_TRUE(cpuinfo_get_memory_pages(&pages));
+	EXPECT_EQ(cpuinfo_transparent_huge_pages_always, pages.transparent_huge_pages);
+	set_memory_pages("always madvise [never]\n", "256\n", "2\n");
+	ASSERT_TRUE(cpuinfo_get_memory_pages(&pages));
+	EXPECT_EQ(cpuinfo_transparent_huge_pages_never, pages.transparent_huge_pages);
+}
+
+TEST(TLB, reach) {
+	EXPECT_EQ(64, cpuinfo_get_dtlb(0, CPUINFO_PAGE_SIZE_4KB)->entries);
+	EXPECT_EQ(32, cpuinfo_get_dtlb(0, CPUINFO_PAGE_SIZE_2MB)->entries);
+	EXPECT_EQ(8, cpuinfo_get_dtlb(0, CPUINFO_PAGE_SIZE_1GB)->entries);
+	EXPECT_EQ(2048, cpuinfo_get_stlb(0, CPUINFO_PAGE_SIZE_4KB)->entries);
+	EXPECT_EQ(2048, cpuinfo_get_stlb(0, CPUINFO_PAGE_SIZE_2MB)->entries);
+	EXPECT_EQ(1024, cpuinfo_get_stlb(0, CPUINFO_PAGE_SIZE_1GB)->entries);
+}
+
+TEST(PAGE_ADVICE, base_pages_within_tlb_reach) {
+	set_memory_pages("always [madvise] never\n", "256\n", "2\n");
+	/* The STLB maps 8 MB with 4 KB pages */
+	const cpuinfo_page_advice advice = advise(4 * MB, cpuinfo_access_pattern_random);
+	EXPECT_EQ(4 * KB, advice.page_size);
+	EXPECT_FALSE(advice.transparent);
+	EXPECT_EQ(8 * MB, advice.tlb_reach);
+	EXPECT_EQ(100, advice.tlb_coverage);
+}
+
+TEST(PAGE_ADVICE, pool_before_thp) {
+	set_memory_pages("always [madvise] never\n", "256\n", "2\n");
+	/* 512 MB are free in the 2 MB pool, which takes precedence over transparent huge pages of the same size */
+	const cpuinfo_page_advice advice = advise(64 * MB, cpuinfo_access_pattern_random);
+	EXPECT_EQ(2 * MB, advice.page_size);
+	EXPECT_FALSE(advice.transparent);
+	EXPECT_EQ(4 * GB, advice.tlb_reach);
+	EXPECT_EQ(100, advice.tlb_coverage);
+}
+
+TEST(PAGE_ADVICE, thp_when_pool_is_short) {
+	set_memory_pages("always [madvise] never\n", "256\n", "2\n");
+	/* The 2 MB pool holds only 512 MB, so 2 MB pages come from transparent huge pages */
+	const cpuinfo_page_advice advice = advise(1 * GB, cpuinfo_access_pattern_random);
+	EXPECT_EQ(2 * MB, advice.page_size);
+	EXPECT_TRUE(advice.transparent);
+	EXPECT_EQ(4 * GB, advice.tlb_reach);
+	EXPECT_EQ(100, advice.tlb_coverage);
+}
+
+TEST(PAGE_ADVICE, gigantic_pages_without_thp) {
+	set_memory_pages("always madvise [never]\n", "0\n", "2\n");
+	/* The STLB covers 8 MB with base pages, and the 1 GB pool is the only huge page source */
+	const cpuinfo_page_advice advice = advise(1 * GB, cpuinfo_access_pattern_random);
+	EXPECT_EQ(1 * GB, advice.page_size);
+	EXPECT_FALSE(advice.transparent);
+	EXPECT_EQ(1024 * GB, advice.tlb_reach);
+	EXPECT_EQ(100, advice.tlb_coverage);
+}
+
+TEST(PAGE_ADVICE, partial_coverage) {
+	set_memory_pages("always [madvise] never\n", "256\n", "2\n");
+	/* Neither pool holds 16 GB, and transparent huge pages map 4 GB of it */
+	const cpuinfo_page_advice advice = advise(16 * GB, cpuinfo_access_pattern_random);
+	EXPECT_EQ(2 * MB, advice.page_size);
+	EXPECT_TRUE(advice.transparent);
+	EXPECT_EQ(4 * GB, advice.tlb_reach);
+	EXPECT_EQ(25, advice.tlb_coverage);
+}
+
+TEST(PAGE_ADVICE, sequential_base_pages) {
+	set_memory_pages("[always] madvise never\n", "256\n", "2\n");
+	const cpuinfo_page_advice advice = advise(64 * MB, cpuinfo_access_pattern_sequential);
+	EXPECT_EQ(4 * KB, advice.page_size);
+	EXPECT_EQ(8 * MB, advice.tlb_reach);
+	EXPECT_EQ(12, advice.tlb_coverage);
+}
+
+int main(int argc, char* argv[]) {
+	cpuinfo_mock_filesystem(filesystem);
+	cpuinfo_mock_set_cpuid(cpuid_dump, sizeof(cpuid_dump) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_mock_affinity(4);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,227 @@
+struct cpuinfo_mock_cpuid cpuid_dump[] = {
+	{
+		.input_eax = 0x00000000,
+		.eax = 0x00000018,
+		.ebx = 0x756E6547,
+		.ecx = 0x6C65746E,
+		.edx = 0x49656E69,
+	},
+	{
+		.input_eax = 0x00000001,
+		.eax = 0x000806F8,
+		.ebx = 0x00040800,
+		.ecx = 0x7FFAFBFF,
+		.edx = 0xBFEBFBFF,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000000,
+		.eax = 0x04004121,
+		.ebx = 0x02C0003F,
+		.ecx = 0x0000003F,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000001,
+		.eax = 0x04004122,
+		.ebx = 0x01C0003F,
+		.ecx = 0x0000003F,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000002,
+		.eax = 0x04004143,
+		.ebx = 0x03C0003F,
+		.ecx = 0x000007FF,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000003,
+		.eax = 0x0400C163,
+		.ebx = 0x03C0003F,
+		.ecx = 0x00001FFF,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000004,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000000,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000000,
+		.eax = 0x00000001,
+		.ebx = 0x00000002,
+		.ecx = 0x00000100,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000001,
+		.eax = 0x00000002,
+		.ebx = 0x00000004,
+		.ecx = 0x00000201,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000002,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000002,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000018,
+		.input_ecx = 0x00000000,
+		.eax = 0x00000004,
+		.ebx = 0x00040001,
+		.ecx = 0x00000010,
+		.edx = 0x00000024,
+	},
+	{
+		.input_eax = 0x00000018,
+		.input_ecx = 0x00000001,
+		.eax = 0x00000000,
+		.ebx = 0x00040006,
+		.ecx = 0x00000008,
+		.edx = 0x00000024,
+	},
+	{
+		.input_eax = 0x00000018,
+		.input_ecx = 0x00000002,
+		.eax = 0x00000000,
+		.ebx = 0x00080008,
+		.ecx = 0x00000001,
+		.edx = 0x00000124,
+	},
+	{
+		.input_eax = 0x00000018,
+		.input_ecx = 0x00000003,
+		.eax = 0x00000000,
+		.ebx = 0x00080003,
+		.ecx = 0x00000100,
+		.edx = 0x00000043,
+	},
+	{
+		.input_eax = 0x00000018,
+		.input_ecx = 0x00000004,
+		.eax = 0x00000000,
+		.ebx = 0x00080008,
+		.ecx = 0x00000080,
+		.edx = 0x00000043,
+	},
+	{
+		.input_eax = 0x80000000,
+		.eax = 0x80000008,
+		.ebx = 0x00000000,
+		.ecx = 0x00000000,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x80000001,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000121,
+		.edx = 0x2C100800,
+	},
+};
+struct cpuinfo_mock_file filesystem[] = {
+	{
+		.path = "/proc/cpuinfo",
+		.size = 544,
+		.content =
+			"processor\t: 0\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 4\n"
+			"core id\t\t: 0\n"
+			"cpu cores\t: 2\n"
+			"apicid\t\t: 0\n"
+			"\n"
+			"processor\t: 1\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 4\n"
+			"core id\t\t: 0\n"
+			"cpu cores\t: 2\n"
+			"apicid\t\t: 1\n"
+			"\n"
+			"processor\t: 2\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 4\n"
+			"core id\t\t: 1\n"
+			"cpu cores\t: 2\n"
+			"apicid\t\t: 2\n"
+			"\n"
+			"processor\t: 3\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 4\n"
+			"core id\t\t: 1\n"
+			"cpu cores\t: 2\n"
+			"apicid\t\t: 3\n"
+			"\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/possible",
+		.size = 4,
+		.content = "0-3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/present",
+		.size = 4,
+		.content = "0-3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/online",
+		.size = 4,
+		.content = "0-3\n",
+	},
+	{
+		.path = "/sys/kernel/mm/transparent_hugepage/enabled",
+		.size = 23,
+		.content = "always [madvise] never\n",
+	},
+	{
+		.path = "/sys/kernel/mm/transparent_hugepage/hpage_pmd_size",
+		.size = 8,
+		.content = "2097152\n",
+	},
+	{
+		.path = "/sys/kernel/mm/hugepages/hugepages-2048kB/nr_hugepages",
+		.size = 4,
+		.content = "512\n",
+	},
+	{
+		.path = "/sys/kernel/mm/hugepages/hugepages-2048kB/free_hugepages",
+		.size = 4,
+		.content = "256\n",
+	},
+	{
+		.path = "/sys/kernel/mm/hugepages/hugepages-1048576kB/nr_hugepages",
+		.size = 2,
+		.content = "4\n",
+	},
+	{
+		.path = "/sys/kernel/mm/hugepages/hugepages-1048576kB/free_hugepages",
+		.size = 2,
+		.content = "2\n",
+	},
+	{NULL},
+};
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+/*
+ * 8 P-cores with 2 threads each (logical processors 0-15) and 16 E-cores
+ * (16-31). Without amd_pstate, the ACPI CPPC highest performance gives the
+ * ITMT priorities: 70 for the favored P-cores 2 and 3, 68 for other P-cores,
+ * and 42 for E-cores.
+ */
+static uint32_t itmt_priority(uint32_t core) {
+	if (core >= 8) {
+		return 42;
+	}
+	return core == 2 || core == 3 ? 70 : 68;
+}
+
+TEST(CORES, count) {
+	ASSERT_EQ(24, cpuinfo_get_cores_count());
+	ASSERT_EQ(32, cpuinfo_get_processors_count());
+}
+
+TEST(CORES, performance_ranking) {
+	for (uint32_t i = 0; i < cpuinfo_get_cores_count(); i++) {
+		EXPECT_EQ(itmt_priority(i), cpuinfo_get_core(i)->performance_ranking) << "core " << i;
+	}
+}
+
+TEST(CORES, uarch) {
+	for (uint32_t i = 0; i < cpuinfo_get_cores_count(); i++) {
+		const cpuinfo_core* core = cpuinfo_get_core(i);
+		EXPECT_EQ(i < 8 ? cpuinfo_uarch_raptor_cove : cpuinfo_uarch_gracemont, core->uarch) << "core " << i;
+		EXPECT_EQ(cpuinfo_get_cluster(i < 8 ? 0 : 1), core->cluster) << "core " << i;
+	}
+}
+
+TEST(CLUSTERS, core_types) {
+	ASSERT_EQ(2, cpuinfo_get_clusters_count());
+	/* P-cores listed by the cpu_core PMU, then E-cores listed by the cpu_atom PMU */
+	const cpuinfo_cluster* p_cluster = cpuinfo_get_cluster(0);
+	EXPECT_EQ(0, p_cluster->processor_start);
+	EXPECT_EQ(16, p_cluster->processor_count);
+	EXPECT_EQ(0, p_cluster->core_start);
+	EXPECT_EQ(8, p_cluster->core_count);
+	EXPECT_EQ(cpuinfo_uarch_raptor_cove, p_cluster->uarch);
+	const cpuinfo_cluster* e_cluster = cpuinfo_get_cluster(1);
+	EXPECT_EQ(16, e_cluster->processor_start);
+	EXPECT_EQ(16, e_cluster->processor_count);
+	EXPECT_EQ(8, e_cluster->core_start);
+	EXPECT_EQ(16, e_cluster->core_count);
+	EXPECT_EQ(cpuinfo_uarch_gracemont, e_cluster->uarch);
+}
+
+TEST(UARCHS, core_types) {
+	ASSERT_EQ(2, cpuinfo_get_uarchs_count());
+	const cpuinfo_uarch_info* p_uarch = cpuinfo_get_uarch(0);
+	EXPECT_EQ(cpuinfo_uarch_raptor_cove, p_uarch->uarch);
+	EXPECT_EQ(16, p_uarch->processor_count);
+	EXPECT_EQ(8, p_uarch->core_count);
+	const cpuinfo_uarch_info* e_uarch = cpuinfo_get_uarch(1);
+	EXPECT_EQ(cpuinfo_uarch_gracemont, e_uarch->uarch);
+	EXPECT_EQ(16, e_uarch->processor_count);
+	EXPECT_EQ(16, e_uarch->core_count);
+	/* Both core types report the family and model of the hybrid processor */
+	EXPECT_EQ(p_uarch->cpuid, e_uarch->cpuid);
+}
+
+TEST(RANKED_PROCESSORS, favored_cores_first) {
+	std::vector<const cpuinfo_processor*> ranked(cpuinfo_get_processors_count());
+	ASSERT_EQ(cpuinfo_get_processors_count(), cpuinfo_get_ranked_processors(ranked.data()));
+	/* Both threads of favored core 2, then of favored core 3, then other P-cores */
+	for (uint32_t i = 0; i < 4; i++) {
+		EXPECT_EQ(cpuinfo_get_core(2 + i / 2), ranked[i]->core) << "processor " << i;
+	}
+	EXPECT_EQ(68, ranked[4]->core->performance_ranking);
+	for (uint32_t i = 16; i < ranked.size(); i++) {
+		EXPECT_EQ(42, ranked[i]->core->performance_ranking) << "processor " << i;
+	}
+}
+
+TEST(PLACEMENT, preferred_cores) {
+	std::vector<const cpuinfo_processor*> plan(cpuinfo_get_cores_count());
+	ASSERT_EQ(plan.size(), cpuinfo_plan_placement(plan.size(), cpuinfo_placement_policy_preferred_cores, plan.data()));
+	/* Favored P-cores first, then other P-cores, then E-cores, one thread per core */
+	EXPECT_EQ(cpuinfo_get_core(2), plan[0]->core);
+	EXPECT_EQ(cpuinfo_get_core(3), plan[1]->core);
+	for (uint32_t i = 0; i < plan.size(); i++) {
+		EXPECT_EQ(0, plan[i]->smt_id) << "thread " << i;
+		EXPECT_EQ(i < 8 ? (i < 2 ? 70 : 68) : 42, plan[i]->core->performance_ranking) << "thread " << i;
+	}
+}
+
+#include <synthetic-intel-hybrid.h>
+
+int main(int argc, char* argv[]) {
+	cpuinfo_mock_filesystem(filesystem);
+	cpuinfo_mock_set_cpuid(cpuid_dump, sizeof(cpuid_dump) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_mock_affinity(32);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,1622 @@
+struct cpuinfo_mock_cpuid cpuid_dump[] = {
+	{
+		.input_eax = 0x00000000,
+		.eax = 0x00000020,
+		.ebx = 0x756E6547,
+		.ecx = 0x6C65746E,
+		.edx = 0x49656E69,
+	},
+	{
+		.input_eax = 0x00000001,
+		.eax = 0x000B0671,
+		.ebx = 0x00800800,
+		.ecx = 0x7FFAFBFF,
+		.edx = 0xBFEBFBFF,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000000,
+		.eax = 0xFC004121,
+		.ebx = 0x02C0003F,
+		.ecx = 0x0000003F,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000001,
+		.eax = 0xFC004122,
+		.ebx = 0x01C0003F,
+		.ecx = 0x0000003F,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000002,
+		.eax = 0xFC004143,
+		.ebx = 0x03C0003F,
+		.ecx = 0x000007FF,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000003,
+		.eax = 0xFC3FC163,
+		.ebx = 0x02C0003F,
+		.ecx = 0x0000BFFF,
+		.edx = 0x00000004,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000004,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000000,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000007,
+		.input_ecx = 0x00000000,
+		.eax = 0x00000002,
+		.ebx = 0x239CA7EB,
+		.ecx = 0x98C007BC,
+		.edx = 0xFC18C410,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000000,
+		.eax = 0x00000001,
+		.ebx = 0x00000002,
+		.ecx = 0x00000100,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000001,
+		.eax = 0x00000007,
+		.ebx = 0x00000020,
+		.ecx = 0x00000201,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000002,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000002,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000016,
+		.eax = 0x00000BB8,
+		.ebx = 0x000016A8,
+		.ecx = 0x00000064,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000001A,
+		.input_ecx = 0x00000000,
+		.eax = 0x40000001,
+		.ebx = 0x00000000,
+		.ecx = 0x00000000,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x80000000,
+		.eax = 0x80000008,
+		.ebx = 0x00000000,
+		.ecx = 0x00000000,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x80000001,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000121,
+		.edx = 0x2C100800,
+	},
+};
+struct cpuinfo_mock_file filesystem[] = {
+	{
+		.path = "/proc/cpuinfo",
+		.size = 6092,
+		.content =
+			"processor\t: 0\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 0\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 0\n"
+			"\n"
+			"processor\t: 1\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 0\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 1\n"
+			"\n"
+			"processor\t: 2\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 4\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 8\n"
+			"\n"
+			"processor\t: 3\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 4\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 9\n"
+			"\n"
+			"processor\t: 4\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 8\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 16\n"
+			"\n"
+			"processor\t: 5\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 8\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 17\n"
+			"\n"
+			"processor\t: 6\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 12\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 24\n"
+			"\n"
+			"processor\t: 7\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 12\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 25\n"
+			"\n"
+			"processor\t: 8\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 16\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 32\n"
+			"\n"
+			"processor\t: 9\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 16\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 33\n"
+			"\n"
+			"processor\t: 10\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 20\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 40\n"
+			"\n"
+			"processor\t: 11\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 20\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 41\n"
+			"\n"
+			"processor\t: 12\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 24\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 48\n"
+			"\n"
+			"processor\t: 13\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 24\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 49\n"
+			"\n"
+			"processor\t: 14\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 28\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 56\n"
+			"\n"
+			"processor\t: 15\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 28\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 57\n"
+			"\n"
+			"processor\t: 16\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 32\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 64\n"
+			"\n"
+			"processor\t: 17\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 33\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 66\n"
+			"\n"
+			"processor\t: 18\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 34\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 68\n"
+			"\n"
+			"processor\t: 19\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 35\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 70\n"
+			"\n"
+			"processor\t: 20\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 36\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 72\n"
+			"\n"
+			"processor\t: 21\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 37\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 74\n"
+			"\n"
+			"processor\t: 22\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 38\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 76\n"
+			"\n"
+			"processor\t: 23\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 39\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 78\n"
+			"\n"
+			"processor\t: 24\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 40\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 80\n"
+			"\n"
+			"processor\t: 25\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 41\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 82\n"
+			"\n"
+			"processor\t: 26\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 42\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 84\n"
+			"\n"
+			"processor\t: 27\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 43\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 86\n"
+			"\n"
+			"processor\t: 28\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 44\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 88\n"
+			"\n"
+			"processor\t: 29\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 45\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 90\n"
+			"\n"
+			"processor\t: 30\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 46\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 92\n"
+			"\n"
+			"processor\t: 31\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 183\n"
+			"model name\t: 13th Gen Intel(R) Core(TM) i9-13900K\n"
+			"physical id\t: 0\n"
+			"siblings\t: 32\n"
+			"core id\t\t: 47\n"
+			"cpu cores\t: 24\n"
+			"apicid\t\t: 94\n"
+			"\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/possible",
+		.size = 5,
+		.content = "0-31\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/present",
+		.size = 5,
+		.content = "0-31\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/online",
+		.size = 5,
+		.content = "0-31\n",
+	},
+	{
+		.path = "/sys/devices/cpu_core/cpus",
+		.size = 5,
+		.content = "0-15\n",
+	},
+	{
+		.path = "/sys/devices/cpu_atom/cpus",
+		.size = 6,
+		.content = "16-31\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "68\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5500000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/topology/core_id",
+		.size = 2,
+		.content = "0\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/topology/thread_siblings_list",
+		.size = 4,
+		.content = "0-1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "68\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5500000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/topology/core_id",
+		.size = 2,
+		.content = "0\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/topology/thread_siblings_list",
+		.size = 4,
+		.content = "0-1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "68\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5500000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/topology/core_id",
+		.size = 2,
+		.content = "4\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/topology/thread_siblings_list",
+		.size = 4,
+		.content = "2-3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "68\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5500000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/topology/core_id",
+		.size = 2,
+		.content = "4\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/topology/thread_siblings_list",
+		.size = 4,
+		.content = "2-3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "70\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5800000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/topology/core_id",
+		.size = 2,
+		.content = "8\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/topology/thread_siblings_list",
+		.size = 4,
+		.content = "4-5\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "70\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5800000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/topology/core_id",
+		.size = 2,
+		.content = "8\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/topology/thread_siblings_list",
+		.size = 4,
+		.content = "4-5\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "70\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5800000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/topology/core_id",
+		.size = 3,
+		.content = "12\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/topology/thread_siblings_list",
+		.size = 4,
+		.content = "6-7\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "70\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5800000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/topology/core_id",
+		.size = 3,
+		.content = "12\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/topology/thread_siblings_list",
+		.size = 4,
+		.content = "6-7\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "68\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5500000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/topology/core_id",
+		.size = 3,
+		.content = "16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu8/topology/thread_siblings_list",
+		.size = 4,
+		.content = "8-9\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "68\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5500000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/topology/core_id",
+		.size = 3,
+		.content = "16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu9/topology/thread_siblings_list",
+		.size = 4,
+		.content = "8-9\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "68\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5500000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/topology/core_id",
+		.size = 3,
+		.content = "20\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu10/topology/thread_siblings_list",
+		.size = 6,
+		.content = "10-11\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "68\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5500000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/topology/core_id",
+		.size = 3,
+		.content = "20\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu11/topology/thread_siblings_list",
+		.size = 6,
+		.content = "10-11\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "68\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5500000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/topology/core_id",
+		.size = 3,
+		.content = "24\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu12/topology/thread_siblings_list",
+		.size = 6,
+		.content = "12-13\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "68\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5500000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/topology/core_id",
+		.size = 3,
+		.content = "24\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu13/topology/thread_siblings_list",
+		.size = 6,
+		.content = "12-13\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "68\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5500000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/topology/core_id",
+		.size = 3,
+		.content = "28\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu14/topology/thread_siblings_list",
+		.size = 6,
+		.content = "14-15\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "68\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "5500000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/topology/core_id",
+		.size = 3,
+		.content = "28\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu15/topology/thread_siblings_list",
+		.size = 6,
+		.content = "14-15\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/topology/core_id",
+		.size = 3,
+		.content = "32\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu16/topology/thread_siblings_list",
+		.size = 3,
+		.content = "16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/topology/core_id",
+		.size = 3,
+		.content = "33\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu17/topology/thread_siblings_list",
+		.size = 3,
+		.content = "17\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/topology/core_id",
+		.size = 3,
+		.content = "34\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu18/topology/thread_siblings_list",
+		.size = 3,
+		.content = "18\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/topology/core_id",
+		.size = 3,
+		.content = "35\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu19/topology/thread_siblings_list",
+		.size = 3,
+		.content = "19\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/topology/core_id",
+		.size = 3,
+		.content = "36\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu20/topology/thread_siblings_list",
+		.size = 3,
+		.content = "20\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/topology/core_id",
+		.size = 3,
+		.content = "37\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu21/topology/thread_siblings_list",
+		.size = 3,
+		.content = "21\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/topology/core_id",
+		.size = 3,
+		.content = "38\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu22/topology/thread_siblings_list",
+		.size = 3,
+		.content = "22\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/topology/core_id",
+		.size = 3,
+		.content = "39\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu23/topology/thread_siblings_list",
+		.size = 3,
+		.content = "23\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/topology/core_id",
+		.size = 3,
+		.content = "40\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu24/topology/thread_siblings_list",
+		.size = 3,
+		.content = "24\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/topology/core_id",
+		.size = 3,
+		.content = "41\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu25/topology/thread_siblings_list",
+		.size = 3,
+		.content = "25\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/topology/core_id",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu26/topology/thread_siblings_list",
+		.size = 3,
+		.content = "26\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/topology/core_id",
+		.size = 3,
+		.content = "43\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu27/topology/thread_siblings_list",
+		.size = 3,
+		.content = "27\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/topology/core_id",
+		.size = 3,
+		.content = "44\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu28/topology/thread_siblings_list",
+		.size = 3,
+		.content = "28\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/topology/core_id",
+		.size = 3,
+		.content = "45\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu29/topology/thread_siblings_list",
+		.size = 3,
+		.content = "29\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/topology/core_id",
+		.size = 3,
+		.content = "46\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu30/topology/thread_siblings_list",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/acpi_cppc/highest_perf",
+		.size = 3,
+		.content = "42\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/acpi_cppc/lowest_perf",
+		.size = 2,
+		.content = "1\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/acpi_cppc/nominal_perf",
+		.size = 3,
+		.content = "30\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/cpufreq/cpuinfo_max_freq",
+		.size = 8,
+		.content = "4300000\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/cpufreq/scaling_driver",
+		.size = 13,
+		.content = "intel_pstate\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/topology/core_id",
+		.size = 3,
+		.content = "47\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu31/topology/thread_siblings_list",
+		.size = 3,
+		.content = "31\n",
+	},
+	{NULL},
+};
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+#include <synthetic-snc.h>
+
+/*
+ * 2 packages with sub-NUMA clustering into 2 nodes each (Intel SNC-2, or AMD
+ * NPS2), 2 cores with 2 threads per node, and a memory-only node attached to
+ * package 0, as with CXL memory expanders.
+ */
+static const uint32_t nodes_count = 5;
+static const uint32_t node_processors_count = 4;
+static const uint32_t node_cores_count = 2;
+static const uint32_t slit[nodes_count][nodes_count] = {
+	{10, 12, 21, 21, 14},
+	{12, 10, 21, 21, 14},
+	{21, 21, 10, 12, 24},
+	{21, 21, 12, 10, 24},
+	{14, 14, 24, 24, 10},
+};
+
+TEST(PACKAGES, count) {
+	EXPECT_EQ(2, cpuinfo_get_packages_count());
+	EXPECT_EQ(16, cpuinfo_get_processors_count());
+	EXPECT_EQ(8, cpuinfo_get_cores_count());
+}
+
+TEST(NUMA_NODES, count) {
+	/* The memory-only node counts, so nodes are not bounded by processors or packages */
+	ASSERT_EQ(nodes_count, cpuinfo_get_numa_nodes_count());
+	EXPECT_GT(cpuinfo_get_numa_nodes_count(), 2 * cpuinfo_get_packages_count());
+}
+
+TEST(NUMA_NODES, sub_numa_clusters) {
+	for (uint32_t i = 0; i < nodes_count - 1; i++) {
+		const cpuinfo_numa_node* node = cpuinfo_get_numa_node(i);
+		ASSERT_TRUE(node);
+		EXPECT_EQ(i, node->node_id);
+		EXPECT_EQ(i * node_processors_count, node->processor_start);
+		EXPECT_EQ(node_processors_count, node->processor_count);
+		EXPECT_EQ(i * node_cores_count, node->core_start);
+		EXPECT_EQ(node_cores_count, node->core_count);
+		/* Two nodes share each package */
+		EXPECT_EQ(cpuinfo_get_package(i / 2), node->package);
+		EXPECT_EQ(UINT64_C(16) * 1024 * 1024 * 1024, node->memory_size);
+		for (uint32_t j = 0; j < node->processor_count; j++) {
+			EXPECT_EQ(node, cpuinfo_get_processor(node->processor_start + j)->numa_node);
+		}
+	}
+}
+
+TEST(NUMA_NODES, memory_only) {
+	const cpuinfo_numa_node* node = cpuinfo_get_numa_node(nodes_count - 1);
+	ASSERT_TRUE(node);
+	EXPECT_EQ(4, node->node_id);
+	EXPECT_EQ(0, node->processor_count);
+	EXPECT_EQ(0, node->core_count);
+	EXPECT_FALSE(node->package);
+	EXPECT_EQ(UINT64_C(64) * 1024 * 1024 * 1024, node->memory_size);
+}
+
+TEST(NUMA_DISTANCE, slit) {
+	for (uint32_t i = 0; i < nodes_count; i++) {
+		for (uint32_t j = 0; j < nodes_count; j++) {
+			EXPECT_EQ(slit[i][j], cpuinfo_get_numa_distance(i, j)) << "from node " << i << " to node " << j;
+		}
+	}
+	EXPECT_EQ(0, cpuinfo_get_numa_distance(nodes_count, 0));
+	EXPECT_EQ(0, cpuinfo_get_numa_distance(0, nodes_count));
+}
+
+TEST(NUMA_DISTANCE, sibling_cluster_is_nearest) {
+	/* The other node of the same package is closer than any node of the other package */
+	for (uint32_t i = 0; i < nodes_count - 1; i++) {
+		const uint32_t sibling = i ^ 1;
+		for (uint32_t j = 0; j < nodes_count - 1; j++) {
+			if (cpuinfo_get_numa_node(j)->package != cpuinfo_get_numa_node(i)->package) {
+				EXPECT_LT(cpuinfo_get_numa_distance(i, sibling), cpuinfo_get_numa_distance(i, j));
+			}
+		}
+	}
+}
+
+TEST(AFFINITY_MASK, numa_node) {
+	cpuinfo_affinity_mask mask = {};
+	ASSERT_TRUE(cpuinfo_affinity_mask_add_numa_node(&mask, cpuinfo_get_numa_node(1)));
+	EXPECT_EQ(node_processors_count, cpuinfo_affinity_mask_count(&mask));
+	for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+		EXPECT_EQ(i / node_processors_count == 1, cpuinfo_affinity_mask_has_processor_id(&mask, i));
+	}
+	cpuinfo_affinity_mask_free(&mask);
+}
+
+int main(int argc, char* argv[]) {
+	cpuinfo_mock_filesystem(filesystem);
+	cpuinfo_mock_set_cpuid(cpuid_dump, sizeof(cpuid_dump) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_mock_affinity(16);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
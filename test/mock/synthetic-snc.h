@@ -0,0 +1,367 @@
+struct cpuinfo_mock_cpuid cpuid_dump[] = {
+	{
+		.input_eax = 0x00000000,
+		.eax = 0x0000000B,
+		.ebx = 0x756E6547,
+		.ecx = 0x6C65746E,
+		.edx = 0x49656E69,
+	},
+	{
+		.input_eax = 0x00000001,
+		.eax = 0x000806F8,
+		.ebx = 0x00080800,
+		.ecx = 0x7FFAFBFF,
+		.edx = 0xBFEBFBFF,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000000,
+		.eax = 0x0C004121,
+		.ebx = 0x02C0003F,
+		.ecx = 0x0000003F,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000001,
+		.eax = 0x0C004122,
+		.ebx = 0x01C0003F,
+		.ecx = 0x0000003F,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000002,
+		.eax = 0x0C004143,
+		.ebx = 0x03C0003F,
+		.ecx = 0x000007FF,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000003,
+		.eax = 0x0C01C163,
+		.ebx = 0x03C0003F,
+		.ecx = 0x00001FFF,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000004,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000000,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000000,
+		.eax = 0x00000001,
+		.ebx = 0x00000002,
+		.ecx = 0x00000100,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000001,
+		.eax = 0x00000003,
+		.ebx = 0x00000008,
+		.ecx = 0x00000201,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000002,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000002,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x80000000,
+		.eax = 0x80000008,
+		.ebx = 0x00000000,
+		.ecx = 0x00000000,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x80000001,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000121,
+		.edx = 0x2C100800,
+	},
+};
+struct cpuinfo_mock_file filesystem[] = {
+	{
+		.path = "/proc/cpuinfo",
+		.size = 2188,
+		.content =
+			"processor\t: 0\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 0\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 0\n"
+			"\n"
+			"processor\t: 1\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 0\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 1\n"
+			"\n"
+			"processor\t: 2\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 1\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 2\n"
+			"\n"
+			"processor\t: 3\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 1\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 3\n"
+			"\n"
+			"processor\t: 4\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 2\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 4\n"
+			"\n"
+			"processor\t: 5\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 2\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 5\n"
+			"\n"
+			"processor\t: 6\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 3\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 6\n"
+			"\n"
+			"processor\t: 7\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 3\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 7\n"
+			"\n"
+			"processor\t: 8\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 1\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 0\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 8\n"
+			"\n"
+			"processor\t: 9\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 1\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 0\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 9\n"
+			"\n"
+			"processor\t: 10\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 1\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 1\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 10\n"
+			"\n"
+			"processor\t: 11\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 1\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 1\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 11\n"
+			"\n"
+			"processor\t: 12\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 1\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 2\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 12\n"
+			"\n"
+			"processor\t: 13\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 1\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 2\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 13\n"
+			"\n"
+			"processor\t: 14\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 1\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 3\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 14\n"
+			"\n"
+			"processor\t: 15\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 1\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 3\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 15\n"
+			"\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/possible",
+		.size = 5,
+		.content = "0-15\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/present",
+		.size = 5,
+		.content = "0-15\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/online",
+		.size = 5,
+		.content = "0-15\n",
+	},
+	{
+		.path = "/sys/devices/system/node/online",
+		.size = 4,
+		.content = "0-4\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node0/cpulist",
+		.size = 4,
+		.content = "0-3\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node0/distance",
+		.size = 15,
+		.content = "10 12 21 21 14\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node0/meminfo",
+		.size = 69,
+		.content =
+			"Node 0 MemTotal:       16777216 kB\n"
+			"Node 0 MemFree:        8388608 kB\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node1/cpulist",
+		.size = 4,
+		.content = "4-7\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node1/distance",
+		.size = 15,
+		.content = "12 10 21 21 14\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node1/meminfo",
+		.size = 69,
+		.content =
+			"Node 1 MemTotal:       16777216 kB\n"
+			"Node 1 MemFree:        8388608 kB\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node2/cpulist",
+		.size = 5,
+		.content = "8-11\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node2/distance",
+		.size = 15,
+		.content = "21 21 10 12 24\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node2/meminfo",
+		.size = 69,
+		.content =
+			"Node 2 MemTotal:       16777216 kB\n"
+			"Node 2 MemFree:        8388608 kB\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node3/cpulist",
+		.size = 6,
+		.content = "12-15\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node3/distance",
+		.size = 15,
+		.content = "21 21 12 10 24\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node3/meminfo",
+		.size = 69,
+		.content =
+			"Node 3 MemTotal:       16777216 kB\n"
+			"Node 3 MemFree:        8388608 kB\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node4/cpulist",
+		.size = 1,
+		.content = "\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node4/distance",
+		.size = 15,
+		.content = "14 14 24 24 10\n",
+	},
+	{
+		.path = "/sys/devices/system/node/node4/meminfo",
+		.size = 70,
+		.content =
+			"Node 4 MemTotal:       67108864 kB\n"
+			"Node 4 MemFree:        33554432 kB\n",
+	},
+	{NULL},
+};
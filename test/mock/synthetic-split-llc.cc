@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <cpuinfo-mock.h>
+#include <cpuinfo.h>
+
+#include <synthetic-split-llc.h>
+
+/*
+ * 4 cores with 2 threads each. CPUID reports an L3 cache shared by the whole
+ * package, while sysfs cacheinfo splits it into two 8 MB caches of 2 cores, as
+ * on virtual machines which pass through the host CPUID.
+ */
+TEST(L3_CACHES, sysfs_sharing) {
+	ASSERT_EQ(2, cpuinfo_get_l3_caches_count());
+	for (uint32_t i = 0; i < cpuinfo_get_l3_caches_count(); i++) {
+		const cpuinfo_cache* cache = cpuinfo_get_l3_cache(i);
+		EXPECT_EQ(8 * 1024 * 1024, cache->size);
+		EXPECT_EQ(i * 4, cache->processor_start);
+		EXPECT_EQ(4, cache->processor_count);
+		EXPECT_TRUE(cache->flags & CPUINFO_CACHE_REPORTED_BY_OS);
+	}
+}
+
+TEST(CLUSTERS, follow_l3_caches) {
+	ASSERT_EQ(2, cpuinfo_get_clusters_count());
+	for (uint32_t i = 0; i < cpuinfo_get_clusters_count(); i++) {
+		const cpuinfo_cluster* cluster = cpuinfo_get_cluster(i);
+		EXPECT_EQ(i, cluster->cluster_id);
+		EXPECT_EQ(i * 4, cluster->processor_start);
+		EXPECT_EQ(4, cluster->processor_count);
+		EXPECT_EQ(i * 2, cluster->core_start);
+		EXPECT_EQ(2, cluster->core_count);
+		EXPECT_EQ(cpuinfo_get_package(0), cluster->package);
+	}
+	EXPECT_EQ(2, cpuinfo_get_package(0)->cluster_count);
+}
+
+TEST(PROCESSORS, cluster_shares_l3_cache) {
+	for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+		const cpuinfo_processor* processor = cpuinfo_get_processor(i);
+		ASSERT_TRUE(processor->cache.l3);
+		EXPECT_EQ(processor->cache.l3->processor_start, processor->cluster->processor_start);
+		EXPECT_EQ(processor->cache.l3->processor_count, processor->cluster->processor_count);
+		EXPECT_EQ(processor->cluster, processor->core->cluster);
+	}
+}
+
+int main(int argc, char* argv[]) {
+	cpuinfo_mock_filesystem(filesystem);
+	cpuinfo_mock_set_cpuid(cpuid_dump, sizeof(cpuid_dump) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_mock_affinity(8);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,477 @@
+struct cpuinfo_mock_cpuid cpuid_dump[] = {
+	{
+		.input_eax = 0x00000000,
+		.eax = 0x0000000B,
+		.ebx = 0x756E6547,
+		.ecx = 0x6C65746E,
+		.edx = 0x49656E69,
+	},
+	{
+		.input_eax = 0x00000001,
+		.eax = 0x000806F8,
+		.ebx = 0x00080800,
+		.ecx = 0x7FFAFBFF,
+		.edx = 0xBFEBFBFF,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000000,
+		.eax = 0x0C004121,
+		.ebx = 0x02C0003F,
+		.ecx = 0x0000003F,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000001,
+		.eax = 0x0C004122,
+		.ebx = 0x01C0003F,
+		.ecx = 0x0000003F,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000002,
+		.eax = 0x0C004143,
+		.ebx = 0x03C0003F,
+		.ecx = 0x000007FF,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000003,
+		.eax = 0x0C01C163,
+		.ebx = 0x03C0003F,
+		.ecx = 0x00003FFF,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x00000004,
+		.input_ecx = 0x00000004,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000000,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000000,
+		.eax = 0x00000001,
+		.ebx = 0x00000002,
+		.ecx = 0x00000100,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000001,
+		.eax = 0x00000003,
+		.ebx = 0x00000008,
+		.ecx = 0x00000201,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x0000000B,
+		.input_ecx = 0x00000002,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000002,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x80000000,
+		.eax = 0x80000008,
+		.ebx = 0x00000000,
+		.ecx = 0x00000000,
+		.edx = 0x00000000,
+	},
+	{
+		.input_eax = 0x80000001,
+		.eax = 0x00000000,
+		.ebx = 0x00000000,
+		.ecx = 0x00000121,
+		.edx = 0x2C100800,
+	},
+};
+struct cpuinfo_mock_file filesystem[] = {
+	{
+		.path = "/proc/cpuinfo",
+		.size = 1088,
+		.content =
+			"processor\t: 0\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 0\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 0\n"
+			"\n"
+			"processor\t: 1\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 0\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 1\n"
+			"\n"
+			"processor\t: 2\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 1\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 2\n"
+			"\n"
+			"processor\t: 3\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 1\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 3\n"
+			"\n"
+			"processor\t: 4\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 2\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 4\n"
+			"\n"
+			"processor\t: 5\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 2\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 5\n"
+			"\n"
+			"processor\t: 6\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 3\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 6\n"
+			"\n"
+			"processor\t: 7\n"
+			"vendor_id\t: GenuineIntel\n"
+			"cpu family\t: 6\n"
+			"model\t\t: 143\n"
+			"physical id\t: 0\n"
+			"siblings\t: 8\n"
+			"core id\t\t: 3\n"
+			"cpu cores\t: 4\n"
+			"apicid\t\t: 7\n"
+			"\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/possible",
+		.size = 4,
+		.content = "0-7\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/present",
+		.size = 4,
+		.content = "0-7\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/online",
+		.size = 4,
+		.content = "0-7\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cache/index0/level",
+		.size = 2,
+		.content = "3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cache/index0/type",
+		.size = 8,
+		.content = "Unified\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cache/index0/size",
+		.size = 6,
+		.content = "8192K\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cache/index0/ways_of_associativity",
+		.size = 3,
+		.content = "16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cache/index0/coherency_line_size",
+		.size = 3,
+		.content = "64\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cache/index0/number_of_sets",
+		.size = 5,
+		.content = "8192\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu0/cache/index0/shared_cpu_list",
+		.size = 4,
+		.content = "0-3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cache/index0/level",
+		.size = 2,
+		.content = "3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cache/index0/type",
+		.size = 8,
+		.content = "Unified\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cache/index0/size",
+		.size = 6,
+		.content = "8192K\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cache/index0/ways_of_associativity",
+		.size = 3,
+		.content = "16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cache/index0/coherency_line_size",
+		.size = 3,
+		.content = "64\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cache/index0/number_of_sets",
+		.size = 5,
+		.content = "8192\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu1/cache/index0/shared_cpu_list",
+		.size = 4,
+		.content = "0-3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cache/index0/level",
+		.size = 2,
+		.content = "3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cache/index0/type",
+		.size = 8,
+		.content = "Unified\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cache/index0/size",
+		.size = 6,
+		.content = "8192K\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cache/index0/ways_of_associativity",
+		.size = 3,
+		.content = "16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cache/index0/coherency_line_size",
+		.size = 3,
+		.content = "64\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cache/index0/number_of_sets",
+		.size = 5,
+		.content = "8192\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu2/cache/index0/shared_cpu_list",
+		.size = 4,
+		.content = "0-3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cache/index0/level",
+		.size = 2,
+		.content = "3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cache/index0/type",
+		.size = 8,
+		.content = "Unified\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cache/index0/size",
+		.size = 6,
+		.content = "8192K\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cache/index0/ways_of_associativity",
+		.size = 3,
+		.content = "16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cache/index0/coherency_line_size",
+		.size = 3,
+		.content = "64\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cache/index0/number_of_sets",
+		.size = 5,
+		.content = "8192\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu3/cache/index0/shared_cpu_list",
+		.size = 4,
+		.content = "0-3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cache/index0/level",
+		.size = 2,
+		.content = "3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cache/index0/type",
+		.size = 8,
+		.content = "Unified\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cache/index0/size",
+		.size = 6,
+		.content = "8192K\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cache/index0/ways_of_associativity",
+		.size = 3,
+		.content = "16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cache/index0/coherency_line_size",
+		.size = 3,
+		.content = "64\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cache/index0/number_of_sets",
+		.size = 5,
+		.content = "8192\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu4/cache/index0/shared_cpu_list",
+		.size = 4,
+		.content = "4-7\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cache/index0/level",
+		.size = 2,
+		.content = "3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cache/index0/type",
+		.size = 8,
+		.content = "Unified\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cache/index0/size",
+		.size = 6,
+		.content = "8192K\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cache/index0/ways_of_associativity",
+		.size = 3,
+		.content = "16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cache/index0/coherency_line_size",
+		.size = 3,
+		.content = "64\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cache/index0/number_of_sets",
+		.size = 5,
+		.content = "8192\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu5/cache/index0/shared_cpu_list",
+		.size = 4,
+		.content = "4-7\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cache/index0/level",
+		.size = 2,
+		.content = "3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cache/index0/type",
+		.size = 8,
+		.content = "Unified\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cache/index0/size",
+		.size = 6,
+		.content = "8192K\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cache/index0/ways_of_associativity",
+		.size = 3,
+		.content = "16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cache/index0/coherency_line_size",
+		.size = 3,
+		.content = "64\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cache/index0/number_of_sets",
+		.size = 5,
+		.content = "8192\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu6/cache/index0/shared_cpu_list",
+		.size = 4,
+		.content = "4-7\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cache/index0/level",
+		.size = 2,
+		.content = "3\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cache/index0/type",
+		.size = 8,
+		.content = "Unified\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cache/index0/size",
+		.size = 6,
+		.content = "8192K\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cache/index0/ways_of_associativity",
+		.size = 3,
+		.content = "16\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cache/index0/coherency_line_size",
+		.size = 3,
+		.content = "64\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cache/index0/number_of_sets",
+		.size = 5,
+		.content = "8192\n",
+	},
+	{
+		.path = "/sys/devices/system/cpu/cpu7/cache/index0/shared_cpu_list",
+		.size = 4,
+		.content = "4-7\n",
+	},
+	{NULL},
+};
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <cpuinfo.h>
+
+static std::string snapshot_path() {
+	return std::string(testing::TempDir()) + "cpuinfo-snapshot-test-" + std::to_string(getpid());
+}
+
+struct processor_record {
+	uint32_t smt_id;
+	uint32_t core_id;
+	uint32_t cluster_id;
+	uint32_t core_index;
+	int linux_id;
+	uint32_t l1d_size;
+	uint32_t l2_size;
+	uint32_t l3_size;
+	uint32_t numa_node_id;
+};
+
+static std::vector<processor_record> record_processors() {
+	std::vector<processor_record> records;
+	for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+		const cpuinfo_processor* processor = cpuinfo_get_processor(i);
+		records.push_back(processor_record{
+			processor->smt_id,
+			processor->core->core_id,
+			processor->cluster->cluster_id,
+			(uint32_t)(processor->core - cpuinfo_get_cores()),
+			processor->linux_id,
+			processor->cache.l1d != nullptr ? processor->cache.l1d->size : 0,
+			processor->cache.l2 != nullptr ? processor->cache.l2->size : 0,
+			processor->cache.l3 != nullptr ? processor->cache.l3->size : 0,
+			processor->numa_node != nullptr ? processor->numa_node->node_id : UINT32_MAX,
+		});
+	}
+	return records;
+}
+
+TEST(SNAPSHOT, round_trip) {
+	const std::string path = snapshot_path();
+
+	ASSERT_TRUE(cpuinfo_initialize());
+	const std::vector<processor_record> expected = record_processors();
+	const uint32_t cores_count = cpuinfo_get_cores_count();
+	const uint32_t packages_count = cpuinfo_get_packages_count();
+	const std::string package_name = cpuinfo_get_package(0)->name;
+	const uint32_t max_cache_size = cpuinfo_get_max_cache_size();
+	const uint32_t numa_nodes_count = cpuinfo_get_numa_nodes_count();
+	std::vector<uint32_t> numa_distances;
+	for (uint32_t i = 0; i < numa_nodes_count * numa_nodes_count; i++) {
+		numa_distances.push_back(cpuinfo_get_numa_distance(i / numa_nodes_count, i % numa_nodes_count));
+	}
+	ASSERT_TRUE(cpuinfo_save_snapshot(path.c_str()));
+	cpuinfo_deinitialize();
+
+	ASSERT_TRUE(cpuinfo_initialize_from_snapshot(path.c_str()));
+	const std::vector<processor_record> loaded = record_processors();
+	ASSERT_EQ(expected.size(), loaded.size());
+	for (size_t i = 0; i < expected.size(); i++) {
+		EXPECT_EQ(0, memcmp(&expected[i], &loaded[i], sizeof(processor_record)));
+	}
+	EXPECT_EQ(cores_count, cpuinfo_get_cores_count());
+	EXPECT_EQ(packages_count, cpuinfo_get_packages_count());
+	EXPECT_EQ(package_name, cpuinfo_get_package(0)->name);
+	EXPECT_EQ(max_cache_size, cpuinfo_get_max_cache_size());
+	ASSERT_EQ(numa_nodes_count, cpuinfo_get_numa_nodes_count());
+	for (uint32_t i = 0; i < numa_nodes_count * numa_nodes_count; i++) {
+		EXPECT_EQ(numa_distances[i], cpuinfo_get_numa_distance(i / numa_nodes_count, i % numa_nodes_count));
+	}
+	const cpuinfo_processor* current_processor = cpuinfo_get_current_processor();
+	EXPECT_TRUE(current_processor);
+	cpuinfo_deinitialize();
+
+	std::remove(path.c_str());
+}
+
+TEST(SNAPSHOT, corrupted) {
+	const std::string path = snapshot_path();
+
+	FILE* file = std::fopen(path.c_str(), "wb");
+	ASSERT_TRUE(file);
+	const char garbage[] = "not a cpuinfo snapshot";
+	std::fwrite(garbage, 1, sizeof(garbage), file);
+	std::fclose(file);
+
+	/* Falls back to full detection and rewrites the snapshot */
+	ASSERT_TRUE(cpuinfo_initialize_from_snapshot(path.c_str()));
+	EXPECT_NE(0, cpuinfo_get_processors_count());
+	cpuinfo_deinitialize();
+
+	ASSERT_TRUE(cpuinfo_initialize_from_snapshot(path.c_str()));
+	EXPECT_NE(0, cpuinfo_get_processors_count());
+	cpuinfo_deinitialize();
+
+	std::remove(path.c_str());
+}
+
+TEST(SNAPSHOT, missing) {
+	const std::string path = snapshot_path() + "-missing";
+	std::remove(path.c_str());
+
+	ASSERT_TRUE(cpuinfo_initialize_from_snapshot(path.c_str()));
+	EXPECT_NE(0, cpuinfo_get_processors_count());
+	cpuinfo_deinitialize();
+
+	EXPECT_EQ(0, access(path.c_str(), R_OK));
+	std::remove(path.c_str());
+}
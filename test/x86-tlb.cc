@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <cpuinfo.h>
+extern "C" {
+#include <x86/api.h>
+}
+
+static cpuinfo_x86_tlbs decode_leaf_0x18(const cpuid_regs subleaves[], size_t count) {
+	cpuinfo_x86_tlbs tlb = {};
+	for (size_t i = 0; i < count; i++) {
+		cpuinfo_x86_decode_deterministic_tlb_parameters(subleaves[i], &tlb);
+	}
+	return tlb;
+}
+
+TEST(DETERMINISTIC_TLB_PARAMETERS, empty_subleaf) {
+	cpuinfo_x86_tlbs tlb = {};
+	EXPECT_FALSE(cpuinfo_x86_decode_deterministic_tlb_parameters(cpuid_regs{4, 0, 0, 0}, &tlb));
+	EXPECT_EQ(0, tlb.itlb_4KB.entries);
+	EXPECT_EQ(0, tlb.dtlb_4KB.entries);
+	EXPECT_EQ(0, tlb.stlb2_4KB.entries);
+}
+
+TEST(DETERMINISTIC_TLB_PARAMETERS, hybrid_core) {
+	const cpuid_regs subleaves[] = {
+		/* L1 instruction TLB: 4K, 2M and 4M pages, 8-way, 32 sets */
+		{4, 0x00080007, 0x00000020, 0x00000022},
+		/* L1 load-only TLB: 4K pages, fully associative, 64 entries */
+		{0, 0x00400001, 0x00000001, 0x00000124},
+		/* L1 store-only TLB: 4K pages, fully associative, 16 entries */
+		{0, 0x00100001, 0x00000001, 0x00000125},
+		/* L2 unified TLB: 4K and 2M pages, 8-way, 256 sets */
+		{0, 0x00080003, 0x00000100, 0x00000043},
+		/* L2 unified TLB: 1G pages, 8-way, 4 sets */
+		{0, 0x00080008, 0x00000004, 0x00000043},
+	};
+	const cpuinfo_x86_tlbs tlb = decode_leaf_0x18(subleaves, sizeof(subleaves) / sizeof(subleaves[0]));
+	EXPECT_EQ(256, tlb.itlb_4KB.entries);
+	EXPECT_EQ(8, tlb.itlb_4KB.associativity);
+	EXPECT_EQ(CPUINFO_PAGE_SIZE_4KB | CPUINFO_PAGE_SIZE_2MB | CPUINFO_PAGE_SIZE_4MB, tlb.itlb_4KB.pages);
+	EXPECT_EQ(256, tlb.itlb_2MB.entries);
+	EXPECT_EQ(256, tlb.itlb_4MB.entries);
+	EXPECT_EQ(64, tlb.dtlb_4KB.entries);
+	EXPECT_EQ(64, tlb.dtlb_4KB.associativity);
+	EXPECT_EQ(0, tlb.dtlb_2MB.entries);
+	EXPECT_EQ(2048, tlb.stlb2_4KB.entries);
+	EXPECT_EQ(8, tlb.stlb2_4KB.associativity);
+	EXPECT_EQ(2048, tlb.stlb2_2MB.entries);
+	EXPECT_EQ(32, tlb.stlb2_1GB.entries);
+	EXPECT_EQ(CPUINFO_PAGE_SIZE_1GB, tlb.stlb2_1GB.pages);
+}
+
+TEST(AMD_TLBS, l1_and_l2) {
+	cpuinfo_x86_tlbs tlb = {};
+	cpuinfo_x86_decode_amd_tlbs(
+		/* Fully associative L1 TLBs of 64 entries for 4K and 2M pages */
+		cpuid_regs{0xFF40FF40, 0xFF40FF40, 0, 0},
+		/* 8-way L2 TLBs of 2048 data and 1024 instruction entries */
+		cpuid_regs{0x68006400, 0x68006400, 0, 0},
+		/* Fully associative L1 TLBs of 64 entries and 8-way L2 TLBs of 1024 entries for 1G pages */
+		cpuid_regs{0xF040F040, 0x64006400, 0, 0},
+		&tlb);
+	EXPECT_EQ(64, tlb.itlb_4KB.entries);
+	EXPECT_EQ(64, tlb.itlb_4KB.associativity);
+	EXPECT_EQ(CPUINFO_PAGE_SIZE_4KB, tlb.itlb_4KB.pages);
+	EXPECT_EQ(64, tlb.itlb_2MB.entries);
+	EXPECT_EQ(0, tlb.itlb_4MB.entries);
+	EXPECT_EQ(64, tlb.dtlb_4KB.entries);
+	EXPECT_EQ(64, tlb.dtlb_2MB.entries);
+	EXPECT_EQ(64, tlb.dtlb_1GB.entries);
+	EXPECT_EQ(64, tlb.dtlb_1GB.associativity);
+	EXPECT_EQ(2048, tlb.stlb2_4KB.entries);
+	EXPECT_EQ(8, tlb.stlb2_4KB.associativity);
+	EXPECT_EQ(2048, tlb.stlb2_2MB.entries);
+	EXPECT_EQ(1024, tlb.stlb2_1GB.entries);
+	EXPECT_EQ(CPUINFO_PAGE_SIZE_1GB, tlb.stlb2_1GB.pages);
+}
+
@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <cpuinfo.h>
+extern "C" {
+#include <x86/api.h>
+}
+
+/* Parses sub-leaves of CPUID leaf 0xB or 0x1F in the output format of cpuid-dump */
+static std::vector<cpuid_regs> parse_cpuid_dump(const char* const lines[], size_t count) {
+	std::vector<cpuid_regs> levels;
+	for (size_t i = 0; i < count; i++) {
+		uint32_t leaf, subleaf;
+		cpuid_regs regs;
+		EXPECT_EQ(
+			6,
+			sscanf(lines[i],
+			       "CPUID %" SCNx32 ": %" SCNx32 "-%" SCNx32 "-%" SCNx32 "-%" SCNx32 " [SL %" SCNx32 "]",
+			       &leaf,
+			       &regs.eax,
+			       &regs.ebx,
+			       &regs.ecx,
+			       &regs.edx,
+			       &subleaf));
+		EXPECT_EQ(levels.size(), subleaf);
+		levels.push_back(regs);
+	}
+	return levels;
+}
+
+static cpuinfo_x86_topology decode_topology(const char* const lines[], size_t count) {
+	const std::vector<cpuid_regs> levels = parse_cpuid_dump(lines, count);
+	cpuinfo_x86_topology topology = {};
+	cpuinfo_x86_decode_extended_topology(levels.size(), levels.data(), &topology);
+	return topology;
+}
+
+TEST(EXTENDED_TOPOLOGY, leaf_b_smt) {
+	/* 12 cores with 2 threads each */
+	const char* const dump[] = {
+		"CPUID 0000000B: 00000001-00000002-00000100-00000007 [SL 00]",
+		"CPUID 0000000B: 00000005-00000018-00000201-00000007 [SL 01]",
+		"CPUID 0000000B: 00000000-00000000-00000002-00000007 [SL 02]",
+	};
+	const cpuinfo_x86_topology topology = decode_topology(dump, sizeof(dump) / sizeof(dump[0]));
+	EXPECT_EQ(UINT32_C(0x00000007), topology.apic_id);
+	EXPECT_EQ(0, topology.thread_bits_offset);
+	EXPECT_EQ(1, topology.thread_bits_length);
+	EXPECT_EQ(1, topology.core_bits_offset);
+	EXPECT_EQ(4, topology.core_bits_length);
+	EXPECT_EQ(0, topology.module_bits_length);
+	EXPECT_EQ(0, topology.tile_bits_length);
+	EXPECT_EQ(0, topology.die_bits_length);
+	EXPECT_EQ(5, topology.package_bits_offset);
+}
+
+TEST(EXTENDED_TOPOLOGY, leaf_b_no_smt) {
+	/* 32 cores without SMT */
+	const char* const dump[] = {
+		"CPUID 0000000B: 00000000-00000001-00000100-00000000 [SL 00]",
+		"CPUID 0000000B: 00000005-00000020-00000201-00000000 [SL 01]",
+		"CPUID 0000000B: 00000000-00000000-00000002-00000000 [SL 02]",
+	};
+	const cpuinfo_x86_topology topology = decode_topology(dump, sizeof(dump) / sizeof(dump[0]));
+	EXPECT_EQ(0, topology.thread_bits_length);
+	EXPECT_EQ(0, topology.core_bits_offset);
+	EXPECT_EQ(5, topology.core_bits_length);
+	EXPECT_EQ(5, topology.package_bits_offset);
+}
+
+TEST(EXTENDED_TOPOLOGY, four_dies) {
+	/* Server package of 4 dies with 14 cores and 2 threads per core */
+	const char* const dump[] = {
+		"CPUID 0000001F: 00000001-00000002-00000100-00000185 [SL 00]",
+		"CPUID 0000001F: 00000007-0000001C-00000201-00000185 [SL 01]",
+		"CPUID 0000001F: 00000009-00000070-00000502-00000185 [SL 02]",
+		"CPUID 0000001F: 00000000-00000000-00000003-00000185 [SL 03]",
+	};
+	const cpuinfo_x86_topology topology = decode_topology(dump, sizeof(dump) / sizeof(dump[0]));
+	EXPECT_EQ(UINT32_C(0x00000185), topology.apic_id);
+	EXPECT_EQ(0, topology.thread_bits_offset);
+	EXPECT_EQ(1, topology.thread_bits_length);
+	EXPECT_EQ(1, topology.core_bits_offset);
+	EXPECT_EQ(6, topology.core_bits_length);
+	EXPECT_EQ(0, topology.module_bits_length);
+	EXPECT_EQ(7, topology.die_bits_offset);
+	EXPECT_EQ(2, topology.die_bits_length);
+	EXPECT_EQ(9, topology.package_bits_offset);
+}
+
+TEST(EXTENDED_TOPOLOGY, four_dies_package_id) {
+	/* Thread 1 of core 5 on die 3 of the second package of the four_dies system */
+	const char* const dump[] = {
+		"CPUID 0000001F: 00000001-00000002-00000100-0000038B [SL 00]",
+		"CPUID 0000001F: 00000007-0000001C-00000201-0000038B [SL 01]",
+		"CPUID 0000001F: 00000009-00000070-00000502-0000038B [SL 02]",
+		"CPUID 0000001F: 00000000-00000000-00000003-0000038B [SL 03]",
+	};
+	const cpuinfo_x86_topology topology = decode_topology(dump, sizeof(dump) / sizeof(dump[0]));
+	/* Die bits sit between the core and package bits: the package ID starts above them */
+	EXPECT_GT(topology.package_bits_offset, topology.core_bits_offset + topology.core_bits_length);
+	EXPECT_EQ(1, topology.apic_id >> topology.package_bits_offset);
+	EXPECT_EQ(3, (topology.apic_id >> topology.die_bits_offset) & ((1 << topology.die_bits_length) - 1));
+	EXPECT_EQ(5, (topology.apic_id >> topology.core_bits_offset) & ((1 << topology.core_bits_length) - 1));
+	EXPECT_EQ(1, (topology.apic_id >> topology.thread_bits_offset) & ((1 << topology.thread_bits_length) - 1));
+}
+
+TEST(EXTENDED_TOPOLOGY, atom_modules) {
+	/* Package of 2 dies with 16 modules of 4 cores each, without SMT */
+	const char* const dump[] = {
+		"CPUID 0000001F: 00000000-00000001-00000100-00000046 [SL 00]",
+		"CPUID 0000001F: 00000002-00000004-00000201-00000046 [SL 01]",
+		"CPUID 0000001F: 00000006-00000040-00000302-00000046 [SL 02]",
+		"CPUID 0000001F: 00000007-00000080-00000503-00000046 [SL 03]",
+		"CPUID 0000001F: 00000000-00000000-00000004-00000046 [SL 04]",
+	};
+	const cpuinfo_x86_topology topology = decode_topology(dump, sizeof(dump) / sizeof(dump[0]));
+	EXPECT_EQ(0, topology.thread_bits_length);
+	EXPECT_EQ(0, topology.core_bits_offset);
+	EXPECT_EQ(2, topology.core_bits_length);
+	EXPECT_EQ(2, topology.module_bits_offset);
+	EXPECT_EQ(4, topology.module_bits_length);
+	EXPECT_EQ(6, topology.die_bits_offset);
+	EXPECT_EQ(1, topology.die_bits_length);
+	EXPECT_EQ(7, topology.package_bits_offset);
+}
+
+TEST(EXTENDED_TOPOLOGY, tiles_and_die_groups) {
+	/* Package of 2 die groups with 2 dies of 2 tiles each, 16 cores per tile */
+	const char* const dump[] = {
+		"CPUID 0000001F: 00000001-00000002-00000100-00000000 [SL 00]",
+		"CPUID 0000001F: 00000005-00000020-00000201-00000000 [SL 01]",
+		"CPUID 0000001F: 00000006-00000040-00000402-00000000 [SL 02]",
+		"CPUID 0000001F: 00000007-00000080-00000503-00000000 [SL 03]",
+		"CPUID 0000001F: 00000008-00000100-00000604-00000000 [SL 04]",
+		"CPUID 0000001F: 00000000-00000000-00000005-00000000 [SL 05]",
+	};
+	const cpuinfo_x86_topology topology = decode_topology(dump, sizeof(dump) / sizeof(dump[0]));
+	EXPECT_EQ(1, topology.core_bits_offset);
+	EXPECT_EQ(4, topology.core_bits_length);
+	EXPECT_EQ(5, topology.tile_bits_offset);
+	EXPECT_EQ(1, topology.tile_bits_length);
+	EXPECT_EQ(6, topology.die_bits_offset);
+	EXPECT_EQ(1, topology.die_bits_length);
+	EXPECT_EQ(8, topology.package_bits_offset);
+}
+
+/* Refines the topology of leaves 1, 0xB and 0x80000008 with dumps of AMD leaves 0x8000001E and 0x80000026 */
+static cpuinfo_x86_topology decode_amd_topology(
+	cpuinfo_x86_topology topology,
+	const char* leaf0x8000001E,
+	const char* const levels_lines[],
+	size_t levels_count,
+	cpuinfo_uarch uarch,
+	uint32_t l3_apic_bits) {
+	const std::vector<cpuid_regs> leaf = parse_cpuid_dump(&leaf0x8000001E, 1);
+	const std::vector<cpuid_regs> levels = parse_cpuid_dump(levels_lines, levels_count);
+	cpuinfo_x86_caches cache = {};
+	cache.l3.size = 16 * 1024 * 1024;
+	cache.l3.apic_bits = l3_apic_bits;
+	cpuinfo_x86_decode_amd_topology(leaf.data(), levels.size(), levels.data(), uarch, &cache, &topology);
+	return topology;
+}
+
+TEST(AMD_TOPOLOGY, zen2_two_ccx_per_ccd) {
+	/* Ryzen 9 3900X: thread 1 of core 2 in CCX 1 of CCD 1, with 4 core slots per CCX and 2 CCDs */
+	cpuinfo_x86_topology topology = {};
+	/* Leaf 0x80000008 reports 24 threads and no leaf 0xB */
+	topology.core_bits_length = 5;
+	topology.package_bits_offset = 5;
+	/* L3 cache of a CCX is shared by 8 APIC IDs */
+	topology = decode_amd_topology(
+		topology, "CPUID 8000001E: 0000001D-0000010E-00000000-00000000 [SL 00]", nullptr, 0, cpuinfo_uarch_zen2, 3);
+	EXPECT_EQ(UINT32_C(0x0000001D), topology.apic_id);
+	EXPECT_EQ(0, topology.thread_bits_offset);
+	EXPECT_EQ(1, topology.thread_bits_length);
+	EXPECT_EQ(1, topology.core_bits_offset);
+	EXPECT_EQ(4, topology.core_bits_length);
+	EXPECT_EQ(4, topology.die_bits_offset);
+	EXPECT_EQ(1, topology.die_bits_length);
+	EXPECT_EQ(5, topology.package_bits_offset);
+	EXPECT_EQ(1, (topology.apic_id >> topology.die_bits_offset) & ((1 << topology.die_bits_length) - 1));
+}
+
+TEST(AMD_TOPOLOGY, zen4_extended_topology) {
+	/* Ryzen 9 7950X: thread 1 of core 3 in CCD 1, with one CCX of 8 cores per CCD */
+	const char* const leaf_b[] = {
+		"CPUID 0000000B: 00000001-00000002-00000100-00000017 [SL 00]",
+		"CPUID 0000000B: 00000005-00000020-00000201-00000017 [SL 01]",
+		"CPUID 0000000B: 00000000-00000000-00000002-00000017 [SL 02]",
+	};
+	const char* const levels[] = {
+		"CPUID 80000026: 00000001-00000002-00000100-00000017 [SL 00]",
+		"CPUID 80000026: 00000004-00000010-00000201-00000017 [SL 01]",
+		"CPUID 80000026: 00000004-00000010-00000302-00000017 [SL 02]",
+		"CPUID 80000026: 00000005-00000020-00000403-00000017 [SL 03]",
+		"CPUID 80000026: 00000000-00000000-00000004-00000017 [SL 04]",
+	};
+	const cpuinfo_x86_topology topology = decode_amd_topology(
+		decode_topology(leaf_b, sizeof(leaf_b) / sizeof(leaf_b[0])),
+		"CPUID 8000001E: 00000017-0000010B-00000000-00000000 [SL 00]",
+		levels,
+		sizeof(levels) / sizeof(levels[0]),
+		cpuinfo_uarch_zen4,
+		4);
+	EXPECT_EQ(UINT32_C(0x00000017), topology.apic_id);
+	EXPECT_EQ(1, topology.thread_bits_length);
+	EXPECT_EQ(1, topology.core_bits_offset);
+	EXPECT_EQ(4, topology.core_bits_length);
+	/* The CCD shift yields the CCD ID, and the socket shift the package ID */
+	EXPECT_EQ(4, topology.die_bits_offset);
+	EXPECT_EQ(1, topology.die_bits_length);
+	EXPECT_EQ(5, topology.package_bits_offset);
+	EXPECT_EQ(1, (topology.apic_id >> topology.die_bits_offset) & ((1 << topology.die_bits_length) - 1));
+}
+
+TEST(AMD_TOPOLOGY, bulldozer_modules_and_nodes) {
+	/* Opteron 6380: core 1 of module 2 on node 1, with 2 nodes of 4 two-core modules */
+	cpuinfo_x86_topology topology = {};
+	/* Leaf 0x80000008 reports 16 cores */
+	topology.core_bits_length = 4;
+	topology.package_bits_offset = 4;
+	topology = decode_amd_topology(
+		topology,
+		"CPUID 8000001E: 0000000D-00000106-00000101-00000000 [SL 00]",
+		nullptr,
+		0,
+		cpuinfo_uarch_piledriver,
+		3);
+	EXPECT_EQ(UINT32_C(0x0000000D), topology.apic_id);
+	EXPECT_EQ(0, topology.thread_bits_length);
+	EXPECT_EQ(1, topology.module_bits_offset);
+	EXPECT_EQ(3, topology.module_bits_length);
+	EXPECT_EQ(3, topology.die_bits_offset);
+	EXPECT_EQ(1, topology.die_bits_length);
+	EXPECT_EQ(4, topology.package_bits_offset);
+	/* Module and node IDs match the compute unit and node IDs of leaf 0x8000001E */
+	EXPECT_EQ(6, topology.apic_id >> topology.module_bits_offset);
+	EXPECT_EQ(1, (topology.apic_id >> topology.die_bits_offset) & ((1 << topology.die_bits_length) - 1));
+}
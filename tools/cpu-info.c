@@ -80,6 +80,12 @@ static const char* uarch_to_string(enum cpuinfo_uarch uarch) {
 			return "Palm Cove";
 		case cpuinfo_uarch_sunny_cove:
 			return "Sunny Cove";
+		case cpuinfo_uarch_golden_cove:
+			return "Golden Cove";
+		case cpuinfo_uarch_raptor_cove:
+			return "Raptor Cove";
+		case cpuinfo_uarch_redwood_cove:
+			return "Redwood Cove";
 		case cpuinfo_uarch_willamette:
 			return "Willamette";
 		case cpuinfo_uarch_prescott:
@@ -96,6 +102,10 @@ static const char* uarch_to_string(enum cpuinfo_uarch uarch) {
 			return "Goldmont";
 		case cpuinfo_uarch_goldmont_plus:
 			return "Goldmont Plus";
+		case cpuinfo_uarch_gracemont:
+			return "Gracemont";
+		case cpuinfo_uarch_crestmont:
+			return "Crestmont";
 		case cpuinfo_uarch_knights_ferry:
 			return "Knights Ferry";
 		case cpuinfo_uarch_knights_corner:
@@ -369,6 +379,26 @@ int main(int argc, char** argv) {
 			printf(", %s %s\n", vendor_string, uarch_string);
 		}
 	}
+	if (cpuinfo_get_numa_nodes_count() != 0) {
+		printf("NUMA nodes:\n");
+		for (uint32_t i = 0; i < cpuinfo_get_numa_nodes_count(); i++) {
+			const struct cpuinfo_numa_node* numa_node = cpuinfo_get_numa_node(i);
+			printf("\t%" PRIu32 " (node %" PRIu32 "): %" PRIu32 " processors",
+			       i,
+			       numa_node->node_id,
+			       numa_node->processor_count);
+			if (numa_node->processor_count != 0) {
+				printf(" (%" PRIu32 "-%" PRIu32 ")",
+				       numa_node->processor_start,
+				       numa_node->processor_start + numa_node->processor_count - 1);
+			}
+			printf(", %" PRIu64 " MB, distances", numa_node->memory_size >> 20);
+			for (uint32_t j = 0; j < cpuinfo_get_numa_nodes_count(); j++) {
+				printf(" %" PRIu32, cpuinfo_get_numa_distance(i, j));
+			}
+			printf("\n");
+		}
+	}
 	printf("Logical processors");
 #if defined(__linux__)
 	printf(" (System ID)");
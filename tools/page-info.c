@@ -0,0 +1,113 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cpuinfo.h>
+
+static const uint64_t working_set_sizes[] = {
+	UINT64_C(1048576),
+	UINT64_C(16777216),
+	UINT64_C(268435456),
+	UINT64_C(4294967296),
+	UINT64_C(68719476736),
+};
+
+static const char* thp_mode_to_string(enum cpuinfo_transparent_huge_pages mode) {
+	switch (mode) {
+		case cpuinfo_transparent_huge_pages_never:
+			return "never";
+		case cpuinfo_transparent_huge_pages_madvise:
+			return "madvise";
+		case cpuinfo_transparent_huge_pages_always:
+			return "always";
+		default:
+			return "unavailable";
+	}
+}
+
+static void print_size(uint64_t size) {
+	if (size != 0 && size % UINT64_C(1073741824) == 0) {
+		printf("%" PRIu64 " GB", size / UINT64_C(1073741824));
+	} else if (size != 0 && size % UINT64_C(1048576) == 0) {
+		printf("%" PRIu64 " MB", size / UINT64_C(1048576));
+	} else if (size != 0 && size % UINT64_C(1024) == 0) {
+		printf("%" PRIu64 " KB", size / UINT64_C(1024));
+	} else {
+		printf("%" PRIu64 " bytes", size);
+	}
+}
+
+static void report_tlb(const char* name, const struct cpuinfo_tlb* tlb, uint64_t page_size) {
+	if (tlb == NULL) {
+		return;
+	}
+	printf("\t\t%s: %" PRIu32 " entries, reach ", name, tlb->entries);
+	print_size((uint64_t)tlb->entries * page_size);
+	printf("\n");
+}
+
+int main(int argc, char** argv) {
+	if (!cpuinfo_initialize()) {
+		fprintf(stderr, "failed to initialize CPU information\n");
+		exit(EXIT_FAILURE);
+	}
+
+	struct cpuinfo_memory_pages pages;
+	cpuinfo_get_memory_pages(&pages);
+	printf("Base page: ");
+	print_size(pages.base_page_size);
+	printf("\nTransparent huge pages: %s", thp_mode_to_string(pages.transparent_huge_pages));
+	if (pages.transparent_huge_page_size != 0) {
+		printf(" (");
+		print_size(pages.transparent_huge_page_size);
+		printf(")");
+	}
+	printf("\n");
+	for (uint32_t i = 0; i < pages.huge_pages_count; i++) {
+		printf("Huge page pool ");
+		print_size(pages.huge_pages[i].page_size);
+		printf(": %" PRIu32 " pages, %" PRIu32 " free\n", pages.huge_pages[i].count, pages.huge_pages[i].free_count);
+	}
+
+	for (uint32_t i = 0; i < cpuinfo_get_uarchs_count(); i++) {
+		printf("Microarchitecture %" PRIu32 ":\n", i);
+		uint64_t page_sizes[CPUINFO_HUGE_PAGE_SIZES_MAX + 2] = {pages.base_page_size, pages.transparent_huge_page_size};
+		for (uint32_t k = 0; k < pages.huge_pages_count; k++) {
+			page_sizes[k + 2] = pages.huge_pages[k].page_size;
+		}
+		for (uint32_t k = 0; k < pages.huge_pages_count + 2; k++) {
+			bool reported = page_sizes[k] == 0;
+			for (uint32_t j = 0; j < k; j++) {
+				reported |= page_sizes[j] == page_sizes[k];
+			}
+			if (reported) {
+				continue;
+			}
+			printf("\t");
+			print_size(page_sizes[k]);
+			printf(" pages:\n");
+			report_tlb("DTLB", cpuinfo_get_dtlb(i, page_sizes[k]), page_sizes[k]);
+			report_tlb("STLB", cpuinfo_get_stlb(i, page_sizes[k]), page_sizes[k]);
+		}
+
+		for (size_t k = 0; k < sizeof(working_set_sizes) / sizeof(working_set_sizes[0]); k++) {
+			struct cpuinfo_page_advice sequential, random;
+			if (!cpuinfo_advise_page_size(working_set_sizes[k], cpuinfo_access_pattern_sequential, i, &sequential) ||
+			    !cpuinfo_advise_page_size(working_set_sizes[k], cpuinfo_access_pattern_random, i, &random)) {
+				continue;
+			}
+			printf("\tWorking set of ");
+			print_size(working_set_sizes[k]);
+			printf(": sequential ");
+			print_size(sequential.page_size);
+			printf(", random ");
+			print_size(random.page_size);
+			printf("%s", random.transparent ? " (transparent)" : "");
+			if (random.tlb_reach != 0) {
+				printf(" covering %" PRIu32 "%%", random.tlb_coverage);
+			}
+			printf("\n");
+		}
+	}
+}